@@ -0,0 +1,286 @@
+/*
+    archivemanifest.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "archivemanifest.h"
+
+#include "filehash_p.h"
+#include "filetreescanner.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+#include <QUrl>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace QGpgME;
+
+namespace
+{
+char typeToChar(ArchiveManifest::EntryType type)
+{
+    switch (type) {
+    case ArchiveManifest::Directory:
+        return 'd';
+    case ArchiveManifest::SymLink:
+        return 'l';
+    case ArchiveManifest::File:
+    default:
+        return 'f';
+    }
+}
+
+bool typeFromChar(char c, ArchiveManifest::EntryType &type)
+{
+    switch (c) {
+    case 'f':
+        type = ArchiveManifest::File;
+        return true;
+    case 'd':
+        type = ArchiveManifest::Directory;
+        return true;
+    case 'l':
+        type = ArchiveManifest::SymLink;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isModified(const ArchiveManifest::Entry &current, const ArchiveManifest::Entry &previous)
+{
+    if (current.type != previous.type) {
+        return true;
+    }
+    if (current.type == ArchiveManifest::Directory) {
+        return false;
+    }
+    // an unreadable file has no checksum; better archive it again
+    return current.sha256.isEmpty() || current.sha256 != previous.sha256;
+}
+}
+
+std::vector<QString> ArchiveManifest::Diff::changed() const
+{
+    std::vector<QString> result;
+    result.reserve(added.size() + modified.size());
+    std::merge(added.cbegin(), added.cend(), modified.cbegin(), modified.cend(), std::back_inserter(result));
+    return result;
+}
+
+ArchiveManifest::ArchiveManifest() = default;
+
+ArchiveManifest ArchiveManifest::create(const std::vector<QString> &paths,
+                                        const QString &baseDirectory,
+                                        const ArchiveManifest &previous)
+{
+    FileTreeScanner scanner{paths};
+    scanner.setBaseDirectory(baseDirectory);
+    const auto scan = scanner.scan();
+
+    ArchiveManifest manifest;
+    manifest.mEntries.resize(scan.paths.size());
+    const QDir baseDir{baseDirectory};
+
+    std::atomic<size_t> nextIndex{0};
+    const auto work = [&]() {
+        for (size_t i = nextIndex++; i < scan.paths.size(); i = nextIndex++) {
+            auto &entry = manifest.mEntries[i];
+            entry.path = scan.paths[i];
+            const QFileInfo fi{baseDirectory.isEmpty() ? entry.path : baseDir.filePath(entry.path)};
+            if (fi.isSymLink()) {
+                entry.type = SymLink;
+                entry.sha256 = QCryptographicHash::hash(fi.symLinkTarget().toUtf8(), QCryptographicHash::Sha256).toHex();
+                continue;
+            }
+            if (fi.isDir()) {
+                entry.type = Directory;
+                continue;
+            }
+            entry.type = File;
+            entry.size = fi.size();
+            entry.modificationTime = fi.lastModified().toMSecsSinceEpoch();
+            const Entry *const previousEntry = previous.find(entry.path);
+            if (previousEntry && previousEntry->type == File && previousEntry->size == entry.size
+                && previousEntry->modificationTime == entry.modificationTime && !previousEntry->sha256.isEmpty()) {
+                // unchanged file; don't read it again
+                entry.sha256 = previousEntry->sha256;
+            } else {
+                const auto hash = _detail::hashFile(fi.filePath(), QCryptographicHash::Sha256);
+                entry.sha256 = hash.checksum;
+                if (!hash.checksum.isEmpty()) {
+                    // the size of the hashed data in case the file was changed
+                    entry.size = hash.size;
+                }
+            }
+        }
+    };
+
+    const size_t numThreads = std::min<size_t>(std::max(QThread::idealThreadCount(), 1), std::max<size_t>(scan.paths.size() / 64, 1));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return manifest;
+}
+
+const ArchiveManifest::Entry *ArchiveManifest::find(const QString &path) const
+{
+    const auto it = std::lower_bound(mEntries.cbegin(), mEntries.cend(), path, [](const Entry &entry, const QString &path) {
+        return entry.path < path;
+    });
+    return (it != mEntries.cend() && it->path == path) ? &*it : nullptr;
+}
+
+ArchiveManifest::Diff ArchiveManifest::diff(const ArchiveManifest &previous) const
+{
+    Diff result;
+    auto current = mEntries.cbegin();
+    auto old = previous.mEntries.cbegin();
+    while (current != mEntries.cend() || old != previous.mEntries.cend()) {
+        if (old == previous.mEntries.cend() || (current != mEntries.cend() && current->path < old->path)) {
+            result.added.push_back(current->path);
+            ++current;
+        } else if (current == mEntries.cend() || old->path < current->path) {
+            result.removed.push_back(old->path);
+            ++old;
+        } else {
+            if (isModified(*current, *old)) {
+                result.modified.push_back(current->path);
+            }
+            ++current;
+            ++old;
+        }
+    }
+
+    // a formerly empty directory that now contains files was not removed
+    const auto isParentOfEntry = [this](const QString &path) {
+        const QString prefix = path + QLatin1Char('/');
+        const auto it = std::lower_bound(mEntries.cbegin(), mEntries.cend(), prefix, [](const Entry &entry, const QString &prefix) {
+            return entry.path < prefix;
+        });
+        return it != mEntries.cend() && it->path.startsWith(prefix);
+    };
+    result.removed.erase(std::remove_if(result.removed.begin(), result.removed.end(), [&](const QString &path) {
+        const Entry *const entry = previous.find(path);
+        return entry && entry->type == Directory && isParentOfEntry(path);
+    }), result.removed.end());
+
+    return result;
+}
+
+QByteArray ArchiveManifest::toByteArray() const
+{
+    QByteArray result = "QGpgME-Archive-Manifest: 1\n";
+    for (const auto &entry : mEntries) {
+        result += typeToChar(entry.type);
+        result += ' ';
+        result += entry.sha256.isEmpty() ? QByteArray{"-"} : entry.sha256;
+        result += ' ' + QByteArray::number(entry.size) + ' ' + QByteArray::number(entry.modificationTime) + ' ';
+        result += QUrl::toPercentEncoding(entry.path, "/");
+        result += '\n';
+    }
+    return result;
+}
+
+bool ArchiveManifest::fromByteArray(const QByteArray &data, ArchiveManifest &manifest)
+{
+    manifest.mEntries.clear();
+    const QList<QByteArray> lines = data.split('\n');
+    if (lines.isEmpty() || lines.front() != "QGpgME-Archive-Manifest: 1") {
+        return false;
+    }
+    manifest.mEntries.reserve(lines.size() - 1);
+    for (auto it = lines.cbegin() + 1; it != lines.cend(); ++it) {
+        if (it->isEmpty()) {
+            continue;
+        }
+        const QList<QByteArray> fields = it->split(' ');
+        Entry entry;
+        bool sizeOk = false, timeOk = false;
+        if (fields.size() != 5 || fields[0].size() != 1 || !typeFromChar(fields[0][0], entry.type)) {
+            return false;
+        }
+        entry.sha256 = fields[1] == "-" ? QByteArray{} : fields[1];
+        entry.size = fields[2].toLongLong(&sizeOk);
+        entry.modificationTime = fields[3].toLongLong(&timeOk);
+        entry.path = QUrl::fromPercentEncoding(fields[4]);
+        if (!sizeOk || !timeOk || entry.path.isEmpty()) {
+            return false;
+        }
+        manifest.mEntries.push_back(entry);
+    }
+    // the lookups rely on the order
+    const bool isSorted = std::is_sorted(manifest.mEntries.cbegin(), manifest.mEntries.cend(), [](const Entry &a, const Entry &b) {
+        return a.path < b.path;
+    });
+    if (!isSorted) {
+        std::sort(manifest.mEntries.begin(), manifest.mEntries.end(), [](const Entry &a, const Entry &b) {
+            return a.path < b.path;
+        });
+    }
+    return true;
+}
+
+bool ArchiveManifest::save(const QString &fileName) const
+{
+    QSaveFile file{fileName};
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray data = toByteArray();
+    return file.write(data) == data.size() && file.commit();
+}
+
+bool ArchiveManifest::load(const QString &fileName, ArchiveManifest &manifest)
+{
+    QFile file{fileName};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return fromByteArray(file.readAll(), manifest);
+}
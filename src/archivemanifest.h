@@ -0,0 +1,147 @@
+/*
+    archivemanifest.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_ARCHIVEMANIFEST_H__
+#define __QGPGME_ARCHIVEMANIFEST_H__
+
+#include "qgpgme_export.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <vector>
+
+namespace QGpgME
+{
+
+/**
+ * A list of the files of a directory tree with their size, modification time
+ * and SHA-256 checksum, e.g. the content of an archive.
+ *
+ * Comparing the manifest of a directory tree with the manifest of an earlier
+ * state of the tree yields the files that have been added, modified or
+ * removed in the meantime. This is used for creating incremental archives
+ * that only contain the changes since the last archive.
+ *
+ * \sa SignEncryptArchiveJob::setIncrementalManifestFile
+ */
+class QGPGME_EXPORT ArchiveManifest
+{
+public:
+    enum EntryType {
+        File,
+        Directory, ///< an empty directory
+        SymLink,
+    };
+
+    struct Entry {
+        QString path;
+        EntryType type = File;
+        qint64 size = 0;
+        qint64 modificationTime = 0; ///< in milliseconds since the epoch
+        QByteArray sha256;           ///< in hex; for symbolic links the checksum of the target
+    };
+
+    struct Diff {
+        std::vector<QString> added;
+        std::vector<QString> modified;
+        /// Paths that do not exist anymore. Directories that are no longer
+        /// empty are not included.
+        std::vector<QString> removed;
+
+        bool isEmpty() const
+        {
+            return added.empty() && modified.empty() && removed.empty();
+        }
+
+        /// Returns the added and modified paths in sorted order.
+        std::vector<QString> changed() const;
+    };
+
+    ArchiveManifest();
+
+    /**
+     * Creates the manifest for the files and directories in \a paths. If
+     * \a baseDirectory is not empty, then relative paths are interpreted
+     * relative to it. The directories are scanned with a FileTreeScanner.
+     *
+     * The checksums of files whose size and modification time are unchanged
+     * compared to the entries in \a previous are taken from \a previous
+     * instead of reading the files again. The other files are read by
+     * multiple threads.
+     */
+    static ArchiveManifest create(const std::vector<QString> &paths,
+                                  const QString &baseDirectory,
+                                  const ArchiveManifest &previous = ArchiveManifest{});
+
+    bool isEmpty() const
+    {
+        return mEntries.empty();
+    }
+
+    /**
+     * Returns the entries sorted by path.
+     */
+    const std::vector<Entry> &entries() const
+    {
+        return mEntries;
+    }
+
+    /**
+     * Returns the entry for \a path or nullptr if there is no such entry.
+     */
+    const Entry *find(const QString &path) const;
+
+    /**
+     * Returns the changes from \a previous to this manifest. A file counts
+     * as modified if its checksum or its type changed, i.e. files that were
+     * only touched are not reported.
+     */
+    Diff diff(const ArchiveManifest &previous) const;
+
+    QByteArray toByteArray() const;
+    static bool fromByteArray(const QByteArray &data, ArchiveManifest &manifest);
+
+    /**
+     * Saves the manifest to \a fileName. An existing file is replaced
+     * atomically.
+     */
+    bool save(const QString &fileName) const;
+    static bool load(const QString &fileName, ArchiveManifest &manifest);
+
+private:
+    std::vector<Entry> mEntries;
+};
+
+}
+
+#endif // __QGPGME_ARCHIVEMANIFEST_H__
@@ -0,0 +1,208 @@
+/*
+    batchdecryptverifyjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchdecryptverifyjob.h"
+
+#include "batchjob_p.h"
+#include "dataprovider.h"
+#include "securebufferdataprovider.h"
+#include "securebufferpool.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/data.h>
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BatchDecryptVerifyJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BatchDecryptVerifyJob)
+
+    explicit BatchDecryptVerifyJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+        m_completionChunkSize = 64;
+    }
+
+    ~BatchDecryptVerifyJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+    void emitCompleted(size_t first, size_t count) override;
+
+    std::vector<QByteArray> m_cipherTexts;
+    int m_sourceCount = 0;
+    BatchDecryptVerifyJob::CipherTextSource m_source;
+    SecureBufferPool *m_outputBufferPool = SecureBufferPool::instance();
+    BatchDecryptVerifyJob::PlainTextHandler m_plainTextHandler;
+    std::vector<GpgME::DecryptionResult> m_decryptionResults;
+    std::vector<GpgME::VerificationResult> m_verificationResults;
+    std::vector<QByteArray> m_plainTexts;
+};
+
+static Error decrypt_verify_message(Context *ctx,
+                                    const QByteArray &cipherText,
+                                    SecureBufferPool *pool,
+                                    const BatchDecryptVerifyJob::PlainTextHandler &handler,
+                                    int index,
+                                    DecryptionResult &decryptionResult,
+                                    VerificationResult &verificationResult,
+                                    QByteArray &plainText)
+{
+    if (!ctx) {
+        decryptionResult = DecryptionResult{Error::fromCode(GPG_ERR_NOT_SUPPORTED)};
+        verificationResult = VerificationResult{};
+        return decryptionResult.error();
+    }
+    // the plain text is usually a bit smaller than the cipher text
+    SecureBuffer buffer = pool->acquire(cipherText.size());
+    if (buffer.isNull()) {
+        decryptionResult = DecryptionResult{Error::fromCode(GPG_ERR_ENOMEM)};
+        verificationResult = VerificationResult{};
+        return decryptionResult.error();
+    }
+    QGpgME::QByteArrayReadOnlyDataProvider in{cipherText};
+    Data indata{&in};
+    {
+        SecureBufferDataProvider out{buffer};
+        Data outdata{&out};
+        std::tie(decryptionResult, verificationResult) = ctx->decryptAndVerify(indata, outdata);
+    }
+    const Error error = decryptionResult.error().code() ? decryptionResult.error() : verificationResult.error();
+    if (!error.code()) {
+        if (handler) {
+            handler(index, buffer);
+        } else {
+            plainText = buffer.toByteArray();
+        }
+    }
+    // the buffer is wiped and returned to the pool for the next message
+    return error;
+}
+
+GpgME::Error BatchDecryptVerifyJobPrivate::startIt()
+{
+    const size_t count = m_source ? static_cast<size_t>(std::max(m_sourceCount, 0)) : m_cipherTexts.size();
+    if (!m_outputBufferPool) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+
+    m_decryptionResults = _detail::canceledResults<DecryptionResult>(count);
+    m_verificationResults = std::vector<VerificationResult>(count);
+    m_plainTexts = std::vector<QByteArray>(count);
+    return startItems(count, {}, [this](Context *ctx, size_t index) {
+        const int i = static_cast<int>(index);
+        const QByteArray cipherText = m_source ? m_source(i) : m_cipherTexts[index];
+        return decrypt_verify_message(ctx, cipherText, m_outputBufferPool, m_plainTextHandler, i,
+                                      m_decryptionResults[index], m_verificationResults[index], m_plainTexts[index]);
+    });
+}
+
+void BatchDecryptVerifyJobPrivate::emitCompleted(size_t first, size_t count)
+{
+    Q_Q(BatchDecryptVerifyJob);
+    Q_EMIT q->chunkDecrypted(static_cast<int>(first),
+                             std::vector<DecryptionResult>(m_decryptionResults.cbegin() + first, m_decryptionResults.cbegin() + first + count),
+                             std::vector<VerificationResult>(m_verificationResults.cbegin() + first, m_verificationResults.cbegin() + first + count),
+                             std::vector<QByteArray>(m_plainTexts.cbegin() + first, m_plainTexts.cbegin() + first + count));
+}
+
+void BatchDecryptVerifyJobPrivate::emitResult()
+{
+    Q_Q(BatchDecryptVerifyJob);
+    Q_EMIT q->result(resultError(), m_decryptionResults, m_verificationResults, m_plainTexts);
+}
+
+BatchDecryptVerifyJob::BatchDecryptVerifyJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<BatchDecryptVerifyJobPrivate>(new BatchDecryptVerifyJobPrivate{protocol}), nullptr}
+{
+}
+
+BatchDecryptVerifyJob::~BatchDecryptVerifyJob() = default;
+
+void BatchDecryptVerifyJob::setCipherTexts(const std::vector<QByteArray> &cipherTexts)
+{
+    Q_D(BatchDecryptVerifyJob);
+    d->m_cipherTexts = cipherTexts;
+    d->m_sourceCount = 0;
+    d->m_source = {};
+}
+
+void BatchDecryptVerifyJob::setCipherTexts(int count, const CipherTextSource &source)
+{
+    Q_D(BatchDecryptVerifyJob);
+    d->m_cipherTexts.clear();
+    d->m_sourceCount = count;
+    d->m_source = source;
+}
+
+void BatchDecryptVerifyJob::setOutputBufferPool(SecureBufferPool *pool)
+{
+    Q_D(BatchDecryptVerifyJob);
+    d->m_outputBufferPool = pool;
+}
+
+SecureBufferPool *BatchDecryptVerifyJob::outputBufferPool() const
+{
+    Q_D(const BatchDecryptVerifyJob);
+    return d->m_outputBufferPool;
+}
+
+void BatchDecryptVerifyJob::setPlainTextHandler(const PlainTextHandler &handler)
+{
+    Q_D(BatchDecryptVerifyJob);
+    d->m_plainTextHandler = handler;
+}
+
+void BatchDecryptVerifyJob::setChunkSize(int size)
+{
+    Q_D(BatchDecryptVerifyJob);
+    d->m_completionChunkSize = static_cast<size_t>(std::max(size, 1));
+}
+
+int BatchDecryptVerifyJob::chunkSize() const
+{
+    Q_D(const BatchDecryptVerifyJob);
+    return static_cast<int>(d->m_completionChunkSize);
+}
+
+#include "moc_batchdecryptverifyjob.cpp"
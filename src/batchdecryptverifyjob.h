@@ -0,0 +1,149 @@
+/*
+    batchdecryptverifyjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BATCHDECRYPTVERIFYJOB_H__
+#define __QGPGME_BATCHDECRYPTVERIFYJOB_H__
+
+#include "batchjob.h"
+
+#include <functional>
+#include <vector>
+
+namespace GpgME
+{
+class DecryptionResult;
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+class BatchDecryptVerifyJobPrivate;
+class SecureBuffer;
+class SecureBufferPool;
+
+/**
+ * This job decrypts and verifies many small in-memory messages, e.g. the
+ * encrypted parts of a mailbox export.
+ *
+ * The messages are processed independently of each other, i.e. a message
+ * that cannot be decrypted doesn't affect the other messages. The job
+ * reports the results in chunks of consecutive messages with
+ * chunkDecrypted() while it is running. The result() signal passes the
+ * results of all messages in the order of the messages. The error passed to
+ * result() is the error of the first message that could not be decrypted
+ * or verified, or \c GPG_ERR_CANCELED if the job was canceled.
+ *
+ * The messages are decrypted into buffers in secure memory that are taken
+ * from a SecureBufferPool. By default, the plain texts are copied to
+ * ordinary memory and kept until the job has finished. To bound the memory
+ * used for large batches set a plain text handler; then each plain text is
+ * passed to the handler and its buffer is returned to the pool right away.
+ */
+class QGPGME_EXPORT BatchDecryptVerifyJob : public BatchJob
+{
+    Q_OBJECT
+public:
+    /**
+     * Returns the cipher text of the message with index \a index.
+     * \note The function is called in the worker threads.
+     */
+    using CipherTextSource = std::function<QByteArray(int index)>;
+
+    /**
+     * Receives the plain text of the message with index \a index. The buffer
+     * is wiped and returned to the pool after the handler returns.
+     * \note The function is called in the worker threads.
+     */
+    using PlainTextHandler = std::function<void(int index, const QGpgME::SecureBuffer &plainText)>;
+
+    explicit BatchDecryptVerifyJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BatchDecryptVerifyJob() override;
+
+    /**
+     * Sets the messages to decrypt.
+     */
+    void setCipherTexts(const std::vector<QByteArray> &cipherTexts);
+
+    /**
+     * Sets the number of messages to decrypt and a function that returns the
+     * messages on demand, e.g. by reading them from a file. Only the
+     * messages that are currently being decrypted are held in memory.
+     */
+    void setCipherTexts(int count, const CipherTextSource &source);
+
+    /**
+     * Sets the pool from which the buffers for the plain texts are taken.
+     * Defaults to SecureBufferPool::instance(). The pool must outlive the
+     * job.
+     */
+    void setOutputBufferPool(SecureBufferPool *pool);
+    SecureBufferPool *outputBufferPool() const;
+
+    /**
+     * Sets a handler for the plain texts. If a handler is set, then the
+     * plain texts passed to chunkDecrypted() and result() are empty.
+     */
+    void setPlainTextHandler(const PlainTextHandler &handler);
+
+    /**
+     * Sets the number of messages reported with chunkDecrypted(). Defaults
+     * to 64. The last chunk, and the chunks reported after the job has been
+     * canceled, may be smaller.
+     */
+    void setChunkSize(int size);
+    int chunkSize() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the results of the messages \a firstIndex to
+     * \a firstIndex + \a decryptionResults.size() - 1 after they have been
+     * processed. Messages that are not processed because the job was
+     * canceled are not reported.
+     */
+    void chunkDecrypted(int firstIndex,
+                        const std::vector<GpgME::DecryptionResult> &decryptionResults,
+                        const std::vector<GpgME::VerificationResult> &verificationResults,
+                        const std::vector<QByteArray> &plainTexts);
+
+    void result(const GpgME::Error &error,
+                const std::vector<GpgME::DecryptionResult> &decryptionResults,
+                const std::vector<GpgME::VerificationResult> &verificationResults,
+                const std::vector<QByteArray> &plainTexts);
+
+private:
+    Q_DECLARE_PRIVATE(BatchDecryptVerifyJob)
+};
+
+}
+
+#endif // __QGPGME_BATCHDECRYPTVERIFYJOB_H__
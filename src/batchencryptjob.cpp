@@ -0,0 +1,170 @@
+/*
+    batchencryptjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchencryptjob.h"
+
+#include "batchjob_p.h"
+#include "dataprovider.h"
+
+#include <gpgme++/data.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BatchEncryptJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BatchEncryptJob)
+
+    explicit BatchEncryptJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+    }
+
+    ~BatchEncryptJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    std::vector<GpgME::Key> m_recipients;
+    std::vector<QByteArray> m_plainTexts;
+    GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::None;
+    bool m_armor = false;
+    std::vector<GpgME::EncryptionResult> m_results;
+    std::vector<QByteArray> m_cipherTexts;
+};
+
+static EncryptionResult encrypt_message(Context *ctx,
+                                        const std::vector<Key> &recipients,
+                                        const QByteArray &plainText,
+                                        Context::EncryptionFlags flags,
+                                        QByteArray &cipherText)
+{
+    if (!ctx) {
+        return EncryptionResult{Error::fromCode(GPG_ERR_NOT_SUPPORTED)};
+    }
+    QGpgME::QByteArrayReadOnlyDataProvider in{plainText};
+    Data indata{&in};
+    QGpgME::QByteArrayDataProvider out;
+    // a small message grows by a few hundred bytes per recipient
+    out.reserve(plainText.size() + 1024);
+    Data outdata{&out};
+
+    const auto result = ctx->encrypt(recipients, indata, outdata, flags);
+    if (!result.error().code()) {
+        cipherText = out.data();
+    }
+    return result;
+}
+
+GpgME::Error BatchEncryptJobPrivate::startIt()
+{
+    m_results = _detail::canceledResults<EncryptionResult>(m_plainTexts.size());
+    m_cipherTexts = std::vector<QByteArray>(m_plainTexts.size());
+    const bool armor = m_armor;
+    return startItems(m_plainTexts.size(), [armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return Error{};
+    }, [this](Context *ctx, size_t index) {
+        m_results[index] = encrypt_message(ctx, m_recipients, m_plainTexts[index], m_encryptionFlags, m_cipherTexts[index]);
+        return m_results[index].error();
+    });
+}
+
+void BatchEncryptJobPrivate::emitResult()
+{
+    Q_Q(BatchEncryptJob);
+    Q_EMIT q->result(resultError(), m_results, m_cipherTexts);
+}
+
+BatchEncryptJob::BatchEncryptJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<BatchEncryptJobPrivate>(new BatchEncryptJobPrivate{protocol}), nullptr}
+{
+}
+
+BatchEncryptJob::~BatchEncryptJob() = default;
+
+void BatchEncryptJob::setRecipients(const std::vector<GpgME::Key> &recipients)
+{
+    Q_D(BatchEncryptJob);
+    d->m_recipients = recipients;
+}
+
+std::vector<GpgME::Key> BatchEncryptJob::recipients() const
+{
+    Q_D(const BatchEncryptJob);
+    return d->m_recipients;
+}
+
+void BatchEncryptJob::setPlainTexts(const std::vector<QByteArray> &plainTexts)
+{
+    Q_D(BatchEncryptJob);
+    d->m_plainTexts = plainTexts;
+}
+
+std::vector<QByteArray> BatchEncryptJob::plainTexts() const
+{
+    Q_D(const BatchEncryptJob);
+    return d->m_plainTexts;
+}
+
+void BatchEncryptJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
+{
+    Q_D(BatchEncryptJob);
+    d->m_encryptionFlags = flags;
+}
+
+GpgME::Context::EncryptionFlags BatchEncryptJob::encryptionFlags() const
+{
+    Q_D(const BatchEncryptJob);
+    return d->m_encryptionFlags;
+}
+
+void BatchEncryptJob::setArmor(bool armor)
+{
+    Q_D(BatchEncryptJob);
+    d->m_armor = armor;
+}
+
+bool BatchEncryptJob::armor() const
+{
+    Q_D(const BatchEncryptJob);
+    return d->m_armor;
+}
+
+#include "moc_batchencryptjob.cpp"
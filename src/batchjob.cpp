@@ -0,0 +1,120 @@
+/*
+    batchjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchjob.h"
+#include "batchjob_p.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+#include <algorithm>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+BatchJobPrivate::BatchJobPrivate(GpgME::Protocol protocol)
+    : PooledJobPrivate{protocol}
+{
+}
+
+BatchJobPrivate::~BatchJobPrivate() = default;
+
+GpgME::Error _detail::setSigningKeys(Context *ctx, const std::vector<Key> &signers)
+{
+    ctx->clearSigningKeys();
+    for (const Key &signer : signers) {
+        if (!signer.isNull()) {
+            if (const Error err = ctx->addSigningKey(signer)) {
+                return err;
+            }
+        }
+    }
+    return {};
+}
+
+BatchJob::SigningSummary _detail::summarizeSigningResults(const std::vector<SigningResult> &results)
+{
+    BatchJob::SigningSummary summary;
+    for (const auto &result : results) {
+        if (result.error().isCanceled()) {
+            continue;
+        }
+        if (result.error().code()) {
+            summary.failedMessages++;
+            continue;
+        }
+        summary.signedMessages++;
+        for (const auto &sig : result.createdSignatures()) {
+            const QByteArray fingerprint{sig.fingerprint()};
+            if (std::find(summary.signerFingerprints.cbegin(), summary.signerFingerprints.cend(), fingerprint) == summary.signerFingerprints.cend()) {
+                summary.signerFingerprints.push_back(fingerprint);
+            }
+        }
+    }
+    return summary;
+}
+
+BatchJob::BatchJob(std::unique_ptr<BatchJobPrivate> dd, QObject *parent)
+    : PooledJob{std::move(dd), parent}
+{
+}
+
+BatchJob::~BatchJob() = default;
+
+BatchJob::LatencyStatistics BatchJob::latencyStatistics() const
+{
+    Q_D(const BatchJob);
+    LatencyStatistics stats;
+    if (d->m_latencies.empty()) {
+        return stats;
+    }
+    auto latencies = d->m_latencies;
+    std::sort(latencies.begin(), latencies.end());
+    // nearest-rank percentiles
+    const auto percentile = [&latencies](size_t p) {
+        const size_t rank = (p * latencies.size() + 99) / 100;
+        return latencies[std::max<size_t>(rank, 1) - 1];
+    };
+    stats.processedMessages = static_cast<int>(latencies.size());
+    stats.p50USecs = percentile(50);
+    stats.p90USecs = percentile(90);
+    stats.p99USecs = percentile(99);
+    stats.maxUSecs = latencies.back();
+    return stats;
+}
+
+#include "moc_batchjob.cpp"
@@ -0,0 +1,99 @@
+/*
+    batchjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BATCHJOB_H__
+#define __QGPGME_BATCHJOB_H__
+
+#include "pooledjob.h"
+
+#include <QByteArray>
+
+#include <vector>
+
+namespace QGpgME
+{
+
+class BatchJobPrivate;
+
+/**
+ * Abstract base class for jobs that apply the same operation to many small
+ * in-memory messages, e.g. encrypt outgoing mails for the same recipients.
+ *
+ * The concrete jobs pass the results of the messages in the order of the
+ * messages to their result() signal. Messages that were not processed
+ * because the job was canceled have a result with \c GPG_ERR_CANCELED.
+ */
+class QGPGME_EXPORT BatchJob : public PooledJob
+{
+    Q_OBJECT
+protected:
+    explicit BatchJob(std::unique_ptr<BatchJobPrivate>, QObject *parent);
+public:
+    /**
+     * A summary of the signing results of the messages of a batch.
+     */
+    struct SigningSummary {
+        int signedMessages = 0;
+        /// The number of messages that could not be signed; messages that
+        /// were not processed because the job was canceled are not counted
+        int failedMessages = 0;
+        /// The distinct fingerprints of the keys that made the signatures
+        std::vector<QByteArray> signerFingerprints;
+    };
+
+    /**
+     * The distribution of the time it took to process a single message, in
+     * microseconds. The percentiles are 0 if no message has been processed.
+     */
+    struct LatencyStatistics {
+        int processedMessages = 0;
+        qint64 p50USecs = 0;
+        qint64 p90USecs = 0;
+        qint64 p99USecs = 0;
+        qint64 maxUSecs = 0;
+    };
+
+    ~BatchJob() override;
+
+    /**
+     * Returns the latencies of the messages processed so far. Messages that
+     * were not processed because the job was canceled are not included.
+     */
+    LatencyStatistics latencyStatistics() const;
+
+private:
+    Q_DECLARE_PRIVATE(BatchJob)
+};
+
+}
+
+#endif // __QGPGME_BATCHJOB_H__
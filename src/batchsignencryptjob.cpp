@@ -0,0 +1,192 @@
+/*
+    batchsignencryptjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchsignencryptjob.h"
+
+#include "batchjob_p.h"
+#include "dataprovider.h"
+
+#include <gpgme++/data.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+#include <tuple>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BatchSignEncryptJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BatchSignEncryptJob)
+
+    explicit BatchSignEncryptJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+    }
+
+    ~BatchSignEncryptJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    std::vector<GpgME::Key> m_signers;
+    std::vector<GpgME::Key> m_recipients;
+    std::vector<QByteArray> m_plainTexts;
+    GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::None;
+    bool m_armor = false;
+    std::vector<GpgME::SigningResult> m_signingResults;
+    std::vector<GpgME::EncryptionResult> m_encryptionResults;
+    std::vector<QByteArray> m_cipherTexts;
+};
+
+static std::pair<SigningResult, EncryptionResult> sign_encrypt_message(Context *ctx,
+                                                                       const std::vector<Key> &recipients,
+                                                                       const QByteArray &plainText,
+                                                                       Context::EncryptionFlags flags,
+                                                                       QByteArray &cipherText)
+{
+    QGpgME::QByteArrayReadOnlyDataProvider in{plainText};
+    Data indata{&in};
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(plainText.size() + 2048);
+    Data outdata{&out};
+
+    const auto results = ctx->signAndEncrypt(recipients, indata, outdata, flags);
+    if (!results.first.error().code() && !results.second.error().code()) {
+        cipherText = out.data();
+    }
+    return results;
+}
+
+GpgME::Error BatchSignEncryptJobPrivate::startIt()
+{
+    m_signingResults = _detail::canceledResults<SigningResult>(m_plainTexts.size());
+    m_encryptionResults = _detail::canceledResults<EncryptionResult>(m_plainTexts.size());
+    m_cipherTexts = std::vector<QByteArray>(m_plainTexts.size());
+    return startItems(m_plainTexts.size(), [signers = m_signers, armor = m_armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return _detail::setSigningKeys(ctx, signers);
+    }, [this](Context *ctx, size_t index) {
+        const Error err = contextSetupError(ctx);
+        if (err) {
+            m_signingResults[index] = SigningResult{err};
+            m_encryptionResults[index] = EncryptionResult{};
+            return err;
+        }
+        std::tie(m_signingResults[index], m_encryptionResults[index]) =
+            sign_encrypt_message(ctx, m_recipients, m_plainTexts[index], m_encryptionFlags, m_cipherTexts[index]);
+        const Error &signingError = m_signingResults[index].error();
+        return signingError.code() ? signingError : m_encryptionResults[index].error();
+    });
+}
+
+void BatchSignEncryptJobPrivate::emitResult()
+{
+    Q_Q(BatchSignEncryptJob);
+    Q_EMIT q->result(resultError(), m_signingResults, m_encryptionResults, m_cipherTexts,
+                     _detail::summarizeSigningResults(m_signingResults));
+}
+
+BatchSignEncryptJob::BatchSignEncryptJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<BatchSignEncryptJobPrivate>(new BatchSignEncryptJobPrivate{protocol}), nullptr}
+{
+}
+
+BatchSignEncryptJob::~BatchSignEncryptJob() = default;
+
+void BatchSignEncryptJob::setSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(BatchSignEncryptJob);
+    d->m_signers = signers;
+}
+
+std::vector<GpgME::Key> BatchSignEncryptJob::signers() const
+{
+    Q_D(const BatchSignEncryptJob);
+    return d->m_signers;
+}
+
+void BatchSignEncryptJob::setRecipients(const std::vector<GpgME::Key> &recipients)
+{
+    Q_D(BatchSignEncryptJob);
+    d->m_recipients = recipients;
+}
+
+std::vector<GpgME::Key> BatchSignEncryptJob::recipients() const
+{
+    Q_D(const BatchSignEncryptJob);
+    return d->m_recipients;
+}
+
+void BatchSignEncryptJob::setPlainTexts(const std::vector<QByteArray> &plainTexts)
+{
+    Q_D(BatchSignEncryptJob);
+    d->m_plainTexts = plainTexts;
+}
+
+std::vector<QByteArray> BatchSignEncryptJob::plainTexts() const
+{
+    Q_D(const BatchSignEncryptJob);
+    return d->m_plainTexts;
+}
+
+void BatchSignEncryptJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
+{
+    Q_D(BatchSignEncryptJob);
+    d->m_encryptionFlags = flags;
+}
+
+GpgME::Context::EncryptionFlags BatchSignEncryptJob::encryptionFlags() const
+{
+    Q_D(const BatchSignEncryptJob);
+    return d->m_encryptionFlags;
+}
+
+void BatchSignEncryptJob::setArmor(bool armor)
+{
+    Q_D(BatchSignEncryptJob);
+    d->m_armor = armor;
+}
+
+bool BatchSignEncryptJob::armor() const
+{
+    Q_D(const BatchSignEncryptJob);
+    return d->m_armor;
+}
+
+#include "moc_batchsignencryptjob.cpp"
@@ -0,0 +1,119 @@
+/*
+    batchsignencryptjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BATCHSIGNENCRYPTJOB_H__
+#define __QGPGME_BATCHSIGNENCRYPTJOB_H__
+
+#include "batchjob.h"
+
+#include <gpgme++/context.h>
+
+#include <vector>
+
+namespace GpgME
+{
+class EncryptionResult;
+class Key;
+class SigningResult;
+}
+
+namespace QGpgME
+{
+
+class BatchSignEncryptJobPrivate;
+
+/**
+ * This job signs many small in-memory messages with the same keys and
+ * encrypts them for the same recipients.
+ *
+ * The signing keys are set only once for each context used by the job
+ * instead of once per message.
+ *
+ * The result() signal passes one signing result, one encryption result and
+ * one cipher text per message in the order of the messages, and a summary
+ * of all signing results. The error passed to result() is the error of the
+ * first message that could not be signed and encrypted, or
+ * \c GPG_ERR_CANCELED if the job was canceled. Messages that were not signed
+ * and encrypted have an empty cipher text.
+ */
+class QGPGME_EXPORT BatchSignEncryptJob : public BatchJob
+{
+    Q_OBJECT
+public:
+    explicit BatchSignEncryptJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BatchSignEncryptJob() override;
+
+    /**
+     * Sets the keys to sign the messages with.
+     */
+    void setSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> signers() const;
+
+    /**
+     * Sets the keys to encrypt the messages for. If no recipients are set,
+     * then symmetric encryption is performed.
+     */
+    void setRecipients(const std::vector<GpgME::Key> &recipients);
+    std::vector<GpgME::Key> recipients() const;
+
+    /**
+     * Sets the messages to sign and encrypt.
+     */
+    void setPlainTexts(const std::vector<QByteArray> &plainTexts);
+    std::vector<QByteArray> plainTexts() const;
+
+    /**
+     * Sets the flags to use for encryption.
+     */
+    void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
+    GpgME::Context::EncryptionFlags encryptionFlags() const;
+
+    /**
+     * Sets whether the output shall be ASCII armored. Defaults to \c false.
+     */
+    void setArmor(bool armor);
+    bool armor() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error,
+                const std::vector<GpgME::SigningResult> &signingResults,
+                const std::vector<GpgME::EncryptionResult> &encryptionResults,
+                const std::vector<QByteArray> &cipherTexts,
+                const QGpgME::BatchJob::SigningSummary &summary);
+
+private:
+    Q_DECLARE_PRIVATE(BatchSignEncryptJob)
+};
+
+}
+
+#endif // __QGPGME_BATCHSIGNENCRYPTJOB_H__
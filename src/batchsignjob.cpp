@@ -0,0 +1,170 @@
+/*
+    batchsignjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchsignjob.h"
+
+#include "batchjob_p.h"
+#include "dataprovider.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/data.h>
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BatchSignJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BatchSignJob)
+
+    explicit BatchSignJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+    }
+
+    ~BatchSignJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    std::vector<GpgME::Key> m_signers;
+    std::vector<QByteArray> m_plainTexts;
+    GpgME::SignatureMode m_signatureMode = GpgME::NormalSignatureMode;
+    bool m_armor = false;
+    std::vector<GpgME::SigningResult> m_results;
+    std::vector<QByteArray> m_signedData;
+};
+
+static SigningResult sign_message(Context *ctx,
+                                  const QByteArray &plainText,
+                                  SignatureMode mode,
+                                  QByteArray &signedData)
+{
+    QGpgME::QByteArrayReadOnlyDataProvider in{plainText};
+    Data indata{&in};
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(plainText.size() + 1024);
+    Data outdata{&out};
+
+    const auto result = ctx->sign(indata, outdata, mode);
+    if (!result.error().code()) {
+        signedData = out.data();
+    }
+    return result;
+}
+
+GpgME::Error BatchSignJobPrivate::startIt()
+{
+    m_results = _detail::canceledResults<SigningResult>(m_plainTexts.size());
+    m_signedData = std::vector<QByteArray>(m_plainTexts.size());
+    return startItems(m_plainTexts.size(), [signers = m_signers, armor = m_armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return _detail::setSigningKeys(ctx, signers);
+    }, [this](Context *ctx, size_t index) {
+        const Error err = contextSetupError(ctx);
+        if (err) {
+            m_results[index] = SigningResult{err};
+        } else {
+            m_results[index] = sign_message(ctx, m_plainTexts[index], m_signatureMode, m_signedData[index]);
+        }
+        return m_results[index].error();
+    });
+}
+
+void BatchSignJobPrivate::emitResult()
+{
+    Q_Q(BatchSignJob);
+    Q_EMIT q->result(resultError(), m_results, m_signedData, _detail::summarizeSigningResults(m_results));
+}
+
+BatchSignJob::BatchSignJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<BatchSignJobPrivate>(new BatchSignJobPrivate{protocol}), nullptr}
+{
+}
+
+BatchSignJob::~BatchSignJob() = default;
+
+void BatchSignJob::setSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(BatchSignJob);
+    d->m_signers = signers;
+}
+
+std::vector<GpgME::Key> BatchSignJob::signers() const
+{
+    Q_D(const BatchSignJob);
+    return d->m_signers;
+}
+
+void BatchSignJob::setPlainTexts(const std::vector<QByteArray> &plainTexts)
+{
+    Q_D(BatchSignJob);
+    d->m_plainTexts = plainTexts;
+}
+
+std::vector<QByteArray> BatchSignJob::plainTexts() const
+{
+    Q_D(const BatchSignJob);
+    return d->m_plainTexts;
+}
+
+void BatchSignJob::setSignatureMode(GpgME::SignatureMode mode)
+{
+    Q_D(BatchSignJob);
+    d->m_signatureMode = mode;
+}
+
+GpgME::SignatureMode BatchSignJob::signatureMode() const
+{
+    Q_D(const BatchSignJob);
+    return d->m_signatureMode;
+}
+
+void BatchSignJob::setArmor(bool armor)
+{
+    Q_D(BatchSignJob);
+    d->m_armor = armor;
+}
+
+bool BatchSignJob::armor() const
+{
+    Q_D(const BatchSignJob);
+    return d->m_armor;
+}
+
+#include "moc_batchsignjob.cpp"
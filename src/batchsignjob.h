@@ -0,0 +1,110 @@
+/*
+    batchsignjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BATCHSIGNJOB_H__
+#define __QGPGME_BATCHSIGNJOB_H__
+
+#include "batchjob.h"
+
+#include <gpgme++/global.h>
+
+#include <vector>
+
+namespace GpgME
+{
+class Key;
+class SigningResult;
+}
+
+namespace QGpgME
+{
+
+class BatchSignJobPrivate;
+
+/**
+ * This job signs many small in-memory messages with the same keys, e.g.
+ * notifications sent by a service.
+ *
+ * The signing keys are set only once for each context used by the job
+ * instead of once per message.
+ *
+ * The result() signal passes one signing result and one signed message per
+ * message in the order of the messages, and a summary of all signing
+ * results. The error passed to result() is the error of the first message
+ * that could not be signed, or \c GPG_ERR_CANCELED if the job was canceled.
+ * Messages that were not signed have empty signed data.
+ */
+class QGPGME_EXPORT BatchSignJob : public BatchJob
+{
+    Q_OBJECT
+public:
+    explicit BatchSignJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BatchSignJob() override;
+
+    /**
+     * Sets the keys to sign the messages with.
+     */
+    void setSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> signers() const;
+
+    /**
+     * Sets the messages to sign.
+     */
+    void setPlainTexts(const std::vector<QByteArray> &plainTexts);
+    std::vector<QByteArray> plainTexts() const;
+
+    /**
+     * Sets the kind of signatures to create. Defaults to
+     * \c GpgME::NormalSignatureMode.
+     */
+    void setSignatureMode(GpgME::SignatureMode mode);
+    GpgME::SignatureMode signatureMode() const;
+
+    /**
+     * Sets whether the output shall be ASCII armored. Defaults to \c false.
+     */
+    void setArmor(bool armor);
+    bool armor() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error,
+                const std::vector<GpgME::SigningResult> &results,
+                const std::vector<QByteArray> &signedData,
+                const QGpgME::BatchJob::SigningSummary &summary);
+
+private:
+    Q_DECLARE_PRIVATE(BatchSignJob)
+};
+
+}
+
+#endif // __QGPGME_BATCHSIGNJOB_H__
@@ -0,0 +1,148 @@
+/*
+    batchverifyjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "batchverifyjob.h"
+
+#include "batchjob_p.h"
+#include "dataprovider.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/data.h>
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BatchVerifyJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BatchVerifyJob)
+
+    explicit BatchVerifyJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+        m_completionChunkSize = 64;
+    }
+
+    ~BatchVerifyJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+    void emitCompleted(size_t first, size_t count) override;
+
+    std::vector<BatchVerifyJob::Item> m_items;
+    std::vector<GpgME::VerificationResult> m_results;
+    std::vector<QByteArray> m_plainTexts;
+};
+
+static VerificationResult verify_item(Context *ctx, const BatchVerifyJob::Item &item, QByteArray &plainText)
+{
+    if (!ctx) {
+        return VerificationResult{Error::fromCode(GPG_ERR_NOT_SUPPORTED)};
+    }
+    QGpgME::QByteArrayReadOnlyDataProvider sig{item.signature};
+    Data signature{&sig};
+    if (!item.signedData.isNull()) {
+        QGpgME::QByteArrayReadOnlyDataProvider signedData{item.signedData};
+        Data data{&signedData};
+        return ctx->verifyDetachedSignature(signature, data);
+    }
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(item.signature.size());
+    Data outdata{&out};
+    const auto result = ctx->verifyOpaqueSignature(signature, outdata);
+    plainText = out.data();
+    return result;
+}
+
+GpgME::Error BatchVerifyJobPrivate::startIt()
+{
+    m_results = _detail::canceledResults<VerificationResult>(m_items.size());
+    m_plainTexts = std::vector<QByteArray>(m_items.size());
+    return startItems(m_items.size(), {}, [this](Context *ctx, size_t index) {
+        m_results[index] = verify_item(ctx, m_items[index], m_plainTexts[index]);
+        return m_results[index].error();
+    });
+}
+
+void BatchVerifyJobPrivate::emitCompleted(size_t first, size_t count)
+{
+    Q_Q(BatchVerifyJob);
+    Q_EMIT q->chunkVerified(static_cast<int>(first),
+                            std::vector<VerificationResult>(m_results.cbegin() + first, m_results.cbegin() + first + count),
+                            std::vector<QByteArray>(m_plainTexts.cbegin() + first, m_plainTexts.cbegin() + first + count));
+}
+
+void BatchVerifyJobPrivate::emitResult()
+{
+    Q_Q(BatchVerifyJob);
+    Q_EMIT q->result(resultError(), m_results, m_plainTexts);
+}
+
+BatchVerifyJob::BatchVerifyJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<BatchVerifyJobPrivate>(new BatchVerifyJobPrivate{protocol}), nullptr}
+{
+}
+
+BatchVerifyJob::~BatchVerifyJob() = default;
+
+void BatchVerifyJob::setItems(const std::vector<Item> &items)
+{
+    Q_D(BatchVerifyJob);
+    d->m_items = items;
+}
+
+std::vector<BatchVerifyJob::Item> BatchVerifyJob::items() const
+{
+    Q_D(const BatchVerifyJob);
+    return d->m_items;
+}
+
+void BatchVerifyJob::setChunkSize(int size)
+{
+    Q_D(BatchVerifyJob);
+    d->m_completionChunkSize = static_cast<size_t>(std::max(size, 1));
+}
+
+int BatchVerifyJob::chunkSize() const
+{
+    Q_D(const BatchVerifyJob);
+    return static_cast<int>(d->m_completionChunkSize);
+}
+
+#include "moc_batchverifyjob.cpp"
@@ -0,0 +1,116 @@
+/*
+    batchverifyjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BATCHVERIFYJOB_H__
+#define __QGPGME_BATCHVERIFYJOB_H__
+
+#include "batchjob.h"
+
+#include <vector>
+
+namespace GpgME
+{
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+class BatchVerifyJobPrivate;
+
+/**
+ * This job verifies the signatures of many small in-memory messages, e.g.
+ * of the messages received by a gateway. Opaque and detached signatures can
+ * be mixed.
+ *
+ * While the job is running it reports the results in chunks of consecutive
+ * items with chunkVerified(), so that the caller can process the first items
+ * while the remaining items are still being verified. The result() signal
+ * passes the results of all items in the order of the items. The error
+ * passed to result() is the error of the first item that could not be
+ * verified, or \c GPG_ERR_CANCELED if the job was canceled. Note that a bad
+ * signature is not an error; check the signatures of the results.
+ */
+class QGPGME_EXPORT BatchVerifyJob : public BatchJob
+{
+    Q_OBJECT
+public:
+    /**
+     * An item to verify.
+     */
+    struct Item {
+        /// The detached signature, or the signed message for an opaque signature
+        QByteArray signature;
+        /// The signed data of a detached signature; null for an opaque signature
+        QByteArray signedData;
+    };
+
+    explicit BatchVerifyJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BatchVerifyJob() override;
+
+    /**
+     * Sets the items to verify.
+     */
+    void setItems(const std::vector<Item> &items);
+    std::vector<Item> items() const;
+
+    /**
+     * Sets the number of items reported with chunkVerified(). Defaults to
+     * 64. The last chunk, and the chunks reported after the job has been
+     * canceled, may be smaller.
+     */
+    void setChunkSize(int size);
+    int chunkSize() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the results of the items \a firstIndex to
+     * \a firstIndex + \a results.size() - 1 after they have been verified.
+     * \a plainTexts contains the signed data of the opaque signatures; it is
+     * empty for detached signatures. Items that are not verified because the
+     * job was canceled are not reported.
+     */
+    void chunkVerified(int firstIndex,
+                       const std::vector<GpgME::VerificationResult> &results,
+                       const std::vector<QByteArray> &plainTexts);
+
+    void result(const GpgME::Error &error,
+                const std::vector<GpgME::VerificationResult> &results,
+                const std::vector<QByteArray> &plainTexts);
+
+private:
+    Q_DECLARE_PRIVATE(BatchVerifyJob)
+};
+
+}
+
+#endif // __QGPGME_BATCHVERIFYJOB_H__
@@ -0,0 +1,171 @@
+/*
+    bulkfiledecryptverifyjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "bulkfiledecryptverifyjob.h"
+
+#include "bulkfilejob_p.h"
+#include "util.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/decryptionresult.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BulkFileDecryptVerifyJobPrivate : public BulkFileJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BulkFileDecryptVerifyJob)
+
+    explicit BulkFileDecryptVerifyJobPrivate(GpgME::Protocol protocol)
+        : BulkFileJobPrivate{protocol}
+    {
+    }
+
+    ~BulkFileDecryptVerifyJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    BulkFileJob::FileResult fileResult(size_t index) const override
+    {
+        return m_results[index];
+    }
+
+    std::vector<std::pair<QString, QString>> m_files;
+    bool m_processAllSignatures = false;
+    std::vector<BulkFileJob::FileResult> m_results;
+};
+
+static BulkFileJob::FileResult decrypt_verify_file(Context *ctx,
+                                                   const QString &inputFilePath,
+                                                   const QString &outputFilePath)
+{
+    BulkFileJob::FileResult result;
+    if (!ctx) {
+        result.error = Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+        return result;
+    }
+    // don't decrypt the file only to fail when renaming the temporary file
+    if (QFile::exists(outputFilePath)) {
+        result.error = Error::fromCode(GPG_ERR_EEXIST);
+        return result;
+    }
+
+    Data indata;
+    _detail::setDataFileName(indata, inputFilePath);
+
+    PartialFileGuard partFileGuard{outputFilePath};
+    if (partFileGuard.tempFileName().isEmpty()) {
+        result.error = Error::fromCode(GPG_ERR_EEXIST);
+        return result;
+    }
+    Data outdata;
+    _detail::setDataFileName(outdata, partFileGuard.tempFileName());
+
+    const auto results = ctx->decryptAndVerify(indata, outdata);
+    const auto &decryptionResult = results.first;
+    const auto &verificationResult = results.second;
+    result.error = decryptionResult.error().code() ? decryptionResult.error() : verificationResult.error();
+    _detail::setSignatureInfo(result, verificationResult);
+    if (!result.error.code()) {
+        // the operation succeeded -> save the result under the requested file name
+        if (!partFileGuard.commit()) {
+            result.error = Error::fromCode(QFile::exists(outputFilePath) ? GPG_ERR_EEXIST : GPG_ERR_EIO);
+        }
+    }
+    return result;
+}
+
+GpgME::Error BulkFileDecryptVerifyJobPrivate::startIt()
+{
+    for (const auto &file : m_files) {
+        if (file.first.isEmpty() || file.second.isEmpty()) {
+            return Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+    }
+
+    m_results = _detail::canceledResults<BulkFileJob::FileResult>(m_files.size());
+    const bool processAllSignatures = m_processAllSignatures;
+    return startItems(m_files.size(), [processAllSignatures](Context *ctx) {
+        if (processAllSignatures) {
+            ctx->setFlag("proc-all-sigs", "1");
+        }
+        return Error{};
+    }, [this](Context *ctx, size_t index) {
+        m_results[index] = decrypt_verify_file(ctx, m_files[index].first, m_files[index].second);
+        return m_results[index].error;
+    });
+}
+
+void BulkFileDecryptVerifyJobPrivate::emitResult()
+{
+    Q_Q(BulkFileDecryptVerifyJob);
+    Q_EMIT q->result(resultError(), m_results);
+}
+
+BulkFileDecryptVerifyJob::BulkFileDecryptVerifyJob(GpgME::Protocol protocol)
+    : BulkFileJob{std::unique_ptr<BulkFileDecryptVerifyJobPrivate>(new BulkFileDecryptVerifyJobPrivate{protocol}), nullptr}
+{
+}
+
+BulkFileDecryptVerifyJob::~BulkFileDecryptVerifyJob() = default;
+
+void BulkFileDecryptVerifyJob::setFiles(const std::vector<std::pair<QString, QString>> &files)
+{
+    Q_D(BulkFileDecryptVerifyJob);
+    d->m_files = files;
+}
+
+std::vector<std::pair<QString, QString>> BulkFileDecryptVerifyJob::files() const
+{
+    Q_D(const BulkFileDecryptVerifyJob);
+    return d->m_files;
+}
+
+void BulkFileDecryptVerifyJob::setProcessAllSignatures(bool processAll)
+{
+    Q_D(BulkFileDecryptVerifyJob);
+    d->m_processAllSignatures = processAll;
+}
+
+bool BulkFileDecryptVerifyJob::processAllSignatures() const
+{
+    Q_D(const BulkFileDecryptVerifyJob);
+    return d->m_processAllSignatures;
+}
+
+#include "moc_bulkfiledecryptverifyjob.cpp"
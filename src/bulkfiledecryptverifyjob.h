@@ -0,0 +1,93 @@
+/*
+    bulkfiledecryptverifyjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILEDECRYPTVERIFYJOB_H__
+#define __QGPGME_BULKFILEDECRYPTVERIFYJOB_H__
+
+#include "bulkfilejob.h"
+
+#include <utility>
+#include <vector>
+
+namespace QGpgME
+{
+
+class BulkFileDecryptVerifyJobPrivate;
+
+/**
+ * This job decrypts and verifies many files, e.g. for restoring a large
+ * number of individually encrypted files. Each input file is decrypted to
+ * its own output file.
+ *
+ * Instead of the full decryption and verification results the result()
+ * signal passes a compact table of FileResult with one entry per file in the
+ * order of the files. The error passed to result() is the error of the first file (in the
+ * order of the files) that could not be decrypted, or \c GPG_ERR_CANCELED if
+ * the job was canceled.
+ *
+ * \note A file is decrypted successfully regardless of the validity of its
+ * signatures. Check the signature information in the result table if the
+ * files must be signed.
+ */
+class QGPGME_EXPORT BulkFileDecryptVerifyJob : public BulkFileJob
+{
+    Q_OBJECT
+public:
+    explicit BulkFileDecryptVerifyJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BulkFileDecryptVerifyJob() override;
+
+    /**
+     * Sets the files to decrypt as pairs of input file and output file.
+     *
+     * \note If an output file exists, then the decryption of this file fails.
+     */
+    void setFiles(const std::vector<std::pair<QString, QString>> &files);
+    std::vector<std::pair<QString, QString>> files() const;
+
+    /**
+     * Enables processing of all signatures if \a processAll is true.
+     *
+     * \see DecryptVerifyJob::setProcessAllSignatures
+     */
+    void setProcessAllSignatures(bool processAll);
+    bool processAllSignatures() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error, const std::vector<QGpgME::BulkFileJob::FileResult> &results);
+
+private:
+    Q_DECLARE_PRIVATE(BulkFileDecryptVerifyJob)
+};
+
+}
+
+#endif // __QGPGME_BULKFILEDECRYPTVERIFYJOB_H__
@@ -0,0 +1,186 @@
+/*
+    bulkfileencryptjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "bulkfileencryptjob.h"
+
+#include "bulkfilejob_p.h"
+#include "util.h"
+
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BulkFileEncryptJobPrivate : public BulkFileJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BulkFileEncryptJob)
+
+    explicit BulkFileEncryptJobPrivate(GpgME::Protocol protocol)
+        : BulkFileJobPrivate{protocol}
+    {
+    }
+
+    ~BulkFileEncryptJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    std::vector<GpgME::Key> m_recipients;
+    std::vector<std::pair<QString, QString>> m_files;
+    GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::None;
+    bool m_armor = false;
+    std::vector<GpgME::EncryptionResult> m_results;
+};
+
+static EncryptionResult encrypt_file(Context *ctx,
+                                     const std::vector<Key> &recipients,
+                                     const QString &inputFilePath,
+                                     const QString &outputFilePath,
+                                     Context::EncryptionFlags flags)
+{
+    if (!ctx) {
+        return EncryptionResult{Error::fromCode(GPG_ERR_NOT_SUPPORTED)};
+    }
+
+    // don't encrypt the file only to fail when renaming the temporary file
+    if (QFile::exists(outputFilePath)) {
+        return EncryptionResult{Error::fromCode(GPG_ERR_EEXIST)};
+    }
+
+    Data indata;
+    _detail::setDataFileName(indata, inputFilePath);
+
+    PartialFileGuard partFileGuard{outputFilePath};
+    if (partFileGuard.tempFileName().isEmpty()) {
+        return EncryptionResult{Error::fromCode(GPG_ERR_EEXIST)};
+    }
+    Data outdata;
+    _detail::setDataFileName(outdata, partFileGuard.tempFileName());
+
+    flags = static_cast<Context::EncryptionFlags>(flags | Context::EncryptFile);
+    const auto result = ctx->encrypt(recipients, indata, outdata, flags);
+    if (!result.error().code()) {
+        // the operation succeeded -> save the result under the requested file name
+        if (!partFileGuard.commit()) {
+            return EncryptionResult{Error::fromCode(QFile::exists(outputFilePath) ? GPG_ERR_EEXIST : GPG_ERR_EIO)};
+        }
+    }
+    return result;
+}
+
+GpgME::Error BulkFileEncryptJobPrivate::startIt()
+{
+    for (const auto &file : m_files) {
+        if (file.first.isEmpty() || file.second.isEmpty()) {
+            return Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+    }
+
+    m_results = _detail::canceledResults<EncryptionResult>(m_files.size());
+    const bool armor = m_armor;
+    return startItems(m_files.size(), [armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return Error{};
+    }, [this](Context *ctx, size_t index) {
+        m_results[index] = encrypt_file(ctx, m_recipients, m_files[index].first, m_files[index].second, m_encryptionFlags);
+        return m_results[index].error();
+    });
+}
+
+void BulkFileEncryptJobPrivate::emitResult()
+{
+    Q_Q(BulkFileEncryptJob);
+    Q_EMIT q->result(resultError(), m_results);
+}
+
+BulkFileEncryptJob::BulkFileEncryptJob(GpgME::Protocol protocol)
+    : BulkFileJob{std::unique_ptr<BulkFileEncryptJobPrivate>(new BulkFileEncryptJobPrivate{protocol}), nullptr}
+{
+}
+
+BulkFileEncryptJob::~BulkFileEncryptJob() = default;
+
+void BulkFileEncryptJob::setRecipients(const std::vector<GpgME::Key> &recipients)
+{
+    Q_D(BulkFileEncryptJob);
+    d->m_recipients = recipients;
+}
+
+std::vector<GpgME::Key> BulkFileEncryptJob::recipients() const
+{
+    Q_D(const BulkFileEncryptJob);
+    return d->m_recipients;
+}
+
+void BulkFileEncryptJob::setFiles(const std::vector<std::pair<QString, QString>> &files)
+{
+    Q_D(BulkFileEncryptJob);
+    d->m_files = files;
+}
+
+std::vector<std::pair<QString, QString>> BulkFileEncryptJob::files() const
+{
+    Q_D(const BulkFileEncryptJob);
+    return d->m_files;
+}
+
+void BulkFileEncryptJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
+{
+    Q_D(BulkFileEncryptJob);
+    d->m_encryptionFlags = flags;
+}
+
+GpgME::Context::EncryptionFlags BulkFileEncryptJob::encryptionFlags() const
+{
+    Q_D(const BulkFileEncryptJob);
+    return d->m_encryptionFlags;
+}
+
+void BulkFileEncryptJob::setArmor(bool armor)
+{
+    Q_D(BulkFileEncryptJob);
+    d->m_armor = armor;
+}
+
+bool BulkFileEncryptJob::armor() const
+{
+    Q_D(const BulkFileEncryptJob);
+    return d->m_armor;
+}
+
+#include "moc_bulkfileencryptjob.cpp"
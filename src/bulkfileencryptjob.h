@@ -0,0 +1,107 @@
+/*
+    bulkfileencryptjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILEENCRYPTJOB_H__
+#define __QGPGME_BULKFILEENCRYPTJOB_H__
+
+#include "bulkfilejob.h"
+
+#include <gpgme++/context.h>
+
+#include <utility>
+#include <vector>
+
+namespace GpgME
+{
+class EncryptionResult;
+class Key;
+}
+
+namespace QGpgME
+{
+
+class BulkFileEncryptJobPrivate;
+
+/**
+ * This job encrypts many files for the same recipients. Each input file is
+ * encrypted to its own output file.
+ *
+ * The result() signal passes one encryption result per file in the order of
+ * the files. The error passed to result() is the error of the first file
+ * (in the order of the files) that could not be encrypted, or
+ * \c GPG_ERR_CANCELED if the job was canceled. Files that were not processed
+ * because the job was canceled have a result with \c GPG_ERR_CANCELED.
+ */
+class QGPGME_EXPORT BulkFileEncryptJob : public BulkFileJob
+{
+    Q_OBJECT
+public:
+    explicit BulkFileEncryptJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BulkFileEncryptJob() override;
+
+    /**
+     * Sets the keys to encrypt the files for. If no recipients are set, then
+     * symmetric encryption is performed.
+     */
+    void setRecipients(const std::vector<GpgME::Key> &recipients);
+    std::vector<GpgME::Key> recipients() const;
+
+    /**
+     * Sets the files to encrypt as pairs of input file and output file.
+     *
+     * \note If an output file exists, then the encryption of this file fails.
+     */
+    void setFiles(const std::vector<std::pair<QString, QString>> &files);
+    std::vector<std::pair<QString, QString>> files() const;
+
+    /**
+     * Sets the flags to use for encryption.
+     */
+    void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
+    GpgME::Context::EncryptionFlags encryptionFlags() const;
+
+    /**
+     * Sets whether the output shall be ASCII armored. Defaults to \c false.
+     */
+    void setArmor(bool armor);
+    bool armor() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error, const std::vector<GpgME::EncryptionResult> &results);
+
+private:
+    Q_DECLARE_PRIVATE(BulkFileEncryptJob)
+};
+
+}
+
+#endif // __QGPGME_BULKFILEENCRYPTJOB_H__
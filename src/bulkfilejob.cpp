@@ -0,0 +1,144 @@
+/*
+    bulkfilejob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "bulkfilejob.h"
+#include "bulkfilejob_p.h"
+
+#include <algorithm>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+BulkFileJobPrivate::BulkFileJobPrivate(GpgME::Protocol protocol)
+    : PooledJobPrivate{protocol}
+{
+    // the results are reported with result(); fileCompleted() is opt-in
+    m_completionChunkSize = 0;
+    m_orderedCompletion = false;
+}
+
+BulkFileJobPrivate::~BulkFileJobPrivate() = default;
+
+BulkFileJob::FileResult BulkFileJobPrivate::fileResult(size_t index) const
+{
+    BulkFileJob::FileResult result;
+    result.error = m_itemErrors[index];
+    return result;
+}
+
+void BulkFileJobPrivate::emitCompleted(size_t first, size_t count)
+{
+    Q_Q(BulkFileJob);
+    for (size_t index = first; index < first + count; ++index) {
+        Q_EMIT q->fileCompleted(static_cast<int>(index), fileResult(index));
+    }
+}
+
+void BulkFileJobPrivate::emitProgress(size_t finished, size_t total)
+{
+    Q_Q(BulkFileJob);
+    // don't flood the event loop with one progress signal per file if
+    // there are many files
+    const size_t step = std::max<size_t>(total / 1000, 1);
+    if (finished % step != 0 && finished != total) {
+        return;
+    }
+    Q_EMIT q->fileProgress(static_cast<int>(finished), static_cast<int>(total));
+    PooledJobPrivate::emitProgress(finished, total);
+}
+
+void _detail::setSignatureInfo(BulkFileJob::FileResult &result, const VerificationResult &verificationResult)
+{
+    const auto signatures = verificationResult.signatures();
+    result.numSignatures = static_cast<int>(signatures.size());
+    if (signatures.empty()) {
+        return;
+    }
+    unsigned int summary = signatures.front().summary();
+    for (const auto &sig : signatures) {
+        const unsigned int sigSummary = sig.summary();
+        // the positive flags must be set for all signatures; the negative flags are collected
+        summary = (summary & sigSummary & (Signature::Valid | Signature::Green))
+            | ((summary | sigSummary) & ~(Signature::Valid | Signature::Green));
+    }
+    result.signatureSummary = static_cast<Signature::Summary>(summary);
+    result.signerFingerprint = signatures.front().fingerprint();
+}
+
+BulkFileJob::BulkFileJob(std::unique_ptr<BulkFileJobPrivate> dd, QObject *parent)
+    : PooledJob{std::move(dd), parent}
+{
+}
+
+BulkFileJob::~BulkFileJob() = default;
+
+void BulkFileJob::setFailurePolicy(FailurePolicy policy)
+{
+    Q_D(BulkFileJob);
+    d->m_stopOnError = policy == StopOnError;
+}
+
+BulkFileJob::FailurePolicy BulkFileJob::failurePolicy() const
+{
+    Q_D(const BulkFileJob);
+    return d->m_stopOnError ? StopOnError : ContinueOnError;
+}
+
+void BulkFileJob::setReportCompletedFiles(bool report)
+{
+    Q_D(BulkFileJob);
+    d->m_completionChunkSize = report ? 1 : 0;
+}
+
+bool BulkFileJob::reportCompletedFiles() const
+{
+    Q_D(const BulkFileJob);
+    return d->m_completionChunkSize > 0;
+}
+
+void BulkFileJob::setCompletionOrder(CompletionOrder order)
+{
+    Q_D(BulkFileJob);
+    d->m_orderedCompletion = order == OrderedCompletion;
+}
+
+BulkFileJob::CompletionOrder BulkFileJob::completionOrder() const
+{
+    Q_D(const BulkFileJob);
+    return d->m_orderedCompletion ? OrderedCompletion : UnorderedCompletion;
+}
+
+#include "moc_bulkfilejob.cpp"
@@ -0,0 +1,145 @@
+/*
+    bulkfilejob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILEJOB_H__
+#define __QGPGME_BULKFILEJOB_H__
+
+#include "pooledjob.h"
+
+#include <QByteArray>
+
+#include <gpgme++/error.h>
+#include <gpgme++/verificationresult.h>
+
+namespace QGpgME
+{
+
+class BulkFileJobPrivate;
+
+/**
+ * Abstract base class for jobs that process many files with the same
+ * operation, e.g. encrypt thousands of files for the same recipients.
+ *
+ * Output files are written to temporary files first and are renamed when
+ * the operation for the file succeeded, i.e. a failed operation doesn't
+ * leave incomplete files behind.
+ *
+ * Instead of the full results of the operations the concrete jobs report a
+ * compact FileResult per file.
+ */
+class QGPGME_EXPORT BulkFileJob : public PooledJob
+{
+    Q_OBJECT
+protected:
+    explicit BulkFileJob(std::unique_ptr<BulkFileJobPrivate>, QObject *parent);
+public:
+    enum FailurePolicy {
+        ContinueOnError, ///< Process all files regardless of failures
+        StopOnError, ///< Stop processing files after the first failure
+    };
+
+    enum CompletionOrder {
+        UnorderedCompletion, ///< Report files as soon as they have been processed
+        OrderedCompletion, ///< Report files in the order of the files
+    };
+
+    /**
+     * The compact result of the operation for one file. Which of the
+     * signature information is filled depends on the operation.
+     */
+    struct FileResult {
+        /// The error of the operation for the file
+        GpgME::Error error = GpgME::Error::fromCode(GPG_ERR_CANCELED);
+        /// The number of signatures that were created or verified
+        int numSignatures = 0;
+        /// The combined summary of all verified signatures, i.e. \c Valid and
+        /// \c Green are only set if they are set for all signatures
+        GpgME::Signature::Summary signatureSummary = GpgME::Signature::None;
+        /// The fingerprint of the key that made the first signature
+        QByteArray signerFingerprint;
+    };
+
+    ~BulkFileJob() override;
+
+    /**
+     * Sets what happens if the processing of a file fails. Defaults to
+     * ContinueOnError.
+     *
+     * With StopOnError no further files are started after a failure and the
+     * files that are processed at that time are canceled. The results of
+     * the files that were not processed have the error \c GPG_ERR_CANCELED.
+     */
+    void setFailurePolicy(FailurePolicy policy);
+    FailurePolicy failurePolicy() const;
+
+    /**
+     * Sets whether fileCompleted() is emitted for each processed file.
+     * Defaults to \c false, i.e. the results of the files are only reported
+     * with the result() signal of the concrete job. Enable it if the results
+     * are needed while the job is running. Has to be set before the job is
+     * started.
+     */
+    void setReportCompletedFiles(bool report);
+    bool reportCompletedFiles() const;
+
+    /**
+     * Sets in which order fileCompleted() is emitted. Defaults to
+     * UnorderedCompletion.
+     *
+     * With OrderedCompletion the result of a file is held back until the
+     * results of all previous files have been reported.
+     */
+    void setCompletionOrder(CompletionOrder order);
+    CompletionOrder completionOrder() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted when files have been processed. \a current is the number of
+     * finished files and \a total is the number of files. For large
+     * numbers of files the progress is reported in steps of 0.1 %.
+     */
+    void fileProgress(int current, int total);
+
+    /**
+     * Emitted with the result of the file with index \a index after it has
+     * been processed if reportCompletedFiles() is set. Files that are not
+     * processed because the job was canceled are not reported.
+     */
+    void fileCompleted(int index, const QGpgME::BulkFileJob::FileResult &result);
+
+private:
+    Q_DECLARE_PRIVATE(BulkFileJob)
+};
+
+}
+
+#endif // __QGPGME_BULKFILEJOB_H__
@@ -0,0 +1,78 @@
+/*
+    bulkfilejob_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILEJOB_P_H__
+#define __QGPGME_BULKFILEJOB_P_H__
+
+#include "bulkfilejob.h"
+#include "pooledjob_p.h"
+
+#include <QFile>
+
+#include <gpgme++/data.h>
+
+namespace QGpgME
+{
+
+class BulkFileJobPrivate : public PooledJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BulkFileJob)
+
+    explicit BulkFileJobPrivate(GpgME::Protocol protocol);
+    ~BulkFileJobPrivate() override;
+
+    // Returns the result of a processed file for fileCompleted()
+    virtual BulkFileJob::FileResult fileResult(size_t index) const;
+
+    void emitCompleted(size_t first, size_t count) override;
+    void emitProgress(size_t finished, size_t total) override;
+};
+
+namespace _detail
+{
+// Fills the signature information of \a result from \a verificationResult
+void setSignatureInfo(BulkFileJob::FileResult &result, const GpgME::VerificationResult &verificationResult);
+
+inline void setDataFileName(GpgME::Data &data, const QString &fileName)
+{
+#ifdef Q_OS_WIN
+    data.setFileName(fileName.toUtf8().constData());
+#else
+    data.setFileName(QFile::encodeName(fileName).constData());
+#endif
+}
+}
+
+}
+
+#endif // __QGPGME_BULKFILEJOB_P_H__
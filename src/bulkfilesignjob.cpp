@@ -0,0 +1,186 @@
+/*
+    bulkfilesignjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "bulkfilesignjob.h"
+
+#include "batchjob_p.h"
+#include "bulkfilejob_p.h"
+#include "util.h"
+
+#include <gpgme++/context.h>
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BulkFileSignJobPrivate : public BulkFileJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BulkFileSignJob)
+
+    explicit BulkFileSignJobPrivate(GpgME::Protocol protocol)
+        : BulkFileJobPrivate{protocol}
+    {
+    }
+
+    ~BulkFileSignJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    BulkFileJob::FileResult fileResult(size_t index) const override
+    {
+        return m_results[index];
+    }
+
+    std::vector<GpgME::Key> m_signers;
+    std::vector<std::pair<QString, QString>> m_files;
+    bool m_armor = false;
+    std::vector<BulkFileJob::FileResult> m_results;
+};
+
+static BulkFileJob::FileResult sign_file(Context *ctx,
+                                         const QString &inputFilePath,
+                                         const QString &signatureFilePath)
+{
+    BulkFileJob::FileResult result;
+    // don't sign the file only to fail when renaming the temporary file
+    if (QFile::exists(signatureFilePath)) {
+        result.error = Error::fromCode(GPG_ERR_EEXIST);
+        return result;
+    }
+
+    Data indata;
+    _detail::setDataFileName(indata, inputFilePath);
+
+    PartialFileGuard partFileGuard{signatureFilePath};
+    if (partFileGuard.tempFileName().isEmpty()) {
+        result.error = Error::fromCode(GPG_ERR_EEXIST);
+        return result;
+    }
+    Data outdata;
+    _detail::setDataFileName(outdata, partFileGuard.tempFileName());
+
+    const auto signingResult = ctx->sign(indata, outdata, static_cast<SignatureMode>(Detached | SignFile));
+    result.error = signingResult.error();
+    const auto signatures = signingResult.createdSignatures();
+    result.numSignatures = static_cast<int>(signatures.size());
+    if (!signatures.empty()) {
+        result.signerFingerprint = signatures.front().fingerprint();
+    }
+    if (!result.error.code()) {
+        // the operation succeeded -> save the signature under the requested file name
+        if (!partFileGuard.commit()) {
+            result.error = Error::fromCode(QFile::exists(signatureFilePath) ? GPG_ERR_EEXIST : GPG_ERR_EIO);
+        }
+    }
+    return result;
+}
+
+GpgME::Error BulkFileSignJobPrivate::startIt()
+{
+    for (const auto &file : m_files) {
+        if (file.first.isEmpty() || file.second.isEmpty()) {
+            return Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+    }
+
+    m_results = _detail::canceledResults<BulkFileJob::FileResult>(m_files.size());
+    return startItems(m_files.size(), [signers = m_signers, armor = m_armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return _detail::setSigningKeys(ctx, signers);
+    }, [this](Context *ctx, size_t index) {
+        const Error err = contextSetupError(ctx);
+        if (err) {
+            m_results[index].error = err;
+        } else {
+            m_results[index] = sign_file(ctx, m_files[index].first, m_files[index].second);
+        }
+        return m_results[index].error;
+    });
+}
+
+void BulkFileSignJobPrivate::emitResult()
+{
+    Q_Q(BulkFileSignJob);
+    Q_EMIT q->result(resultError(), m_results);
+}
+
+BulkFileSignJob::BulkFileSignJob(GpgME::Protocol protocol)
+    : BulkFileJob{std::unique_ptr<BulkFileSignJobPrivate>(new BulkFileSignJobPrivate{protocol}), nullptr}
+{
+}
+
+BulkFileSignJob::~BulkFileSignJob() = default;
+
+void BulkFileSignJob::setSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(BulkFileSignJob);
+    d->m_signers = signers;
+}
+
+std::vector<GpgME::Key> BulkFileSignJob::signers() const
+{
+    Q_D(const BulkFileSignJob);
+    return d->m_signers;
+}
+
+void BulkFileSignJob::setFiles(const std::vector<std::pair<QString, QString>> &files)
+{
+    Q_D(BulkFileSignJob);
+    d->m_files = files;
+}
+
+std::vector<std::pair<QString, QString>> BulkFileSignJob::files() const
+{
+    Q_D(const BulkFileSignJob);
+    return d->m_files;
+}
+
+void BulkFileSignJob::setArmor(bool armor)
+{
+    Q_D(BulkFileSignJob);
+    d->m_armor = armor;
+}
+
+bool BulkFileSignJob::armor() const
+{
+    Q_D(const BulkFileSignJob);
+    return d->m_armor;
+}
+
+#include "moc_bulkfilesignjob.cpp"
@@ -0,0 +1,100 @@
+/*
+    bulkfilesignjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILESIGNJOB_H__
+#define __QGPGME_BULKFILESIGNJOB_H__
+
+#include "bulkfilejob.h"
+
+#include <utility>
+#include <vector>
+
+namespace GpgME
+{
+class Key;
+}
+
+namespace QGpgME
+{
+
+class BulkFileSignJobPrivate;
+
+/**
+ * This job creates detached signatures for many files with the same keys,
+ * e.g. for signing the artifacts of a release.
+ *
+ * The result() signal passes a compact table of FileResult with one entry
+ * per file in the order of the files. The number of signatures and the
+ * fingerprint of the first signing key are set for the created signatures.
+ * The error passed to result() is the error of the first file (in the order
+ * of the files) that could not be signed, or \c GPG_ERR_CANCELED if the job
+ * was canceled.
+ */
+class QGPGME_EXPORT BulkFileSignJob : public BulkFileJob
+{
+    Q_OBJECT
+public:
+    explicit BulkFileSignJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BulkFileSignJob() override;
+
+    /**
+     * Sets the keys to sign with. If no keys are set, then the default key
+     * of the engine is used.
+     */
+    void setSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> signers() const;
+
+    /**
+     * Sets the files to sign as pairs of file to sign and signature file,
+     * e.g. "foo" and "foo.sig".
+     *
+     * \note If a signature file exists, then the signing of this file fails.
+     */
+    void setFiles(const std::vector<std::pair<QString, QString>> &files);
+    std::vector<std::pair<QString, QString>> files() const;
+
+    /**
+     * Sets whether the signatures shall be ASCII armored. Defaults to \c false.
+     */
+    void setArmor(bool armor);
+    bool armor() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error, const std::vector<QGpgME::BulkFileJob::FileResult> &results);
+
+private:
+    Q_DECLARE_PRIVATE(BulkFileSignJob)
+};
+
+}
+
+#endif // __QGPGME_BULKFILESIGNJOB_H__
@@ -0,0 +1,150 @@
+/*
+    bulkfileverifydetachedjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "bulkfileverifydetachedjob.h"
+
+#include "bulkfilejob_p.h"
+
+#include <gpgme++/context.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::BulkFileVerifyDetachedJobPrivate : public BulkFileJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(BulkFileVerifyDetachedJob)
+
+    explicit BulkFileVerifyDetachedJobPrivate(GpgME::Protocol protocol)
+        : BulkFileJobPrivate{protocol}
+    {
+    }
+
+    ~BulkFileVerifyDetachedJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    BulkFileJob::FileResult fileResult(size_t index) const override
+    {
+        return m_results[index];
+    }
+
+    std::vector<std::pair<QString, QString>> m_files;
+    bool m_processAllSignatures = false;
+    std::vector<BulkFileJob::FileResult> m_results;
+};
+
+static BulkFileJob::FileResult verify_file(Context *ctx,
+                                           const QString &signedFilePath,
+                                           const QString &signatureFilePath)
+{
+    BulkFileJob::FileResult result;
+    if (!ctx) {
+        result.error = Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+        return result;
+    }
+
+    Data signatureData;
+    _detail::setDataFileName(signatureData, signatureFilePath);
+    Data signedData;
+    _detail::setDataFileName(signedData, signedFilePath);
+
+    const auto verificationResult = ctx->verifyDetachedSignature(signatureData, signedData);
+    result.error = verificationResult.error();
+    _detail::setSignatureInfo(result, verificationResult);
+    return result;
+}
+
+GpgME::Error BulkFileVerifyDetachedJobPrivate::startIt()
+{
+    for (const auto &file : m_files) {
+        if (file.first.isEmpty() || file.second.isEmpty()) {
+            return Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+    }
+
+    m_results = _detail::canceledResults<BulkFileJob::FileResult>(m_files.size());
+    const bool processAllSignatures = m_processAllSignatures;
+    return startItems(m_files.size(), [processAllSignatures](Context *ctx) {
+        if (processAllSignatures) {
+            ctx->setFlag("proc-all-sigs", "1");
+        }
+        return Error{};
+    }, [this](Context *ctx, size_t index) {
+        m_results[index] = verify_file(ctx, m_files[index].first, m_files[index].second);
+        return m_results[index].error;
+    });
+}
+
+void BulkFileVerifyDetachedJobPrivate::emitResult()
+{
+    Q_Q(BulkFileVerifyDetachedJob);
+    Q_EMIT q->result(resultError(), m_results);
+}
+
+BulkFileVerifyDetachedJob::BulkFileVerifyDetachedJob(GpgME::Protocol protocol)
+    : BulkFileJob{std::unique_ptr<BulkFileVerifyDetachedJobPrivate>(new BulkFileVerifyDetachedJobPrivate{protocol}), nullptr}
+{
+}
+
+BulkFileVerifyDetachedJob::~BulkFileVerifyDetachedJob() = default;
+
+void BulkFileVerifyDetachedJob::setFiles(const std::vector<std::pair<QString, QString>> &files)
+{
+    Q_D(BulkFileVerifyDetachedJob);
+    d->m_files = files;
+}
+
+std::vector<std::pair<QString, QString>> BulkFileVerifyDetachedJob::files() const
+{
+    Q_D(const BulkFileVerifyDetachedJob);
+    return d->m_files;
+}
+
+void BulkFileVerifyDetachedJob::setProcessAllSignatures(bool processAll)
+{
+    Q_D(BulkFileVerifyDetachedJob);
+    d->m_processAllSignatures = processAll;
+}
+
+bool BulkFileVerifyDetachedJob::processAllSignatures() const
+{
+    Q_D(const BulkFileVerifyDetachedJob);
+    return d->m_processAllSignatures;
+}
+
+#include "moc_bulkfileverifydetachedjob.cpp"
@@ -0,0 +1,89 @@
+/*
+    bulkfileverifydetachedjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_BULKFILEVERIFYDETACHEDJOB_H__
+#define __QGPGME_BULKFILEVERIFYDETACHEDJOB_H__
+
+#include "bulkfilejob.h"
+
+#include <utility>
+#include <vector>
+
+namespace QGpgME
+{
+
+class BulkFileVerifyDetachedJobPrivate;
+
+/**
+ * This job verifies the detached signatures of many files, e.g. of the
+ * artifacts of a release.
+ *
+ * The result() signal passes a compact table of FileResult with one entry
+ * per file in the order of the files. The error passed to result() is the
+ * error of the first file (in the order of the files) that could not be
+ * verified, or \c GPG_ERR_CANCELED if the job was canceled.
+ *
+ * \note A bad signature is not an error of the verification. Check the
+ * signature summary in the result table.
+ */
+class QGPGME_EXPORT BulkFileVerifyDetachedJob : public BulkFileJob
+{
+    Q_OBJECT
+public:
+    explicit BulkFileVerifyDetachedJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~BulkFileVerifyDetachedJob() override;
+
+    /**
+     * Sets the files to verify as pairs of signed file and signature file,
+     * e.g. "foo" and "foo.sig".
+     */
+    void setFiles(const std::vector<std::pair<QString, QString>> &files);
+    std::vector<std::pair<QString, QString>> files() const;
+
+    /**
+     * Enables processing of all signatures if \a processAll is true.
+     *
+     * \see VerifyDetachedJob::setProcessAllSignatures
+     */
+    void setProcessAllSignatures(bool processAll);
+    bool processAllSignatures() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error, const std::vector<QGpgME::BulkFileJob::FileResult> &results);
+
+private:
+    Q_DECLARE_PRIVATE(BulkFileVerifyDetachedJob)
+};
+
+}
+
+#endif // __QGPGME_BULKFILEVERIFYDETACHEDJOB_H__
@@ -0,0 +1,185 @@
+/*
+    compressionprobe.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "compressionprobe_p.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+using namespace QGpgME;
+
+namespace
+{
+// the number of bytes at the start of the input that are probed
+constexpr qint64 SampleSize = 64 * 1024;
+// the entropy estimate of smaller samples is too unreliable
+constexpr qint64 MinEntropySampleSize = 4 * 1024;
+// compressed data has close to 8 bits of entropy per byte; text has less
+// than 5 and even executables rarely have more than 6.5
+constexpr double IncompressibleEntropy = 7.5;
+// the number of files probed by filesLookIncompressible()
+constexpr int MaxSampledFiles = 16;
+
+bool startsWith(const char *data, qint64 size, qint64 offset, const char *magic, qint64 magicSize)
+{
+    return size >= offset + magicSize && std::memcmp(data + offset, magic, magicSize) == 0;
+}
+
+bool hasCompressedFormatSignature(const char *data, qint64 size)
+{
+    struct Signature {
+        qint64 offset;
+        const char *magic;
+        qint64 size;
+    };
+    static const Signature signatures[] = {
+        {0, "\xFF\xD8\xFF", 3},                     // JPEG
+        {0, "\x89PNG\r\n\x1A\n", 8},                // PNG
+        {0, "GIF8", 4},                             // GIF
+        {0, "PK\x03\x04", 4},                       // ZIP, OOXML, ODF, JAR
+        {0, "\x1F\x8B", 2},                         // gzip
+        {0, "BZh", 3},                              // bzip2
+        {0, "\xFD" "7zXZ\x00", 6},                  // xz
+        {0, "\x28\xB5\x2F\xFD", 4},                 // zstd
+        {0, "\x04\x22\x4D\x18", 4},                 // lz4
+        {0, "7z\xBC\xAF\x27\x1C", 6},               // 7-Zip
+        {0, "Rar!\x1A\x07", 6},                     // RAR
+        {4, "ftyp", 4},                             // MP4, MOV, HEIC
+        {0, "\x1A\x45\xDF\xA3", 4},                 // Matroska, WebM
+        {0, "OggS", 4},                             // Ogg
+        {0, "fLaC", 4},                             // FLAC
+        {0, "ID3", 3},                              // MP3
+        {8, "WEBP", 4},                             // WebP
+    };
+    for (const auto &signature : signatures) {
+        if (startsWith(data, size, signature.offset, signature.magic, signature.size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double entropy(const char *data, qint64 size)
+{
+    std::array<qint64, 256> counts{};
+    for (qint64 i = 0; i < size; ++i) {
+        ++counts[static_cast<unsigned char>(data[i])];
+    }
+    double bits = 0;
+    for (const auto count : counts) {
+        if (count > 0) {
+            const double p = static_cast<double>(count) / size;
+            bits -= p * std::log2(p);
+        }
+    }
+    return bits;
+}
+}
+
+bool _detail::looksIncompressible(const char *data, qint64 size)
+{
+    if (!data || size <= 0) {
+        return false;
+    }
+    size = std::min(size, SampleSize);
+    if (hasCompressedFormatSignature(data, size)) {
+        return true;
+    }
+    return size >= MinEntropySampleSize && entropy(data, size) >= IncompressibleEntropy;
+}
+
+bool _detail::looksIncompressible(const QByteArray &plainText)
+{
+    return looksIncompressible(plainText.constData(), plainText.size());
+}
+
+bool _detail::looksIncompressible(QIODevice *device)
+{
+    // reading from a sequential device would consume the data
+    if (!device || !device->isOpen() || device->isSequential()) {
+        return false;
+    }
+    return looksIncompressible(device->peek(SampleSize));
+}
+
+bool _detail::fileLooksIncompressible(const QString &filePath)
+{
+    QFile file{filePath};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return looksIncompressible(file.read(SampleSize));
+}
+
+bool _detail::filesLookIncompressible(const std::vector<QString> &paths, const QString &baseDirectory)
+{
+    const QDir baseDir{baseDirectory.isEmpty() ? QDir::currentPath() : baseDirectory};
+    int sampledFiles = 0;
+    qint64 totalSize = 0;
+    qint64 incompressibleSize = 0;
+    const auto probe = [&](const QFileInfo &fi) {
+        ++sampledFiles;
+        totalSize += fi.size();
+        if (fileLooksIncompressible(fi.filePath())) {
+            incompressibleSize += fi.size();
+        }
+    };
+    for (const auto &path : paths) {
+        if (sampledFiles >= MaxSampledFiles) {
+            break;
+        }
+        const QFileInfo fi{baseDir.filePath(path)};
+        if (fi.isDir()) {
+            QDirIterator it{fi.filePath(), QDir::Files | QDir::Hidden | QDir::NoSymLinks, QDirIterator::Subdirectories};
+            while (sampledFiles < MaxSampledFiles && it.hasNext()) {
+                it.next();
+                probe(it.fileInfo());
+            }
+        } else if (fi.isFile()) {
+            probe(fi);
+        }
+    }
+    // a few small text files don't justify compressing a large video
+    return totalSize > 0 && incompressibleSize >= totalSize * 9 / 10;
+}
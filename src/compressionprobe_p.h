@@ -0,0 +1,86 @@
+/*
+    compressionprobe_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_COMPRESSIONPROBE_P_H__
+#define __QGPGME_COMPRESSIONPROBE_P_H__
+
+#include <QByteArray>
+#include <QString>
+
+#include <gpgme++/context.h>
+
+#include <atomic>
+#include <vector>
+
+class QIODevice;
+
+namespace QGpgME
+{
+namespace _detail
+{
+// Returns true if the data starts with the signature of a compressed file
+// format (e.g. JPEG, ZIP, zstd) or if the bytes are so evenly distributed
+// that compressing them again is a waste of time, e.g. because they are
+// encrypted.
+bool looksIncompressible(const char *data, qint64 size);
+
+// Probes the first bytes of plainText.
+bool looksIncompressible(const QByteArray &plainText);
+
+// Probes the first bytes of a random-access device without consuming them.
+// Returns false for sequential devices.
+bool looksIncompressible(QIODevice *device);
+
+// Probes the first bytes of the file.
+bool fileLooksIncompressible(const QString &filePath);
+
+// Probes the first bytes of a sample of the files that would be archived.
+// Paths are resolved relative to baseDirectory and directories are searched
+// for files. Returns true if most of the sampled data looks incompressible.
+bool filesLookIncompressible(const std::vector<QString> &paths, const QString &baseDirectory);
+
+// Sets detected to whether the detection of incompressible input is enabled
+// and probe() says that the input looks incompressible. Returns flags with
+// NoCompress added if it does. Probing may read from disk, so the jobs call
+// this in their thread.
+template<typename Probe>
+GpgME::Context::EncryptionFlags disableCompressionIfIncompressible(GpgME::Context::EncryptionFlags flags,
+                                                                   bool detect, std::atomic<bool> &detected, Probe probe)
+{
+    const bool incompressible = detect && probe();
+    detected = incompressible;
+    return incompressible ? static_cast<GpgME::Context::EncryptionFlags>(flags | GpgME::Context::NoCompress) : flags;
+}
+}
+}
+
+#endif // __QGPGME_COMPRESSIONPROBE_P_H__
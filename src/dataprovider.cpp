@@ -28,6 +28,8 @@
 
 #include <dataprovider.h>
 
+#include "jobthroughput.h"
+
 #include <gpgme++/error.h>
 
 #include <QIODevice>
@@ -36,6 +38,7 @@
 #include <cstdio>
 #include <cstring>
 #include <cassert>
+#include <limits>
 
 using namespace QGpgME;
 using namespace GpgME;
@@ -65,6 +68,13 @@ QByteArrayDataProvider::QByteArrayDataProvider(const QByteArray &initialData)
 
 QByteArrayDataProvider::~QByteArrayDataProvider() {}
 
+void QByteArrayDataProvider::reserve(qint64 size)
+{
+    if (size > mArray.capacity() && size < std::numeric_limits<int>::max()) {
+        mArray.reserve(size);
+    }
+}
+
 gpgme_ssize_t QByteArrayDataProvider::read(void *buffer, size_t bufSize)
 {
 #ifndef NDEBUG
@@ -82,7 +92,7 @@ gpgme_ssize_t QByteArrayDataProvider::read(void *buffer, size_t bufSize)
     }
     size_t amount = qMin(bufSize, static_cast<size_t>(mArray.size() - mOff));
     assert(amount > 0);
-    memcpy(buffer, mArray.data() + mOff, amount);
+    memcpy(buffer, mArray.constData() + mOff, amount);
     mOff += amount;
     return amount;
 }
@@ -143,23 +153,234 @@ void QByteArrayDataProvider::release()
     mArray = QByteArray();
 }
 
+//
+//
+// QByteArrayReadOnlyDataProvider
+//
+//
+
+QByteArrayReadOnlyDataProvider::QByteArrayReadOnlyDataProvider(const QByteArray &data)
+    : GpgME::DataProvider(), mArray(data), mOff(0) {}
+
+QByteArrayReadOnlyDataProvider::~QByteArrayReadOnlyDataProvider() = default;
+
+gpgme_ssize_t QByteArrayReadOnlyDataProvider::read(void *buffer, size_t bufSize)
+{
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    if (mOff >= mArray.size()) {
+        return 0; // EOF
+    }
+    const size_t amount = qMin(bufSize, static_cast<size_t>(mArray.size() - mOff));
+    memcpy(buffer, mArray.constData() + mOff, amount);
+    mOff += amount;
+    return amount;
+}
+
+gpgme_ssize_t QByteArrayReadOnlyDataProvider::write(const void *, size_t)
+{
+    Error::setSystemError(GPG_ERR_EBADF);
+    return -1;
+}
+
+gpgme_off_t QByteArrayReadOnlyDataProvider::seek(gpgme_off_t offset, int whence)
+{
+    gpgme_off_t newOffset = mOff;
+    switch (whence) {
+    case SEEK_SET:
+        newOffset = offset;
+        break;
+    case SEEK_CUR:
+        newOffset += offset;
+        break;
+    case SEEK_END:
+        newOffset = mArray.size() + offset;
+        break;
+    default:
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    if (newOffset < 0) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    return mOff = newOffset;
+}
+
+void QByteArrayReadOnlyDataProvider::release()
+{
+}
+
+//
+//
+// QByteArraySinkDataProvider
+//
+//
+
+QByteArraySinkDataProvider::QByteArraySinkDataProvider(QByteArray &array)
+    : GpgME::DataProvider(), mArray(array), mOff(0)
+{
+    // marking the current capacity as reserved makes resize() keep the memory
+    mArray.reserve(mArray.capacity());
+    mArray.resize(0);
+}
+
+QByteArraySinkDataProvider::~QByteArraySinkDataProvider() = default;
+
+void QByteArraySinkDataProvider::reserve(qint64 size)
+{
+    if (size > mArray.capacity() && size < std::numeric_limits<int>::max()) {
+        mArray.reserve(size);
+    }
+}
+
+gpgme_ssize_t QByteArraySinkDataProvider::read(void *buffer, size_t bufSize)
+{
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    if (mOff >= mArray.size()) {
+        return 0; // EOF
+    }
+    const size_t amount = qMin(bufSize, static_cast<size_t>(mArray.size() - mOff));
+    memcpy(buffer, mArray.constData() + mOff, amount);
+    mOff += amount;
+    return amount;
+}
+
+gpgme_ssize_t QByteArraySinkDataProvider::write(const void *buffer, size_t bufSize)
+{
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    const size_t newSize = mOff + bufSize;
+    if (newSize > static_cast<size_t>(mArray.size())) {
+        if (newSize >= static_cast<size_t>(std::numeric_limits<int>::max())) {
+            Error::setSystemError(GPG_ERR_EIO);
+            return -1;
+        }
+        // only zero-fill a gap left by seeking beyond the end
+        if (mOff > mArray.size()) {
+            resizeAndInit(mArray, mOff);
+        }
+        mArray.resize(newSize);
+    }
+    memcpy(mArray.data() + mOff, buffer, bufSize);
+    mOff += bufSize;
+    return bufSize;
+}
+
+gpgme_off_t QByteArraySinkDataProvider::seek(gpgme_off_t offset, int whence)
+{
+    gpgme_off_t newOffset = mOff;
+    switch (whence) {
+    case SEEK_SET:
+        newOffset = offset;
+        break;
+    case SEEK_CUR:
+        newOffset += offset;
+        break;
+    case SEEK_END:
+        newOffset = mArray.size() + offset;
+        break;
+    default:
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    if (newOffset < 0) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    return mOff = newOffset;
+}
+
+void QByteArraySinkDataProvider::release()
+{
+    // the byte array is owned by the caller; keep the data
+}
+
 //
 //
 // QIODeviceDataProvider
 //
 //
 
+static const qint64 defaultWriteFlushThreshold = 64 * 1024;
+static const qint64 defaultMaxPendingWriteBytes = 1024 * 1024;
+// the time release() waits for the process to consume the pending data
+static const int releaseFlushTimeout = 30 * 1000;
+
+class QIODeviceDataProvider::Private
+{
+public:
+    explicit Private(bool haveQProcess)
+        : haveQProcess{haveQProcess}
+    {
+    }
+
+    qint64 writeFlushThreshold = defaultWriteFlushThreshold;
+    qint64 maxPendingWriteBytes = defaultMaxPendingWriteBytes;
+    std::shared_ptr<JobThroughput> throughput;
+    bool errorOccurred = false;
+    // set if waiting for the process failed after the data of a write had
+    // already been accepted; the error is reported by the next write
+    bool writeErrorPending = false;
+    const bool haveQProcess;
+};
+
 QIODeviceDataProvider::QIODeviceDataProvider(const std::shared_ptr<QIODevice> &io)
     : GpgME::DataProvider(),
       mIO(io),
-      mErrorOccurred(false),
-      mHaveQProcess(qobject_cast<QProcess *>(io.get()))
+      d{new Private{qobject_cast<QProcess *>(io.get()) != nullptr}}
 {
     assert(mIO);
 }
 
 QIODeviceDataProvider::~QIODeviceDataProvider() {}
 
+void QIODeviceDataProvider::setWriteFlushThreshold(qint64 bytes)
+{
+    d->writeFlushThreshold = qMax(bytes, qint64(0));
+}
+
+qint64 QIODeviceDataProvider::writeFlushThreshold() const
+{
+    return d->writeFlushThreshold;
+}
+
+void QIODeviceDataProvider::setMaxPendingWriteBytes(qint64 bytes)
+{
+    d->maxPendingWriteBytes = qMax(bytes, qint64(0));
+}
+
+qint64 QIODeviceDataProvider::maxPendingWriteBytes() const
+{
+    return d->maxPendingWriteBytes;
+}
+
+void QIODeviceDataProvider::setThroughput(const std::shared_ptr<JobThroughput> &throughput)
+{
+    d->throughput = throughput;
+}
+
+std::shared_ptr<JobThroughput> QIODeviceDataProvider::throughput() const
+{
+    return d->throughput;
+}
+
 bool QIODeviceDataProvider::isSupported(Operation op) const
 {
     const QProcess *const proc = qobject_cast<QProcess *>(mIO.get());
@@ -177,6 +398,33 @@ bool QIODeviceDataProvider::isSupported(Operation op) const
     }
 }
 
+namespace
+{
+class ThroughputWaitGuard
+{
+public:
+    ThroughputWaitGuard(const std::shared_ptr<JobThroughput> &throughput, JobThroughput::WaitReason reason)
+        : mThroughput{throughput.get()}
+        , mReason{reason}
+    {
+        if (mThroughput) {
+            mThroughput->beginWait(mReason);
+        }
+    }
+
+    ~ThroughputWaitGuard()
+    {
+        if (mThroughput) {
+            mThroughput->endWait(mReason);
+        }
+    }
+
+private:
+    JobThroughput *const mThroughput;
+    const JobThroughput::WaitReason mReason;
+};
+}
+
 static qint64 blocking_read(const std::shared_ptr<QIODevice> &io, char *buffer, qint64 maxSize)
 {
     while (!io->bytesAvailable()) {
@@ -214,23 +462,27 @@ gpgme_ssize_t QIODeviceDataProvider::read(void *buffer, size_t bufSize)
         Error::setSystemError(GPG_ERR_EINVAL);
         return -1;
     }
-    const qint64 numRead = mHaveQProcess
+    const ThroughputWaitGuard waitGuard{d->throughput, JobThroughput::WaitingForInput};
+    const qint64 numRead = d->haveQProcess
                            ? blocking_read(mIO, static_cast<char *>(buffer), bufSize)
                            : mIO->read(static_cast<char *>(buffer), bufSize);
+    if (d->throughput && numRead > 0) {
+        d->throughput->addProcessedBytes(numRead);
+    }
 
     //workaround: some QIODevices (known example: QProcess) might not return 0 (EOF), but immediately -1 when finished. If no
     //errno is set, gpgme doesn't detect the error and loops forever. So return 0 on the very first -1 in case errno is 0
 
     gpgme_ssize_t rc = numRead;
     if (numRead < 0 && !Error::hasSystemError()) {
-        if (mErrorOccurred) {
+        if (d->errorOccurred) {
             Error::setSystemError(GPG_ERR_EIO);
         } else {
             rc = 0;
         }
     }
     if (numRead < 0) {
-        mErrorOccurred = true;
+        d->errorOccurred = true;
     }
     return rc;
 }
@@ -247,16 +499,36 @@ gpgme_ssize_t QIODeviceDataProvider::write(const void *buffer, size_t bufSize)
         Error::setSystemError(GPG_ERR_EINVAL);
         return -1;
     }
+    if (d->writeErrorPending) {
+        Error::setSystemError(GPG_ERR_EIO);
+        return -1;
+    }
 
+    const ThroughputWaitGuard waitGuard{d->throughput, JobThroughput::WaitingForOutput};
     gpgme_ssize_t ret = mIO->write(static_cast<const char *>(buffer), bufSize);
-    if (mHaveQProcess) {
+    if (d->haveQProcess && ret > 0) {
         /* XXX: With at least Qt 5.12 we have the problem that the acutal write
          * would be triggered by an event / slot. So as we have moved the io
          * device to our thread this is never triggered until the job is finished
          * calling waitForBytesWritten internally triggers a _q_canWrite which will
          * actually write. This is what we want as we want to stream and not to
-         * buffer endlessly. */
-        qobject_cast<QProcess *>(mIO.get())->waitForBytesWritten(0);
+         * buffer endlessly.
+         * To avoid one flush per (usually small) write of gpgme we let the
+         * data pile up in the write buffer of the process until the flush
+         * threshold is reached. If the process doesn't keep up, then we block
+         * until the pending data is below the limit again. */
+        QProcess *const proc = qobject_cast<QProcess *>(mIO.get());
+        if (proc->bytesToWrite() >= d->writeFlushThreshold) {
+            proc->waitForBytesWritten(0);
+        }
+        while (proc->bytesToWrite() > d->maxPendingWriteBytes) {
+            if (!proc->waitForBytesWritten(-1)) {
+                // the data has already been accepted by the write buffer, so
+                // report the bytes as written and fail the next write
+                d->writeErrorPending = true;
+                break;
+            }
+        }
     }
     return ret;
 }
@@ -297,5 +569,12 @@ void QIODeviceDataProvider::release()
 #ifndef NDEBUG
     //qDebug( "QIODeviceDataProvider::release()" );
 #endif
+    if (d->haveQProcess && !d->writeErrorPending) {
+        // flush the data that is still pending because of write coalescing;
+        // give up if the process stops consuming the data
+        QProcess *const proc = qobject_cast<QProcess *>(mIO.get());
+        while (proc->bytesToWrite() > 0 && proc->waitForBytesWritten(releaseFlushTimeout)) {
+        }
+    }
     mIO->close();
 }
@@ -38,6 +38,8 @@ class QIODevice;
 namespace QGpgME
 {
 
+class JobThroughput;
+
 class QGPGME_EXPORT QByteArrayDataProvider : public GpgME::DataProvider
 {
 public:
@@ -50,6 +52,12 @@ public:
         return mArray;
     }
 
+    /**
+     * Reserves memory for at least \a size bytes, so that writing up to
+     * \a size bytes does not cause any reallocations.
+     */
+    void reserve(qint64 size);
+
 private:
     // these shall only be accessed through the dataprovider
     // interface, where they're public:
@@ -77,6 +85,100 @@ private:
 #endif
 };
 
+/**
+ * This read-only data provider serves the data of a byte array directly
+ * from the array's memory.
+ *
+ * The provider keeps a shallow copy of the byte array. Reading does not
+ * detach the array, i.e. the data is never copied, so that this provider
+ * is the cheapest way to pass in-memory input data to gpgme.
+ */
+class QGPGME_EXPORT QByteArrayReadOnlyDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit QByteArrayReadOnlyDataProvider(const QByteArray &data);
+    ~QByteArrayReadOnlyDataProvider() override;
+
+    const QByteArray &data() const
+    {
+        return mArray;
+    }
+
+private:
+    bool isSupported(Operation op) const override
+    {
+        return op != Operation::Write;
+    }
+#ifdef _WIN32
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override;
+    gpgme_ssize_t write(const void *buffer, size_t bufSize) override;
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override;
+#else
+    ssize_t read(void *buffer, size_t bufSize) override;
+    ssize_t write(const void *buffer, size_t bufSize) override;
+    off_t seek(off_t offset, int whence) override;
+#endif
+    void release() override;
+
+private:
+    const QByteArray mArray;
+#ifdef _WIN32
+    gpgme_off_t mOff;
+#else
+    off_t mOff;
+#endif
+};
+
+/**
+ * This data provider writes the data to a byte array owned by the caller.
+ *
+ * The byte array is cleared when the provider is created, but the memory
+ * allocated by the byte array is kept. If the same byte array is used for
+ * many operations, then it has to be reallocated only until it has grown to
+ * the size of the largest output. The byte array must outlive the provider.
+ */
+class QGPGME_EXPORT QByteArraySinkDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit QByteArraySinkDataProvider(QByteArray &array);
+    ~QByteArraySinkDataProvider() override;
+
+    const QByteArray &data() const
+    {
+        return mArray;
+    }
+
+    /**
+     * Reserves memory for at least \a size bytes, so that writing up to
+     * \a size bytes does not cause any reallocations.
+     */
+    void reserve(qint64 size);
+
+private:
+    bool isSupported(Operation) const override
+    {
+        return true;
+    }
+#ifdef _WIN32
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override;
+    gpgme_ssize_t write(const void *buffer, size_t bufSize) override;
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override;
+#else
+    ssize_t read(void *buffer, size_t bufSize) override;
+    ssize_t write(const void *buffer, size_t bufSize) override;
+    off_t seek(off_t offset, int whence) override;
+#endif
+    void release() override;
+
+private:
+    QByteArray &mArray;
+#ifdef _WIN32
+    gpgme_off_t mOff;
+#else
+    off_t mOff;
+#endif
+};
+
 class QGPGME_EXPORT QIODeviceDataProvider : public GpgME::DataProvider
 {
 public:
@@ -88,6 +190,38 @@ public:
         return mIO;
     }
 
+    /**
+     * Sets the number of bytes that are collected in the write buffer of
+     * a QProcess before they are flushed to the process.
+     *
+     * Writes to a QProcess are coalesced until at least \a bytes bytes are
+     * pending. A threshold of 0 flushes after every write. Defaults to
+     * 64 KiB. Has no effect for other IO devices.
+     */
+    void setWriteFlushThreshold(qint64 bytes);
+    qint64 writeFlushThreshold() const;
+
+    /**
+     * Sets the maximum number of bytes that may be pending in the write
+     * buffer of a QProcess.
+     *
+     * If the process does not consume the data fast enough, then write()
+     * blocks until the number of pending bytes has dropped to \a bytes or
+     * below, i.e. the amount of buffered data is always bounded. Defaults to
+     * 1 MiB. Has no effect for other IO devices.
+     */
+    void setMaxPendingWriteBytes(qint64 bytes);
+    qint64 maxPendingWriteBytes() const;
+
+    /**
+     * Sets the statistics that shall be fed by this data provider. The time
+     * spent in reading from the IO device is counted as waiting for input
+     * and the read bytes are counted as processed. The time spent in writing
+     * to the IO device is counted as waiting for output.
+     */
+    void setThroughput(const std::shared_ptr<JobThroughput> &throughput);
+    std::shared_ptr<JobThroughput> throughput() const;
+
 private:
     // these shall only be accessed through the dataprovider
     // interface, where they're public:
@@ -105,8 +239,8 @@ private:
 
 private:
     const std::shared_ptr<QIODevice> mIO;
-    bool mErrorOccurred : 1;
-    bool mHaveQProcess  : 1;
+    class Private;
+    std::unique_ptr<Private> d;
 };
 
 } // namespace QGpgME
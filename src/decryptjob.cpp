@@ -32,6 +32,9 @@
 */
 
 #include "decryptjob.h"
+#include "decryptjob_p.h"
+
+#include <gpgme++/decryptionresult.h>
 
 using namespace QGpgME;
 
@@ -40,6 +43,48 @@ DecryptJob::DecryptJob(QObject *parent)
 {
 }
 
+DecryptJob::DecryptJob(std::unique_ptr<DecryptJobPrivate> dd, QObject *parent)
+    : Job{std::move(dd), parent}
+{
+}
+
 DecryptJob::~DecryptJob() = default;
 
+void DecryptJob::setInputSizeHint(qint64 size)
+{
+    Q_D(DecryptJob);
+    Q_ASSERT(d && "This DecryptJob class has no DecryptJobPrivate class");
+    d->m_inputSizeHint = size;
+}
+
+qint64 DecryptJob::inputSizeHint() const
+{
+    Q_D(const DecryptJob);
+    return d ? d->m_inputSizeHint : 0;
+}
+
+void DecryptJob::setSessionKeyCache(const std::shared_ptr<SessionKeyCache> &cache)
+{
+    Q_D(DecryptJob);
+    Q_ASSERT(d && "This DecryptJob class has no DecryptJobPrivate class");
+    d->m_sessionKeyCache = cache;
+}
+
+std::shared_ptr<SessionKeyCache> DecryptJob::sessionKeyCache() const
+{
+    Q_D(const DecryptJob);
+    return d ? d->m_sessionKeyCache : std::shared_ptr<SessionKeyCache>{};
+}
+
+GpgME::DecryptionResult DecryptJob::exec(const QByteArray &cipherText, GpgME::DataProvider &plainText)
+{
+    Q_D(DecryptJob);
+    return d->exec(cipherText, plainText);
+}
+
+GpgME::DecryptionResult DecryptJobPrivate::exec(const QByteArray &, GpgME::DataProvider &)
+{
+    return GpgME::DecryptionResult{GpgME::Error::fromCode(GPG_ERR_NOT_IMPLEMENTED)};
+}
+
 #include "moc_decryptjob.cpp"
@@ -38,6 +38,9 @@
 #include "decryptverifyjob.h"
 #include "decryptverifyjob_p.h"
 
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/verificationresult.h>
+
 using namespace QGpgME;
 
 DecryptVerifyJob::DecryptVerifyJob(std::unique_ptr<DecryptVerifyJobPrivate> dd, QObject *parent)
@@ -59,6 +62,30 @@ bool DecryptVerifyJob::processAllSignatures() const
     return d->m_processAllSignatures;
 }
 
+void DecryptVerifyJob::setInputSizeHint(qint64 size)
+{
+    Q_D(DecryptVerifyJob);
+    d->m_inputSizeHint = size;
+}
+
+qint64 DecryptVerifyJob::inputSizeHint() const
+{
+    Q_D(const DecryptVerifyJob);
+    return d->m_inputSizeHint;
+}
+
+void DecryptVerifyJob::setSessionKeyCache(const std::shared_ptr<SessionKeyCache> &cache)
+{
+    Q_D(DecryptVerifyJob);
+    d->m_sessionKeyCache = cache;
+}
+
+std::shared_ptr<SessionKeyCache> DecryptVerifyJob::sessionKeyCache() const
+{
+    Q_D(const DecryptVerifyJob);
+    return d->m_sessionKeyCache;
+}
+
 void DecryptVerifyJob::setInputFile(const QString &path)
 {
     Q_D(DecryptVerifyJob);
@@ -83,4 +110,18 @@ QString DecryptVerifyJob::outputFile() const
     return d->m_outputFilePath;
 }
 
+std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
+DecryptVerifyJob::exec(const QByteArray &cipherText, GpgME::DataProvider &plainText)
+{
+    Q_D(DecryptVerifyJob);
+    return d->exec(cipherText, plainText);
+}
+
+std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
+DecryptVerifyJobPrivate::exec(const QByteArray &, GpgME::DataProvider &)
+{
+    const auto err = GpgME::Error::fromCode(GPG_ERR_NOT_IMPLEMENTED);
+    return {GpgME::DecryptionResult{err}, GpgME::VerificationResult{err}};
+}
+
 #include "moc_decryptverifyjob.cpp"
@@ -44,6 +44,7 @@ class QIODevice;
 
 namespace GpgME
 {
+class DataProvider;
 class Error;
 class DecryptionResult;
 class VerificationResult;
@@ -53,6 +54,7 @@ namespace QGpgME
 {
 
 class DecryptVerifyJobPrivate;
+class SessionKeyCache;
 
 /**
    @short An abstract base class for asynchronous combined decrypters and verifiers
@@ -97,6 +99,34 @@ public:
     void setProcessAllSignatures(bool processAll);
     bool processAllSignatures() const;
 
+    /**
+     * Sets the expected size of the input data in bytes.
+     *
+     * The size hint is passed to the backend, so that progress information
+     * has a known total even if the input is a sequential device (e.g. a pipe
+     * or a socket) whose size cannot be determined. It is also used to
+     * preallocate the output buffer if the result is returned as byte array.
+     *
+     * This is only used if one of the start() or exec() functions is used.
+     */
+    void setInputSizeHint(qint64 size);
+    qint64 inputSizeHint() const;
+
+    /**
+     * Sets a cache for the session keys of the decrypted messages. If a
+     * cache is set, then the session key of a message is exported when the
+     * message is decrypted for the first time, and the cached session key
+     * is used instead of the secret key the next time.
+     *
+     * This is only used if the cipher text is passed as byte array to
+     * start() or exec().
+     *
+     * \note Everybody who can access the process memory can decrypt the
+     * cached messages without the secret key.
+     */
+    void setSessionKeyCache(const std::shared_ptr<SessionKeyCache> &cache);
+    std::shared_ptr<SessionKeyCache> sessionKeyCache() const;
+
     /**
      * Sets the path of the file to decrypt (and verify).
      *
@@ -136,6 +166,19 @@ public:
     virtual std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
     exec(const QByteArray &cipherText, QByteArray &plainText) = 0;
 
+    /**
+     * Like exec, but writes the plaintext to \a plainText instead of
+     * returning it in a byte array.
+     *
+     * This allows writing the plaintext to a custom sink or reusing an
+     * output buffer for many operations, e.g. with a QByteArraySinkDataProvider.
+     *
+     * Returns errors with code GPG_ERR_NOT_IMPLEMENTED if the job doesn't
+     * support this.
+     */
+    std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
+    exec(const QByteArray &cipherText, GpgME::DataProvider &plainText);
+
 Q_SIGNALS:
     void result(const GpgME::DecryptionResult &decryptionresult,
                 const GpgME::VerificationResult &verificationresult,
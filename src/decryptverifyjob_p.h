@@ -36,15 +36,35 @@
 
 #include "job_p.h"
 
+#include <memory>
+#include <utility>
+
+namespace GpgME
+{
+class DataProvider;
+class DecryptionResult;
+class VerificationResult;
+}
+
 namespace QGpgME
 {
 
+class SessionKeyCache;
+
 class DecryptVerifyJobPrivate : public JobPrivate
 {
 public:
+    // used by start() functions
+    qint64 m_inputSizeHint = 0;
+    std::shared_ptr<SessionKeyCache> m_sessionKeyCache;
+
     QString m_inputFilePath;
     QString m_outputFilePath;
     bool m_processAllSignatures = false;
+
+    // used by exec() with a data provider
+    virtual std::pair<GpgME::DecryptionResult, GpgME::VerificationResult> exec(const QByteArray &cipherText,
+                                                                               GpgME::DataProvider &plainText);
 };
 
 }
@@ -0,0 +1,239 @@
+/*
+    directorywalker.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "directorywalker.h"
+
+#include "filetreefilter_p.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+
+#include <algorithm>
+
+using namespace QGpgME;
+
+namespace
+{
+struct Frame {
+    QString path;
+    QString canonicalPath;
+    std::unique_ptr<QDirIterator> it;
+    bool hasEntries = false;
+};
+}
+
+class DirectoryWalker::Private
+{
+public:
+    QString fileSystemPath(const QString &path) const
+    {
+        return baseDirectory.isEmpty() ? path : QDir{baseDirectory}.filePath(path);
+    }
+
+    // returns false if the directory must not be walked because it's part of a cycle
+    bool pushDirectory(const QString &path, const QFileInfo &fi)
+    {
+        Frame frame;
+        frame.path = path;
+        if (symlinkPolicy == FollowSymlinks) {
+            frame.canonicalPath = fi.canonicalFilePath();
+            const bool isCycle = std::any_of(stack.cbegin(), stack.cend(), [&frame](const auto &f) {
+                return f.canonicalPath == frame.canonicalPath;
+            });
+            if (isCycle) {
+                return false;
+            }
+        }
+        frame.it.reset(new QDirIterator{fi.filePath(), QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System});
+        stack.push_back(std::move(frame));
+        return true;
+    }
+
+    QString nextPath();
+
+    std::vector<QString> roots;
+    size_t nextRoot = 0;
+    QString baseDirectory;
+    SymlinkPolicy symlinkPolicy = KeepSymlinks;
+    _detail::FileTreeFilter filter;
+    std::vector<Frame> stack;
+    qint64 count = 0;
+};
+
+QString DirectoryWalker::Private::nextPath()
+{
+    while (true) {
+        if (stack.empty()) {
+            if (nextRoot >= roots.size()) {
+                return {};
+            }
+            const QString root = roots[nextRoot++];
+            if (root.isEmpty()) {
+                continue;
+            }
+            const QFileInfo fi{fileSystemPath(root)};
+            if (fi.isSymLink()) {
+                if (symlinkPolicy == SkipSymlinks) {
+                    continue;
+                }
+                if (symlinkPolicy == KeepSymlinks) {
+                    return root;
+                }
+            }
+            if (fi.isDir() && pushDirectory(root, fi)) {
+                continue;
+            }
+            // let gpgtar deal with files and with non-existing paths
+            return root;
+        }
+
+        Frame &frame = stack.back();
+        if (!frame.it->hasNext()) {
+            const bool isEmptyDirectory = !frame.hasEntries;
+            const QString path = frame.path;
+            stack.pop_back();
+            if (isEmptyDirectory) {
+                // return empty directories, so that they are added to the archive
+                return path;
+            }
+            continue;
+        }
+        frame.it->next();
+        frame.hasEntries = true;
+        const QFileInfo fi = frame.it->fileInfo();
+        const QString path = frame.path.endsWith(QLatin1Char('/')) ? frame.path + fi.fileName()
+                                                                   : frame.path + QLatin1Char('/') + fi.fileName();
+        if (fi.isSymLink()) {
+            if (symlinkPolicy == SkipSymlinks || !filter.isWanted(fi)) {
+                continue;
+            }
+            if (symlinkPolicy == FollowSymlinks && fi.isDir()) {
+                pushDirectory(path, fi);
+                continue;
+            }
+            return path;
+        }
+        if (!filter.isWanted(fi)) {
+            continue;
+        }
+        if (fi.isDir()) {
+            pushDirectory(path, fi);
+            continue;
+        }
+        if (fi.isFile()) {
+            return path;
+        }
+        // skip sockets, devices, etc.; gpgtar cannot archive them
+    }
+}
+
+DirectoryWalker::DirectoryWalker(const std::vector<QString> &paths)
+    : d{new Private}
+{
+    d->roots = paths;
+}
+
+DirectoryWalker::~DirectoryWalker() = default;
+
+void DirectoryWalker::setBaseDirectory(const QString &baseDirectory)
+{
+    d->baseDirectory = baseDirectory;
+}
+
+QString DirectoryWalker::baseDirectory() const
+{
+    return d->baseDirectory;
+}
+
+void DirectoryWalker::setSymlinkPolicy(SymlinkPolicy policy)
+{
+    d->symlinkPolicy = policy;
+}
+
+DirectoryWalker::SymlinkPolicy DirectoryWalker::symlinkPolicy() const
+{
+    return d->symlinkPolicy;
+}
+
+void DirectoryWalker::setNameFilters(const QStringList &nameFilters)
+{
+    d->filter.setNameFilters(nameFilters);
+}
+
+QStringList DirectoryWalker::nameFilters() const
+{
+    return d->filter.nameFilters();
+}
+
+void DirectoryWalker::setExcludeFilters(const QStringList &excludeFilters)
+{
+    d->filter.setExcludeFilters(excludeFilters);
+}
+
+QStringList DirectoryWalker::excludeFilters() const
+{
+    return d->filter.excludeFilters();
+}
+
+void DirectoryWalker::setIncludeHidden(bool includeHidden)
+{
+    d->filter.setIncludeHidden(includeHidden);
+}
+
+bool DirectoryWalker::includeHidden() const
+{
+    return d->filter.includeHidden();
+}
+
+void DirectoryWalker::setFilter(const std::function<bool(const QFileInfo &)> &filter)
+{
+    d->filter.setFilter(filter);
+}
+
+QString DirectoryWalker::next()
+{
+    const QString path = d->nextPath();
+    if (!path.isEmpty()) {
+        d->count++;
+    }
+    return path;
+}
+
+qint64 DirectoryWalker::count() const
+{
+    return d->count;
+}
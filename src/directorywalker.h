@@ -0,0 +1,144 @@
+/*
+    directorywalker.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_DIRECTORYWALKER_H__
+#define __QGPGME_DIRECTORYWALKER_H__
+
+#include "qgpgme_export.h"
+
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QFileInfo;
+
+namespace QGpgME
+{
+
+/**
+ * This class walks directory trees lazily, i.e. it reads the entries of a
+ * directory only when the walk reaches the directory. Only the iterators of
+ * the directories on the current path are kept in memory, so that the walk
+ * starts immediately and needs little memory even for directory trees with
+ * millions of files.
+ *
+ * The walker returns the paths of all files below the given paths, but not
+ * the paths of the directories, because gpgtar would otherwise add the
+ * complete content of the directories. The paths of empty directories are
+ * returned, so that they are added to an archive.
+ *
+ * Example for creating an encrypted archive of a huge directory tree:
+ * \code
+ * auto walker = std::make_shared<DirectoryWalker>(std::vector<QString>{QStringLiteral("Documents")});
+ * walker->setBaseDirectory(QDir::homePath());
+ * walker->setExcludeFilters({QStringLiteral("*.tmp"), QStringLiteral(".cache")});
+ * job->setBaseDirectory(QDir::homePath());
+ * job->setInputPathGenerator([walker]() { return walker->next(); });
+ * \endcode
+ */
+class QGPGME_EXPORT DirectoryWalker
+{
+public:
+    enum SymlinkPolicy {
+        SkipSymlinks,   ///< Symbolic links are ignored.
+        KeepSymlinks,   ///< Symbolic links are returned as they are. This is the default.
+        FollowSymlinks, ///< Symbolic links to directories are followed. Cycles are detected
+                        ///< and not followed. Symbolic links to files are returned as they are.
+    };
+
+    /**
+     * Creates a walker for the files and directories in \a paths. If a base
+     * directory is set, then relative paths are interpreted relative to the
+     * base directory. The returned paths start with the given paths.
+     */
+    explicit DirectoryWalker(const std::vector<QString> &paths);
+    ~DirectoryWalker();
+
+    DirectoryWalker(const DirectoryWalker &) = delete;
+    DirectoryWalker &operator=(const DirectoryWalker &) = delete;
+
+    void setBaseDirectory(const QString &baseDirectory);
+    QString baseDirectory() const;
+
+    void setSymlinkPolicy(SymlinkPolicy policy);
+    SymlinkPolicy symlinkPolicy() const;
+
+    /**
+     * Sets wildcard patterns, e.g. "*.txt", for the names of the files to
+     * return. If no name filters are set, then all files are returned.
+     * Directories are always walked.
+     */
+    void setNameFilters(const QStringList &nameFilters);
+    QStringList nameFilters() const;
+
+    /**
+     * Sets wildcard patterns for the names of the files and directories to
+     * skip. Excluded directories are not walked.
+     */
+    void setExcludeFilters(const QStringList &excludeFilters);
+    QStringList excludeFilters() const;
+
+    /**
+     * Sets whether hidden files and directories are returned respectively
+     * walked. Defaults to true.
+     */
+    void setIncludeHidden(bool includeHidden);
+    bool includeHidden() const;
+
+    /**
+     * Sets a function that decides whether a file is returned respectively
+     * whether a directory is walked. The function is called after the other
+     * filters have been applied.
+     */
+    void setFilter(const std::function<bool(const QFileInfo &)> &filter);
+
+    /**
+     * Returns the path of the next file. Returns an empty string if the walk
+     * is complete.
+     */
+    QString next();
+
+    /**
+     * Returns the number of paths returned by next() so far.
+     */
+    qint64 count() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_DIRECTORYWALKER_H__
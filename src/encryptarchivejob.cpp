@@ -80,6 +80,37 @@ std::vector<QString> EncryptArchiveJob::inputPaths() const
     return d->m_inputPaths;
 }
 
+void EncryptArchiveJob::setInputPathGenerator(const std::function<QString()> &generator)
+{
+    Q_D(EncryptArchiveJob);
+    d->m_inputPathGenerator = generator;
+}
+
+std::function<QString()> EncryptArchiveJob::inputPathGenerator() const
+{
+    Q_D(const EncryptArchiveJob);
+    return d->m_inputPathGenerator;
+}
+
+void EncryptArchiveJob::setInputSizeHint(qint64 fileCount, qint64 totalBytes)
+{
+    Q_D(EncryptArchiveJob);
+    d->m_inputFileCountHint = fileCount;
+    d->m_inputSizeHint = totalBytes;
+}
+
+qint64 EncryptArchiveJob::inputFileCountHint() const
+{
+    Q_D(const EncryptArchiveJob);
+    return d->m_inputFileCountHint;
+}
+
+qint64 EncryptArchiveJob::inputSizeHint() const
+{
+    Q_D(const EncryptArchiveJob);
+    return d->m_inputSizeHint;
+}
+
 void EncryptArchiveJob::setOutputFile(const QString &path)
 {
     Q_D(EncryptArchiveJob);
@@ -104,6 +135,24 @@ GpgME::Context::EncryptionFlags EncryptArchiveJob::encryptionFlags() const
     return d->m_encryptionFlags;
 }
 
+void EncryptArchiveJob::setDetectIncompressibleInput(bool detect)
+{
+    Q_D(EncryptArchiveJob);
+    d->m_detectIncompressibleInput = detect;
+}
+
+bool EncryptArchiveJob::detectIncompressibleInput() const
+{
+    Q_D(const EncryptArchiveJob);
+    return d->m_detectIncompressibleInput;
+}
+
+bool EncryptArchiveJob::incompressibleInputDetected() const
+{
+    Q_D(const EncryptArchiveJob);
+    return d->m_incompressibleInputDetected;
+}
+
 void EncryptArchiveJob::setBaseDirectory(const QString &baseDirectory)
 {
     Q_D(EncryptArchiveJob);
@@ -38,6 +38,8 @@
 
 #include <gpgme++/context.h>
 
+#include <functional>
+
 namespace GpgME
 {
 class Key;
@@ -80,6 +82,37 @@ public:
     void setInputPaths(const std::vector<QString> &paths);
     std::vector<QString> inputPaths() const;
 
+    /**
+     * Sets a function that returns the paths of the files and folders to put
+     * into the archive one by one. The function must return an empty string
+     * after the last path. If a generator is set, then the input paths are
+     * ignored.
+     *
+     * The paths are fetched while gpgtar reads them, i.e. the complete list of
+     * paths never needs to be held in memory. The function is called in the
+     * thread of the job.
+     *
+     * Used if the job is started with startIt().
+     *
+     * \sa DirectoryWalker
+     */
+    void setInputPathGenerator(const std::function<QString()> &generator);
+    std::function<QString()> inputPathGenerator() const;
+
+    /**
+     * Sets the number of files and the total size in bytes of the files that
+     * will be put into the archive, e.g. as determined by a FileTreeScanner.
+     *
+     * gpgtar knows the total number of files only after it has scanned all
+     * files. If a hint is set, then fileProgress() reports the hinted number
+     * of files as total during the scanning phase. The values reported by
+     * dataProgress() are scaled; they can be converted to bytes with the
+     * hinted total size.
+     */
+    void setInputSizeHint(qint64 fileCount, qint64 totalBytes);
+    qint64 inputFileCountHint() const;
+    qint64 inputSizeHint() const;
+
     /**
      * Sets the path of the file to write the created archive to.
      *
@@ -104,6 +137,30 @@ public:
     void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
     GpgME::Context::EncryptionFlags encryptionFlags() const;
 
+    /**
+     * Enables the detection of incompressible input.
+     *
+     * If enabled, then the job probes the beginning of the first few input
+     * files before it starts. If most of the probed data is in a compressed
+     * format (e.g. JPEG, ZIP or MP4) or looks random, then the \c NoCompress
+     * flag is added to the encryption flags, so that the backend doesn't
+     * waste time trying to compress it. The files are not probed if the
+     * paths are fetched with an input path generator.
+     *
+     * Defaults to false.
+     */
+    void setDetectIncompressibleInput(bool detect);
+    bool detectIncompressibleInput() const;
+
+    /**
+     * Returns true if the job detected incompressible input and disabled the
+     * compression. The files are probed in the job's thread; the value is
+     * valid when the job emits result().
+     *
+     * \sa setDetectIncompressibleInput
+     */
+    bool incompressibleInputDetected() const;
+
     /**
      * Sets the base directory for the relative paths of the input files and
      * the output file.
@@ -130,7 +187,8 @@ Q_SIGNALS:
      * This signal is emitted whenever gpgtar sends a progress status update for
      * the number of files. In the scanning phase (i.e. while gpgtar checks
      * which files to put into the archive), \a current is the current number of
-     * files and \a total is 0. In the writing phase, \a current is the number
+     * files and \a total is 0 (or the number of files set with
+     * setInputSizeHint()). In the writing phase, \a current is the number
      * of processed files and \a total is the total number of files.
      */
     void fileProgress(int current, int total);
@@ -0,0 +1,256 @@
+/*
+    encryptionrecipients.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "encryptionrecipients_p.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include <gpgme++/context.h>
+#include <gpgme++/key.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+namespace
+{
+// Returns a description of the state of the files in the GnuPG home
+// directory that affect the validity of keys. It changes if a key is
+// imported, updated, signed or deleted, or if the owner trust changes.
+QByteArray keyringState()
+{
+    const QDir homeDir{QFile::decodeName(GpgME::dirInfo("homedir"))};
+    QByteArray state;
+    // public-keys.d contains the keyring of keyboxd; tofu.db affects the
+    // validity of keys if the TOFU trust model is used
+    for (const auto fileName : {"pubring.kbx", "pubring.gpg", "public-keys.d/pubring.db", "public-keys.d/pubring.db-wal",
+                                "trustdb.gpg", "tofu.db", "trustlist.txt"}) {
+        const QFileInfo fi{homeDir.filePath(QLatin1String{fileName})};
+        state += QByteArray::number(fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : 0) + ','
+            + QByteArray::number(fi.size()) + ';';
+    }
+    return state;
+}
+
+bool isUsableSubkey(const Subkey &subkey)
+{
+    return subkey.canEncrypt() && !subkey.isRevoked() && !subkey.isExpired()
+        && !subkey.isDisabled() && !subkey.isInvalid();
+}
+
+bool isValidRecipient(const Key &key)
+{
+    if (key.isNull() || key.isRevoked() || key.isExpired() || key.isDisabled() || key.isInvalid()
+        || !key.canEncrypt()) {
+        return false;
+    }
+    for (const auto &uid : key.userIDs()) {
+        if (!uid.isRevoked() && !uid.isInvalid() && uid.validity() >= UserID::Full) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// the engine encrypts to the most recently created usable subkey
+QByteArray encryptionSubkeyFingerprint(const Key &key)
+{
+    Subkey newest;
+    for (const auto &subkey : key.subkeys()) {
+        if (isUsableSubkey(subkey) && (newest.isNull() || subkey.creationTime() > newest.creationTime())) {
+            newest = subkey;
+        }
+    }
+    return newest.isNull() ? QByteArray{} : QByteArray{newest.fingerprint()};
+}
+}
+
+class EncryptionRecipients::Private
+{
+public:
+    Private(Protocol protocol_, const std::vector<Key> &keys_)
+        : protocol{protocol_}
+    {
+        for (const auto &key : keys_) {
+            if (!key.isNull()) {
+                keys.push_back(key);
+            }
+        }
+        validatedKeys = keys;
+    }
+
+    Error validate();
+
+    const Protocol protocol;
+    std::vector<Key> keys;
+
+    mutable std::mutex mutex;
+    bool validated = false;
+    QByteArray validatedKeyringState;
+    std::vector<Key> validatedKeys;
+    std::vector<QByteArray> subkeyFingerprints;
+    bool allKeysValid = false;
+    Statistics stats;
+};
+
+Error EncryptionRecipients::Private::validate()
+{
+    const QByteArray state = keyringState();
+    if (validated && state == validatedKeyringState) {
+        stats.reuses++;
+        return {};
+    }
+
+    std::unique_ptr<Context> ctx{Context::createForProtocol(protocol)};
+    if (!ctx) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    ctx->setKeyListMode(Local | Validate);
+
+    std::vector<Key> newKeys;
+    std::vector<QByteArray> newSubkeyFingerprints;
+    bool newAllKeysValid = true;
+    for (const auto &key : keys) {
+        Error err;
+        const Key listedKey = key.primaryFingerprint() ? ctx->key(key.primaryFingerprint(), err, false) : Key{};
+        if (err.code() && err.code() != GPG_ERR_EOF) {
+            return err;
+        }
+        // a key that vanished from the keyring is passed on as is; the
+        // engine reports it as invalid recipient even with AlwaysTrust
+        newKeys.push_back(listedKey.isNull() ? key : listedKey);
+        newSubkeyFingerprints.push_back(listedKey.isNull() ? QByteArray{} : encryptionSubkeyFingerprint(listedKey));
+        newAllKeysValid = newAllKeysValid && isValidRecipient(listedKey);
+    }
+
+    validatedKeys = std::move(newKeys);
+    subkeyFingerprints = std::move(newSubkeyFingerprints);
+    allKeysValid = newAllKeysValid && !validatedKeys.empty();
+    validatedKeyringState = state;
+    validated = true;
+    stats.validations++;
+    return {};
+}
+
+EncryptionRecipients::EncryptionRecipients(Protocol protocol, const std::vector<Key> &keys)
+    : d{new Private{protocol, keys}}
+{
+}
+
+EncryptionRecipients::~EncryptionRecipients() = default;
+
+Protocol EncryptionRecipients::protocol() const
+{
+    return d->protocol;
+}
+
+std::vector<Key> EncryptionRecipients::keys() const
+{
+    return d->keys;
+}
+
+Error EncryptionRecipients::validate()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->validate();
+}
+
+void EncryptionRecipients::invalidate()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->validated = false;
+}
+
+std::vector<Key> EncryptionRecipients::validatedKeys() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->validatedKeys;
+}
+
+std::vector<Key> EncryptionRecipients::invalidKeys() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    std::vector<Key> result;
+    if (d->validated) {
+        for (const auto &key : d->validatedKeys) {
+            if (!isValidRecipient(key)) {
+                result.push_back(key);
+            }
+        }
+    }
+    return result;
+}
+
+bool EncryptionRecipients::allKeysValid() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->validated && d->allKeysValid;
+}
+
+std::vector<QByteArray> EncryptionRecipients::encryptionSubkeyFingerprints() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->subkeyFingerprints;
+}
+
+EncryptionRecipients::Statistics EncryptionRecipients::statistics() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->stats;
+}
+
+void _detail::useEncryptionRecipients(EncryptionRecipients *recipients, std::vector<Key> &keys,
+                                      Context::EncryptionFlags &flags)
+{
+    if (!recipients) {
+        return;
+    }
+    if (recipients->validate()) {
+        // the keys cannot be listed; let the engine validate them
+        keys = recipients->keys();
+        return;
+    }
+    keys = recipients->validatedKeys();
+    // check the keys instead of asking for allKeysValid() because another
+    // thread may have validated them again in between
+    if (!keys.empty() && std::all_of(keys.cbegin(), keys.cend(), isValidRecipient)) {
+        flags = static_cast<Context::EncryptionFlags>(flags | Context::AlwaysTrust);
+    }
+}
@@ -0,0 +1,150 @@
+/*
+    encryptionrecipients.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_ENCRYPTIONRECIPIENTS_H__
+#define __QGPGME_ENCRYPTIONRECIPIENTS_H__
+
+#include "qgpgme_export.h"
+
+#include <QByteArray>
+
+#include <gpgme++/global.h>
+
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+class Error;
+class Key;
+}
+
+namespace QGpgME
+{
+
+/**
+ * A set of recipients that is resolved and validated once and can be used
+ * by many encrypt and sign-encrypt jobs.
+ *
+ * Normally, the engine looks up and validates the recipients every time a
+ * message is encrypted, which includes computing the validity of the keys
+ * from the trust database. If an EncryptionRecipients object is set for an
+ * EncryptJob or a SignEncryptJob, then the keys are listed with their
+ * validity once by validate(), and the jobs encrypt with the \c AlwaysTrust
+ * flag if all keys are valid, so that the engine skips the validation.
+ * If some keys are not valid, then the jobs leave the validation to the
+ * engine, which rejects the invalid keys as usual.
+ *
+ * The keys are validated again only if the keyring or the trust database
+ * changed since the last validation, or after invalidate() was called.
+ *
+ * All functions are thread-safe.
+ */
+class QGPGME_EXPORT EncryptionRecipients
+{
+public:
+    struct Statistics {
+        /** Number of times the keys were listed and validated. */
+        quint64 validations = 0;
+        /** Number of times the result of the last validation was used. */
+        quint64 reuses = 0;
+    };
+
+    /**
+     * Creates a set of the recipients \a keys for the protocol \a protocol.
+     * Null keys are ignored.
+     */
+    EncryptionRecipients(GpgME::Protocol protocol, const std::vector<GpgME::Key> &keys);
+    ~EncryptionRecipients();
+
+    EncryptionRecipients(const EncryptionRecipients &) = delete;
+    EncryptionRecipients &operator=(const EncryptionRecipients &) = delete;
+
+    GpgME::Protocol protocol() const;
+
+    /**
+     * Returns the keys as passed to the constructor.
+     */
+    std::vector<GpgME::Key> keys() const;
+
+    /**
+     * Lists the keys with their validity unless they have already been
+     * validated and the keyring and the trust database haven't changed
+     * since. Returns an error if the keys could not be listed.
+     *
+     * The jobs call this when they are started. Call it in advance to
+     * avoid the key listing when the first job is started.
+     */
+    GpgME::Error validate();
+
+    /**
+     * Forces the keys to be validated again the next time they are used,
+     * e.g. after a change of the keyring that cannot be detected from the
+     * files in the GnuPG home directory.
+     */
+    void invalidate();
+
+    /**
+     * Returns the listed keys. Returns the keys as passed to the
+     * constructor if they haven't been validated yet.
+     */
+    std::vector<GpgME::Key> validatedKeys() const;
+
+    /**
+     * Returns the keys that are not usable for encryption, e.g. because they
+     * are revoked or expired, or because none of their user IDs is valid.
+     */
+    std::vector<GpgME::Key> invalidKeys() const;
+
+    /**
+     * Returns true if the keys have been validated and all of them can be
+     * used for encryption.
+     */
+    bool allKeysValid() const;
+
+    /**
+     * Returns the fingerprints of the subkeys the engine will encrypt to,
+     * in the order of validatedKeys(). The fingerprint is empty for keys
+     * without a usable encryption subkey.
+     */
+    std::vector<QByteArray> encryptionSubkeyFingerprints() const;
+
+    Statistics statistics() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_ENCRYPTIONRECIPIENTS_H__
@@ -38,6 +38,8 @@
 #include "encryptjob.h"
 #include "encryptjob_p.h"
 
+#include <gpgme++/encryptionresult.h>
+
 using namespace QGpgME;
 
 EncryptJob::EncryptJob(std::unique_ptr<EncryptJobPrivate> dd, QObject *parent)
@@ -71,6 +73,18 @@ GpgME::Data::Encoding EncryptJob::inputEncoding() const
     return d->m_inputEncoding;
 }
 
+void EncryptJob::setInputSizeHint(qint64 size)
+{
+    Q_D(EncryptJob);
+    d->m_inputSizeHint = size;
+}
+
+qint64 EncryptJob::inputSizeHint() const
+{
+    Q_D(const EncryptJob);
+    return d->m_inputSizeHint;
+}
+
 void EncryptJob::setRecipients(const std::vector<GpgME::Key> &recipients)
 {
     Q_D(EncryptJob);
@@ -119,4 +133,47 @@ GpgME::Context::EncryptionFlags EncryptJob::encryptionFlags() const
     return d->m_encryptionFlags;
 }
 
+void EncryptJob::setDetectIncompressibleInput(bool detect)
+{
+    Q_D(EncryptJob);
+    d->m_detectIncompressibleInput = detect;
+}
+
+bool EncryptJob::detectIncompressibleInput() const
+{
+    Q_D(const EncryptJob);
+    return d->m_detectIncompressibleInput;
+}
+
+bool EncryptJob::incompressibleInputDetected() const
+{
+    Q_D(const EncryptJob);
+    return d->m_incompressibleInputDetected;
+}
+
+void EncryptJob::setEncryptionRecipients(const std::shared_ptr<EncryptionRecipients> &recipients)
+{
+    Q_D(EncryptJob);
+    d->m_encryptionRecipients = recipients;
+}
+
+std::shared_ptr<EncryptionRecipients> EncryptJob::encryptionRecipients() const
+{
+    Q_D(const EncryptJob);
+    return d->m_encryptionRecipients;
+}
+
+GpgME::EncryptionResult EncryptJob::exec(const std::vector<GpgME::Key> &recipients, const QByteArray &plainText,
+                                         const GpgME::Context::EncryptionFlags flags, GpgME::DataProvider &cipherText)
+{
+    Q_D(EncryptJob);
+    return d->exec(recipients, plainText, flags, cipherText);
+}
+
+GpgME::EncryptionResult EncryptJobPrivate::exec(const std::vector<GpgME::Key> &, const QByteArray &,
+                                                GpgME::Context::EncryptionFlags, GpgME::DataProvider &)
+{
+    return GpgME::EncryptionResult{GpgME::Error::fromCode(GPG_ERR_NOT_IMPLEMENTED)};
+}
+
 #include "moc_encryptjob.cpp"
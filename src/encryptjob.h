@@ -50,6 +50,7 @@ class QIODevice;
 
 namespace GpgME
 {
+class DataProvider;
 class Error;
 class Key;
 class EncryptionResult;
@@ -58,6 +59,7 @@ class EncryptionResult;
 namespace QGpgME
 {
 
+class EncryptionRecipients;
 class EncryptJobPrivate;
 
 /**
@@ -106,6 +108,19 @@ public:
     void setInputEncoding(GpgME::Data::Encoding);
     GpgME::Data::Encoding inputEncoding() const;
 
+    /**
+     * Sets the expected size of the input data in bytes.
+     *
+     * The size hint is passed to the backend, so that progress information
+     * has a known total even if the input is a sequential device (e.g. a pipe
+     * or a socket) whose size cannot be determined. It is also used to
+     * preallocate the output buffer if the result is returned as byte array.
+     *
+     * This is only used if one of the start() or exec() functions is used.
+     */
+    void setInputSizeHint(qint64 size);
+    qint64 inputSizeHint() const;
+
     /**
      * Sets the keys to use for encryption.
      *
@@ -145,6 +160,42 @@ public:
     void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
     GpgME::Context::EncryptionFlags encryptionFlags() const;
 
+    /**
+     * Enables the detection of incompressible input.
+     *
+     * If enabled, then the job probes the beginning of the input before it
+     * starts. If the input starts with the signature of a compressed format
+     * (e.g. JPEG, ZIP or MP4) or if it looks random (e.g. because it is
+     * encrypted), then the \c NoCompress flag is added to the encryption
+     * flags, so that the backend doesn't waste time trying to compress it.
+     * Input from sequential devices is not probed.
+     *
+     * Defaults to false.
+     */
+    void setDetectIncompressibleInput(bool detect);
+    bool detectIncompressibleInput() const;
+
+    /**
+     * Returns true if the job detected incompressible input and disabled the
+     * compression. The input is probed in the job's thread; the value is
+     * valid when the job emits result() or when exec() returns.
+     *
+     * \sa setDetectIncompressibleInput
+     */
+    bool incompressibleInputDetected() const;
+
+    /**
+     * Sets a set of recipients that is validated once and shared by many
+     * jobs. If it is set, then the validated keys of \a recipients are used
+     * instead of the recipients passed to start() or exec() or set with
+     * setRecipients(), and the \c AlwaysTrust flag is added if all of them
+     * are valid.
+     *
+     * \sa EncryptionRecipients
+     */
+    void setEncryptionRecipients(const std::shared_ptr<EncryptionRecipients> &recipients);
+    std::shared_ptr<EncryptionRecipients> encryptionRecipients() const;
+
     /**
        Starts the encryption operation. \a recipients is the a list of
        keys to encrypt \a plainText to. Empty (null) keys are
@@ -191,6 +242,21 @@ public:
     virtual GpgME::EncryptionResult exec(const std::vector<GpgME::Key> &recipients,
                                          const QByteArray &plainText,
                                          const GpgME::Context::EncryptionFlags flags, QByteArray &cipherText) = 0;
+
+    /**
+     * Like exec, but writes the ciphertext to \a cipherText instead of
+     * returning it in a byte array.
+     *
+     * This allows writing the ciphertext to a custom sink or reusing an
+     * output buffer for many operations, e.g. with a QByteArraySinkDataProvider.
+     *
+     * Returns an error with code GPG_ERR_NOT_IMPLEMENTED if the job doesn't
+     * support this.
+     */
+    GpgME::EncryptionResult exec(const std::vector<GpgME::Key> &recipients,
+                                 const QByteArray &plainText,
+                                 const GpgME::Context::EncryptionFlags flags,
+                                 GpgME::DataProvider &cipherText);
 Q_SIGNALS:
     void result(const GpgME::EncryptionResult &result, const QByteArray &cipherText, const QString &auditLogAsHtml = QString(), const GpgME::Error &auditLogError = GpgME::Error());
 
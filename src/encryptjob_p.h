@@ -39,21 +39,41 @@
 #include <gpgme++/data.h>
 #include <gpgme++/key.h>
 
+#include <atomic>
+#include <memory>
+
+namespace GpgME
+{
+class DataProvider;
+class EncryptionResult;
+}
+
 namespace QGpgME
 {
 
+class EncryptionRecipients;
+
 class EncryptJobPrivate : public JobPrivate
 {
 public:
     // used by start() functions
     QString m_fileName;
     GpgME::Data::Encoding m_inputEncoding;
+    qint64 m_inputSizeHint = 0;
 
     // used by startIt()
     std::vector<GpgME::Key> m_recipients;
     QString m_inputFilePath;
     QString m_outputFilePath;
     GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::EncryptFile;
+    bool m_detectIncompressibleInput = false;
+    // set in the job's thread
+    std::atomic<bool> m_incompressibleInputDetected{false};
+    std::shared_ptr<EncryptionRecipients> m_encryptionRecipients;
+
+    // used by exec() with a data provider
+    virtual GpgME::EncryptionResult exec(const std::vector<GpgME::Key> &recipients, const QByteArray &plainText,
+                                         GpgME::Context::EncryptionFlags flags, GpgME::DataProvider &cipherText);
 };
 
 }
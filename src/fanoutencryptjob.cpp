@@ -0,0 +1,292 @@
+/*
+    fanoutencryptjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "fanoutencryptjob.h"
+
+#include "batchjob_p.h"
+#include "compressionprobe_p.h"
+#include "dataprovider.h"
+
+#include <QFile>
+
+#include <gpgme++/data.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+
+#include <atomic>
+#include <mutex>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::FanOutEncryptJobPrivate : public BatchJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(FanOutEncryptJob)
+
+    explicit FanOutEncryptJobPrivate(GpgME::Protocol protocol)
+        : BatchJobPrivate{protocol}
+    {
+    }
+
+    ~FanOutEncryptJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+    void emitResult() override;
+
+    GpgME::Error mapInputFile();
+    void prepareInput();
+
+    std::vector<GpgME::Key> m_recipients;
+    QByteArray m_plainText;
+    QString m_inputFilePath;
+    FanOutEncryptJob::CipherTextSink m_cipherTextSink;
+    GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::None;
+    bool m_armor = false;
+    bool m_detectIncompressibleInput = false;
+    std::atomic<bool> m_incompressibleInputDetected{false};
+    // the plain text shared by the worker threads; refers to the memory of
+    // m_inputFile if the input file is mapped into memory
+    QByteArray m_input;
+    std::unique_ptr<QFile> m_inputFile;
+    // the input is prepared once by the first worker thread
+    std::once_flag m_inputPrepared;
+    GpgME::Error m_inputError;
+    GpgME::Context::EncryptionFlags m_flags = GpgME::Context::None;
+    std::vector<GpgME::EncryptionResult> m_results;
+    std::vector<QByteArray> m_cipherTexts;
+};
+
+static EncryptionResult encrypt_for_recipient(Context *ctx,
+                                              const Key &recipient,
+                                              const QByteArray &plainText,
+                                              Context::EncryptionFlags flags,
+                                              const FanOutEncryptJob::CipherTextSink &sink,
+                                              int index,
+                                              QByteArray &cipherText)
+{
+    if (!ctx) {
+        return EncryptionResult{Error::fromCode(GPG_ERR_NOT_SUPPORTED)};
+    }
+    const std::vector<Key> recipients{recipient};
+    QGpgME::QByteArrayReadOnlyDataProvider in{plainText};
+    Data indata{&in};
+
+    const auto sinkProvider = sink ? sink(index) : std::unique_ptr<DataProvider>{};
+    if (sinkProvider) {
+        Data outdata{sinkProvider.get()};
+        return ctx->encrypt(recipients, indata, outdata, flags);
+    }
+
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(plainText.size() + 1024);
+    Data outdata{&out};
+    const auto result = ctx->encrypt(recipients, indata, outdata, flags);
+    if (!result.error().code()) {
+        cipherText = out.data();
+    }
+    return result;
+}
+
+GpgME::Error FanOutEncryptJobPrivate::mapInputFile()
+{
+    m_inputFile = std::make_unique<QFile>(m_inputFilePath);
+    if (!m_inputFile->open(QIODevice::ReadOnly)) {
+        return Error::fromCode(m_inputFile->exists() ? GPG_ERR_EACCES : GPG_ERR_ENOENT);
+    }
+    const qint64 size = m_inputFile->size();
+    // empty files and files on some file systems cannot be mapped
+    uchar *data = size > 0 ? m_inputFile->map(0, size) : nullptr;
+    if (data) {
+        m_input = QByteArray::fromRawData(reinterpret_cast<const char *>(data), size);
+    } else {
+        m_input = m_inputFile->readAll();
+        m_inputFile.reset();
+        if (m_input.size() != size) {
+            m_input = QByteArray{};
+            return Error::fromCode(GPG_ERR_EIO);
+        }
+    }
+    return {};
+}
+
+void FanOutEncryptJobPrivate::prepareInput()
+{
+    if (m_inputFilePath.isEmpty()) {
+        m_input = m_plainText;
+    } else if ((m_inputError = mapInputFile())) {
+        return;
+    }
+    // the input is the same for all recipients, so it is probed only once
+    m_flags = _detail::disableCompressionIfIncompressible(m_encryptionFlags, m_detectIncompressibleInput, m_incompressibleInputDetected, [this]() {
+        return _detail::looksIncompressible(m_input);
+    });
+}
+
+GpgME::Error FanOutEncryptJobPrivate::startIt()
+{
+    if (m_recipients.empty()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    for (const auto &recipient : m_recipients) {
+        if (recipient.isNull()) {
+            return Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+    }
+
+    m_results = _detail::canceledResults<EncryptionResult>(m_recipients.size());
+    m_cipherTexts = std::vector<QByteArray>(m_recipients.size());
+    const bool armor = m_armor;
+    return startItems(m_recipients.size(), [armor](Context *ctx) {
+        ctx->setArmor(armor);
+        return Error{};
+    }, [this](Context *ctx, size_t index) {
+        // map and probe the input off the caller's thread; the other workers
+        // wait until it's done
+        std::call_once(m_inputPrepared, [this]() {
+            prepareInput();
+        });
+        if (m_inputError) {
+            m_results[index] = EncryptionResult{m_inputError};
+            return m_inputError;
+        }
+        m_results[index] = encrypt_for_recipient(ctx, m_recipients[index], m_input, m_flags, m_cipherTextSink,
+                                                 static_cast<int>(index), m_cipherTexts[index]);
+        return m_results[index].error();
+    });
+}
+
+void FanOutEncryptJobPrivate::emitResult()
+{
+    Q_Q(FanOutEncryptJob);
+    // release the mapped input file before the result is handled
+    m_input = QByteArray{};
+    m_inputFile.reset();
+    Q_EMIT q->result(resultError(), m_results, m_cipherTexts);
+}
+
+FanOutEncryptJob::FanOutEncryptJob(GpgME::Protocol protocol)
+    : BatchJob{std::unique_ptr<FanOutEncryptJobPrivate>(new FanOutEncryptJobPrivate{protocol}), nullptr}
+{
+}
+
+FanOutEncryptJob::~FanOutEncryptJob() = default;
+
+void FanOutEncryptJob::setRecipients(const std::vector<GpgME::Key> &recipients)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_recipients = recipients;
+}
+
+std::vector<GpgME::Key> FanOutEncryptJob::recipients() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_recipients;
+}
+
+void FanOutEncryptJob::setPlainText(const QByteArray &plainText)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_plainText = plainText;
+}
+
+QByteArray FanOutEncryptJob::plainText() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_plainText;
+}
+
+void FanOutEncryptJob::setInputFile(const QString &path)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_inputFilePath = path;
+}
+
+QString FanOutEncryptJob::inputFile() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_inputFilePath;
+}
+
+void FanOutEncryptJob::setCipherTextSink(const CipherTextSink &sink)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_cipherTextSink = sink;
+}
+
+void FanOutEncryptJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_encryptionFlags = flags;
+}
+
+GpgME::Context::EncryptionFlags FanOutEncryptJob::encryptionFlags() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_encryptionFlags;
+}
+
+void FanOutEncryptJob::setArmor(bool armor)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_armor = armor;
+}
+
+bool FanOutEncryptJob::armor() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_armor;
+}
+
+void FanOutEncryptJob::setDetectIncompressibleInput(bool detect)
+{
+    Q_D(FanOutEncryptJob);
+    d->m_detectIncompressibleInput = detect;
+}
+
+bool FanOutEncryptJob::detectIncompressibleInput() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_detectIncompressibleInput;
+}
+
+bool FanOutEncryptJob::incompressibleInputDetected() const
+{
+    Q_D(const FanOutEncryptJob);
+    return d->m_incompressibleInputDetected;
+}
+
+#include "moc_fanoutencryptjob.cpp"
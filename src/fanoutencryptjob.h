@@ -0,0 +1,153 @@
+/*
+    fanoutencryptjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_FANOUTENCRYPTJOB_H__
+#define __QGPGME_FANOUTENCRYPTJOB_H__
+
+#include "batchjob.h"
+
+#include <gpgme++/context.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+class DataProvider;
+class EncryptionResult;
+class Key;
+}
+
+namespace QGpgME
+{
+
+class FanOutEncryptJobPrivate;
+
+/**
+ * This job encrypts one message individually for each of many recipients,
+ * e.g. a document that must be sent to every recipient as separately
+ * encrypted copy.
+ *
+ * The plain text is read only once; it is shared by all worker threads.
+ * If the plain text is read from a file, then the file is mapped into
+ * memory instead of being copied. The file is opened by the first worker
+ * thread; if it cannot be read, then the encryption fails for all
+ * recipients with the read error.
+ *
+ * The result() signal passes one encryption result and one cipher text per
+ * recipient in the order of the recipients. The cipher texts that are
+ * written to a sink (see setCipherTextSink()) are empty. The error passed to
+ * result() is the error of the first recipient for whom the message could
+ * not be encrypted, or \c GPG_ERR_CANCELED if the job was canceled.
+ */
+class QGPGME_EXPORT FanOutEncryptJob : public BatchJob
+{
+    Q_OBJECT
+public:
+    /**
+     * Returns the data provider to write the cipher text for the recipient
+     * with the index \a index to, or nullptr to pass the cipher text to
+     * result(). The job destroys the data provider after the encryption
+     * for this recipient.
+     * \note The function is called in the worker threads.
+     */
+    using CipherTextSink = std::function<std::unique_ptr<GpgME::DataProvider>(int index)>;
+
+    explicit FanOutEncryptJob(GpgME::Protocol protocol = GpgME::OpenPGP);
+    ~FanOutEncryptJob() override;
+
+    /**
+     * Sets the keys to encrypt the message for. One cipher text is created
+     * for each key.
+     */
+    void setRecipients(const std::vector<GpgME::Key> &recipients);
+    std::vector<GpgME::Key> recipients() const;
+
+    /**
+     * Sets the message to encrypt.
+     */
+    void setPlainText(const QByteArray &plainText);
+    QByteArray plainText() const;
+
+    /**
+     * Sets the path of the file to encrypt. If set, then the file is used
+     * instead of the plain text set with setPlainText().
+     */
+    void setInputFile(const QString &path);
+    QString inputFile() const;
+
+    /**
+     * Sets the function that provides the sinks for the cipher texts.
+     */
+    void setCipherTextSink(const CipherTextSink &sink);
+
+    /**
+     * Sets the flags to use for encryption.
+     */
+    void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
+    GpgME::Context::EncryptionFlags encryptionFlags() const;
+
+    /**
+     * Sets whether the output shall be ASCII armored. Defaults to \c false.
+     */
+    void setArmor(bool armor);
+    bool armor() const;
+
+    /**
+     * Enables the detection of incompressible input. If enabled, then the
+     * plain text is probed once by the first worker thread, and the \c NoCompress
+     * flag is added if it looks already compressed or random.
+     *
+     * Defaults to false.
+     */
+    void setDetectIncompressibleInput(bool detect);
+    bool detectIncompressibleInput() const;
+
+    /**
+     * Returns true if the job detected incompressible input and disabled the
+     * compression. The value is set before the first message is encrypted.
+     */
+    bool incompressibleInputDetected() const;
+
+Q_SIGNALS:
+    void result(const GpgME::Error &error,
+                const std::vector<GpgME::EncryptionResult> &results,
+                const std::vector<QByteArray> &cipherTexts);
+
+private:
+    Q_DECLARE_PRIVATE(FanOutEncryptJob)
+};
+
+}
+
+#endif // __QGPGME_FANOUTENCRYPTJOB_H__
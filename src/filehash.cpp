@@ -0,0 +1,146 @@
+/*
+    filehash.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "filehash_p.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <thread>
+
+using namespace QGpgME;
+
+namespace
+{
+// files smaller than this are read; mapping them is not worth it
+static const qint64 minMappedFileSize = 1024 * 1024;
+// the size of the parts of a file that are mapped at a time; this limits
+// the address space used by many threads hashing large files
+static const qint64 mapChunkSize = 64 * 1024 * 1024;
+
+bool isCanceled(const std::atomic<bool> *canceled)
+{
+    return canceled && *canceled;
+}
+
+void addData(QCryptographicHash &hash, const char *data, qint64 size)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(QByteArrayView{data, static_cast<qsizetype>(size)});
+#else
+    hash.addData(data, static_cast<int>(size));
+#endif
+}
+}
+
+_detail::FileHash _detail::hashFile(const QString &fileName,
+                                    QCryptographicHash::Algorithm algorithm,
+                                    const std::atomic<bool> *canceled)
+{
+    QFile file{fileName};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash{algorithm};
+
+    qint64 offset = 0;
+    const qint64 size = file.size();
+    if (size >= minMappedFileSize && !file.isSequential()) {
+        while (offset < size) {
+            if (isCanceled(canceled)) {
+                return {};
+            }
+            const qint64 length = std::min(mapChunkSize, size - offset);
+            uchar *data = file.map(offset, length);
+            if (!data) {
+                // read the rest of the file
+                break;
+            }
+            addData(hash, reinterpret_cast<const char *>(data), length);
+            file.unmap(data);
+            offset += length;
+        }
+    }
+
+    if (offset > 0 && !file.seek(offset)) {
+        return {};
+    }
+    QByteArray buffer(256 * 1024, Qt::Uninitialized);
+    qint64 numRead;
+    while ((numRead = file.read(buffer.data(), buffer.size())) > 0) {
+        if (isCanceled(canceled)) {
+            return {};
+        }
+        addData(hash, buffer.constData(), numRead);
+        offset += numRead;
+    }
+    if (numRead < 0) {
+        return {};
+    }
+    return {hash.result().toHex(), offset};
+}
+
+std::vector<_detail::FileHash> _detail::hashFiles(const std::vector<QString> &fileNames,
+                                                  QCryptographicHash::Algorithm algorithm,
+                                                  int threadCount,
+                                                  const std::atomic<bool> *canceled,
+                                                  const std::function<void(size_t)> &progress)
+{
+    std::vector<FileHash> result(fileNames.size());
+    std::atomic<size_t> nextIndex{0};
+    std::atomic<size_t> hashedFiles{0};
+    const auto work = [&]() {
+        for (size_t i = nextIndex++; i < fileNames.size() && !isCanceled(canceled); i = nextIndex++) {
+            result[i] = hashFile(fileNames[i], algorithm, canceled);
+            const size_t n = ++hashedFiles;
+            if (progress) {
+                progress(n);
+            }
+        }
+    };
+
+    const size_t numThreads = std::min<size_t>(std::max(threadCount, 1), std::max<size_t>(fileNames.size(), 1));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return result;
+}
@@ -0,0 +1,77 @@
+/*
+    filehash_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_FILEHASH_P_H__
+#define __QGPGME_FILEHASH_P_H__
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QString>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace QGpgME
+{
+namespace _detail
+{
+
+struct FileHash {
+    // the checksum in hex; empty if the file cannot be read
+    QByteArray checksum;
+    // the number of bytes that were hashed, which may differ from the
+    // current size of the file if it was changed in the meantime
+    qint64 size = 0;
+};
+
+// Returns the checksum of the file or an empty checksum if the file cannot
+// be read or if canceled is set. Large files are mapped into memory in
+// chunks instead of being copied into a buffer.
+FileHash hashFile(const QString &fileName,
+                  QCryptographicHash::Algorithm algorithm,
+                  const std::atomic<bool> *canceled = nullptr);
+
+// Computes the checksums of the files with up to threadCount threads. The
+// result has an empty checksum for files that cannot be read. progress(n) is
+// called in the hashing threads after each file with the number of files
+// hashed so far. Blocks until all files have been hashed or canceled is set.
+std::vector<FileHash> hashFiles(const std::vector<QString> &fileNames,
+                                QCryptographicHash::Algorithm algorithm,
+                                int threadCount,
+                                const std::atomic<bool> *canceled = nullptr,
+                                const std::function<void(size_t)> &progress = {});
+
+}
+}
+
+#endif // __QGPGME_FILEHASH_P_H__
@@ -43,6 +43,8 @@
 
 #include <gpgme++/error.h>
 
+#include <algorithm>
+#include <cstring>
 #include <numeric>
 
 using namespace QGpgME;
@@ -69,11 +71,102 @@ static QByteArray encodeFilenames(const std::vector<QString> &filenames)
     return ret;
 }
 
+namespace
+{
+// Provides the filenames fetched from a generator. The generator state is
+// kept here instead of in FileListDataProvider to keep the layout of the
+// exported class unchanged.
+class GeneratorDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit GeneratorDataProvider(const std::function<QString()> &generator)
+        : mGenerator{generator}
+    {
+    }
+
+    bool isSupported(Operation op) const override
+    {
+        return op != Operation::Write;
+    }
+
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override
+    {
+        if (bufSize == 0) {
+            return 0;
+        }
+        if (!buffer) {
+            Error::setSystemError(GPG_ERR_EINVAL);
+            return -1;
+        }
+        char *out = static_cast<char *>(buffer);
+        size_t numRead = 0;
+        while (numRead < bufSize) {
+            if (mPendingOffset >= mPending.size()) {
+                if (!mGenerator) {
+                    break;
+                }
+                const QString filename = mGenerator();
+                if (filename.isEmpty()) {
+                    // the generator is exhausted; drop it to free its resources
+                    mGenerator = {};
+                    break;
+                }
+                mPending.clear();
+                if (mOffset + static_cast<qint64>(numRead) > 0) {
+                    mPending += '\0';
+                }
+                mPending += filename.toUtf8();
+                mPendingOffset = 0;
+            }
+            const size_t amount = std::min(bufSize - numRead, static_cast<size_t>(mPending.size() - mPendingOffset));
+            memcpy(out + numRead, mPending.constData() + mPendingOffset, amount);
+            mPendingOffset += amount;
+            numRead += amount;
+        }
+        mOffset += numRead;
+        return numRead;
+    }
+
+    gpgme_ssize_t write(const void *, size_t) override
+    {
+        Error::setSystemError(GPG_ERR_EBADF);
+        return -1;
+    }
+
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override
+    {
+        // the filenames are generated on the fly; allow only no-op seeks
+        if ((whence == SEEK_CUR && offset == 0) || (whence == SEEK_SET && offset == mOffset)) {
+            return mOffset;
+        }
+        Error::setSystemError(GPG_ERR_ESPIPE);
+        return (gpgme_off_t) -1;
+    }
+
+    void release() override
+    {
+        mGenerator = {};
+        mPending.clear();
+    }
+
+private:
+    std::function<QString()> mGenerator;
+    QByteArray mPending;
+    qint64 mPendingOffset = 0;
+    qint64 mOffset = 0;
+};
+}
+
 FileListDataProvider::FileListDataProvider(const std::vector<QString> &filenames)
     : mProvider{new QByteArrayDataProvider{encodeFilenames(filenames)}}
 {
 }
 
+FileListDataProvider::FileListDataProvider(const std::function<QString()> &generator)
+    : mProvider{new GeneratorDataProvider{generator}}
+{
+}
+
 FileListDataProvider::~FileListDataProvider() = default;
 
 gpgme_ssize_t FileListDataProvider::read(void* buffer, size_t bufSize)
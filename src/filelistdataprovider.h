@@ -38,6 +38,7 @@
 
 #include <gpgme++/interfaces/dataprovider.h>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -54,6 +55,20 @@ class QGPGME_EXPORT FileListDataProvider : public GpgME::DataProvider
 {
 public:
     explicit FileListDataProvider(const std::vector<QString> &filenames);
+
+    /**
+     * Creates a data provider that fetches the filenames one by one from
+     * \a generator while the data is read. The generator has to return an
+     * empty string after the last filename. Only the filenames that are
+     * currently being read are kept in memory, so that this is suitable for
+     * huge lists of filenames, e.g. if the generator walks a directory tree
+     * with a DirectoryWalker.
+     *
+     * The data can only be read once, i.e. seeking is only supported as
+     * long as nothing has been read.
+     */
+    explicit FileListDataProvider(const std::function<QString()> &generator);
+
     ~FileListDataProvider() override;
 
 private:
@@ -0,0 +1,133 @@
+/*
+    filemanifest_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_FILEMANIFEST_P_H__
+#define __QGPGME_FILEMANIFEST_P_H__
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+#include <vector>
+
+namespace QGpgME
+{
+namespace _detail
+{
+
+// The manifest signed by a SignManifestJob. It's a text file with one line
+// per file which is clear-signed, e.g.
+//   QGpgME-File-Manifest: 1
+//   Hash: SHA256
+//   <checksum in hex> 1234 dir/file%20name.tar.gz
+// The paths are relative and percent-encoded, and the lines are sorted by
+// path, i.e. the same files always result in the same manifest.
+struct FileManifest {
+    struct Entry {
+        QString path;
+        qint64 size = 0;
+        QByteArray checksum; // in hex
+    };
+    QCryptographicHash::Algorithm algorithm = QCryptographicHash::Sha256;
+    std::vector<Entry> entries;
+
+    static QByteArray algorithmName(QCryptographicHash::Algorithm algorithm)
+    {
+        return algorithm == QCryptographicHash::Sha512 ? "SHA512" : "SHA256";
+    }
+
+    QByteArray toByteArray() const
+    {
+        QByteArray result = "QGpgME-File-Manifest: 1\nHash: " + algorithmName(algorithm) + '\n';
+        for (const auto &entry : entries) {
+            result += entry.checksum + ' ' + QByteArray::number(entry.size) + ' '
+                + QUrl::toPercentEncoding(entry.path, "/") + '\n';
+        }
+        return result;
+    }
+
+    static bool fromByteArray(const QByteArray &data, FileManifest &manifest)
+    {
+        manifest.entries.clear();
+        QList<QByteArray> lines = data.split('\n');
+        if (lines.size() < 2 || lines[0].trimmed() != "QGpgME-File-Manifest: 1") {
+            return false;
+        }
+        const QByteArray hashLine = lines[1].trimmed();
+        int checksumSize;
+        if (hashLine == "Hash: SHA256") {
+            manifest.algorithm = QCryptographicHash::Sha256;
+            checksumSize = 64;
+        } else if (hashLine == "Hash: SHA512") {
+            manifest.algorithm = QCryptographicHash::Sha512;
+            checksumSize = 128;
+        } else {
+            return false;
+        }
+        for (int i = 2; i < lines.size(); ++i) {
+            const QByteArray line = lines[i].trimmed();
+            if (line.isEmpty()) {
+                continue;
+            }
+            const QList<QByteArray> fields = line.split(' ');
+            if (fields.size() != 3) {
+                return false;
+            }
+            Entry entry;
+            bool ok = false;
+            entry.checksum = fields[0];
+            entry.size = fields[1].toLongLong(&ok);
+            entry.path = QUrl::fromPercentEncoding(fields[2]);
+            if (!ok || entry.size < 0 || entry.checksum.size() != checksumSize || !isSafePath(entry.path)) {
+                return false;
+            }
+            manifest.entries.push_back(entry);
+        }
+        return !manifest.entries.empty();
+    }
+
+    // the files must be below the base directory
+    static bool isSafePath(const QString &path)
+    {
+        const QString cleanPath = QDir::cleanPath(path);
+        return !path.isEmpty() && QDir::isRelativePath(path) && cleanPath == path
+            && cleanPath != QLatin1String{".."} && !cleanPath.startsWith(QLatin1String{"../"});
+    }
+};
+
+}
+}
+
+#endif // __QGPGME_FILEMANIFEST_P_H__
@@ -0,0 +1,138 @@
+/*
+    filetreefilter_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_FILETREEFILTER_P_H__
+#define __QGPGME_FILETREEFILTER_P_H__
+
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace QGpgME
+{
+namespace _detail
+{
+
+// The filters shared by DirectoryWalker and FileTreeScanner. isWanted() may
+// be called concurrently from multiple threads.
+class FileTreeFilter
+{
+public:
+    void setNameFilters(const QStringList &nameFilters)
+    {
+        mNameFilters = nameFilters;
+        mNameRegExps = toRegularExpressions(nameFilters);
+    }
+    QStringList nameFilters() const
+    {
+        return mNameFilters;
+    }
+
+    void setExcludeFilters(const QStringList &excludeFilters)
+    {
+        mExcludeFilters = excludeFilters;
+        mExcludeRegExps = toRegularExpressions(excludeFilters);
+    }
+    QStringList excludeFilters() const
+    {
+        return mExcludeFilters;
+    }
+
+    void setIncludeHidden(bool includeHidden)
+    {
+        mIncludeHidden = includeHidden;
+    }
+    bool includeHidden() const
+    {
+        return mIncludeHidden;
+    }
+
+    void setFilter(const std::function<bool(const QFileInfo &)> &filter)
+    {
+        mFilter = filter;
+    }
+
+    // name filters only apply to files; directories are always walked unless
+    // they are hidden, excluded or rejected by the custom filter
+    bool isWanted(const QFileInfo &fi) const
+    {
+        if (!mIncludeHidden && fi.isHidden()) {
+            return false;
+        }
+        if (matchesAny(mExcludeRegExps, fi.fileName())) {
+            return false;
+        }
+        if (!fi.isDir() && !mNameRegExps.empty() && !matchesAny(mNameRegExps, fi.fileName())) {
+            return false;
+        }
+        return !mFilter || mFilter(fi);
+    }
+
+private:
+    static std::vector<QRegularExpression> toRegularExpressions(const QStringList &patterns)
+    {
+#ifdef Q_OS_WIN
+        const auto options = QRegularExpression::CaseInsensitiveOption;
+#else
+        const auto options = QRegularExpression::NoPatternOption;
+#endif
+        std::vector<QRegularExpression> result;
+        result.reserve(patterns.size());
+        for (const auto &pattern : patterns) {
+            result.emplace_back(QRegularExpression::wildcardToRegularExpression(pattern), options);
+        }
+        return result;
+    }
+
+    static bool matchesAny(const std::vector<QRegularExpression> &regexps, const QString &name)
+    {
+        return std::any_of(regexps.cbegin(), regexps.cend(), [&name](const auto &re) {
+            return re.match(name).hasMatch();
+        });
+    }
+
+    QStringList mNameFilters;
+    QStringList mExcludeFilters;
+    std::vector<QRegularExpression> mNameRegExps;
+    std::vector<QRegularExpression> mExcludeRegExps;
+    bool mIncludeHidden = true;
+    std::function<bool(const QFileInfo &)> mFilter;
+};
+
+}
+}
+
+#endif // __QGPGME_FILETREEFILTER_P_H__
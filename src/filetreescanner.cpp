@@ -0,0 +1,326 @@
+/*
+    filetreescanner.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "filetreescanner.h"
+
+#include "filetreefilter_p.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+using namespace QGpgME;
+
+namespace
+{
+struct Directory {
+    QString path;           // the path that is returned
+    QString fileSystemPath; // the path for accessing the directory
+};
+}
+
+class FileTreeScanner::Private
+{
+public:
+    QString fileSystemPath(const QString &path) const
+    {
+        return baseDirectory.isEmpty() ? path : QDir{baseDirectory}.filePath(path);
+    }
+
+    void addFile(const QString &path, const QFileInfo &fi, Result &result)
+    {
+        const qint64 size = fi.isSymLink() ? 0 : fi.size();
+        result.paths.push_back(path);
+        result.fileSizes.push_back(size);
+        result.fileCount++;
+        result.totalBytes += size;
+    }
+
+    void enqueueDirectory(const QString &path, const QFileInfo &fi)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (symlinkPolicy == DirectoryWalker::FollowSymlinks) {
+            // skip cycles and directories that were reached via another link
+            if (!visitedDirectories.insert(fi.canonicalFilePath()).second) {
+                return;
+            }
+        }
+        queue.push_back({path, fi.filePath()});
+        condition.notify_one();
+    }
+
+    void scanDirectory(const Directory &dir, Result &result);
+    void work(Result &result);
+
+    std::vector<QString> roots;
+    QString baseDirectory;
+    DirectoryWalker::SymlinkPolicy symlinkPolicy = DirectoryWalker::KeepSymlinks;
+    _detail::FileTreeFilter filter;
+    int threadCount = std::max(QThread::idealThreadCount(), 4);
+
+    std::atomic<bool> canceled{false};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Directory> queue;
+    int busyWorkers = 0;
+    std::set<QString> visitedDirectories;
+};
+
+void FileTreeScanner::Private::scanDirectory(const Directory &dir, Result &result)
+{
+    result.directoryCount++;
+    QDirIterator it{dir.fileSystemPath, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System};
+    bool hasEntries = false;
+    while (it.hasNext() && !canceled.load(std::memory_order_relaxed)) {
+        it.next();
+        hasEntries = true;
+        const QFileInfo fi = it.fileInfo();
+        const QString path = dir.path.endsWith(QLatin1Char('/')) ? dir.path + fi.fileName()
+                                                                 : dir.path + QLatin1Char('/') + fi.fileName();
+        if (fi.isSymLink()) {
+            if (symlinkPolicy == DirectoryWalker::SkipSymlinks || !filter.isWanted(fi)) {
+                continue;
+            }
+            if (symlinkPolicy == DirectoryWalker::FollowSymlinks && fi.isDir()) {
+                enqueueDirectory(path, fi);
+                continue;
+            }
+            addFile(path, fi, result);
+            continue;
+        }
+        if (!filter.isWanted(fi)) {
+            continue;
+        }
+        if (fi.isDir()) {
+            enqueueDirectory(path, fi);
+        } else if (fi.isFile()) {
+            addFile(path, fi, result);
+        }
+    }
+    if (!hasEntries) {
+        // return empty directories, so that they are added to the archive
+        result.paths.push_back(dir.path);
+        result.fileSizes.push_back(0);
+    }
+}
+
+void FileTreeScanner::Private::work(Result &result)
+{
+    while (true) {
+        Directory dir;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            condition.wait(lock, [this]() {
+                return !queue.empty() || busyWorkers == 0 || canceled.load();
+            });
+            if (queue.empty() || canceled.load()) {
+                // nothing left to do and nobody who could add more work
+                condition.notify_all();
+                return;
+            }
+            dir = std::move(queue.front());
+            queue.pop_front();
+            busyWorkers++;
+        }
+        scanDirectory(dir, result);
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            busyWorkers--;
+            if (busyWorkers == 0 && queue.empty()) {
+                condition.notify_all();
+            }
+        }
+    }
+}
+
+FileTreeScanner::FileTreeScanner(const std::vector<QString> &paths)
+    : d{new Private}
+{
+    d->roots = paths;
+}
+
+FileTreeScanner::~FileTreeScanner() = default;
+
+void FileTreeScanner::setBaseDirectory(const QString &baseDirectory)
+{
+    d->baseDirectory = baseDirectory;
+}
+
+QString FileTreeScanner::baseDirectory() const
+{
+    return d->baseDirectory;
+}
+
+void FileTreeScanner::setSymlinkPolicy(DirectoryWalker::SymlinkPolicy policy)
+{
+    d->symlinkPolicy = policy;
+}
+
+DirectoryWalker::SymlinkPolicy FileTreeScanner::symlinkPolicy() const
+{
+    return d->symlinkPolicy;
+}
+
+void FileTreeScanner::setNameFilters(const QStringList &nameFilters)
+{
+    d->filter.setNameFilters(nameFilters);
+}
+
+QStringList FileTreeScanner::nameFilters() const
+{
+    return d->filter.nameFilters();
+}
+
+void FileTreeScanner::setExcludeFilters(const QStringList &excludeFilters)
+{
+    d->filter.setExcludeFilters(excludeFilters);
+}
+
+QStringList FileTreeScanner::excludeFilters() const
+{
+    return d->filter.excludeFilters();
+}
+
+void FileTreeScanner::setIncludeHidden(bool includeHidden)
+{
+    d->filter.setIncludeHidden(includeHidden);
+}
+
+bool FileTreeScanner::includeHidden() const
+{
+    return d->filter.includeHidden();
+}
+
+void FileTreeScanner::setFilter(const std::function<bool(const QFileInfo &)> &filter)
+{
+    d->filter.setFilter(filter);
+}
+
+void FileTreeScanner::setThreadCount(int threadCount)
+{
+    d->threadCount = std::max(threadCount, 1);
+}
+
+int FileTreeScanner::threadCount() const
+{
+    return d->threadCount;
+}
+
+FileTreeScanner::Result FileTreeScanner::scan()
+{
+    d->queue.clear();
+    d->busyWorkers = 0;
+    d->visitedDirectories.clear();
+
+    Result result;
+    for (const auto &root : d->roots) {
+        if (root.isEmpty()) {
+            continue;
+        }
+        const QFileInfo fi{d->fileSystemPath(root)};
+        if (fi.isSymLink() && d->symlinkPolicy != DirectoryWalker::FollowSymlinks) {
+            if (d->symlinkPolicy == DirectoryWalker::KeepSymlinks) {
+                d->addFile(root, fi, result);
+            }
+            continue;
+        }
+        if (fi.isDir()) {
+            d->enqueueDirectory(root, fi);
+        } else {
+            // let gpgtar deal with files and with non-existing paths
+            d->addFile(root, fi, result);
+        }
+    }
+
+    std::vector<Result> partialResults(d->threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(d->threadCount);
+    for (auto &partialResult : partialResults) {
+        threads.emplace_back([this, &partialResult]() {
+            d->work(partialResult);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    result.canceled = d->canceled.exchange(false);
+
+    for (auto &partialResult : partialResults) {
+        std::move(partialResult.paths.begin(), partialResult.paths.end(), std::back_inserter(result.paths));
+        std::copy(partialResult.fileSizes.cbegin(), partialResult.fileSizes.cend(), std::back_inserter(result.fileSizes));
+        result.fileCount += partialResult.fileCount;
+        result.directoryCount += partialResult.directoryCount;
+        result.totalBytes += partialResult.totalBytes;
+        partialResult = {};
+    }
+
+    // the order in which the threads find the files is random; sort the
+    // paths so that the same tree always results in the same archive
+    std::vector<size_t> order(result.paths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&result](size_t a, size_t b) {
+        return result.paths[a] < result.paths[b];
+    });
+    Result sorted;
+    sorted.paths.reserve(order.size());
+    sorted.fileSizes.reserve(order.size());
+    for (const auto i : order) {
+        sorted.paths.push_back(std::move(result.paths[i]));
+        sorted.fileSizes.push_back(result.fileSizes[i]);
+    }
+    result.paths = std::move(sorted.paths);
+    result.fileSizes = std::move(sorted.fileSizes);
+
+    return result;
+}
+
+void FileTreeScanner::cancel()
+{
+    d->canceled = true;
+    std::lock_guard<std::mutex> lock{d->mutex};
+    d->condition.notify_all();
+}
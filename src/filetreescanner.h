@@ -0,0 +1,146 @@
+/*
+    filetreescanner.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_FILETREESCANNER_H__
+#define __QGPGME_FILETREESCANNER_H__
+
+#include "directorywalker.h"
+#include "qgpgme_export.h"
+
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QFileInfo;
+
+namespace QGpgME
+{
+
+/**
+ * This class scans directory trees with multiple threads and collects the
+ * paths of the files to put into an archive together with the number of
+ * files and the total size of the files.
+ *
+ * The scanner returns the same paths as a DirectoryWalker with the same
+ * settings, but sorted. If symbolic links are followed, then a directory
+ * that can be reached via multiple links is only scanned once. The result can be passed to an archive job, e.g.
+ * \code
+ * FileTreeScanner scanner{{QStringLiteral("Documents")}};
+ * scanner.setBaseDirectory(QDir::homePath());
+ * const auto result = scanner.scan();
+ * job->setBaseDirectory(QDir::homePath());
+ * job->setInputPaths(result.paths);
+ * job->setInputSizeHint(result.fileCount, result.totalBytes);
+ * \endcode
+ */
+class QGPGME_EXPORT FileTreeScanner
+{
+public:
+    struct Result {
+        std::vector<QString> paths;
+        std::vector<qint64> fileSizes; ///< size of each path in paths; 0 for symbolic links and directories
+        qint64 fileCount = 0;      ///< number of regular files and symbolic links in paths
+        qint64 directoryCount = 0; ///< number of scanned directories
+        qint64 totalBytes = 0;     ///< total size of the regular files
+        bool canceled = false;     ///< true if the scan was stopped by cancel(); the result is incomplete
+    };
+
+    /**
+     * Creates a scanner for the files and directories in \a paths. If a base
+     * directory is set, then relative paths are interpreted relative to the
+     * base directory. The returned paths start with the given paths.
+     */
+    explicit FileTreeScanner(const std::vector<QString> &paths);
+    ~FileTreeScanner();
+
+    FileTreeScanner(const FileTreeScanner &) = delete;
+    FileTreeScanner &operator=(const FileTreeScanner &) = delete;
+
+    void setBaseDirectory(const QString &baseDirectory);
+    QString baseDirectory() const;
+
+    void setSymlinkPolicy(DirectoryWalker::SymlinkPolicy policy);
+    DirectoryWalker::SymlinkPolicy symlinkPolicy() const;
+
+    /**
+     * \sa DirectoryWalker::setNameFilters
+     */
+    void setNameFilters(const QStringList &nameFilters);
+    QStringList nameFilters() const;
+
+    /**
+     * \sa DirectoryWalker::setExcludeFilters
+     */
+    void setExcludeFilters(const QStringList &excludeFilters);
+    QStringList excludeFilters() const;
+
+    void setIncludeHidden(bool includeHidden);
+    bool includeHidden() const;
+
+    /**
+     * Sets a function that decides whether a file is returned respectively
+     * whether a directory is scanned. The function is called concurrently
+     * from multiple threads.
+     */
+    void setFilter(const std::function<bool(const QFileInfo &)> &filter);
+
+    /**
+     * Sets the number of threads to use for scanning. Defaults to the number
+     * of CPU cores, but at least 4 because scanning mostly waits for the
+     * file system.
+     */
+    void setThreadCount(int threadCount);
+    int threadCount() const;
+
+    /**
+     * Scans the directory trees and returns the result. Blocks until the
+     * scan is complete or cancel() has been called.
+     */
+    Result scan();
+
+    /**
+     * Stops the running scan or, if no scan is running, the next scan. This
+     * function can be called from any thread. scan() returns the result
+     * collected so far with Result::canceled set.
+     */
+    void cancel();
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_FILETREESCANNER_H__
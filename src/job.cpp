@@ -57,6 +57,11 @@ QGpgME::Job::Job(std::unique_ptr<JobPrivate> dd, QObject *parent)
     if (QCoreApplication *app = QCoreApplication::instance()) {
         connect(app, &QCoreApplication::aboutToQuit, this, &Job::slotCancel);
     }
+    if (d_ptr) {
+        connect(this, &Job::done, this, [this]() {
+            d_ptr->m_throughput->finish();
+        });
+    }
 }
 
 QGpgME::Job::Job(QObject *parent)
@@ -105,4 +110,10 @@ void QGpgME::Job::startNow()
     d->startNow();
 }
 
+std::shared_ptr<QGpgME::JobThroughput> QGpgME::Job::throughput() const
+{
+    Q_D(const Job);
+    return d ? d->m_throughput : nullptr;
+}
+
 #include "moc_job.cpp"
@@ -50,6 +50,7 @@ namespace QGpgME
 {
 
 class JobPrivate;
+class JobThroughput;
 
 /**
    @short An abstract base class for asynchronous crypto operations
@@ -111,6 +112,17 @@ public:
      */
     void startNow();
 
+    /**
+     * Returns the throughput statistics of the job, i.e. the processing rate,
+     * the estimated remaining time, the time spent waiting for input and
+     * output, and whether the engine seems to be stalled.
+     *
+     * The statistics are fed by the stream jobs that read from and write to
+     * IO devices and by the archive jobs. For other jobs they stay empty.
+     * Returns nullptr for jobs without private data.
+     */
+    std::shared_ptr<JobThroughput> throughput() const;
+
 public Q_SLOTS:
     virtual void slotCancel() = 0;
 
@@ -36,8 +36,12 @@
 
 #include "job.h"
 
+#include "jobthroughput.h"
 #include "qgpgme_debug.h"
 
+#include <algorithm>
+#include <limits>
+
 // Base class for pimpl classes for Job subclasses
 class QGpgME::JobPrivate
 {
@@ -54,20 +58,40 @@ public:
     virtual void startNow() = 0;
 
     Job *q_ptr = nullptr;
+    const std::shared_ptr<JobThroughput> m_throughput = std::make_shared<JobThroughput>();
 };
 
-// Helper for the archive job classes
+// Helper for the archive job classes; if the number of files is known in
+// advance, then it is reported as total during gpgtar's scanning phase. The
+// data progress is fed into the throughput statistics; it is converted to
+// bytes if the total size is known.
 template<class JobClass>
-void emitArchiveProgressSignals(JobClass *job, const QString &what, int type, int current, int total)
+void emitArchiveProgressSignals(JobClass *job, const QString &what, int type, int current, int total, qint64 fileCountHint = 0, qint64 sizeHint = 0)
 {
     if (what != QLatin1String{"gpgtar"}) {
         return;
     }
+    const auto throughput = job->throughput();
     switch (type) {
     case 'c':
+        if (total == 0 && fileCountHint >= current) {
+            total = static_cast<int>(std::min<qint64>(fileCountHint, std::numeric_limits<int>::max()));
+        }
+        if (throughput) {
+            throughput->reportActivity();
+        }
         Q_EMIT job->fileProgress(current, total);
         break;
     case 's':
+        if (throughput && total > 0) {
+            if (sizeHint > 0) {
+                throughput->setTotalBytes(sizeHint);
+                throughput->setProcessedBytes(static_cast<qint64>(static_cast<double>(current) / total * sizeHint));
+            } else {
+                throughput->setTotalBytes(total);
+                throughput->setProcessedBytes(current);
+            }
+        }
         Q_EMIT job->dataProgress(current, total);
         break;
     default:
@@ -0,0 +1,254 @@
+/*
+    jobthroughput.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "jobthroughput.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+
+using namespace QGpgME;
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+// the rate is sampled at most every 250 ms and smoothed with a time constant
+// of 2 seconds, i.e. it follows changes quickly without jumping around
+constexpr std::chrono::milliseconds minSampleDuration{250};
+constexpr double smoothingTimeConstant = 2.0;
+
+qint64 toMSecs(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+
+double toSecs(Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+}
+
+class JobThroughput::Private
+{
+public:
+    void startIfNeeded(Clock::time_point now)
+    {
+        if (!started) {
+            started = true;
+            startTime = now;
+            lastProgress = now;
+            sampleStart = now;
+        }
+    }
+
+    void addProgress(Clock::time_point now, qint64 bytes)
+    {
+        processed += bytes;
+        sampleBytes += bytes;
+        if (bytes != 0) {
+            lastProgress = now;
+        }
+        if (now - sampleStart >= minSampleDuration) {
+            rate = smoothedRate(now);
+            haveRate = true;
+            sampleBytes = 0;
+            sampleStart = now;
+        }
+    }
+
+    double smoothedRate(Clock::time_point now) const
+    {
+        const double duration = toSecs(now - sampleStart);
+        if (duration <= 0) {
+            return rate;
+        }
+        const double sampleRate = sampleBytes / duration;
+        if (!haveRate) {
+            return sampleRate;
+        }
+        const double alpha = 1.0 - std::exp(-duration / smoothingTimeConstant);
+        return rate + alpha * (sampleRate - rate);
+    }
+
+    Clock::duration blockedTime(WaitReason reason, Clock::time_point now) const
+    {
+        return blocked[reason] + (waiting[reason] > 0 ? now - waitStart[reason] : Clock::duration::zero());
+    }
+
+    mutable std::mutex mutex;
+    bool started = false;
+    bool finished = false;
+    Clock::time_point startTime;
+    Clock::time_point finishTime;
+    Clock::time_point lastProgress;
+    qint64 processed = 0;
+    qint64 total = 0;
+    Clock::time_point sampleStart;
+    qint64 sampleBytes = 0;
+    double rate = 0;
+    bool haveRate = false;
+    Clock::duration blocked[2] = {Clock::duration::zero(), Clock::duration::zero()};
+    int waiting[2] = {0, 0};
+    Clock::time_point waitStart[2];
+    int stallTimeout = 10000;
+};
+
+JobThroughput::JobThroughput()
+    : d{new Private}
+{
+}
+
+JobThroughput::~JobThroughput() = default;
+
+void JobThroughput::setStallTimeout(int msecs)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->stallTimeout = msecs;
+}
+
+int JobThroughput::stallTimeout() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->stallTimeout;
+}
+
+JobThroughput::Snapshot JobThroughput::snapshot() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    Snapshot result;
+    if (!d->started) {
+        return result;
+    }
+    const auto now = d->finished ? d->finishTime : Clock::now();
+    result.processedBytes = d->processed;
+    result.totalBytes = d->total;
+    result.elapsedMSecs = toMSecs(now - d->startTime);
+    result.inputBlockedMSecs = toMSecs(d->blockedTime(WaitingForInput, now));
+    result.outputBlockedMSecs = toMSecs(d->blockedTime(WaitingForOutput, now));
+    result.finished = d->finished;
+    if (d->finished) {
+        const double elapsed = toSecs(now - d->startTime);
+        result.bytesPerSecond = elapsed > 0 ? d->processed / elapsed : 0;
+        result.etaMSecs = 0;
+        return result;
+    }
+    // include the current sample, so that the rate drops while nothing happens
+    result.bytesPerSecond = (now - d->sampleStart >= minSampleDuration) ? d->smoothedRate(now) : d->rate;
+    if (d->total > 0 && d->processed >= d->total) {
+        result.etaMSecs = 0;
+    } else if (d->total > 0 && result.bytesPerSecond > 0) {
+        result.etaMSecs = static_cast<qint64>((d->total - d->processed) / result.bytesPerSecond * 1000);
+    }
+    // waiting for input or output is not the engine's fault
+    const bool isWaiting = d->waiting[WaitingForInput] > 0 || d->waiting[WaitingForOutput] > 0;
+    result.stalled = !isWaiting && toMSecs(now - d->lastProgress) >= d->stallTimeout;
+    return result;
+}
+
+void JobThroughput::setTotalBytes(qint64 totalBytes)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->startIfNeeded(Clock::now());
+    d->total = totalBytes;
+}
+
+void JobThroughput::addProcessedBytes(qint64 bytes)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto now = Clock::now();
+    d->startIfNeeded(now);
+    d->addProgress(now, bytes);
+}
+
+void JobThroughput::setProcessedBytes(qint64 bytes)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto now = Clock::now();
+    d->startIfNeeded(now);
+    // progress is monotonic; ignore values belonging to an earlier phase
+    d->addProgress(now, std::max<qint64>(bytes - d->processed, 0));
+}
+
+void JobThroughput::reportActivity()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto now = Clock::now();
+    d->startIfNeeded(now);
+    d->lastProgress = now;
+}
+
+void JobThroughput::beginWait(WaitReason reason)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto now = Clock::now();
+    d->startIfNeeded(now);
+    if (d->waiting[reason]++ == 0) {
+        d->waitStart[reason] = now;
+    }
+}
+
+void JobThroughput::endWait(WaitReason reason)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    if (d->waiting[reason] == 0) {
+        return;
+    }
+    const auto now = Clock::now();
+    if (--d->waiting[reason] == 0) {
+        d->blocked[reason] += now - d->waitStart[reason];
+        // the engine cannot make progress while waiting
+        d->lastProgress = now;
+    }
+}
+
+void JobThroughput::finish()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    if (!d->started || d->finished) {
+        return;
+    }
+    const auto now = Clock::now();
+    for (auto reason : {WaitingForInput, WaitingForOutput}) {
+        if (d->waiting[reason] > 0) {
+            d->blocked[reason] += now - d->waitStart[reason];
+            d->waiting[reason] = 0;
+        }
+    }
+    d->finished = true;
+    d->finishTime = now;
+}
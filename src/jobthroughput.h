@@ -0,0 +1,124 @@
+/*
+    jobthroughput.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_JOBTHROUGHPUT_H__
+#define __QGPGME_JOBTHROUGHPUT_H__
+
+#include "qgpgme_export.h"
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace QGpgME
+{
+
+/**
+ * This class collects throughput statistics of a running job.
+ *
+ * The statistics are fed by the data providers of the job and by the
+ * progress reported by gpgtar. They tell how fast the job processes its
+ * input, how long it will presumably take to finish, and whether the job is
+ * slowed down by its input or its output (I/O-bound) or by the crypto engine
+ * (CPU-bound). If the amount of processed data doesn't change for a while
+ * although the job doesn't wait for input or output, then the engine is
+ * considered stalled.
+ *
+ * All functions are thread-safe. Usually, you only need snapshot(), e.g.
+ * \code
+ * const auto stats = job->throughput()->snapshot();
+ * if (stats.inputBlockedMSecs > stats.elapsedMSecs / 2) {
+ *     // the job mostly waits for its input
+ * }
+ * \endcode
+ *
+ * \sa Job::throughput
+ */
+class QGPGME_EXPORT JobThroughput
+{
+public:
+    enum WaitReason {
+        WaitingForInput,
+        WaitingForOutput,
+    };
+
+    struct Snapshot {
+        qint64 processedBytes = 0;
+        qint64 totalBytes = 0;         ///< 0 if the total is unknown
+        double bytesPerSecond = 0;     ///< smoothed over the last few seconds
+        qint64 elapsedMSecs = 0;
+        qint64 etaMSecs = -1;          ///< estimated remaining time; -1 if unknown
+        qint64 inputBlockedMSecs = 0;  ///< time spent waiting for the input
+        qint64 outputBlockedMSecs = 0; ///< time spent waiting for the output
+        bool stalled = false;
+        bool finished = false;
+    };
+
+    JobThroughput();
+    ~JobThroughput();
+
+    JobThroughput(const JobThroughput &) = delete;
+    JobThroughput &operator=(const JobThroughput &) = delete;
+
+    /**
+     * Sets the time in milliseconds without progress after which the engine
+     * is considered stalled. Defaults to 10 seconds.
+     */
+    void setStallTimeout(int msecs);
+    int stallTimeout() const;
+
+    Snapshot snapshot() const;
+
+    /**
+     * \name Feeding the statistics
+     * These functions are called by the jobs and the data providers. The time
+     * is measured from the first call of one of these functions.
+     */
+    //@{
+    void setTotalBytes(qint64 totalBytes);
+    void addProcessedBytes(qint64 bytes);
+    void setProcessedBytes(qint64 bytes);
+    /// Signals progress that isn't measured in bytes, e.g. the number of scanned files.
+    void reportActivity();
+    void beginWait(WaitReason reason);
+    void endWait(WaitReason reason);
+    void finish();
+    //@}
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_JOBTHROUGHPUT_H__
@@ -0,0 +1,129 @@
+/*
+    keylistcoalescing.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "keylistcoalescing.h"
+
+#include "singleflight_p.h"
+
+#include <QCryptographicHash>
+
+#include <gpgme++/context.h>
+#include <gpgme++/engineinfo.h>
+
+#include <atomic>
+
+using namespace QGpgME;
+
+namespace
+{
+std::atomic<bool> enabled{false};
+std::atomic<quint64> requests{0};
+std::atomic<quint64> coalescedRequests{0};
+std::atomic<int> inFlightRequests{0};
+}
+
+bool _detail::keyListCoalescingEnabled()
+{
+    return enabled;
+}
+
+void _detail::countKeyListRequest(bool coalesced)
+{
+    ++requests;
+    if (coalesced) {
+        ++coalescedRequests;
+    }
+}
+
+void _detail::countInFlightKeyListRequests(int delta)
+{
+    inFlightRequests += delta;
+}
+
+QByteArray _detail::keyListRequestId(GpgME::Context *ctx, unsigned int keyListMode, const QStringList &patterns,
+                                     const QByteArray &options)
+{
+    const QByteArray separator(1, '\0');
+    QCryptographicHash hash{QCryptographicHash::Sha256};
+    hash.addData(QByteArray::number(static_cast<int>(ctx->protocol())));
+    hash.addData(separator);
+    hash.addData(ctx->offline() ? QByteArrayLiteral("offline") : QByteArrayLiteral("online"));
+    // the context flags that change which keys are found or how they are
+    // validated
+    for (const char *flag : {"auto-key-locate", "trust-model", "no-auto-check-trustdb"}) {
+        hash.addData(separator);
+        hash.addData(QByteArray{ctx->getFlag(flag)});
+    }
+    const auto engine = ctx->engineInfo();
+    hash.addData(separator);
+    hash.addData(QByteArray{engine.fileName()});
+    hash.addData(separator);
+    hash.addData(QByteArray{engine.homeDirectory()});
+    hash.addData(separator);
+    hash.addData(QByteArray::number(keyListMode));
+    hash.addData(separator);
+    hash.addData(options);
+    for (const auto &pattern : patterns) {
+        hash.addData(separator);
+        hash.addData(pattern.toUtf8());
+    }
+    return hash.result();
+}
+
+void KeyListCoalescing::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+bool KeyListCoalescing::isEnabled()
+{
+    return enabled;
+}
+
+KeyListCoalescing::Statistics KeyListCoalescing::statistics()
+{
+    Statistics statistics;
+    statistics.requests = requests;
+    statistics.coalescedRequests = coalescedRequests;
+    statistics.inFlightRequests = inFlightRequests;
+    return statistics;
+}
+
+void KeyListCoalescing::resetStatistics()
+{
+    requests = 0;
+    coalescedRequests = 0;
+}
@@ -0,0 +1,84 @@
+/*
+    keylistcoalescing.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_KEYLISTCOALESCING_H__
+#define __QGPGME_KEYLISTCOALESCING_H__
+
+#include "qgpgme_export.h"
+
+#include <QtGlobal>
+
+namespace QGpgME
+{
+
+/**
+ * Controls the coalescing of identical concurrent key listings.
+ *
+ * Different parts of an application often list the same keys at the same
+ * time, e.g. when several views are opened at once. If coalescing is
+ * enabled, then a KeyListJob or a KeyForMailboxJob that is started while an
+ * identical job is running doesn't ask the engine again, but waits for the
+ * result of the running job and reports the same keys. Jobs are identical if
+ * they are for the same protocol and the same patterns (or mailbox) and use
+ * the same key list mode and options.
+ *
+ * Only jobs started with start() are coalesced; exec() always asks the
+ * engine. If the running job is canceled, then the jobs waiting for it ask
+ * the engine themselves.
+ *
+ * All functions are thread-safe.
+ */
+class QGPGME_EXPORT KeyListCoalescing
+{
+public:
+    struct Statistics {
+        /** Number of started jobs that could have been coalesced. */
+        quint64 requests = 0;
+        /** Number of jobs that waited for the result of an identical job. */
+        quint64 coalescedRequests = 0;
+        /** Number of running jobs that other jobs can wait for. */
+        int inFlightRequests = 0;
+    };
+
+    /**
+     * Enables or disables the coalescing. Defaults to false.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    static Statistics statistics();
+    static void resetStatistics();
+};
+
+}
+
+#endif // __QGPGME_KEYLISTCOALESCING_H__
@@ -0,0 +1,345 @@
+/*
+    pipedataprovider.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "pipedataprovider.h"
+
+#include <gpgme++/error.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+namespace QGpgME
+{
+
+// A bounded single-producer single-consumer ring buffer. Reading and writing
+// do not take a lock; the mutex and the condition variables are only used to
+// put the reader to sleep if the buffer is empty and the writer to sleep if
+// the buffer is full.
+class PipeBuffer
+{
+public:
+    explicit PipeBuffer(qint64 capacity)
+    {
+        size_t size = 4096;
+        while (size < static_cast<size_t>(capacity)) {
+            size *= 2;
+        }
+        mBuffer.resize(size);
+        mMask = size - 1;
+    }
+
+    qint64 bytesAvailable() const
+    {
+        return mTail.load() - mHead.load();
+    }
+
+    // Blocks until data is available. Returns the number of bytes read, 0 on
+    // EOF, or -1 on error (with the system error set).
+    qint64 read(char *data, qint64 maxSize)
+    {
+        if (mReadEndClosed.load()) {
+            Error::setSystemError(GPG_ERR_EBADF);
+            return -1;
+        }
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        size_t tail = mTail.load();
+        if (tail == head && !mWriteEndClosed.load()) {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mReaderWaiting.store(true);
+            mCanRead.wait(lock, [&]() {
+                tail = mTail.load();
+                return tail != head || mWriteEndClosed.load() || mReadEndClosed.load();
+            });
+            mReaderWaiting.store(false);
+        }
+        if (const int err = mWriteEndError.load()) {
+            // the writer failed; don't pretend that the data is complete
+            Error::setSystemError(static_cast<gpg_err_code_t>(err));
+            return -1;
+        }
+        if (tail == head) {
+            return 0; // EOF
+        }
+
+        const size_t amount = std::min(static_cast<size_t>(maxSize), tail - head);
+        const size_t offset = head & mMask;
+        const size_t first = std::min(amount, mBuffer.size() - offset);
+        memcpy(data, mBuffer.data() + offset, first);
+        memcpy(data + first, mBuffer.data(), amount - first);
+        mHead.store(head + amount);
+
+        if (mWriterWaiting.load()) {
+            std::lock_guard<std::mutex> lock{mMutex};
+            mCanWrite.notify_one();
+        }
+        return amount;
+    }
+
+    // Blocks until all data was written. Returns size, or -1 on error (with
+    // the system error set).
+    qint64 write(const char *data, qint64 size)
+    {
+        qint64 written = 0;
+        while (written < size) {
+            if (mWriteEndClosed.load()) {
+                Error::setSystemError(GPG_ERR_EBADF);
+                return -1;
+            }
+            if (mReadEndClosed.load()) {
+                const int err = mReadEndError.load();
+                Error::setSystemError(err ? static_cast<gpg_err_code_t>(err) : GPG_ERR_EPIPE);
+                return -1;
+            }
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            size_t head = mHead.load();
+            if (tail - head == mBuffer.size()) {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mWriterWaiting.store(true);
+                mCanWrite.wait(lock, [&]() {
+                    head = mHead.load();
+                    return tail - head < mBuffer.size() || mReadEndClosed.load() || mWriteEndClosed.load();
+                });
+                mWriterWaiting.store(false);
+                continue;
+            }
+
+            const size_t amount = std::min(static_cast<size_t>(size - written), mBuffer.size() - (tail - head));
+            const size_t offset = tail & mMask;
+            const size_t first = std::min(amount, mBuffer.size() - offset);
+            memcpy(mBuffer.data() + offset, data + written, first);
+            memcpy(mBuffer.data(), data + written + first, amount - first);
+            mTail.store(tail + amount);
+            written += amount;
+
+            if (mReaderWaiting.load()) {
+                std::lock_guard<std::mutex> lock{mMutex};
+                mCanRead.notify_one();
+            }
+        }
+        return written;
+    }
+
+    void closeEnd(PipeDataProvider::End end, gpg_err_code_t err)
+    {
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            if (end == PipeDataProvider::ReadEnd) {
+                if (!mReadEndClosed.load()) {
+                    mReadEndError.store(err);
+                    mReadEndClosed.store(true);
+                }
+            } else {
+                if (!mWriteEndClosed.load()) {
+                    mWriteEndError.store(err);
+                    mWriteEndClosed.store(true);
+                }
+            }
+        }
+        mCanRead.notify_all();
+        mCanWrite.notify_all();
+    }
+
+private:
+    std::vector<char> mBuffer;
+    size_t mMask = 0;
+    // the indexes grow monotonically; they are masked for accessing the buffer
+    std::atomic<size_t> mHead{0};
+    std::atomic<size_t> mTail{0};
+    std::atomic<bool> mReadEndClosed{false};
+    std::atomic<bool> mWriteEndClosed{false};
+    std::atomic<int> mReadEndError{0};
+    std::atomic<int> mWriteEndError{0};
+    std::atomic<bool> mReaderWaiting{false};
+    std::atomic<bool> mWriterWaiting{false};
+    std::mutex mMutex;
+    std::condition_variable mCanRead;
+    std::condition_variable mCanWrite;
+};
+
+}
+
+//
+//
+// PipeDataProvider
+//
+//
+
+std::pair<std::unique_ptr<PipeDataProvider>, std::unique_ptr<PipeDataProvider>>
+PipeDataProvider::createPipe(qint64 capacity)
+{
+    const auto buffer = std::make_shared<PipeBuffer>(capacity);
+    return {std::unique_ptr<PipeDataProvider>{new PipeDataProvider{ReadEnd, buffer}},
+            std::unique_ptr<PipeDataProvider>{new PipeDataProvider{WriteEnd, buffer}}};
+}
+
+std::pair<std::shared_ptr<PipeDevice>, std::shared_ptr<PipeDevice>>
+PipeDataProvider::createDevicePipe(qint64 capacity)
+{
+    const auto buffer = std::make_shared<PipeBuffer>(capacity);
+    std::shared_ptr<PipeDevice> reader{new PipeDevice{ReadEnd, buffer}};
+    std::shared_ptr<PipeDevice> writer{new PipeDevice{WriteEnd, buffer}};
+    reader->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    writer->open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    return {reader, writer};
+}
+
+PipeDataProvider::PipeDataProvider(End end, const std::shared_ptr<PipeBuffer> &buffer)
+    : GpgME::DataProvider(), mEnd{end}, mBuffer{buffer}
+{
+}
+
+PipeDataProvider::~PipeDataProvider()
+{
+    close();
+}
+
+void PipeDataProvider::close()
+{
+    mBuffer->closeEnd(mEnd, GPG_ERR_NO_ERROR);
+}
+
+void PipeDataProvider::closeWithError(const GpgME::Error &error)
+{
+    mBuffer->closeEnd(mEnd, error.code() ? static_cast<gpg_err_code_t>(error.code()) : GPG_ERR_GENERAL);
+}
+
+gpgme_ssize_t PipeDataProvider::read(void *buffer, size_t bufSize)
+{
+    if (mEnd != ReadEnd) {
+        Error::setSystemError(GPG_ERR_EBADF);
+        return -1;
+    }
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    return mBuffer->read(static_cast<char *>(buffer), bufSize);
+}
+
+gpgme_ssize_t PipeDataProvider::write(const void *buffer, size_t bufSize)
+{
+    if (mEnd != WriteEnd) {
+        Error::setSystemError(GPG_ERR_EBADF);
+        return -1;
+    }
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    return mBuffer->write(static_cast<const char *>(buffer), bufSize);
+}
+
+gpgme_off_t PipeDataProvider::seek(gpgme_off_t, int)
+{
+    Error::setSystemError(GPG_ERR_ESPIPE);
+    return (gpgme_off_t) -1;
+}
+
+void PipeDataProvider::release()
+{
+    close();
+}
+
+//
+//
+// PipeDevice
+//
+//
+
+PipeDevice::PipeDevice(PipeDataProvider::End end, const std::shared_ptr<PipeBuffer> &buffer)
+    : QIODevice{}, mEnd{end}, mBuffer{buffer}
+{
+}
+
+PipeDevice::~PipeDevice()
+{
+    mBuffer->closeEnd(mEnd, GPG_ERR_NO_ERROR);
+}
+
+bool PipeDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 PipeDevice::bytesAvailable() const
+{
+    return QIODevice::bytesAvailable() + (mEnd == PipeDataProvider::ReadEnd ? mBuffer->bytesAvailable() : 0);
+}
+
+void PipeDevice::close()
+{
+    mBuffer->closeEnd(mEnd, GPG_ERR_NO_ERROR);
+    QIODevice::close();
+}
+
+void PipeDevice::closeWithError(const GpgME::Error &error)
+{
+    mBuffer->closeEnd(mEnd, error.code() ? static_cast<gpg_err_code_t>(error.code()) : GPG_ERR_GENERAL);
+    QIODevice::close();
+}
+
+qint64 PipeDevice::readData(char *data, qint64 maxSize)
+{
+    if (maxSize == 0) {
+        return 0;
+    }
+    const qint64 numRead = mBuffer->read(data, maxSize);
+    if (numRead < 0) {
+        setErrorString(QString::fromLocal8Bit(Error::fromSystemError().asString()));
+    }
+    // QIODevice signals the end of a sequential device with -1
+    return numRead == 0 ? -1 : numRead;
+}
+
+qint64 PipeDevice::writeData(const char *data, qint64 maxSize)
+{
+    return mBuffer->write(data, maxSize);
+}
+
+#include "moc_pipedataprovider.cpp"
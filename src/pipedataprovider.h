@@ -0,0 +1,177 @@
+/*
+    pipedataprovider.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_PIPEDATAPROVIDER_H__
+#define __QGPGME_PIPEDATAPROVIDER_H__
+
+#include "qgpgme_export.h"
+
+#include <gpgme++/interfaces/dataprovider.h>
+
+#include <QIODevice>
+
+#include <memory>
+#include <utility>
+
+namespace GpgME
+{
+class Error;
+}
+
+namespace QGpgME
+{
+
+class PipeBuffer;
+class PipeDevice;
+
+/**
+ * One end of an in-process pipe with a bounded buffer.
+ *
+ * A pipe connects the output of one operation with the input of another
+ * operation, e.g. a decryption with a signing operation, without having to
+ * keep the complete intermediate data in memory. Both operations run
+ * concurrently in different threads. If the buffer is full, then writing
+ * blocks until the reading end has consumed some data. If the buffer is
+ * empty, then reading blocks until data was written or the writing end was
+ * closed.
+ *
+ * Closing the writing end signals EOF to the reading end after all buffered
+ * data has been read. Closing the reading end makes all further writes fail
+ * with GPG_ERR_EPIPE. closeWithError() makes the other end fail immediately
+ * with the given error, e.g. if the writing operation failed or was canceled.
+ *
+ * The ends are closed when gpgme releases them or when they are destroyed.
+ *
+ * \sa PipeDevice
+ */
+class QGPGME_EXPORT PipeDataProvider : public GpgME::DataProvider
+{
+public:
+    enum End {
+        ReadEnd,
+        WriteEnd,
+    };
+
+    /**
+     * Creates a pipe with a buffer of at least \a capacity bytes. Returns the
+     * reading end and the writing end of the pipe (in this order).
+     */
+    static std::pair<std::unique_ptr<PipeDataProvider>, std::unique_ptr<PipeDataProvider>>
+    createPipe(qint64 capacity = 64 * 1024);
+
+    /**
+     * Creates a pipe with a buffer of at least \a capacity bytes whose ends
+     * are IO devices that can be passed to the start() functions of the jobs
+     * taking a QIODevice. Returns the reading end and the writing end of the
+     * pipe (in this order). The devices are already open.
+     */
+    static std::pair<std::shared_ptr<PipeDevice>, std::shared_ptr<PipeDevice>>
+    createDevicePipe(qint64 capacity = 64 * 1024);
+
+    ~PipeDataProvider() override;
+
+    End end() const
+    {
+        return mEnd;
+    }
+
+    void close();
+    void closeWithError(const GpgME::Error &error);
+
+private:
+    PipeDataProvider(End end, const std::shared_ptr<PipeBuffer> &buffer);
+
+    bool isSupported(Operation op) const override
+    {
+        return (op == Read && mEnd == ReadEnd) || (op == Write && mEnd == WriteEnd) || op == Release;
+    }
+#ifdef _WIN32
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override;
+    gpgme_ssize_t write(const void *buffer, size_t bufSize) override;
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override;
+#else
+    ssize_t read(void *buffer, size_t bufSize) override;
+    ssize_t write(const void *buffer, size_t bufSize) override;
+    off_t seek(off_t offset, int whence) override;
+#endif
+    void release() override;
+
+private:
+    const End mEnd;
+    const std::shared_ptr<PipeBuffer> mBuffer;
+};
+
+/**
+ * One end of an in-process pipe as sequential IO device.
+ *
+ * Reading and writing block, i.e. the devices are meant to be used by jobs
+ * that run in their own threads, and not in the thread of an event loop.
+ * The devices do not emit readyRead() or bytesWritten().
+ *
+ * \sa PipeDataProvider::createDevicePipe
+ */
+class QGPGME_EXPORT PipeDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    ~PipeDevice() override;
+
+    PipeDataProvider::End end() const
+    {
+        return mEnd;
+    }
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    void close() override;
+
+    /**
+     * Closes the device and makes the other end of the pipe fail with
+     * \a error.
+     */
+    void closeWithError(const GpgME::Error &error);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    friend class PipeDataProvider;
+    PipeDevice(PipeDataProvider::End end, const std::shared_ptr<PipeBuffer> &buffer);
+
+    const PipeDataProvider::End mEnd;
+    const std::shared_ptr<PipeBuffer> mBuffer;
+};
+
+}
+
+#endif // __QGPGME_PIPEDATAPROVIDER_H__
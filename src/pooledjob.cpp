@@ -0,0 +1,236 @@
+/*
+    pooledjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "pooledjob.h"
+#include "pooledjob_p.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+PooledJobPrivate::PooledJobPrivate(GpgME::Protocol protocol)
+    : m_protocol{protocol}
+{
+}
+
+PooledJobPrivate::~PooledJobPrivate() = default;
+
+GpgME::Error PooledJobPrivate::startItems(size_t count, const ContextSetup &setup, const ItemTask &processItem)
+{
+    if (m_pool) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+    if (count == 0) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (count > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return Error::fromCode(GPG_ERR_TOO_LARGE);
+    }
+
+    Q_Q(PooledJob);
+    m_itemCount = count;
+    m_itemErrors = std::vector<Error>(count, Error::fromCode(GPG_ERR_CANCELED));
+    m_latencies.reserve(count);
+    m_processedItems = std::vector<bool>(count, false);
+    m_pool = std::make_unique<_detail::WorkerPool>(m_protocol);
+    m_pool->setContextSetup([this, setup, userSetup = m_userContextSetup](Context *ctx) {
+        const Error err = setup ? setup(ctx) : Error{};
+        if (userSetup) {
+            userSetup(ctx);
+        }
+        const std::lock_guard<std::mutex> lock{m_contextErrorsMutex};
+        // the address of a context may be reused by a context created later
+        if (err) {
+            m_contextErrors[ctx] = err;
+            m_hasContextErrors = true;
+        } else {
+            m_contextErrors.erase(ctx);
+        }
+    });
+    const bool stopOnError = m_stopOnError;
+    // ~PooledJob() joins the threads, i.e. q and the data of the concrete
+    // job are still alive while the threads use them
+    m_pool->start(count, m_maxThreads, [this, q, processItem, stopOnError](Context *ctx, size_t index) {
+        const auto startTime = std::chrono::steady_clock::now();
+        const Error error = processItem(ctx, index);
+        const qint64 latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+        m_itemErrors[index] = error;
+        if (error.code() && stopOnError) {
+            m_pool->cancel();
+        }
+        QMetaObject::invokeMethod(q, [this, index, latency]() {
+            itemFinished(index, latency);
+        }, Qt::QueuedConnection);
+    }, [this, q]() {
+        QMetaObject::invokeMethod(q, [this]() {
+            allFinished();
+        }, Qt::QueuedConnection);
+    });
+    return {};
+}
+
+GpgME::Error PooledJobPrivate::contextSetupError(GpgME::Context *ctx)
+{
+    if (!ctx) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    if (!m_hasContextErrors) {
+        return {};
+    }
+    const std::lock_guard<std::mutex> lock{m_contextErrorsMutex};
+    const auto it = m_contextErrors.find(ctx);
+    return it != m_contextErrors.end() ? it->second : Error{};
+}
+
+GpgME::Error PooledJobPrivate::resultError() const
+{
+    if (m_canceled) {
+        return Error::fromCode(GPG_ERR_CANCELED);
+    }
+    const auto it = std::find_if(m_itemErrors.cbegin(), m_itemErrors.cend(), [](const auto &error) {
+        return error.code() && !error.isCanceled();
+    });
+    return it != m_itemErrors.cend() ? *it : Error{};
+}
+
+void PooledJobPrivate::emitProgress(size_t finished, size_t total)
+{
+    Q_Q(PooledJob);
+    Q_EMIT q->jobProgress(static_cast<int>(finished), static_cast<int>(total));
+}
+
+void PooledJobPrivate::itemFinished(size_t index, qint64 latencyUSecs)
+{
+    m_finishedItems++;
+    m_latencies.push_back(latencyUSecs);
+    if (m_completionChunkSize > 0) {
+        if (!m_orderedCompletion) {
+            emitCompleted(index, 1);
+        } else {
+            m_processedItems[index] = true;
+            while (m_nextUnprocessed < m_itemCount && m_processedItems[m_nextUnprocessed]) {
+                m_nextUnprocessed++;
+            }
+            while (m_nextUnprocessed - m_nextCompleted >= m_completionChunkSize) {
+                emitCompleted(m_nextCompleted, m_completionChunkSize);
+                m_nextCompleted += m_completionChunkSize;
+            }
+        }
+    }
+    emitProgress(m_finishedItems, m_itemCount);
+}
+
+void PooledJobPrivate::flushCompleted()
+{
+    if (m_completionChunkSize == 0 || !m_orderedCompletion) {
+        return;
+    }
+    // report the processed items that were held back, i.e. the last partial
+    // chunk and the items held back by items that were canceled
+    while (m_nextCompleted < m_itemCount) {
+        if (!m_processedItems[m_nextCompleted]) {
+            m_nextCompleted++;
+            continue;
+        }
+        size_t end = m_nextCompleted;
+        while (end < m_itemCount && m_processedItems[end] && end - m_nextCompleted < m_completionChunkSize) {
+            end++;
+        }
+        emitCompleted(m_nextCompleted, end - m_nextCompleted);
+        m_nextCompleted = end;
+    }
+}
+
+void PooledJobPrivate::allFinished()
+{
+    Q_Q(PooledJob);
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    flushCompleted();
+    Q_EMIT q->done();
+    emitResult();
+    q->deleteLater();
+}
+
+PooledJob::PooledJob(std::unique_ptr<PooledJobPrivate> dd, QObject *parent)
+    : Job{std::move(dd), parent}
+{
+}
+
+PooledJob::~PooledJob()
+{
+    Q_D(PooledJob);
+    // the threads use the members of the private class of the concrete job,
+    // which are destroyed before m_pool; stop them before that happens
+    if (d->m_pool) {
+        d->m_pool->cancel();
+        d->m_pool.reset();
+    }
+}
+
+void PooledJob::setMaxThreads(int count)
+{
+    Q_D(PooledJob);
+    d->m_maxThreads = std::max(count, 1);
+}
+
+int PooledJob::maxThreads() const
+{
+    Q_D(const PooledJob);
+    return d->m_maxThreads;
+}
+
+void PooledJob::setContextSetupFunction(const ContextSetupFunction &setup)
+{
+    Q_D(PooledJob);
+    d->m_userContextSetup = setup;
+}
+
+void PooledJob::slotCancel()
+{
+    Q_D(PooledJob);
+    d->m_canceled = true;
+    if (d->m_pool) {
+        d->m_pool->cancel();
+    }
+}
+
+#include "moc_pooledjob.cpp"
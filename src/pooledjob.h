@@ -0,0 +1,100 @@
+/*
+    pooledjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_POOLEDJOB_H__
+#define __QGPGME_POOLEDJOB_H__
+
+#include "job.h"
+
+#include <functional>
+
+namespace GpgME
+{
+class Context;
+}
+
+namespace QGpgME
+{
+
+class PooledJobPrivate;
+
+/**
+ * Abstract base class for jobs that apply the same operation to many items,
+ * e.g. files or in-memory messages.
+ *
+ * The items are processed by a bounded number of threads. Each thread
+ * creates one context, configures it once and reuses it for all items it
+ * processes. No audit logs are retrieved.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself. Deleting the job while it is running cancels it and waits
+ * for the threads.
+ */
+class QGPGME_EXPORT PooledJob : public Job
+{
+    Q_OBJECT
+protected:
+    explicit PooledJob(std::unique_ptr<PooledJobPrivate>, QObject *parent);
+public:
+    using ContextSetupFunction = std::function<void(GpgME::Context *)>;
+
+    ~PooledJob() override;
+
+    /**
+     * Sets the maximum number of items that are processed concurrently.
+     * Defaults to the number of CPU cores.
+     */
+    void setMaxThreads(int count);
+    int maxThreads() const;
+
+    /**
+     * Sets a function that is called for each context created by the job,
+     * e.g. for setting a passphrase provider. Since the job uses more than
+     * one context, Job::context() doesn't work for this job.
+     *
+     * The function is called after the job has configured the context, i.e.
+     * it can override the settings of the job.
+     *
+     * \note The function is called in the worker threads.
+     */
+    void setContextSetupFunction(const ContextSetupFunction &setup);
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+private:
+    Q_DECLARE_PRIVATE(PooledJob)
+};
+
+}
+
+#endif // __QGPGME_POOLEDJOB_H__
@@ -0,0 +1,147 @@
+/*
+    pooledjob_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_POOLEDJOB_P_H__
+#define __QGPGME_POOLEDJOB_P_H__
+
+#include "pooledjob.h"
+#include "job_p.h"
+#include "workerpool_p.h"
+
+#include <gpgme++/error.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace QGpgME
+{
+
+class PooledJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(PooledJob)
+
+    // configures a new context; if it fails, then the items processed with
+    // this context fail with the returned error
+    using ContextSetup = std::function<GpgME::Error(GpgME::Context *ctx)>;
+    using ItemTask = std::function<GpgME::Error(GpgME::Context *ctx, size_t index)>;
+
+    explicit PooledJobPrivate(GpgME::Protocol protocol);
+    ~PooledJobPrivate() override;
+
+    void startNow() override
+    {
+    }
+
+    // Starts processing the items. setup(ctx) is called for each context
+    // before the user's context setup function. processItem(ctx, index) is
+    // called in the worker threads; it must only touch the data of the given
+    // item and return the error of the item.
+    GpgME::Error startItems(size_t count, const ContextSetup &setup, const ItemTask &processItem);
+
+    // Returns the error of the setup of ctx or GPG_ERR_NOT_SUPPORTED if the
+    // context couldn't be created; called in the worker threads
+    GpgME::Error contextSetupError(GpgME::Context *ctx);
+
+    // Returns the error to pass to result(): GPG_ERR_CANCELED if the job was
+    // canceled, otherwise the error of the first failed item in the order of
+    // the items. Items canceled because of m_stopOnError are skipped.
+    GpgME::Error resultError() const;
+
+    // Called in the main thread after all items have been processed; emits
+    // the result() signal of the concrete job.
+    virtual void emitResult() = 0;
+
+    // Called in the main thread with the items first to first + count - 1
+    // after they have been processed; emits the signal of the concrete job
+    // that reports processed items. Only called if m_completionChunkSize is
+    // not 0.
+    virtual void emitCompleted(size_t first, size_t count)
+    {
+        Q_UNUSED(first);
+        Q_UNUSED(count);
+    }
+
+    // Called in the main thread whenever an item has been processed
+    virtual void emitProgress(size_t finished, size_t total);
+
+    void itemFinished(size_t index, qint64 latencyUSecs);
+    void flushCompleted();
+    void allFinished();
+
+    const GpgME::Protocol m_protocol;
+    int m_maxThreads = _detail::WorkerPool::defaultThreadCount();
+    PooledJob::ContextSetupFunction m_userContextSetup;
+    std::unique_ptr<_detail::WorkerPool> m_pool;
+    // if set, then no further items are started after an item failed
+    bool m_stopOnError = false;
+    // the maximum number of items passed to emitCompleted(); 0 if the job
+    // doesn't report processed items
+    size_t m_completionChunkSize = 0;
+    // if set, then the items are passed to emitCompleted() in the order of
+    // the items, otherwise one by one as soon as they have been processed
+    bool m_orderedCompletion = true;
+    size_t m_itemCount = 0;
+    size_t m_finishedItems = 0;
+    std::vector<qint64> m_latencies;
+    // written by the worker threads; each thread only writes the entries of
+    // the items it processes
+    std::vector<GpgME::Error> m_itemErrors;
+    std::mutex m_contextErrorsMutex;
+    std::map<GpgME::Context *, GpgME::Error> m_contextErrors;
+    std::atomic<bool> m_hasContextErrors{false};
+    // the processed items; the items before m_nextUnprocessed have all been
+    // processed and the items before m_nextCompleted have been reported
+    std::vector<bool> m_processedItems;
+    size_t m_nextUnprocessed = 0;
+    size_t m_nextCompleted = 0;
+    bool m_canceled = false;
+    bool m_finished = false;
+};
+
+namespace _detail
+{
+// Returns the initial results of count items; the items that are never
+// processed because of a cancellation keep these results
+template<typename T_result>
+std::vector<T_result> canceledResults(size_t count)
+{
+    return std::vector<T_result>(count, T_result{GpgME::Error::fromCode(GPG_ERR_CANCELED)});
+}
+}
+
+}
+
+#endif // __QGPGME_POOLEDJOB_P_H__
@@ -39,18 +39,47 @@
 #include "qgpgmedecryptjob.h"
 
 #include "dataprovider.h"
+#include "decryptjob_p.h"
+#include "jobthroughput.h"
+#include "sessionkeycache_p.h"
 
 #include <gpgme++/context.h>
 #include <gpgme++/decryptionresult.h>
 #include <gpgme++/data.h>
 
-#include <QBuffer>
-
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
+namespace QGpgME
+{
+
+class QGpgMEDecryptJobPrivate : public DecryptJobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QGpgMEDecryptJob)
+
+    QGpgMEDecryptJobPrivate() = default;
+
+    ~QGpgMEDecryptJobPrivate() override = default;
+
+private:
+    GpgME::Error startIt() override
+    {
+        Q_ASSERT(!"Not supported by this Job class.");
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+
+    GpgME::DecryptionResult exec(const QByteArray &cipherText, GpgME::DataProvider &plainText) override;
+
+    void startNow() override
+    {
+        Q_Q(QGpgMEDecryptJob);
+        q->run();
+    }
+};
+
+}
+
 QGpgMEDecryptJob::QGpgMEDecryptJob(Context *context)
     : mixin_type(context)
 {
@@ -59,9 +88,25 @@ QGpgMEDecryptJob::QGpgMEDecryptJob(Context *context)
 
 QGpgMEDecryptJob::~QGpgMEDecryptJob() {}
 
+static QGpgMEDecryptJob::result_type decrypt_data(Context *ctx, Data &indata, DataProvider &out, qint64 sizeHint)
+{
+    if (sizeHint > 0) {
+        indata.setSizeHint(sizeHint);
+    }
+
+    Data outdata(&out);
+
+    const DecryptionResult res = ctx->decrypt(indata, outdata);
+    Error ae;
+    const QString log = _detail::audit_log_as_html(ctx, ae);
+    return std::make_tuple(res, QByteArray(), log, ae);
+}
+
 static QGpgMEDecryptJob::result_type decrypt(Context *ctx, QThread *thread,
                                              const std::weak_ptr<QIODevice> &cipherText_,
-                                             const std::weak_ptr<QIODevice> &plainText_)
+                                             const std::weak_ptr<QIODevice> &plainText_,
+                                             qint64 inputSizeHint,
+                                             const std::shared_ptr<JobThroughput> &throughput)
 {
 
     const std::shared_ptr<QIODevice> cipherText = cipherText_.lock();
@@ -72,56 +117,76 @@ static QGpgMEDecryptJob::result_type decrypt(Context *ctx, QThread *thread,
 
     QGpgME::QIODeviceDataProvider in(cipherText);
     Data indata(&in);
-    if (!cipherText->isSequential()) {
-        indata.setSizeHint(cipherText->size());
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : !cipherText->isSequential() ? cipherText->size() : 0;
+    in.setThroughput(throughput);
+    if (throughput && sizeHint > 0) {
+        throughput->setTotalBytes(sizeHint);
     }
 
     if (!plainText) {
         QGpgME::QByteArrayDataProvider out;
-        Data outdata(&out);
-
-        const DecryptionResult res = ctx->decrypt(indata, outdata);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, out.data(), log, ae);
+        out.reserve(sizeHint);
+        auto result = decrypt_data(ctx, indata, out, sizeHint);
+        std::get<1>(result) = out.data();
+        return result;
     } else {
         QGpgME::QIODeviceDataProvider out(plainText);
-        Data outdata(&out);
-
-        const DecryptionResult res = ctx->decrypt(indata, outdata);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, QByteArray(), log, ae);
+        out.setThroughput(throughput);
+        return decrypt_data(ctx, indata, out, sizeHint);
     }
+}
 
+static QGpgMEDecryptJob::result_type decrypt_qba_to_provider(Context *ctx, const QByteArray &cipherText, DataProvider &plainText, qint64 sizeHint,
+                                                             const std::shared_ptr<SessionKeyCache> &sessionKeyCache)
+{
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(cipherText);
+    Data indata(&in);
+
+    const QByteArray messageId = sessionKeyCache ? SessionKeyCache::messageId(cipherText) : QByteArray{};
+    return _detail::decryptWithSessionKeyCache(ctx, sessionKeyCache.get(), messageId, indata, plainText, [&]() {
+        return decrypt_data(ctx, indata, plainText, sizeHint);
+    });
 }
 
-static QGpgMEDecryptJob::result_type decrypt_qba(Context *ctx, const QByteArray &cipherText)
+static QGpgMEDecryptJob::result_type decrypt_qba(Context *ctx, const QByteArray &cipherText, qint64 inputSizeHint,
+                                                 const std::shared_ptr<SessionKeyCache> &sessionKeyCache)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(cipherText);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
-    }
-    return decrypt(ctx, nullptr, buffer, std::shared_ptr<QIODevice>());
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : cipherText.size();
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(sizeHint);
+    auto result = decrypt_qba_to_provider(ctx, cipherText, out, sizeHint, sessionKeyCache);
+    std::get<1>(result) = out.data();
+    return result;
 }
 
 Error QGpgMEDecryptJob::start(const QByteArray &cipherText)
 {
-    run(std::bind(&decrypt_qba, std::placeholders::_1, cipherText));
+    run(std::bind(&decrypt_qba, std::placeholders::_1, cipherText, inputSizeHint(), sessionKeyCache()));
     return Error();
 }
 
 void QGpgMEDecryptJob::start(const std::shared_ptr<QIODevice> &cipherText, const std::shared_ptr<QIODevice> &plainText)
 {
-    run(std::bind(&decrypt, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), cipherText, plainText);
+    run(std::bind(&decrypt, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, inputSizeHint(), throughput()), cipherText, plainText);
 }
 
 GpgME::DecryptionResult QGpgME::QGpgMEDecryptJob::exec(const QByteArray &cipherText,
         QByteArray &plainText)
 {
-    const result_type r = decrypt_qba(context(), cipherText);
-    plainText = std::get<1>(r);
+    // write directly into the caller's byte array to reuse its memory
+    const qint64 sizeHint = inputSizeHint() > 0 ? inputSizeHint() : cipherText.size();
+    QGpgME::QByteArraySinkDataProvider out(plainText);
+    out.reserve(sizeHint);
+    const result_type r = decrypt_qba_to_provider(context(), cipherText, out, sizeHint, sessionKeyCache());
+    return std::get<0>(r);
+}
+
+GpgME::DecryptionResult QGpgMEDecryptJobPrivate::exec(const QByteArray &cipherText, DataProvider &plainText)
+{
+    Q_Q(QGpgMEDecryptJob);
+    const qint64 sizeHint = m_inputSizeHint > 0 ? m_inputSizeHint : cipherText.size();
+    const auto r = decrypt_qba_to_provider(q->context(), cipherText, plainText, sizeHint, m_sessionKeyCache);
     return std::get<0>(r);
 }
 
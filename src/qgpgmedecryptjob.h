@@ -44,11 +44,13 @@
 namespace QGpgME
 {
 
+class QGpgMEDecryptJobPrivate;
+
 class QGpgMEDecryptJob
 #ifdef Q_MOC_RUN
     : public DecryptJob
 #else
-    : public _detail::ThreadedJobMixin<DecryptJob, void, std::tuple<GpgME::DecryptionResult, QByteArray, QString, GpgME::Error> >
+    : public _detail::ThreadedJobMixin<DecryptJob, QGpgMEDecryptJobPrivate, std::tuple<GpgME::DecryptionResult, QByteArray, QString, GpgME::Error> >
 #endif
 {
     Q_OBJECT
@@ -69,6 +71,11 @@ public:
     /* from DecryptJob */
     GpgME::DecryptionResult exec(const QByteArray &cipherText,
                                  QByteArray &plainText) override;
+
+    using DecryptJob::exec;
+
+private:
+    Q_DECLARE_PRIVATE(QGpgMEDecryptJob)
 };
 
 }
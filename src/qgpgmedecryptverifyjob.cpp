@@ -41,6 +41,8 @@
 #include "dataprovider.h"
 #include "debug.h"
 #include "decryptverifyjob_p.h"
+#include "jobthroughput.h"
+#include "sessionkeycache_p.h"
 #include "util.h"
 
 #include <gpgme++/context.h>
@@ -51,11 +53,8 @@
 #include <QDebug>
 #include "qgpgme_debug.h"
 
-#include <QBuffer>
 #include <QFile>
 
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -74,6 +73,9 @@ public:
 private:
     GpgME::Error startIt() override;
 
+    std::pair<GpgME::DecryptionResult, GpgME::VerificationResult> exec(const QByteArray &cipherText,
+                                                                       GpgME::DataProvider &plainText) override;
+
     void startNow() override
     {
         Q_Q(QGpgMEDecryptVerifyJob);
@@ -91,9 +93,26 @@ QGpgMEDecryptVerifyJob::QGpgMEDecryptVerifyJob(Context *context)
 
 QGpgMEDecryptVerifyJob::~QGpgMEDecryptVerifyJob() {}
 
+static QGpgMEDecryptVerifyJob::result_type decrypt_verify_data(Context *ctx, Data &indata, DataProvider &out, qint64 sizeHint)
+{
+    if (sizeHint > 0) {
+        indata.setSizeHint(sizeHint);
+    }
+
+    Data outdata(&out);
+
+    const std::pair<DecryptionResult, VerificationResult> res = ctx->decryptAndVerify(indata, outdata);
+    Error ae;
+    const QString log = _detail::audit_log_as_html(ctx, ae);
+    qCDebug(QGPGME_LOG) << __func__ << "- End. Error:" << ae;
+    return std::make_tuple(res.first, res.second, QByteArray(), log, ae);
+}
+
 static QGpgMEDecryptVerifyJob::result_type decrypt_verify(Context *ctx, QThread *thread,
                                                           const std::weak_ptr<QIODevice> &cipherText_,
-                                                          const std::weak_ptr<QIODevice> &plainText_)
+                                                          const std::weak_ptr<QIODevice> &plainText_,
+                                                          qint64 inputSizeHint,
+                                                          const std::shared_ptr<JobThroughput> &throughput)
 {
     qCDebug(QGPGME_LOG) << __func__;
 
@@ -105,39 +124,49 @@ static QGpgMEDecryptVerifyJob::result_type decrypt_verify(Context *ctx, QThread
 
     QGpgME::QIODeviceDataProvider in(cipherText);
     Data indata(&in);
-    if (!cipherText->isSequential()) {
-        indata.setSizeHint(cipherText->size());
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : !cipherText->isSequential() ? cipherText->size() : 0;
+    in.setThroughput(throughput);
+    if (throughput && sizeHint > 0) {
+        throughput->setTotalBytes(sizeHint);
     }
 
     if (!plainText) {
         QGpgME::QByteArrayDataProvider out;
-        Data outdata(&out);
-
-        const std::pair<DecryptionResult, VerificationResult> res = ctx->decryptAndVerify(indata, outdata);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        qCDebug(QGPGME_LOG) << __func__ << "- End no plainText. Error:" << ae;
-        return std::make_tuple(res.first, res.second, out.data(), log, ae);
+        out.reserve(sizeHint);
+        auto result = decrypt_verify_data(ctx, indata, out, sizeHint);
+        std::get<2>(result) = out.data();
+        return result;
     } else {
         QGpgME::QIODeviceDataProvider out(plainText);
-        Data outdata(&out);
-
-        const std::pair<DecryptionResult, VerificationResult> res = ctx->decryptAndVerify(indata, outdata);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        qCDebug(QGPGME_LOG) << __func__ << "- End plainText. Error:" << ae;
-        return std::make_tuple(res.first, res.second, QByteArray(), log, ae);
+        out.setThroughput(throughput);
+        return decrypt_verify_data(ctx, indata, out, sizeHint);
     }
 }
 
-static QGpgMEDecryptVerifyJob::result_type decrypt_verify_qba(Context *ctx, const QByteArray &cipherText)
+static QGpgMEDecryptVerifyJob::result_type decrypt_verify_qba_to_provider(Context *ctx, const QByteArray &cipherText, DataProvider &plainText, qint64 sizeHint,
+                                                                          const std::shared_ptr<SessionKeyCache> &sessionKeyCache)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(cipherText);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
-    }
-    return decrypt_verify(ctx, nullptr, buffer, std::shared_ptr<QIODevice>());
+    qCDebug(QGPGME_LOG) << __func__;
+
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(cipherText);
+    Data indata(&in);
+
+    const QByteArray messageId = sessionKeyCache ? SessionKeyCache::messageId(cipherText) : QByteArray{};
+    return _detail::decryptWithSessionKeyCache(ctx, sessionKeyCache.get(), messageId, indata, plainText, [&]() {
+        return decrypt_verify_data(ctx, indata, plainText, sizeHint);
+    });
+}
+
+static QGpgMEDecryptVerifyJob::result_type decrypt_verify_qba(Context *ctx, const QByteArray &cipherText, qint64 inputSizeHint,
+                                                              const std::shared_ptr<SessionKeyCache> &sessionKeyCache)
+{
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : cipherText.size();
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(sizeHint);
+    auto result = decrypt_verify_qba_to_provider(ctx, cipherText, out, sizeHint, sessionKeyCache);
+    std::get<2>(result) = out.data();
+    return result;
 }
 
 static QGpgMEDecryptVerifyJob::result_type decrypt_verify_from_filename(Context *ctx,
@@ -186,7 +215,7 @@ Error QGpgMEDecryptVerifyJob::start(const QByteArray &cipherText)
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    run(std::bind(&decrypt_verify_qba, std::placeholders::_1, cipherText));
+    run(std::bind(&decrypt_verify_qba, std::placeholders::_1, cipherText, inputSizeHint(), sessionKeyCache()));
     return Error();
 }
 
@@ -195,7 +224,7 @@ void QGpgMEDecryptVerifyJob::start(const std::shared_ptr<QIODevice> &cipherText,
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    run(std::bind(&decrypt_verify, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), cipherText, plainText);
+    run(std::bind(&decrypt_verify, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, inputSizeHint(), throughput()), cipherText, plainText);
 }
 
 std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
@@ -204,8 +233,23 @@ QGpgME::QGpgMEDecryptVerifyJob::exec(const QByteArray &cipherText, QByteArray &p
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    const result_type r = decrypt_verify_qba(context(), cipherText);
-    plainText = std::get<2>(r);
+    // write directly into the caller's byte array to reuse its memory
+    const qint64 sizeHint = inputSizeHint() > 0 ? inputSizeHint() : cipherText.size();
+    QGpgME::QByteArraySinkDataProvider out(plainText);
+    out.reserve(sizeHint);
+    const result_type r = decrypt_verify_qba_to_provider(context(), cipherText, out, sizeHint, sessionKeyCache());
+    return std::make_pair(std::get<0>(r), std::get<1>(r));
+}
+
+std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
+QGpgMEDecryptVerifyJobPrivate::exec(const QByteArray &cipherText, DataProvider &plainText)
+{
+    Q_Q(QGpgMEDecryptVerifyJob);
+    if (m_processAllSignatures) {
+        q->context()->setFlag("proc-all-sigs", "1");
+    }
+    const qint64 sizeHint = m_inputSizeHint > 0 ? m_inputSizeHint : cipherText.size();
+    const auto r = decrypt_verify_qba_to_provider(q->context(), cipherText, plainText, sizeHint, m_sessionKeyCache);
     return std::make_pair(std::get<0>(r), std::get<1>(r));
 }
 
@@ -73,6 +73,8 @@ public:
     std::pair<GpgME::DecryptionResult, GpgME::VerificationResult>
     exec(const QByteArray &cipherText, QByteArray &plainText) override;
 
+    using DecryptVerifyJob::exec;
+
 private:
     Q_DECLARE_PRIVATE(QGpgMEDecryptVerifyJob)
 };
@@ -40,9 +40,11 @@
 
 #include "qgpgmeencryptarchivejob.h"
 
+#include "compressionprobe_p.h"
 #include "dataprovider.h"
 #include "encryptarchivejob_p.h"
 #include "filelistdataprovider.h"
+#include "jobthroughput.h"
 #include "qgpgme_debug.h"
 #include "util.h"
 
@@ -50,6 +52,8 @@
 
 #include <gpgme++/data.h>
 
+#include <memory>
+
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -82,19 +86,22 @@ QGpgMEEncryptArchiveJob::QGpgMEEncryptArchiveJob(Context *context)
 {
     lateInitialization();
     connect(this, &Job::rawProgress, this, [this](const QString &what, int type, int current, int total) {
-        emitArchiveProgressSignals(this, what, type, current, total);
+        emitArchiveProgressSignals(this, what, type, current, total, inputFileCountHint(), inputSizeHint());
     });
 }
 
 static QGpgMEEncryptArchiveJob::result_type encrypt(Context *ctx,
                                                     const std::vector<Key> &recipients,
                                                     const std::vector<QString> &paths,
+                                                    const std::function<QString()> &pathGenerator,
                                                     GpgME::Data &outdata,
                                                     Context::EncryptionFlags flags,
                                                     const QString &baseDirectory)
 {
-    QGpgME::FileListDataProvider in{paths};
-    Data indata(&in);
+    // with a generator the paths are fetched while gpgtar reads them
+    const auto in = pathGenerator ? std::make_unique<QGpgME::FileListDataProvider>(pathGenerator)
+                                  : std::make_unique<QGpgME::FileListDataProvider>(paths);
+    Data indata(in.get());
     if (!baseDirectory.isEmpty()) {
         indata.setFileName(baseDirectory.toStdString());
     }
@@ -113,19 +120,23 @@ static QGpgMEEncryptArchiveJob::result_type encrypt_to_io_device(Context *ctx,
                                                                  const std::vector<QString> &paths,
                                                                  const std::weak_ptr<QIODevice> &cipherText_,
                                                                  Context::EncryptionFlags flags,
-                                                                 const QString &baseDirectory)
+                                                                 const QString &baseDirectory,
+                                                                 const std::shared_ptr<JobThroughput> &throughput)
 {
     const std::shared_ptr<QIODevice> cipherText = cipherText_.lock();
     const _detail::ToThreadMover ctMover(cipherText, thread);
     QGpgME::QIODeviceDataProvider out{cipherText};
+    // gpgtar reads the files itself; only the output can be observed
+    out.setThroughput(throughput);
     Data outdata(&out);
 
-    return encrypt(ctx, recipients, paths, outdata, flags, baseDirectory);
+    return encrypt(ctx, recipients, paths, {}, outdata, flags, baseDirectory);
 }
 
 static QGpgMEEncryptArchiveJob::result_type encrypt_to_filename(Context *ctx,
                                                                 const std::vector<Key> &recipients,
                                                                 const std::vector<QString> &paths,
+                                                                const std::function<QString()> &pathGenerator,
                                                                 const QString &outputFileName,
                                                                 Context::EncryptionFlags flags,
                                                                 const QString &baseDirectory)
@@ -142,7 +153,7 @@ static QGpgMEEncryptArchiveJob::result_type encrypt_to_filename(Context *ctx,
     outdata.setFileName(QFile::encodeName(partFileGuard.tempFileName()).constData());
 #endif
 
-    const auto result = encrypt(ctx, recipients, paths, outdata, flags, baseDirectory);
+    const auto result = encrypt(ctx, recipients, paths, pathGenerator, outdata, flags, baseDirectory);
     const auto &encryptionResult = std::get<0>(result);
     if (!encryptionResult.error().code()) {
         // the operation succeeded -> save the result under the requested file name
@@ -155,21 +166,21 @@ static QGpgMEEncryptArchiveJob::result_type encrypt_to_filename(Context *ctx,
 GpgME::Error QGpgMEEncryptArchiveJob::start(const std::vector<GpgME::Key> &recipients,
                                             const std::vector<QString> &paths,
                                             const std::shared_ptr<QIODevice> &cipherText,
-                                            const GpgME::Context::EncryptionFlags flags)
+                                            GpgME::Context::EncryptionFlags flags)
 {
     if (!cipherText) {
         return Error::fromCode(GPG_ERR_INV_VALUE);
     }
 
-    run(std::bind(&encrypt_to_io_device,
-                  std::placeholders::_1,
-                  std::placeholders::_2,
-                  recipients,
-                  paths,
-                  std::placeholders::_3,
-                  flags,
-                  baseDirectory()),
-        cipherText);
+    Q_D(QGpgMEEncryptArchiveJob);
+    run([d, recipients, paths, flags, baseDir = baseDirectory(), jobThroughput = throughput()]
+        (Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &cipherText_) {
+        // the files are probed in the job's thread
+        const auto eflags = _detail::disableCompressionIfIncompressible(flags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&paths, &baseDir]() {
+            return _detail::filesLookIncompressible(paths, baseDir);
+        });
+        return encrypt_to_io_device(ctx, thread, recipients, paths, cipherText_, eflags, baseDir, jobThroughput);
+    }, cipherText);
     return {};
 }
 
@@ -181,7 +192,12 @@ GpgME::Error QGpgMEEncryptArchiveJobPrivate::startIt()
 
     Q_Q(QGpgMEEncryptArchiveJob);
     q->run([=](Context *ctx) {
-        return encrypt_to_filename(ctx, m_recipients, m_inputPaths, m_outputFilePath, m_encryptionFlags, m_baseDirectory);
+        // the files are probed in the job's thread; the paths of a generator
+        // are only known while the archive is created
+        const auto flags = _detail::disableCompressionIfIncompressible(m_encryptionFlags, m_detectIncompressibleInput && !m_inputPathGenerator, m_incompressibleInputDetected, [this]() {
+            return _detail::filesLookIncompressible(m_inputPaths, m_baseDirectory);
+        });
+        return encrypt_to_filename(ctx, m_recipients, m_inputPaths, m_inputPathGenerator, m_outputFilePath, flags, m_baseDirectory);
     });
 
     return {};
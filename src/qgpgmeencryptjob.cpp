@@ -40,19 +40,19 @@
 
 #include "qgpgmeencryptjob.h"
 
+#include "compressionprobe_p.h"
 #include "dataprovider.h"
+#include "encryptionrecipients_p.h"
 #include "encryptjob_p.h"
+#include "jobthroughput.h"
 #include "util.h"
 
 #include <gpgme++/context.h>
 #include <gpgme++/data.h>
 #include <gpgme++/encryptionresult.h>
 
-#include <QBuffer>
 #include <QFileInfo>
 
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -71,6 +71,9 @@ public:
 private:
     GpgME::Error startIt() override;
 
+    GpgME::EncryptionResult exec(const std::vector<GpgME::Key> &recipients, const QByteArray &plainText,
+                                 GpgME::Context::EncryptionFlags flags, GpgME::DataProvider &cipherText) override;
+
     void startNow() override
     {
         Q_Q(QGpgMEEncryptJob);
@@ -94,6 +97,39 @@ void QGpgMEEncryptJob::setOutputIsBase64Encoded(bool on)
     mOutputIsBase64Encoded = on;
 }
 
+static QGpgMEEncryptJob::result_type encrypt_data(Context *ctx,
+        const std::vector<Key> &recipients,
+        Data &indata,
+        DataProvider &out,
+        const Context::EncryptionFlags eflags,
+        bool outputIsBase64Encoded,
+        Data::Encoding inputEncoding,
+        const QString &fileName,
+        qint64 sizeHint)
+{
+    indata.setEncoding(inputEncoding);
+
+    if (sizeHint > 0) {
+        indata.setSizeHint(sizeHint);
+    }
+
+    const auto pureFileName = QFileInfo{fileName}.fileName().toStdString();
+    if (!pureFileName.empty()) {
+        indata.setFileName(pureFileName.c_str());
+    }
+
+    Data outdata(&out);
+
+    if (outputIsBase64Encoded) {
+        outdata.setEncoding(Data::Base64Encoding);
+    }
+
+    const EncryptionResult res = ctx->encrypt(recipients, indata, outdata, eflags);
+    Error ae;
+    const QString log = _detail::audit_log_as_html(ctx, ae);
+    return std::make_tuple(res, QByteArray(), log, ae);
+}
+
 static QGpgMEEncryptJob::result_type encrypt(Context *ctx, QThread *thread,
         const std::vector<Key> &recipients,
         const std::weak_ptr<QIODevice> &plainText_,
@@ -101,7 +137,9 @@ static QGpgMEEncryptJob::result_type encrypt(Context *ctx, QThread *thread,
         const Context::EncryptionFlags eflags,
         bool outputIsBase64Encoded,
         Data::Encoding inputEncoding,
-        const QString &fileName)
+        const QString &fileName,
+        qint64 inputSizeHint,
+        const std::shared_ptr<JobThroughput> &throughput)
 {
 
     const std::shared_ptr<QIODevice> plainText = plainText_.lock();
@@ -112,53 +150,42 @@ static QGpgMEEncryptJob::result_type encrypt(Context *ctx, QThread *thread,
 
     QGpgME::QIODeviceDataProvider in(plainText);
     Data indata(&in);
-    indata.setEncoding(inputEncoding);
-
-    if (!plainText->isSequential()) {
-        indata.setSizeHint(plainText->size());
-    }
-
-    const auto pureFileName = QFileInfo{fileName}.fileName().toStdString();
-    if (!pureFileName.empty()) {
-        indata.setFileName(pureFileName.c_str());
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : !plainText->isSequential() ? plainText->size() : 0;
+    in.setThroughput(throughput);
+    if (throughput && sizeHint > 0) {
+        throughput->setTotalBytes(sizeHint);
     }
 
     if (!cipherText) {
         QGpgME::QByteArrayDataProvider out;
-        Data outdata(&out);
-
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
-        }
-
-        const EncryptionResult res = ctx->encrypt(recipients, indata, outdata, eflags);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, out.data(), log, ae);
+        out.reserve(sizeHint);
+        auto result = encrypt_data(ctx, recipients, indata, out, eflags, outputIsBase64Encoded, inputEncoding, fileName, sizeHint);
+        std::get<1>(result) = out.data();
+        return result;
     } else {
         QGpgME::QIODeviceDataProvider out(cipherText);
-        Data outdata(&out);
-
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
-        }
-
-        const EncryptionResult res = ctx->encrypt(recipients, indata, outdata, eflags);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, QByteArray(), log, ae);
+        out.setThroughput(throughput);
+        return encrypt_data(ctx, recipients, indata, out, eflags, outputIsBase64Encoded, inputEncoding, fileName, sizeHint);
     }
+}
 
+static QGpgMEEncryptJob::result_type encrypt_qba_to_provider(Context *ctx, const std::vector<Key> &recipients, const QByteArray &plainText, DataProvider &cipherText, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, Data::Encoding inputEncoding, const QString &fileName, qint64 sizeHint)
+{
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(plainText);
+    Data indata(&in);
+
+    return encrypt_data(ctx, recipients, indata, cipherText, eflags, outputIsBase64Encoded, inputEncoding, fileName, sizeHint);
 }
 
-static QGpgMEEncryptJob::result_type encrypt_qba(Context *ctx, const std::vector<Key> &recipients, const QByteArray &plainText, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, Data::Encoding inputEncoding, const QString &fileName)
+static QGpgMEEncryptJob::result_type encrypt_qba(Context *ctx, const std::vector<Key> &recipients, const QByteArray &plainText, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, Data::Encoding inputEncoding, const QString &fileName, qint64 inputSizeHint)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(plainText);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
-    }
-    return encrypt(ctx, nullptr, recipients, buffer, std::shared_ptr<QIODevice>(), eflags, outputIsBase64Encoded, inputEncoding, fileName);
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : plainText.size();
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(sizeHint);
+    auto result = encrypt_qba_to_provider(ctx, recipients, plainText, out, eflags, outputIsBase64Encoded, inputEncoding, fileName, sizeHint);
+    std::get<1>(result) = out.data();
+    return result;
 }
 
 static QGpgMEEncryptJob::result_type encrypt_to_filename(Context *ctx,
@@ -201,31 +228,68 @@ static QGpgMEEncryptJob::result_type encrypt_to_filename(Context *ctx,
 
 Error QGpgMEEncryptJob::start(const std::vector<Key> &recipients, const QByteArray &plainText, bool alwaysTrust)
 {
+    Q_D(QGpgMEEncryptJob);
     const auto flags = static_cast<Context::EncryptionFlags>((alwaysTrust ? Context::AlwaysTrust : Context::None) | (encryptionFlags() & ~Context::EncryptFile));
 
-    run(std::bind(&encrypt_qba, std::placeholders::_1, recipients, plainText, flags , mOutputIsBase64Encoded, inputEncoding(), fileName()));
+    run([d, recipients, plainText, flags, encryptionRecipients = d->m_encryptionRecipients, base64 = mOutputIsBase64Encoded,
+         encoding = inputEncoding(), inputFileName = fileName(), sizeHint = inputSizeHint()](Context *ctx) {
+        // the input is probed and the recipients are validated in the job's thread
+        auto eflags = _detail::disableCompressionIfIncompressible(flags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText]() {
+            return _detail::looksIncompressible(plainText);
+        });
+        auto recipientKeys = recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, eflags);
+        return encrypt_qba(ctx, recipientKeys, plainText, eflags, base64, encoding, inputFileName, sizeHint);
+    });
     return Error();
 }
 
 void QGpgMEEncryptJob::start(const std::vector<Key> &recipients, const std::shared_ptr<QIODevice> &plainText,
-                             const std::shared_ptr<QIODevice> &cipherText, const Context::EncryptionFlags eflags)
+                             const std::shared_ptr<QIODevice> &cipherText, Context::EncryptionFlags eflags)
 {
-    run(std::bind(&encrypt,
-                    std::placeholders::_1, std::placeholders::_2,
-                    recipients,
-                    std::placeholders::_3, std::placeholders::_4,
-                    eflags,
-                    mOutputIsBase64Encoded,
-                    inputEncoding(),
-                    fileName()),
-        plainText, cipherText);
+    Q_D(QGpgMEEncryptJob);
+    run([d, recipients, eflags, encryptionRecipients = d->m_encryptionRecipients, base64 = mOutputIsBase64Encoded,
+         encoding = inputEncoding(), inputFileName = fileName(), sizeHint = inputSizeHint(), jobThroughput = throughput()]
+        (Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &plainText_, const std::weak_ptr<QIODevice> &cipherText_) {
+        // the input is probed in the job's thread, which the device has been
+        // moved to, and the recipients are validated there
+        auto flags = _detail::disableCompressionIfIncompressible(eflags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText_]() {
+            return _detail::looksIncompressible(plainText_.lock().get());
+        });
+        auto recipientKeys = recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, flags);
+        return encrypt(ctx, thread, recipientKeys, plainText_, cipherText_, flags, base64, encoding, inputFileName, sizeHint, jobThroughput);
+    }, plainText, cipherText);
 }
 
 EncryptionResult QGpgMEEncryptJob::exec(const std::vector<Key> &recipients, const QByteArray &plainText,
-                                        const Context::EncryptionFlags eflags, QByteArray &cipherText)
+                                        Context::EncryptionFlags eflags, QByteArray &cipherText)
 {
-    const result_type r = encrypt_qba(context(), recipients, plainText, eflags, mOutputIsBase64Encoded, inputEncoding(), fileName());
-    cipherText = std::get<1>(r);
+    Q_D(QGpgMEEncryptJob);
+    eflags = _detail::disableCompressionIfIncompressible(eflags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText]() {
+        return _detail::looksIncompressible(plainText);
+    });
+    auto recipientKeys = recipients;
+    _detail::useEncryptionRecipients(d->m_encryptionRecipients.get(), recipientKeys, eflags);
+    // write directly into the caller's byte array to reuse its memory
+    const qint64 sizeHint = inputSizeHint() > 0 ? inputSizeHint() : plainText.size();
+    QGpgME::QByteArraySinkDataProvider out(cipherText);
+    out.reserve(sizeHint);
+    const result_type r = encrypt_qba_to_provider(context(), recipientKeys, plainText, out, eflags, mOutputIsBase64Encoded, inputEncoding(), fileName(), sizeHint);
+    return std::get<0>(r);
+}
+
+EncryptionResult QGpgMEEncryptJobPrivate::exec(const std::vector<Key> &recipients, const QByteArray &plainText,
+                                               Context::EncryptionFlags eflags, DataProvider &cipherText)
+{
+    Q_Q(QGpgMEEncryptJob);
+    eflags = _detail::disableCompressionIfIncompressible(eflags, m_detectIncompressibleInput, m_incompressibleInputDetected, [&plainText]() {
+        return _detail::looksIncompressible(plainText);
+    });
+    auto recipientKeys = recipients;
+    _detail::useEncryptionRecipients(m_encryptionRecipients.get(), recipientKeys, eflags);
+    const qint64 sizeHint = m_inputSizeHint > 0 ? m_inputSizeHint : plainText.size();
+    const auto r = encrypt_qba_to_provider(q->context(), recipientKeys, plainText, cipherText, eflags, q->mOutputIsBase64Encoded, m_inputEncoding, m_fileName, sizeHint);
     return std::get<0>(r);
 }
 
@@ -250,8 +314,14 @@ GpgME::Error QGpgMEEncryptJobPrivate::startIt()
     }
 
     Q_Q(QGpgMEEncryptJob);
-    q->run([=](Context *ctx) {
-        return encrypt_to_filename(ctx, m_recipients, m_inputFilePath, m_outputFilePath, m_encryptionFlags);
+    q->run([=, encryptionRecipients = m_encryptionRecipients](Context *ctx) {
+        // the input is probed and the recipients are validated in the job's thread
+        auto eflags = _detail::disableCompressionIfIncompressible(m_encryptionFlags, m_detectIncompressibleInput, m_incompressibleInputDetected, [this]() {
+            return _detail::fileLooksIncompressible(m_inputFilePath);
+        });
+        auto recipientKeys = m_recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, eflags);
+        return encrypt_to_filename(ctx, recipientKeys, m_inputFilePath, m_outputFilePath, eflags);
     });
 
     return {};
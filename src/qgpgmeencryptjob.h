@@ -88,6 +88,8 @@ public:
                                  const QByteArray &plainText, const GpgME::Context::EncryptionFlags flags,
                                  QByteArray &cipherText) override;
 
+    using EncryptJob::exec;
+
     /* from EncryptJob */
     void setOutputIsBase64Encoded(bool on) override;
 
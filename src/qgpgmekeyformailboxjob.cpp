@@ -38,6 +38,8 @@
 #include "qgpgmekeyformailboxjob.h"
 #include "qgpgmekeylistjob.h"
 
+#include "singleflight_p.h"
+
 #include <QStringList>
 
 #include <tuple>
@@ -47,6 +49,7 @@ using namespace QGpgME;
 
 QGpgMEKeyForMailboxJob::QGpgMEKeyForMailboxJob(Context *context)
     : mixin_type(context)
+    , mCanceled(std::make_shared<std::atomic<bool>>(false))
 {
     lateInitialization();
 }
@@ -127,10 +130,26 @@ static QGpgMEKeyForMailboxJob::result_type do_work(Context *ctx, const QString &
 
 Error QGpgMEKeyForMailboxJob::start(const QString &mailbox, bool canEncrypt)
 {
-    run(std::bind(&do_work, std::placeholders::_1, mailbox, canEncrypt));
+    auto work = std::bind(&do_work, std::placeholders::_1, mailbox, canEncrypt);
+    if (_detail::keyListCoalescingEnabled()) {
+        // do_work sets the key list mode itself
+        static _detail::SingleFlightGroup<result_type> group;
+        const auto id = _detail::keyListRequestId(context(), 0, {mailbox.toLower()},
+                                                  canEncrypt ? QByteArrayLiteral("mailbox-encrypt") : QByteArrayLiteral("mailbox"));
+        run(group.join(id, work, mCanceled));
+    } else {
+        run(work);
+    }
     return Error();
 }
 
+void QGpgMEKeyForMailboxJob::slotCancel()
+{
+    // stops waiting for the result of an identical request
+    *mCanceled = true;
+    mixin_type::slotCancel();
+}
+
 KeyListResult QGpgMEKeyForMailboxJob::exec(const QString &mailbox, bool canEncrypt, Key &key, UserID &uid)
 {
     const result_type r = do_work(context(), mailbox, canEncrypt);
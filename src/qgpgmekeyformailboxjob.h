@@ -42,6 +42,9 @@
 #include <gpgme++/keylistresult.h>
 #include <gpgme++/key.h>
 
+#include <atomic>
+#include <memory>
+
 namespace QGpgME
 {
 
@@ -74,6 +77,12 @@ public:
     GpgME::Error start(const QString &mailbox, bool canEncrypt = true) override;
 
     GpgME::KeyListResult exec(const QString &mailbox, bool canEncrypt, GpgME::Key &key, GpgME::UserID &uid) override;
+
+    /* from Job */
+    void slotCancel() override;
+
+private:
+    std::shared_ptr<std::atomic<bool>> mCanceled;
 };
 
 }
@@ -38,6 +38,8 @@
 
 #include "qgpgmekeylistjob.h"
 
+#include "singleflight_p.h"
+
 #include <gpgme++/key.h>
 #include <gpgme++/context.h>
 #include <gpgme++/keylistresult.h>
@@ -57,6 +59,7 @@ using namespace GpgME;
 QGpgMEKeyListJob::QGpgMEKeyListJob(Context *context)
     : mixin_type(context)
     , mSecretOnly(false)
+    , mCanceled(std::make_shared<std::atomic<bool>>(false))
 {
     lateInitialization();
 }
@@ -136,7 +139,15 @@ retry:
 Error QGpgMEKeyListJob::start(const QStringList &patterns, bool secretOnly)
 {
     mSecretOnly = secretOnly;
-    run(std::bind(&list_keys, std::placeholders::_1, patterns, secretOnly));
+    auto work = std::bind(&list_keys, std::placeholders::_1, patterns, secretOnly);
+    if (_detail::keyListCoalescingEnabled()) {
+        static _detail::SingleFlightGroup<result_type> group;
+        const auto id = _detail::keyListRequestId(context(), context()->keyListMode(), patterns,
+                                                  secretOnly ? QByteArrayLiteral("secret") : QByteArrayLiteral("public"));
+        run(group.join(id, work, mCanceled));
+    } else {
+        run(work);
+    }
     return Error();
 }
 
@@ -156,6 +167,13 @@ void QGpgMEKeyListJob::resultHook(const result_type &tuple)
     }
 }
 
+void QGpgMEKeyListJob::slotCancel()
+{
+    // stops waiting for the result of an identical request
+    *mCanceled = true;
+    mixin_type::slotCancel();
+}
+
 void QGpgMEKeyListJob::addMode(KeyListMode mode)
 {
     context()->addKeyListMode(mode);
@@ -42,6 +42,9 @@
 #include <gpgme++/keylistresult.h>
 #include <gpgme++/key.h>
 
+#include <atomic>
+#include <memory>
+
 namespace QGpgME
 {
 
@@ -71,8 +74,12 @@ public:
 
     /* from ThreadedJobMixin */
     void resultHook(const result_type &result) override;
+
+    /* from Job */
+    void slotCancel() override;
 private:
     bool mSecretOnly;
+    std::shared_ptr<std::atomic<bool>> mCanceled;
 };
 
 }
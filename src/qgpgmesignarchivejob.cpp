@@ -43,6 +43,7 @@
 #include "dataprovider.h"
 #include "signarchivejob_p.h"
 #include "filelistdataprovider.h"
+#include "jobthroughput.h"
 #include "qgpgme_debug.h"
 #include "util.h"
 
@@ -50,6 +51,8 @@
 
 #include <gpgme++/data.h>
 
+#include <memory>
+
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -82,18 +85,21 @@ QGpgMESignArchiveJob::QGpgMESignArchiveJob(Context *context)
 {
     lateInitialization();
     connect(this, &Job::rawProgress, this, [this](const QString &what, int type, int current, int total) {
-        emitArchiveProgressSignals(this, what, type, current, total);
+        emitArchiveProgressSignals(this, what, type, current, total, inputFileCountHint(), inputSizeHint());
     });
 }
 
 static QGpgMESignArchiveJob::result_type sign(Context *ctx,
                                               const std::vector<Key> &signers,
                                               const std::vector<QString> &paths,
+                                              const std::function<QString()> &pathGenerator,
                                               GpgME::Data &outdata,
                                               const QString &baseDirectory)
 {
-    QGpgME::FileListDataProvider in{paths};
-    Data indata(&in);
+    // with a generator the paths are fetched while gpgtar reads them
+    const auto in = pathGenerator ? std::make_unique<QGpgME::FileListDataProvider>(pathGenerator)
+                                  : std::make_unique<QGpgME::FileListDataProvider>(paths);
+    Data indata(in.get());
     if (!baseDirectory.isEmpty()) {
         indata.setFileName(baseDirectory.toStdString());
     }
@@ -119,19 +125,23 @@ static QGpgMESignArchiveJob::result_type sign_to_io_device(Context *ctx,
                                                            const std::vector<Key> &signers,
                                                            const std::vector<QString> &paths,
                                                            const std::weak_ptr<QIODevice> &output_,
-                                                           const QString &baseDirectory)
+                                                           const QString &baseDirectory,
+                                                           const std::shared_ptr<JobThroughput> &throughput)
 {
     const std::shared_ptr<QIODevice> output = output_.lock();
     const _detail::ToThreadMover ctMover(output, thread);
     QGpgME::QIODeviceDataProvider out{output};
+    // gpgtar reads the files itself; only the output can be observed
+    out.setThroughput(throughput);
     Data outdata(&out);
 
-    return sign(ctx, signers, paths, outdata, baseDirectory);
+    return sign(ctx, signers, paths, {}, outdata, baseDirectory);
 }
 
 static QGpgMESignArchiveJob::result_type sign_to_filename(Context *ctx,
                                                           const std::vector<Key> &signers,
                                                           const std::vector<QString> &paths,
+                                                          const std::function<QString()> &pathGenerator,
                                                           const QString &outputFileName,
                                                           const QString &baseDirectory)
 {
@@ -147,7 +157,7 @@ static QGpgMESignArchiveJob::result_type sign_to_filename(Context *ctx,
     outdata.setFileName(QFile::encodeName(partFileGuard.tempFileName()).constData());
 #endif
 
-    const auto result = sign(ctx, signers, paths, outdata, baseDirectory);
+    const auto result = sign(ctx, signers, paths, pathGenerator, outdata, baseDirectory);
     const auto &signingResult = std::get<0>(result);
     if (!signingResult.error().code()) {
         // the operation succeeded -> save the result under the requested file name
@@ -171,7 +181,8 @@ GpgME::Error QGpgMESignArchiveJob::start(const std::vector<GpgME::Key> &signers,
                   signers,
                   paths,
                   std::placeholders::_3,
-                  baseDirectory()),
+                  baseDirectory(),
+                  throughput()),
         output);
     return {};
 }
@@ -185,7 +196,7 @@ GpgME::Error QGpgMESignArchiveJobPrivate::startIt()
 
     Q_Q(QGpgMESignArchiveJob);
     q->run([=](Context *ctx) {
-        return sign_to_filename(ctx, m_signers, m_inputPaths, m_outputFilePath, m_baseDirectory);
+        return sign_to_filename(ctx, m_signers, m_inputPaths, m_inputPathGenerator, m_outputFilePath, m_baseDirectory);
     });
 
     return {};
@@ -40,16 +40,22 @@
 
 #include "qgpgmesignencryptarchivejob.h"
 
+#include "archivemanifest.h"
+#include "compressionprobe_p.h"
 #include "dataprovider.h"
 #include "signencryptarchivejob_p.h"
 #include "filelistdataprovider.h"
+#include "jobthroughput.h"
 #include "qgpgme_debug.h"
 #include "util.h"
 
+#include <QDir>
 #include <QFile>
 
 #include <gpgme++/data.h>
 
+#include <memory>
+
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -82,7 +88,7 @@ QGpgMESignEncryptArchiveJob::QGpgMESignEncryptArchiveJob(Context *context)
 {
     lateInitialization();
     connect(this, &Job::rawProgress, this, [this](const QString &what, int type, int current, int total) {
-        emitArchiveProgressSignals(this, what, type, current, total);
+        emitArchiveProgressSignals(this, what, type, current, total, inputFileCountHint(), inputSizeHint());
     });
 }
 
@@ -90,12 +96,15 @@ static QGpgMESignEncryptArchiveJob::result_type sign_encrypt(Context *ctx,
                                                              const std::vector<GpgME::Key> &signers,
                                                              const std::vector<Key> &recipients,
                                                              const std::vector<QString> &paths,
+                                                             const std::function<QString()> &pathGenerator,
                                                              GpgME::Data &outdata,
                                                              Context::EncryptionFlags encryptionFlags,
                                                              const QString &baseDirectory)
 {
-    QGpgME::FileListDataProvider in{paths};
-    Data indata(&in);
+    // with a generator the paths are fetched while gpgtar reads them
+    const auto in = pathGenerator ? std::make_unique<QGpgME::FileListDataProvider>(pathGenerator)
+                                  : std::make_unique<QGpgME::FileListDataProvider>(paths);
+    Data indata(in.get());
     if (!baseDirectory.isEmpty()) {
         indata.setFileName(baseDirectory.toStdString());
     }
@@ -126,20 +135,24 @@ static QGpgMESignEncryptArchiveJob::result_type sign_encrypt_to_io_device(Contex
                                                                           const std::vector<QString> &paths,
                                                                           const std::weak_ptr<QIODevice> &cipherText_,
                                                                           Context::EncryptionFlags encryptionFlags,
-                                                                          const QString &baseDirectory)
+                                                                          const QString &baseDirectory,
+                                                                          const std::shared_ptr<JobThroughput> &throughput)
 {
     const std::shared_ptr<QIODevice> cipherText = cipherText_.lock();
     const _detail::ToThreadMover ctMover(cipherText, thread);
     QGpgME::QIODeviceDataProvider out{cipherText};
+    // gpgtar reads the files itself; only the output can be observed
+    out.setThroughput(throughput);
     Data outdata(&out);
 
-    return sign_encrypt(ctx, signers, recipients, paths, outdata, encryptionFlags, baseDirectory);
+    return sign_encrypt(ctx, signers, recipients, paths, {}, outdata, encryptionFlags, baseDirectory);
 }
 
 static QGpgMESignEncryptArchiveJob::result_type sign_encrypt_to_filename(Context *ctx,
                                                                          const std::vector<GpgME::Key> &signers,
                                                                          const std::vector<Key> &recipients,
                                                                          const std::vector<QString> &paths,
+                                                                         const std::function<QString()> &pathGenerator,
                                                                          const QString &outputFileName,
                                                                          Context::EncryptionFlags encryptionFlags,
                                                                          const QString &baseDirectory)
@@ -159,7 +172,7 @@ static QGpgMESignEncryptArchiveJob::result_type sign_encrypt_to_filename(Context
     outdata.setFileName(QFile::encodeName(partFileGuard.tempFileName()).constData());
 #endif
 
-    const auto result = sign_encrypt(ctx, signers, recipients, paths, outdata, encryptionFlags, baseDirectory);
+    const auto result = sign_encrypt(ctx, signers, recipients, paths, pathGenerator, outdata, encryptionFlags, baseDirectory);
     const auto &signingResult = std::get<0>(result);
     const auto &encryptionResult = std::get<1>(result);
     if (!signingResult.error().code() && !encryptionResult.error().code()) {
@@ -170,26 +183,117 @@ static QGpgMESignEncryptArchiveJob::result_type sign_encrypt_to_filename(Context
     return result;
 }
 
+static QGpgMESignEncryptArchiveJob::result_type sign_encrypt_incrementally(Context *ctx,
+                                                                           const std::vector<GpgME::Key> &signers,
+                                                                           const std::vector<Key> &recipients,
+                                                                           const std::vector<QString> &paths,
+                                                                           const QString &outputFileName,
+                                                                           const QString &manifestFileName,
+                                                                           Context::EncryptionFlags encryptionFlags,
+                                                                           const QString &baseDirectory)
+{
+    const auto failure = [](gpg_err_code_t code) {
+        return std::make_tuple(SigningResult{Error::fromCode(code)}, EncryptionResult{Error::fromCode(code)}, QString{}, Error{});
+    };
+
+    const QString manifestPath = baseDirectory.isEmpty() ? manifestFileName : QDir{baseDirectory}.filePath(manifestFileName);
+    ArchiveManifest previous;
+    if (QFile::exists(manifestPath) && !ArchiveManifest::load(manifestPath, previous)) {
+        return failure(GPG_ERR_BAD_DATA);
+    }
+    const auto current = ArchiveManifest::create(paths, baseDirectory, previous);
+    const auto diff = current.diff(previous);
+    if (diff.isEmpty()) {
+        return failure(GPG_ERR_NO_DATA);
+    }
+
+    // entries that changed their type or symbolic links with a new target
+    // must be removed before the archive is extracted over them
+    std::vector<QString> removed = diff.removed;
+    for (const auto &path : diff.modified) {
+        const auto currentEntry = current.find(path);
+        const auto previousEntry = previous.find(path);
+        if (currentEntry->type != previousEntry->type || currentEntry->type == ArchiveManifest::SymLink) {
+            removed.push_back(path);
+        }
+    }
+
+    PartialFileGuard partFileGuard{outputFileName};
+    if (partFileGuard.tempFileName().isEmpty()) {
+        return failure(GPG_ERR_EEXIST);
+    }
+    std::unique_ptr<PartialFileGuard> deletionsFileGuard;
+    if (!removed.empty()) {
+        deletionsFileGuard = std::make_unique<PartialFileGuard>(outputFileName + QLatin1String{".deletions.gpg"});
+        if (deletionsFileGuard->tempFileName().isEmpty()) {
+            return failure(GPG_ERR_EEXIST);
+        }
+    }
+
+    Data outdata;
+#ifdef Q_OS_WIN
+    outdata.setFileName(partFileGuard.tempFileName().toUtf8().constData());
+#else
+    outdata.setFileName(QFile::encodeName(partFileGuard.tempFileName()).constData());
+#endif
+    auto result = sign_encrypt(ctx, signers, recipients, diff.changed(), {}, outdata, encryptionFlags, baseDirectory);
+    if (std::get<0>(result).error().code() || std::get<1>(result).error().code()) {
+        return result;
+    }
+
+    if (deletionsFileGuard) {
+        // the removed paths are signed and encrypted like the archive, so
+        // that they cannot be tampered with when the archives are restored
+        QByteArray deletions;
+        for (const auto &path : removed) {
+            deletions += path.toUtf8() + '\0';
+        }
+        Data indata{deletions.constData(), static_cast<size_t>(deletions.size()), false};
+        Data deletionsData;
+#ifdef Q_OS_WIN
+        deletionsData.setFileName(deletionsFileGuard->tempFileName().toUtf8().constData());
+#else
+        deletionsData.setFileName(QFile::encodeName(deletionsFileGuard->tempFileName()).constData());
+#endif
+        const auto flags = static_cast<Context::EncryptionFlags>(encryptionFlags & ~Context::EncryptArchive);
+        const auto res = ctx->signAndEncrypt(recipients, indata, deletionsData, flags);
+        if (res.first.error().code() || res.second.error().code()) {
+            return std::make_tuple(res.first, res.second, std::get<2>(result), std::get<3>(result));
+        }
+    }
+
+    // the operation succeeded -> save the results under the requested file names
+    partFileGuard.commit();
+    if (deletionsFileGuard) {
+        deletionsFileGuard->commit();
+    }
+    if (!current.save(manifestPath)) {
+        // the next run will again archive the changes of this run
+        std::get<1>(result) = EncryptionResult{Error::fromCode(GPG_ERR_EIO)};
+    }
+
+    return result;
+}
+
 GpgME::Error QGpgMESignEncryptArchiveJob::start(const std::vector<GpgME::Key> &signers,
                                                 const std::vector<GpgME::Key> &recipients,
                                                 const std::vector<QString> &paths,
                                                 const std::shared_ptr<QIODevice> &cipherText,
-                                                const GpgME::Context::EncryptionFlags encryptionFlags)
+                                                GpgME::Context::EncryptionFlags encryptionFlags)
 {
     if (!cipherText) {
         return Error::fromCode(GPG_ERR_INV_VALUE);
     }
 
-    run(std::bind(&sign_encrypt_to_io_device,
-                  std::placeholders::_1,
-                  std::placeholders::_2,
-                  signers,
-                  recipients,
-                  paths,
-                  std::placeholders::_3,
-                  encryptionFlags,
-                  baseDirectory()),
-        cipherText);
+    Q_D(QGpgMESignEncryptArchiveJob);
+    run([d, signers, recipients, paths, encryptionFlags, baseDir = baseDirectory(), jobThroughput = throughput()]
+        (Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &cipherText_) {
+        // the files are probed in the job's thread
+        const auto flags = _detail::disableCompressionIfIncompressible(encryptionFlags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&paths, &baseDir]() {
+            return _detail::filesLookIncompressible(paths, baseDir);
+        });
+        return sign_encrypt_to_io_device(ctx, thread, signers, recipients, paths, cipherText_, flags, baseDir, jobThroughput);
+    }, cipherText);
     return {};
 }
 
@@ -199,9 +303,28 @@ GpgME::Error QGpgMESignEncryptArchiveJobPrivate::startIt()
         return Error::fromCode(GPG_ERR_INV_VALUE);
     }
 
+    // the files are probed in the job's thread; the paths of a generator are
+    // only known while the archive is created
+    const auto probedFlags = [this]() {
+        return _detail::disableCompressionIfIncompressible(m_encryptionFlags, m_detectIncompressibleInput && !m_inputPathGenerator, m_incompressibleInputDetected, [this]() {
+            return _detail::filesLookIncompressible(m_inputPaths, m_baseDirectory);
+        });
+    };
+
     Q_Q(QGpgMESignEncryptArchiveJob);
+    if (!m_incrementalManifestFile.isEmpty()) {
+        if (m_inputPathGenerator) {
+            // the manifest needs all paths before anything is archived
+            return Error::fromCode(GPG_ERR_CONFLICT);
+        }
+        q->run([=](Context *ctx) {
+            return sign_encrypt_incrementally(ctx, m_signers, m_recipients, m_inputPaths, m_outputFilePath, m_incrementalManifestFile, probedFlags(), m_baseDirectory);
+        });
+        return {};
+    }
+
     q->run([=](Context *ctx) {
-        return sign_encrypt_to_filename(ctx, m_signers, m_recipients, m_inputPaths, m_outputFilePath, m_encryptionFlags, m_baseDirectory);
+        return sign_encrypt_to_filename(ctx, m_signers, m_recipients, m_inputPaths, m_inputPathGenerator, m_outputFilePath, probedFlags(), m_baseDirectory);
     });
 
     return {};
@@ -40,7 +40,10 @@
 
 #include "qgpgmesignencryptjob.h"
 
+#include "compressionprobe_p.h"
 #include "dataprovider.h"
+#include "encryptionrecipients_p.h"
+#include "jobthroughput.h"
 #include "signencryptjob_p.h"
 #include "util.h"
 
@@ -49,11 +52,8 @@
 #include <gpgme++/exception.h>
 #include <gpgme++/key.h>
 
-#include <QBuffer>
 #include <QFileInfo>
 
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -72,6 +72,12 @@ public:
 private:
     GpgME::Error startIt() override;
 
+    std::pair<GpgME::SigningResult, GpgME::EncryptionResult> exec(const std::vector<GpgME::Key> &signers,
+                                                                  const std::vector<GpgME::Key> &recipients,
+                                                                  const QByteArray &plainText,
+                                                                  GpgME::Context::EncryptionFlags flags,
+                                                                  GpgME::DataProvider &cipherText) override;
+
     void startNow() override
     {
         Q_Q(QGpgMESignEncryptJob);
@@ -95,20 +101,13 @@ void QGpgMESignEncryptJob::setOutputIsBase64Encoded(bool on)
     mOutputIsBase64Encoded = on;
 }
 
-static QGpgMESignEncryptJob::result_type sign_encrypt(Context *ctx, QThread *thread, const std::vector<Key> &signers,
-                                                      const std::vector<Key> &recipients, const std::weak_ptr<QIODevice> &plainText_,
-                                                      const std::weak_ptr<QIODevice> &cipherText_, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName)
+static QGpgMESignEncryptJob::result_type sign_encrypt_data(Context *ctx, const std::vector<Key> &signers,
+                                                           const std::vector<Key> &recipients, Data &indata,
+                                                           DataProvider &out, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName,
+                                                           qint64 sizeHint)
 {
-    const std::shared_ptr<QIODevice> &plainText = plainText_.lock();
-    const std::shared_ptr<QIODevice> &cipherText = cipherText_.lock();
-
-    const _detail::ToThreadMover ctMover(cipherText, thread);
-    const _detail::ToThreadMover ptMover(plainText, thread);
-
-    QGpgME::QIODeviceDataProvider in(plainText);
-    Data indata(&in);
-    if (!plainText->isSequential()) {
-        indata.setSizeHint(plainText->size());
+    if (sizeHint > 0) {
+        indata.setSizeHint(sizeHint);
     }
 
     const auto pureFileName = QFileInfo{fileName}.fileName().toStdString();
@@ -125,43 +124,73 @@ static QGpgMESignEncryptJob::result_type sign_encrypt(Context *ctx, QThread *thr
         }
     }
 
-    if (!cipherText) {
-        QGpgME::QByteArrayDataProvider out;
-        Data outdata(&out);
+    Data outdata(&out);
 
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
-        }
+    if (outputIsBase64Encoded) {
+        outdata.setEncoding(Data::Base64Encoding);
+    }
 
-        const std::pair<SigningResult, EncryptionResult> res = ctx->signAndEncrypt(recipients, indata, outdata, eflags);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res.first, res.second, out.data(), log, ae);
-    } else {
-        QGpgME::QIODeviceDataProvider out(cipherText);
-        Data outdata(&out);
+    const std::pair<SigningResult, EncryptionResult> res = ctx->signAndEncrypt(recipients, indata, outdata, eflags);
+    Error ae;
+    const QString log = _detail::audit_log_as_html(ctx, ae);
+    return std::make_tuple(res.first, res.second, QByteArray(), log, ae);
+}
 
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
-        }
+static QGpgMESignEncryptJob::result_type sign_encrypt(Context *ctx, QThread *thread, const std::vector<Key> &signers,
+                                                      const std::vector<Key> &recipients, const std::weak_ptr<QIODevice> &plainText_,
+                                                      const std::weak_ptr<QIODevice> &cipherText_, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName,
+                                                      qint64 inputSizeHint,
+                                                      const std::shared_ptr<JobThroughput> &throughput)
+{
+    const std::shared_ptr<QIODevice> &plainText = plainText_.lock();
+    const std::shared_ptr<QIODevice> &cipherText = cipherText_.lock();
+
+    const _detail::ToThreadMover ctMover(cipherText, thread);
+    const _detail::ToThreadMover ptMover(plainText, thread);
 
-        const std::pair<SigningResult, EncryptionResult> res = ctx->signAndEncrypt(recipients, indata, outdata, eflags);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res.first, res.second, QByteArray(), log, ae);
+    QGpgME::QIODeviceDataProvider in(plainText);
+    Data indata(&in);
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : !plainText->isSequential() ? plainText->size() : 0;
+    in.setThroughput(throughput);
+    if (throughput && sizeHint > 0) {
+        throughput->setTotalBytes(sizeHint);
     }
 
+    if (!cipherText) {
+        QGpgME::QByteArrayDataProvider out;
+        out.reserve(sizeHint);
+        auto result = sign_encrypt_data(ctx, signers, recipients, indata, out, eflags, outputIsBase64Encoded, fileName, sizeHint);
+        std::get<2>(result) = out.data();
+        return result;
+    } else {
+        QGpgME::QIODeviceDataProvider out(cipherText);
+        out.setThroughput(throughput);
+        return sign_encrypt_data(ctx, signers, recipients, indata, out, eflags, outputIsBase64Encoded, fileName, sizeHint);
+    }
+}
+
+static QGpgMESignEncryptJob::result_type sign_encrypt_qba_to_provider(Context *ctx, const std::vector<Key> &signers,
+                                                                      const std::vector<Key> &recipients, const QByteArray &plainText, DataProvider &cipherText,
+                                                                      const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName,
+                                                                      qint64 sizeHint)
+{
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(plainText);
+    Data indata(&in);
+
+    return sign_encrypt_data(ctx, signers, recipients, indata, cipherText, eflags, outputIsBase64Encoded, fileName, sizeHint);
 }
 
 static QGpgMESignEncryptJob::result_type sign_encrypt_qba(Context *ctx, const std::vector<Key> &signers,
-                                                          const std::vector<Key> &recipients, const QByteArray &plainText, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName)
+                                                          const std::vector<Key> &recipients, const QByteArray &plainText, const Context::EncryptionFlags eflags, bool outputIsBase64Encoded, const QString &fileName,
+                                                          qint64 inputSizeHint)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(plainText);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
-    }
-    return sign_encrypt(ctx, nullptr, signers, recipients, buffer, std::shared_ptr<QIODevice>(), eflags, outputIsBase64Encoded, fileName);
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : plainText.size();
+    QGpgME::QByteArrayDataProvider out;
+    out.reserve(sizeHint);
+    auto result = sign_encrypt_qba_to_provider(ctx, signers, recipients, plainText, out, eflags, outputIsBase64Encoded, fileName, sizeHint);
+    std::get<2>(result) = out.data();
+    return result;
 }
 
 static QGpgMESignEncryptJob::result_type sign_encrypt_to_filename(Context *ctx,
@@ -220,16 +249,38 @@ static QGpgMESignEncryptJob::result_type sign_encrypt_to_filename(Context *ctx,
 
 Error QGpgMESignEncryptJob::start(const std::vector<Key> &signers, const std::vector<Key> &recipients, const QByteArray &plainText, bool alwaysTrust)
 {
+    Q_D(QGpgMESignEncryptJob);
     const auto flags = static_cast<Context::EncryptionFlags>((alwaysTrust ? Context::AlwaysTrust : Context::None) | (encryptionFlags() & ~Context::EncryptFile));
 
-    run(std::bind(&sign_encrypt_qba, std::placeholders::_1, signers, recipients, plainText, flags, mOutputIsBase64Encoded, fileName()));
+    run([d, signers, recipients, plainText, flags, encryptionRecipients = d->m_encryptionRecipients, base64 = mOutputIsBase64Encoded,
+         inputFileName = fileName(), sizeHint = inputSizeHint()](Context *ctx) {
+        // the input is probed and the recipients are validated in the job's thread
+        auto eflags = _detail::disableCompressionIfIncompressible(flags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText]() {
+            return _detail::looksIncompressible(plainText);
+        });
+        auto recipientKeys = recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, eflags);
+        return sign_encrypt_qba(ctx, signers, recipientKeys, plainText, eflags, base64, inputFileName, sizeHint);
+    });
     return Error();
 }
 
 void QGpgMESignEncryptJob::start(const std::vector<Key> &signers, const std::vector<Key> &recipients,
-                                 const std::shared_ptr<QIODevice> &plainText, const std::shared_ptr<QIODevice> &cipherText, const Context::EncryptionFlags eflags)
+                                 const std::shared_ptr<QIODevice> &plainText, const std::shared_ptr<QIODevice> &cipherText, Context::EncryptionFlags eflags)
 {
-    run(std::bind(&sign_encrypt, std::placeholders::_1, std::placeholders::_2, signers, recipients, std::placeholders::_3, std::placeholders::_4, eflags, mOutputIsBase64Encoded, fileName()), plainText, cipherText);
+    Q_D(QGpgMESignEncryptJob);
+    run([d, signers, recipients, eflags, encryptionRecipients = d->m_encryptionRecipients, base64 = mOutputIsBase64Encoded,
+         inputFileName = fileName(), sizeHint = inputSizeHint(), jobThroughput = throughput()]
+        (Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &plainText_, const std::weak_ptr<QIODevice> &cipherText_) {
+        // the input is probed in the job's thread, which the device has been
+        // moved to, and the recipients are validated there
+        auto flags = _detail::disableCompressionIfIncompressible(eflags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText_]() {
+            return _detail::looksIncompressible(plainText_.lock().get());
+        });
+        auto recipientKeys = recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, flags);
+        return sign_encrypt(ctx, thread, signers, recipientKeys, plainText_, cipherText_, flags, base64, inputFileName, sizeHint, jobThroughput);
+    }, plainText, cipherText);
 }
 
 void QGpgMESignEncryptJob::start(const std::vector<Key> &signers, const std::vector<Key> &recipients, const std::shared_ptr<QIODevice> &plainText, const std::shared_ptr<QIODevice> &cipherText, bool alwaysTrust)
@@ -239,10 +290,32 @@ void QGpgMESignEncryptJob::start(const std::vector<Key> &signers, const std::vec
     return start(signers, recipients, plainText, cipherText, flags);
 }
 
-std::pair<SigningResult, EncryptionResult> QGpgMESignEncryptJob::exec(const std::vector<Key> &signers, const std::vector<Key> &recipients, const QByteArray &plainText, const Context::EncryptionFlags eflags, QByteArray &cipherText)
+std::pair<SigningResult, EncryptionResult> QGpgMESignEncryptJob::exec(const std::vector<Key> &signers, const std::vector<Key> &recipients, const QByteArray &plainText, Context::EncryptionFlags eflags, QByteArray &cipherText)
+{
+    Q_D(QGpgMESignEncryptJob);
+    eflags = _detail::disableCompressionIfIncompressible(eflags, d->m_detectIncompressibleInput, d->m_incompressibleInputDetected, [&plainText]() {
+        return _detail::looksIncompressible(plainText);
+    });
+    auto recipientKeys = recipients;
+    _detail::useEncryptionRecipients(d->m_encryptionRecipients.get(), recipientKeys, eflags);
+    // write directly into the caller's byte array to reuse its memory
+    const qint64 sizeHint = inputSizeHint() > 0 ? inputSizeHint() : plainText.size();
+    QGpgME::QByteArraySinkDataProvider out(cipherText);
+    out.reserve(sizeHint);
+    const result_type r = sign_encrypt_qba_to_provider(context(), signers, recipientKeys, plainText, out, eflags, mOutputIsBase64Encoded, fileName(), sizeHint);
+    return std::make_pair(std::get<0>(r), std::get<1>(r));
+}
+
+std::pair<SigningResult, EncryptionResult> QGpgMESignEncryptJobPrivate::exec(const std::vector<Key> &signers, const std::vector<Key> &recipients, const QByteArray &plainText, Context::EncryptionFlags eflags, DataProvider &cipherText)
 {
-    const result_type r = sign_encrypt_qba(context(), signers, recipients, plainText, eflags, mOutputIsBase64Encoded, fileName());
-    cipherText = std::get<2>(r);
+    Q_Q(QGpgMESignEncryptJob);
+    eflags = _detail::disableCompressionIfIncompressible(eflags, m_detectIncompressibleInput, m_incompressibleInputDetected, [&plainText]() {
+        return _detail::looksIncompressible(plainText);
+    });
+    auto recipientKeys = recipients;
+    _detail::useEncryptionRecipients(m_encryptionRecipients.get(), recipientKeys, eflags);
+    const qint64 sizeHint = m_inputSizeHint > 0 ? m_inputSizeHint : plainText.size();
+    const auto r = sign_encrypt_qba_to_provider(q->context(), signers, recipientKeys, plainText, cipherText, eflags, q->mOutputIsBase64Encoded, m_fileName, sizeHint);
     return std::make_pair(std::get<0>(r), std::get<1>(r));
 }
 
@@ -260,8 +333,14 @@ GpgME::Error QGpgMESignEncryptJobPrivate::startIt()
     }
 
     Q_Q(QGpgMESignEncryptJob);
-    q->run([=](Context *ctx) {
-        return sign_encrypt_to_filename(ctx, m_signers, m_recipients, m_inputFilePath, m_outputFilePath, m_encryptionFlags);
+    q->run([=, encryptionRecipients = m_encryptionRecipients](Context *ctx) {
+        // the input is probed and the recipients are validated in the job's thread
+        auto eflags = _detail::disableCompressionIfIncompressible(m_encryptionFlags, m_detectIncompressibleInput, m_incompressibleInputDetected, [this]() {
+            return _detail::fileLooksIncompressible(m_inputFilePath);
+        });
+        auto recipientKeys = m_recipients;
+        _detail::useEncryptionRecipients(encryptionRecipients.get(), recipientKeys, eflags);
+        return sign_encrypt_to_filename(ctx, m_signers, recipientKeys, m_inputFilePath, m_outputFilePath, eflags);
     });
 
     return {};
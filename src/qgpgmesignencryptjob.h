@@ -96,6 +96,8 @@ public:
          const QByteArray &plainText, const GpgME::Context::EncryptionFlags flags,
          QByteArray &cipherText) override;
 
+    using SignEncryptJob::exec;
+
     /* from SignEncryptJob */
     void setOutputIsBase64Encoded(bool on) override;
 
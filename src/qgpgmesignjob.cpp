@@ -39,6 +39,7 @@
 #include "qgpgmesignjob.h"
 
 #include "dataprovider.h"
+#include "jobthroughput.h"
 #include "signjob_p.h"
 #include "util.h"
 
@@ -46,11 +47,8 @@
 #include <gpgme++/data.h>
 #include <gpgme++/signingresult.h>
 
-#include <QBuffer>
 #include <QFile>
 
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -69,6 +67,9 @@ public:
 private:
     GpgME::Error startIt() override;
 
+    GpgME::SigningResult exec(const std::vector<GpgME::Key> &signers, const QByteArray &plainText,
+                              GpgME::SignatureMode mode, GpgME::DataProvider &signature) override;
+
     void startNow() override
     {
         Q_Q(QGpgMESignJob);
@@ -92,12 +93,47 @@ void QGpgMESignJob::setOutputIsBase64Encoded(bool on)
     mOutputIsBase64Encoded = on;
 }
 
+static QGpgMESignJob::result_type sign_data(Context *ctx,
+                                            const std::vector<Key> &signers,
+                                            Data &indata,
+                                            DataProvider &out,
+                                            SignatureMode mode,
+                                            bool outputIsBase64Encoded,
+                                            qint64 sizeHint)
+{
+    if (sizeHint > 0) {
+        indata.setSizeHint(sizeHint);
+    }
+
+    ctx->clearSigningKeys();
+    for (const Key &signer : signers) {
+        if (!signer.isNull()) {
+            if (const Error err = ctx->addSigningKey(signer)) {
+                return std::make_tuple(SigningResult(err), QByteArray(), QString(), Error());
+            }
+        }
+    }
+
+    Data outdata(&out);
+
+    if (outputIsBase64Encoded) {
+        outdata.setEncoding(Data::Base64Encoding);
+    }
+
+    const SigningResult res = ctx->sign(indata, outdata, mode);
+    Error ae;
+    const QString log = _detail::audit_log_as_html(ctx, ae);
+    return std::make_tuple(res, QByteArray(), log, ae);
+}
+
 static QGpgMESignJob::result_type sign(Context *ctx, QThread *thread,
                                        const std::vector<Key> &signers,
                                        const std::weak_ptr<QIODevice> &plainText_,
                                        const std::weak_ptr<QIODevice> &signature_,
                                        SignatureMode mode,
-                                       bool outputIsBase64Encoded)
+                                       bool outputIsBase64Encoded,
+                                       qint64 inputSizeHint,
+                                       const std::shared_ptr<JobThroughput> &throughput)
 {
 
     const std::shared_ptr<QIODevice> plainText = plainText_.lock();
@@ -108,59 +144,57 @@ static QGpgMESignJob::result_type sign(Context *ctx, QThread *thread,
 
     QGpgME::QIODeviceDataProvider in(plainText);
     Data indata(&in);
-    if (!plainText->isSequential()) {
-        indata.setSizeHint(plainText->size());
-    }
-
-    ctx->clearSigningKeys();
-    for (const Key &signer : signers) {
-        if (!signer.isNull()) {
-            if (const Error err = ctx->addSigningKey(signer)) {
-                return std::make_tuple(SigningResult(err), QByteArray(), QString(), Error());
-            }
-        }
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : !plainText->isSequential() ? plainText->size() : 0;
+    in.setThroughput(throughput);
+    if (throughput && sizeHint > 0) {
+        throughput->setTotalBytes(sizeHint);
     }
 
     if (!signature) {
         QGpgME::QByteArrayDataProvider out;
-        Data outdata(&out);
-
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
+        if (!(mode & Detached)) {
+            out.reserve(sizeHint);
         }
-
-        const SigningResult res = ctx->sign(indata, outdata, mode);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, out.data(), log, ae);
+        auto result = sign_data(ctx, signers, indata, out, mode, outputIsBase64Encoded, sizeHint);
+        std::get<1>(result) = out.data();
+        return result;
     } else {
         QGpgME::QIODeviceDataProvider out(signature);
-        Data outdata(&out);
-
-        if (outputIsBase64Encoded) {
-            outdata.setEncoding(Data::Base64Encoding);
-        }
-
-        const SigningResult res = ctx->sign(indata, outdata, mode);
-        Error ae;
-        const QString log = _detail::audit_log_as_html(ctx, ae);
-        return std::make_tuple(res, QByteArray(), log, ae);
+        out.setThroughput(throughput);
+        return sign_data(ctx, signers, indata, out, mode, outputIsBase64Encoded, sizeHint);
     }
+}
 
+static QGpgMESignJob::result_type sign_qba_to_provider(Context *ctx,
+        const std::vector<Key> &signers,
+        const QByteArray &plainText,
+        DataProvider &signature,
+        SignatureMode mode,
+        bool outputIsBase64Encoded,
+        qint64 sizeHint)
+{
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(plainText);
+    Data indata(&in);
+
+    return sign_data(ctx, signers, indata, signature, mode, outputIsBase64Encoded, sizeHint);
 }
 
 static QGpgMESignJob::result_type sign_qba(Context *ctx,
         const std::vector<Key> &signers,
         const QByteArray &plainText,
         SignatureMode mode,
-        bool outputIsBase64Encoded)
+        bool outputIsBase64Encoded,
+        qint64 inputSizeHint)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(plainText);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
+    const qint64 sizeHint = inputSizeHint > 0 ? inputSizeHint : plainText.size();
+    QGpgME::QByteArrayDataProvider out;
+    if (!(mode & Detached)) {
+        out.reserve(sizeHint);
     }
-    return sign(ctx, nullptr, signers, buffer, std::shared_ptr<QIODevice>(), mode, outputIsBase64Encoded);
+    auto result = sign_qba_to_provider(ctx, signers, plainText, out, mode, outputIsBase64Encoded, sizeHint);
+    std::get<1>(result) = out.data();
+    return result;
 }
 
 static QGpgMESignJob::result_type sign_to_filename(Context *ctx,
@@ -245,19 +279,32 @@ static QGpgMESignJob::result_type sign_to_filename(Context *ctx,
 
 Error QGpgMESignJob::start(const std::vector<Key> &signers, const QByteArray &plainText, SignatureMode mode)
 {
-    run(std::bind(&sign_qba, std::placeholders::_1, signers, plainText, mode, mOutputIsBase64Encoded));
+    run(std::bind(&sign_qba, std::placeholders::_1, signers, plainText, mode, mOutputIsBase64Encoded, inputSizeHint()));
     return Error();
 }
 
 void QGpgMESignJob::start(const std::vector<Key> &signers, const std::shared_ptr<QIODevice> &plainText, const std::shared_ptr<QIODevice> &signature, SignatureMode mode)
 {
-    run(std::bind(&sign, std::placeholders::_1, std::placeholders::_2, signers, std::placeholders::_3, std::placeholders::_4, mode, mOutputIsBase64Encoded), plainText, signature);
+    run(std::bind(&sign, std::placeholders::_1, std::placeholders::_2, signers, std::placeholders::_3, std::placeholders::_4, mode, mOutputIsBase64Encoded, inputSizeHint(), throughput()), plainText, signature);
 }
 
 SigningResult QGpgMESignJob::exec(const std::vector<Key> &signers, const QByteArray &plainText, SignatureMode mode, QByteArray &signature)
 {
-    const result_type r = sign_qba(context(), signers, plainText, mode, mOutputIsBase64Encoded);
-    signature = std::get<1>(r);
+    // write directly into the caller's byte array to reuse its memory
+    const qint64 sizeHint = inputSizeHint() > 0 ? inputSizeHint() : plainText.size();
+    QGpgME::QByteArraySinkDataProvider out(signature);
+    if (!(mode & Detached)) {
+        out.reserve(sizeHint);
+    }
+    const result_type r = sign_qba_to_provider(context(), signers, plainText, out, mode, mOutputIsBase64Encoded, sizeHint);
+    return std::get<0>(r);
+}
+
+SigningResult QGpgMESignJobPrivate::exec(const std::vector<Key> &signers, const QByteArray &plainText, SignatureMode mode, DataProvider &signature)
+{
+    Q_Q(QGpgMESignJob);
+    const qint64 sizeHint = m_inputSizeHint > 0 ? m_inputSizeHint : plainText.size();
+    const auto r = sign_qba_to_provider(q->context(), signers, plainText, signature, mode, q->mOutputIsBase64Encoded, sizeHint);
     return std::get<0>(r);
 }
 
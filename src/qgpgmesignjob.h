@@ -80,6 +80,8 @@ public:
                               GpgME::SignatureMode mode,
                               QByteArray &signature) override;
 
+    using SignJob::exec;
+
     /* from SignJob */
     void setOutputIsBase64Encoded(bool on) override;
 
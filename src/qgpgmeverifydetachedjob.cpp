@@ -40,6 +40,7 @@
 
 #include "dataprovider.h"
 #include "util.h"
+#include "verificationcache.h"
 #include "verifydetachedjob_p.h"
 
 #include <QFile>
@@ -110,18 +111,32 @@ static QGpgMEVerifyDetachedJob::result_type verify_detached(Context *ctx, QThrea
     return std::make_tuple(res, log, ae);
 }
 
-static QGpgMEVerifyDetachedJob::result_type verify_detached_qba(Context *ctx, const QByteArray &signature, const QByteArray &signedData)
+static QGpgMEVerifyDetachedJob::result_type verify_detached_qba(Context *ctx, const QByteArray &signature, const QByteArray &signedData,
+                                                                const std::shared_ptr<VerificationCache> &cache, bool processAllSignatures)
 {
-    QGpgME::QByteArrayDataProvider sigDP(signature);
+    // a null byte array would make the id the id of an opaque signature
+    const QByteArray id = cache ? VerificationCache::signatureId(signature, signedData.isNull() ? QByteArray{""} : signedData, processAllSignatures) : QByteArray{};
+    if (cache) {
+        VerificationResult cachedResult;
+        QByteArray plainText;
+        if (cache->find(ctx, id, cachedResult, plainText)) {
+            return std::make_tuple(cachedResult, QString{}, Error{});
+        }
+    }
+
+    QGpgME::QByteArrayReadOnlyDataProvider sigDP(signature);
     Data sig(&sigDP);
 
-    QGpgME::QByteArrayDataProvider dataDP(signedData);
+    QGpgME::QByteArrayReadOnlyDataProvider dataDP(signedData);
     Data data(&dataDP);
 
     const VerificationResult res = ctx->verifyDetachedSignature(sig, data);
     Error ae;
     const QString log = _detail::audit_log_as_html(ctx, ae);
 
+    if (cache) {
+        cache->insert(ctx, id, res);
+    }
     return std::make_tuple(res, log, ae);
 
 }
@@ -160,7 +175,7 @@ Error QGpgMEVerifyDetachedJob::start(const QByteArray &signature, const QByteArr
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    run(std::bind(&verify_detached_qba, std::placeholders::_1, signature, signedData));
+    run(std::bind(&verify_detached_qba, std::placeholders::_1, signature, signedData, verificationCache(), processAllSignatures()));
     return Error();
 }
 
@@ -178,7 +193,7 @@ GpgME::VerificationResult QGpgME::QGpgMEVerifyDetachedJob::exec(const QByteArray
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    const result_type r = verify_detached_qba(context(), signature, signedData);
+    const result_type r = verify_detached_qba(context(), signature, signedData, verificationCache(), processAllSignatures());
     return std::get<0>(r);
 }
 
@@ -40,17 +40,15 @@
 
 #include "dataprovider.h"
 #include "util.h"
+#include "verificationcache.h"
 #include "verifyopaquejob_p.h"
 
 #include <gpgme++/context.h>
 #include <gpgme++/data.h>
 #include <gpgme++/verificationresult.h>
 
-#include <QBuffer>
 #include <QFile>
 
-#include <cassert>
-
 using namespace QGpgME;
 using namespace GpgME;
 
@@ -86,21 +84,8 @@ QGpgMEVerifyOpaqueJob::QGpgMEVerifyOpaqueJob(Context *context)
 
 QGpgMEVerifyOpaqueJob::~QGpgMEVerifyOpaqueJob() {}
 
-static QGpgMEVerifyOpaqueJob::result_type verify_opaque(Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &signedData_, const std::weak_ptr<QIODevice> &plainText_)
+static QGpgMEVerifyOpaqueJob::result_type verify_opaque_data(Context *ctx, Data &indata, const std::shared_ptr<QIODevice> &plainText)
 {
-
-    const std::shared_ptr<QIODevice> plainText = plainText_.lock();
-    const std::shared_ptr<QIODevice> signedData = signedData_.lock();
-
-    const _detail::ToThreadMover ptMover(plainText,  thread);
-    const _detail::ToThreadMover sdMover(signedData, thread);
-
-    QGpgME::QIODeviceDataProvider in(signedData);
-    Data indata(&in);
-    if (!signedData->isSequential()) {
-        indata.setSizeHint(signedData->size());
-    }
-
     if (!plainText) {
         QGpgME::QByteArrayDataProvider out;
         Data outdata(&out);
@@ -118,17 +103,48 @@ static QGpgMEVerifyOpaqueJob::result_type verify_opaque(Context *ctx, QThread *t
         const QString log = _detail::audit_log_as_html(ctx, ae);
         return std::make_tuple(res, QByteArray(), log, ae);
     }
+}
 
+static QGpgMEVerifyOpaqueJob::result_type verify_opaque(Context *ctx, QThread *thread, const std::weak_ptr<QIODevice> &signedData_, const std::weak_ptr<QIODevice> &plainText_)
+{
+
+    const std::shared_ptr<QIODevice> plainText = plainText_.lock();
+    const std::shared_ptr<QIODevice> signedData = signedData_.lock();
+
+    const _detail::ToThreadMover ptMover(plainText,  thread);
+    const _detail::ToThreadMover sdMover(signedData, thread);
+
+    QGpgME::QIODeviceDataProvider in(signedData);
+    Data indata(&in);
+    if (!signedData->isSequential()) {
+        indata.setSizeHint(signedData->size());
+    }
+
+    return verify_opaque_data(ctx, indata, plainText);
 }
 
-static QGpgMEVerifyOpaqueJob::result_type verify_opaque_qba(Context *ctx, const QByteArray &signedData)
+static QGpgMEVerifyOpaqueJob::result_type verify_opaque_qba(Context *ctx, const QByteArray &signedData,
+                                                            const std::shared_ptr<VerificationCache> &cache, bool processAllSignatures)
 {
-    const std::shared_ptr<QBuffer> buffer(new QBuffer);
-    buffer->setData(signedData);
-    if (!buffer->open(QIODevice::ReadOnly)) {
-        assert(!"This should never happen: QBuffer::open() failed");
+    const QByteArray id = cache ? VerificationCache::signatureId(signedData, QByteArray{}, processAllSignatures) : QByteArray{};
+    if (cache) {
+        VerificationResult cachedResult;
+        QByteArray plainText;
+        if (cache->find(ctx, id, cachedResult, plainText)) {
+            return std::make_tuple(cachedResult, plainText, QString{}, Error{});
+        }
+    }
+
+    // read directly from the byte array instead of going through a QBuffer
+    QGpgME::QByteArrayReadOnlyDataProvider in(signedData);
+    Data indata(&in);
+    indata.setSizeHint(signedData.size());
+
+    const auto result = verify_opaque_data(ctx, indata, std::shared_ptr<QIODevice>());
+    if (cache) {
+        cache->insert(ctx, id, std::get<0>(result), std::get<1>(result));
     }
-    return verify_opaque(ctx, nullptr, buffer, std::shared_ptr<QIODevice>());
+    return result;
 }
 
 static QGpgMEVerifyOpaqueJob::result_type verify_from_filename(Context *ctx,
@@ -175,7 +191,7 @@ Error QGpgMEVerifyOpaqueJob::start(const QByteArray &signedData)
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    run(std::bind(&verify_opaque_qba, std::placeholders::_1, signedData));
+    run(std::bind(&verify_opaque_qba, std::placeholders::_1, signedData, verificationCache(), processAllSignatures()));
     return Error();
 }
 
@@ -192,7 +208,7 @@ GpgME::VerificationResult QGpgME::QGpgMEVerifyOpaqueJob::exec(const QByteArray &
     if (processAllSignatures()) {
         context()->setFlag("proc-all-sigs", "1");
     }
-    const result_type r = verify_opaque_qba(context(), signedData);
+    const result_type r = verify_opaque_qba(context(), signedData, verificationCache(), processAllSignatures());
     plainText = std::get<1>(r);
     return std::get<0>(r);
 }
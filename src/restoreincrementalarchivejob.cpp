@@ -0,0 +1,393 @@
+/*
+    restoreincrementalarchivejob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "restoreincrementalarchivejob.h"
+
+#include "decryptverifyarchivejob.h"
+#include "decryptverifyjob.h"
+#include "job_p.h"
+#include "protocol.h"
+#include "signaturecheck_p.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
+
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/verificationresult.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+namespace
+{
+bool isSafeRelativePath(const QString &path)
+{
+    const QString cleanPath = QDir::cleanPath(path);
+    return !path.isEmpty() && QDir::isRelativePath(path) && cleanPath == path
+        && cleanPath != QLatin1String{".."} && !cleanPath.startsWith(QLatin1String{"../"});
+}
+
+void addFingerprints(std::vector<QByteArray> &fingerprints, const Key &key)
+{
+    for (const auto &subkey : key.subkeys()) {
+        fingerprints.push_back(subkey.fingerprint());
+    }
+}
+}
+
+class QGpgME::RestoreIncrementalArchiveJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(RestoreIncrementalArchiveJob)
+
+    explicit RestoreIncrementalArchiveJobPrivate(const Protocol *protocol)
+        : m_protocol{protocol}
+    {
+    }
+
+    ~RestoreIncrementalArchiveJobPrivate() override = default;
+
+    GpgME::Error startIt() override;
+
+    void startNow() override
+    {
+    }
+
+    void restoreNextArchive();
+    void deletionsDecrypted(const GpgME::DecryptionResult &decryptionResult,
+                            const GpgME::VerificationResult &verificationResult,
+                            const QByteArray &plainText);
+    void extractArchive();
+    void archiveExtracted(const GpgME::DecryptionResult &decryptionResult,
+                          const GpgME::VerificationResult &verificationResult);
+    std::vector<QByteArray> allowedSigners() const;
+    GpgME::Error removePaths(const QByteArray &deletions);
+    void finish(const GpgME::Error &error);
+
+    const Protocol *const m_protocol;
+    std::vector<QString> m_archiveFiles;
+    QString m_outputDirectory;
+    std::vector<GpgME::Key> m_trustedSigners;
+
+    QPointer<DecryptVerifyJob> m_deletionsJob;
+    QPointer<DecryptVerifyArchiveJob> m_archiveJob;
+    std::vector<GpgME::VerificationResult> m_verificationResults;
+    size_t m_currentArchive = 0;
+    bool m_canceled = false;
+    bool m_started = false;
+    bool m_finished = false;
+};
+
+GpgME::Error RestoreIncrementalArchiveJobPrivate::startIt()
+{
+    if (m_archiveFiles.empty() || m_outputDirectory.isEmpty()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (m_started) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+    if (!QDir{}.mkpath(m_outputDirectory)) {
+        return Error::fromCode(GPG_ERR_EIO);
+    }
+
+    Q_Q(RestoreIncrementalArchiveJob);
+    m_started = true;
+    // don't emit result() before the caller had a chance to look at the return value
+    QMetaObject::invokeMethod(q, [this]() {
+        restoreNextArchive();
+    }, Qt::QueuedConnection);
+    return {};
+}
+
+void RestoreIncrementalArchiveJobPrivate::restoreNextArchive()
+{
+    Q_Q(RestoreIncrementalArchiveJob);
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (m_currentArchive == m_archiveFiles.size()) {
+        finish({});
+        return;
+    }
+    const int current = static_cast<int>(m_currentArchive);
+    const int total = static_cast<int>(m_archiveFiles.size());
+    Q_EMIT q->archiveProgress(current, total);
+    Q_EMIT q->jobProgress(current, total);
+
+    const QString archiveFile = m_archiveFiles[m_currentArchive];
+    if (!QFile::exists(archiveFile)) {
+        finish(Error::fromCode(GPG_ERR_ENOENT));
+        return;
+    }
+    QFile deletionsFile{archiveFile + QLatin1String{".deletions.gpg"}};
+    if (!deletionsFile.exists()) {
+        extractArchive();
+        return;
+    }
+    if (!deletionsFile.open(QIODevice::ReadOnly)) {
+        finish(Error::fromCode(GPG_ERR_EACCES));
+        return;
+    }
+
+    m_deletionsJob = m_protocol->decryptVerifyJob();
+    if (!m_deletionsJob) {
+        finish(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+        return;
+    }
+    QObject::connect(m_deletionsJob.data(), &DecryptVerifyJob::result, q, [this](const DecryptionResult &decryptionResult,
+                                                                                const VerificationResult &verificationResult,
+                                                                                const QByteArray &plainText) {
+        deletionsDecrypted(decryptionResult, verificationResult, plainText);
+    });
+    if (const auto err = m_deletionsJob->start(deletionsFile.readAll())) {
+        delete m_deletionsJob.data();
+        finish(err);
+    }
+}
+
+void RestoreIncrementalArchiveJobPrivate::deletionsDecrypted(const GpgME::DecryptionResult &decryptionResult,
+                                                             const GpgME::VerificationResult &verificationResult,
+                                                             const QByteArray &plainText)
+{
+    m_deletionsJob = nullptr;
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (decryptionResult.error()) {
+        finish(decryptionResult.error());
+        return;
+    }
+    // removing files is destructive; only do it on behalf of a trusted signer
+    if (!_detail::allSignaturesValid(verificationResult, allowedSigners())) {
+        finish(Error::fromCode(GPG_ERR_BAD_SIGNATURE));
+        return;
+    }
+    if (const auto err = removePaths(plainText)) {
+        finish(err);
+        return;
+    }
+    extractArchive();
+}
+
+std::vector<QByteArray> RestoreIncrementalArchiveJobPrivate::allowedSigners() const
+{
+    std::vector<QByteArray> fingerprints;
+    if (!m_trustedSigners.empty()) {
+        for (const auto &key : m_trustedSigners) {
+            addFingerprints(fingerprints, key);
+        }
+        return fingerprints;
+    }
+    // the lists must be signed by the signer of the archives restored so far
+    for (const auto &result : m_verificationResults) {
+        for (const auto &sig : result.signatures()) {
+            if (sig.status().code() || !(sig.summary() & Signature::Valid)) {
+                continue;
+            }
+            const Key key = sig.key(true, false);
+            if (key.isNull()) {
+                fingerprints.push_back(sig.fingerprint());
+            } else {
+                addFingerprints(fingerprints, key);
+            }
+        }
+    }
+    return fingerprints;
+}
+
+GpgME::Error RestoreIncrementalArchiveJobPrivate::removePaths(const QByteArray &deletions)
+{
+    const QString canonicalOutputDir = QFileInfo{m_outputDirectory}.canonicalFilePath();
+    if (canonicalOutputDir.isEmpty()) {
+        return Error::fromCode(GPG_ERR_ENOENT);
+    }
+    const QDir outputDir{m_outputDirectory};
+    // the parent directory of a path could be a symbolic link pointing
+    // outside of the output directory; resolve it before removing anything
+    const auto isInsideOutputDir = [&outputDir, &canonicalOutputDir](const QString &path) {
+        const QString parent = QFileInfo{outputDir.filePath(path)}.absolutePath();
+        const QString canonicalParent = QFileInfo{parent}.canonicalFilePath();
+        // a parent that doesn't exist cannot contain anything to remove
+        return canonicalParent.isEmpty() || canonicalParent == canonicalOutputDir
+            || canonicalParent.startsWith(canonicalOutputDir + QLatin1Char('/'));
+    };
+
+    std::vector<QString> paths;
+    const auto entries = deletions.split('\0');
+    for (const auto &entry : entries) {
+        if (entry.isEmpty()) {
+            continue;
+        }
+        const QString path = QString::fromUtf8(entry);
+        if (!isSafeRelativePath(path) || !isInsideOutputDir(path)) {
+            return Error::fromCode(GPG_ERR_INV_NAME);
+        }
+        paths.push_back(path);
+    }
+
+    for (const auto &path : paths) {
+        // check again; removing the previous paths may have changed the tree
+        if (!isInsideOutputDir(path)) {
+            return Error::fromCode(GPG_ERR_INV_NAME);
+        }
+        const QFileInfo fi{outputDir.filePath(path)};
+        if (fi.isDir() && !fi.isSymLink()) {
+            outputDir.rmdir(path);
+        } else if (fi.exists() || fi.isSymLink()) {
+            if (!QFile::remove(fi.filePath())) {
+                return Error::fromCode(GPG_ERR_EIO);
+            }
+        }
+        // remove the parent directories that became empty; an empty
+        // directory that still exists is contained in the archive
+        for (QString parent = QFileInfo{path}.path(); parent != QLatin1String{"."}; parent = QFileInfo{parent}.path()) {
+            if (!outputDir.rmdir(parent)) {
+                break;
+            }
+        }
+    }
+    return {};
+}
+
+void RestoreIncrementalArchiveJobPrivate::extractArchive()
+{
+    Q_Q(RestoreIncrementalArchiveJob);
+    m_archiveJob = m_protocol->decryptVerifyArchiveJob();
+    if (!m_archiveJob) {
+        finish(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+        return;
+    }
+    m_archiveJob->setInputFile(m_archiveFiles[m_currentArchive]);
+    m_archiveJob->setOutputDirectory(m_outputDirectory);
+    QObject::connect(m_archiveJob.data(), &DecryptVerifyArchiveJob::result, q, [this](const DecryptionResult &decryptionResult,
+                                                                                     const VerificationResult &verificationResult) {
+        archiveExtracted(decryptionResult, verificationResult);
+    });
+    if (const auto err = m_archiveJob->startIt()) {
+        delete m_archiveJob.data();
+        finish(err);
+    }
+}
+
+void RestoreIncrementalArchiveJobPrivate::archiveExtracted(const GpgME::DecryptionResult &decryptionResult,
+                                                           const GpgME::VerificationResult &verificationResult)
+{
+    m_archiveJob = nullptr;
+    m_verificationResults.push_back(verificationResult);
+    if (decryptionResult.error()) {
+        finish(decryptionResult.error());
+        return;
+    }
+    m_currentArchive++;
+    restoreNextArchive();
+}
+
+void RestoreIncrementalArchiveJobPrivate::finish(const GpgME::Error &error)
+{
+    Q_Q(RestoreIncrementalArchiveJob);
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    Q_EMIT q->done();
+    Q_EMIT q->result(error, m_verificationResults);
+    q->deleteLater();
+}
+
+RestoreIncrementalArchiveJob::RestoreIncrementalArchiveJob(const Protocol *protocol)
+    : Job{std::unique_ptr<RestoreIncrementalArchiveJobPrivate>(new RestoreIncrementalArchiveJobPrivate{protocol}), nullptr}
+{
+}
+
+RestoreIncrementalArchiveJob::~RestoreIncrementalArchiveJob() = default;
+
+void RestoreIncrementalArchiveJob::setArchiveFiles(const std::vector<QString> &paths)
+{
+    Q_D(RestoreIncrementalArchiveJob);
+    d->m_archiveFiles = paths;
+}
+
+std::vector<QString> RestoreIncrementalArchiveJob::archiveFiles() const
+{
+    Q_D(const RestoreIncrementalArchiveJob);
+    return d->m_archiveFiles;
+}
+
+void RestoreIncrementalArchiveJob::setOutputDirectory(const QString &outputDirectory)
+{
+    Q_D(RestoreIncrementalArchiveJob);
+    d->m_outputDirectory = outputDirectory;
+}
+
+QString RestoreIncrementalArchiveJob::outputDirectory() const
+{
+    Q_D(const RestoreIncrementalArchiveJob);
+    return d->m_outputDirectory;
+}
+
+void RestoreIncrementalArchiveJob::setTrustedSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(RestoreIncrementalArchiveJob);
+    d->m_trustedSigners = signers;
+}
+
+std::vector<GpgME::Key> RestoreIncrementalArchiveJob::trustedSigners() const
+{
+    Q_D(const RestoreIncrementalArchiveJob);
+    return d->m_trustedSigners;
+}
+
+void RestoreIncrementalArchiveJob::slotCancel()
+{
+    Q_D(RestoreIncrementalArchiveJob);
+    if (d->m_finished) {
+        return;
+    }
+    d->m_canceled = true;
+    if (d->m_deletionsJob) {
+        d->m_deletionsJob->slotCancel();
+    }
+    if (d->m_archiveJob) {
+        d->m_archiveJob->slotCancel();
+    }
+}
+
+#include "moc_restoreincrementalarchivejob.cpp"
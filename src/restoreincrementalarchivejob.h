@@ -0,0 +1,119 @@
+/*
+    restoreincrementalarchivejob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_RESTOREINCREMENTALARCHIVEJOB_H__
+#define __QGPGME_RESTOREINCREMENTALARCHIVEJOB_H__
+
+#include "job.h"
+
+#include <vector>
+
+namespace GpgME
+{
+class Key;
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+class Protocol;
+class RestoreIncrementalArchiveJobPrivate;
+
+/**
+ * This job restores a directory tree from a full archive and the incremental
+ * archives created after it by a SignEncryptArchiveJob with an incremental
+ * manifest file.
+ *
+ * The archives are applied one after the other in the given order. For each
+ * archive, the paths listed in the accompanying ".deletions.gpg" file (if any)
+ * are removed from the output directory first, then the archive is
+ * extracted into the output directory. The list of removed paths must carry
+ * a good signature made with a valid, i.e. trusted, key of one of the trusted
+ * signers; otherwise the job fails with \c GPG_ERR_BAD_SIGNATURE without
+ * removing anything. Paths that would point outside of the output directory,
+ * also via symbolic links, are rejected with \c GPG_ERR_INV_NAME.
+ *
+ * The verification results of the archives are passed to result() in the
+ * order of the archives, so that the caller can check who signed them.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself.
+ */
+class QGPGME_EXPORT RestoreIncrementalArchiveJob : public Job
+{
+    Q_OBJECT
+public:
+    explicit RestoreIncrementalArchiveJob(const Protocol *protocol);
+    ~RestoreIncrementalArchiveJob() override;
+
+    /**
+     * Sets the archives to restore, starting with the full archive followed
+     * by the incremental archives in the order they were created.
+     */
+    void setArchiveFiles(const std::vector<QString> &paths);
+    std::vector<QString> archiveFiles() const;
+
+    /**
+     * Sets the directory the content of the archives shall be written to. The
+     * directory is created if it doesn't exist.
+     */
+    void setOutputDirectory(const QString &outputDirectory);
+    QString outputDirectory() const;
+
+    /**
+     * Sets the keys that may sign the lists of removed paths. If no keys are
+     * set, then only the keys that made valid signatures of the archives
+     * restored before, i.e. usually of the full archive, may sign the lists.
+     */
+    void setTrustedSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> trustedSigners() const;
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the index of the archive that is currently restored and
+     * the number of archives.
+     */
+    void archiveProgress(int current, int total);
+
+    void result(const GpgME::Error &error, const std::vector<GpgME::VerificationResult> &verificationResults);
+
+private:
+    Q_DECLARE_PRIVATE(RestoreIncrementalArchiveJob)
+};
+
+}
+
+#endif // __QGPGME_RESTOREINCREMENTALARCHIVEJOB_H__
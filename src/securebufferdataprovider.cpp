@@ -0,0 +1,145 @@
+/*
+    securebufferdataprovider.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "securebufferdataprovider.h"
+
+#include "securebufferpool.h"
+
+#include <gpgme++/error.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+SecureBufferDataProvider::SecureBufferDataProvider(SecureBuffer &buffer)
+    : GpgME::DataProvider(), mBuffer(buffer), mOff(0)
+{
+    mBuffer.clear();
+}
+
+SecureBufferDataProvider::~SecureBufferDataProvider() = default;
+
+bool SecureBufferDataProvider::reserve(qint64 size)
+{
+    if (size <= mBuffer.capacity()) {
+        return true;
+    }
+    SecureBufferPool *pool = mBuffer.pool() ? mBuffer.pool() : SecureBufferPool::instance();
+    // at least double the capacity to keep the number of copies low
+    SecureBuffer newBuffer = pool->acquire(std::max(size, 2 * mBuffer.capacity()));
+    if (newBuffer.isNull()) {
+        return false;
+    }
+    newBuffer.resize(mBuffer.size());
+    if (mBuffer.size() > 0) {
+        memcpy(newBuffer.data(), mBuffer.constData(), mBuffer.size());
+    }
+    // this wipes the old buffer and returns it to its pool
+    mBuffer = std::move(newBuffer);
+    return true;
+}
+
+gpgme_ssize_t SecureBufferDataProvider::read(void *buffer, size_t bufSize)
+{
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    if (mOff >= mBuffer.size()) {
+        return 0; // EOF
+    }
+    const size_t amount = std::min(bufSize, static_cast<size_t>(mBuffer.size() - mOff));
+    memcpy(buffer, mBuffer.constData() + mOff, amount);
+    mOff += amount;
+    return amount;
+}
+
+gpgme_ssize_t SecureBufferDataProvider::write(const void *buffer, size_t bufSize)
+{
+    if (bufSize == 0) {
+        return 0;
+    }
+    if (!buffer) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return -1;
+    }
+    const qint64 newSize = mOff + bufSize;
+    if (!reserve(newSize)) {
+        Error::setSystemError(GPG_ERR_ENOMEM);
+        return -1;
+    }
+    if (newSize > mBuffer.size()) {
+        mBuffer.resize(newSize);
+    }
+    memcpy(mBuffer.data() + mOff, buffer, bufSize);
+    mOff += bufSize;
+    return bufSize;
+}
+
+gpgme_off_t SecureBufferDataProvider::seek(gpgme_off_t offset, int whence)
+{
+    gpgme_off_t newOffset = mOff;
+    switch (whence) {
+    case SEEK_SET:
+        newOffset = offset;
+        break;
+    case SEEK_CUR:
+        newOffset += offset;
+        break;
+    case SEEK_END:
+        newOffset = mBuffer.size() + offset;
+        break;
+    default:
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    if (newOffset < 0) {
+        Error::setSystemError(GPG_ERR_EINVAL);
+        return (gpgme_off_t) -1;
+    }
+    return mOff = newOffset;
+}
+
+void SecureBufferDataProvider::release()
+{
+    // the buffer is owned by the caller; keep the data
+}
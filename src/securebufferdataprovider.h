@@ -0,0 +1,103 @@
+/*
+    securebufferdataprovider.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SECUREBUFFERDATAPROVIDER_H__
+#define __QGPGME_SECUREBUFFERDATAPROVIDER_H__
+
+#include "qgpgme_export.h"
+
+#include <gpgme++/interfaces/dataprovider.h>
+
+#include <QtGlobal>
+
+namespace QGpgME
+{
+
+class SecureBuffer;
+
+/**
+ * This data provider writes the data to a SecureBuffer owned by the caller,
+ * e.g. to receive the plaintext of a decryption in secure memory. Use it
+ * with the exec() overloads of the jobs that take a GpgME::DataProvider.
+ *
+ * The content of the buffer is wiped when the provider is created, but the
+ * memory is kept. If the buffer is null or too small, then a larger buffer
+ * is acquired from the pool of the buffer (or from the global pool), the
+ * data is moved to the new buffer and the old buffer is wiped and returned
+ * to its pool. The buffer must outlive the provider.
+ */
+class QGPGME_EXPORT SecureBufferDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit SecureBufferDataProvider(SecureBuffer &buffer);
+    ~SecureBufferDataProvider() override;
+
+    const SecureBuffer &buffer() const
+    {
+        return mBuffer;
+    }
+
+    /**
+     * Makes sure that the buffer can hold at least \a size bytes without
+     * having to be replaced by a larger buffer. Returns false if no buffer
+     * of this size could be acquired.
+     */
+    bool reserve(qint64 size);
+
+private:
+    bool isSupported(Operation) const override
+    {
+        return true;
+    }
+#ifdef _WIN32
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override;
+    gpgme_ssize_t write(const void *buffer, size_t bufSize) override;
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override;
+#else
+    ssize_t read(void *buffer, size_t bufSize) override;
+    ssize_t write(const void *buffer, size_t bufSize) override;
+    off_t seek(off_t offset, int whence) override;
+#endif
+    void release() override;
+
+private:
+    SecureBuffer &mBuffer;
+#ifdef _WIN32
+    gpgme_off_t mOff;
+#else
+    off_t mOff;
+#endif
+};
+
+}
+
+#endif // __QGPGME_SECUREBUFFERDATAPROVIDER_H__
@@ -0,0 +1,361 @@
+/*
+    securebufferpool.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "securebufferpool.h"
+
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifdef Q_OS_WIN
+# include <windows.h>
+#else
+# include <sys/mman.h>
+#endif
+
+using namespace QGpgME;
+
+namespace
+{
+// the size classes are the powers of two from 4 KiB to 64 MiB
+constexpr int minSizeClassShift = 12;
+constexpr int maxSizeClassShift = 26;
+constexpr int numSizeClasses = maxSizeClassShift - minSizeClassShift + 1;
+constexpr qint64 pageSize = qint64(1) << minSizeClassShift;
+
+int sizeClass(qint64 size)
+{
+    int c = 0;
+    while (c < numSizeClasses && (qint64(1) << (minSizeClassShift + c)) < size) {
+        ++c;
+    }
+    return c;
+}
+
+qint64 sizeOfClass(int c)
+{
+    return qint64(1) << (minSizeClassShift + c);
+}
+
+void secureZero(void *ptr, size_t size)
+{
+#ifdef Q_OS_WIN
+    SecureZeroMemory(ptr, size);
+#elif defined(__GNUC__)
+    std::memset(ptr, 0, size);
+    // prevent the compiler from optimizing away the memset
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+    volatile char *p = static_cast<volatile char *>(ptr);
+    while (size--) {
+        *p++ = 0;
+    }
+#endif
+}
+
+char *allocatePages(qint64 size, bool *locked)
+{
+#ifdef Q_OS_WIN
+    void *ptr = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!ptr) {
+        return nullptr;
+    }
+    *locked = VirtualLock(ptr, size);
+#else
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+    *locked = (mlock(ptr, size) == 0);
+# ifdef MADV_DONTDUMP
+    // keep the content out of core dumps
+    madvise(ptr, size, MADV_DONTDUMP);
+# endif
+#endif
+    return static_cast<char *>(ptr);
+}
+
+void freePages(char *ptr, qint64 size, bool locked)
+{
+#ifdef Q_OS_WIN
+    if (locked) {
+        VirtualUnlock(ptr, size);
+    }
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    if (locked) {
+        munlock(ptr, size);
+    }
+    munmap(ptr, size);
+#endif
+}
+
+struct Block {
+    char *data;
+    bool locked;
+};
+}
+
+//
+//
+// SecureBuffer
+//
+//
+
+SecureBuffer::~SecureBuffer()
+{
+    release();
+}
+
+SecureBuffer::SecureBuffer(SecureBuffer &&other) noexcept
+    : mPool{other.mPool}
+    , mData{other.mData}
+    , mSize{other.mSize}
+    , mCapacity{other.mCapacity}
+    , mDirty{other.mDirty}
+    , mLocked{other.mLocked}
+{
+    other.mPool = nullptr;
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mCapacity = 0;
+    other.mDirty = 0;
+    other.mLocked = false;
+}
+
+SecureBuffer &SecureBuffer::operator=(SecureBuffer &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        std::swap(mPool, other.mPool);
+        std::swap(mData, other.mData);
+        std::swap(mSize, other.mSize);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mDirty, other.mDirty);
+        std::swap(mLocked, other.mLocked);
+    }
+    return *this;
+}
+
+void SecureBuffer::resize(qint64 size)
+{
+    size = qBound(qint64(0), size, mCapacity);
+    if (size > mSize) {
+        std::memset(mData + mSize, 0, size - mSize);
+    }
+    mSize = size;
+    mDirty = std::max(mDirty, size);
+}
+
+void SecureBuffer::clear()
+{
+    if (mData) {
+        secureZero(mData, mDirty);
+    }
+    mSize = 0;
+    mDirty = 0;
+}
+
+void SecureBuffer::release()
+{
+    if (mData) {
+        mPool->release(*this);
+    }
+}
+
+QByteArray SecureBuffer::toByteArray() const
+{
+    return QByteArray{mData, static_cast<int>(mSize)};
+}
+
+//
+//
+// SecureBufferPool
+//
+//
+
+class SecureBufferPool::Private
+{
+public:
+    mutable std::mutex mutex;
+    std::vector<Block> freeBlocks[numSizeClasses];
+    qint64 maxPooledBytes = 16 * 1024 * 1024;
+    Statistics stats;
+};
+
+SecureBufferPool *SecureBufferPool::instance()
+{
+    // intentionally leaked, so that buffers can still be released during
+    // the destruction of other static objects
+    static SecureBufferPool *pool = new SecureBufferPool;
+    return pool;
+}
+
+SecureBufferPool::SecureBufferPool()
+    : d{new Private}
+{
+}
+
+SecureBufferPool::~SecureBufferPool()
+{
+    trim();
+}
+
+SecureBuffer SecureBufferPool::acquire(qint64 minimumCapacity)
+{
+    SecureBuffer buffer;
+    if (minimumCapacity < 0) {
+        return buffer;
+    }
+
+    const int c = sizeClass(minimumCapacity);
+    // buffers larger than the largest size class are rounded up to full pages
+    const qint64 capacity = c < numSizeClasses ? sizeOfClass(c) : (minimumCapacity + pageSize - 1) & ~(pageSize - 1);
+
+    Block block{nullptr, false};
+    {
+        std::lock_guard<std::mutex> lock{d->mutex};
+        d->stats.acquisitions++;
+        if (c < numSizeClasses && !d->freeBlocks[c].empty()) {
+            block = d->freeBlocks[c].back();
+            d->freeBlocks[c].pop_back();
+            d->stats.hits++;
+            d->stats.pooledBytes -= capacity;
+        } else {
+            d->stats.misses++;
+        }
+    }
+
+    const bool allocate = !block.data;
+    if (allocate) {
+        block.data = allocatePages(capacity, &block.locked);
+        if (!block.data) {
+            return buffer;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{d->mutex};
+        if (allocate) {
+            if (block.locked) {
+                d->stats.lockedBytes += capacity;
+            } else {
+                d->stats.lockFailures++;
+            }
+        }
+        d->stats.bytesInUse += capacity;
+        d->stats.highWaterMark = std::max(d->stats.highWaterMark, d->stats.bytesInUse);
+    }
+
+    buffer.mPool = this;
+    buffer.mData = block.data;
+    buffer.mCapacity = capacity;
+    buffer.mLocked = block.locked;
+    return buffer;
+}
+
+void SecureBufferPool::release(SecureBuffer &buffer)
+{
+    secureZero(buffer.mData, buffer.mDirty);
+
+    const qint64 capacity = buffer.mCapacity;
+    const int c = sizeClass(capacity);
+    bool keep = false;
+    {
+        std::lock_guard<std::mutex> lock{d->mutex};
+        d->stats.bytesInUse -= capacity;
+        if (c < numSizeClasses && sizeOfClass(c) == capacity
+            && d->stats.pooledBytes + capacity <= d->maxPooledBytes) {
+            d->freeBlocks[c].push_back({buffer.mData, buffer.mLocked});
+            d->stats.pooledBytes += capacity;
+            keep = true;
+        } else if (buffer.mLocked) {
+            d->stats.lockedBytes -= capacity;
+        }
+    }
+    if (!keep) {
+        freePages(buffer.mData, capacity, buffer.mLocked);
+    }
+
+    buffer.mPool = nullptr;
+    buffer.mData = nullptr;
+    buffer.mSize = 0;
+    buffer.mCapacity = 0;
+    buffer.mDirty = 0;
+    buffer.mLocked = false;
+}
+
+void SecureBufferPool::setMaxPooledBytes(qint64 bytes)
+{
+    std::lock_guard<std::mutex> lock{d->mutex};
+    d->maxPooledBytes = bytes;
+}
+
+qint64 SecureBufferPool::maxPooledBytes() const
+{
+    std::lock_guard<std::mutex> lock{d->mutex};
+    return d->maxPooledBytes;
+}
+
+void SecureBufferPool::trim()
+{
+    std::vector<std::pair<Block, qint64>> blocks;
+    {
+        std::lock_guard<std::mutex> lock{d->mutex};
+        for (int c = 0; c < numSizeClasses; ++c) {
+            for (const auto &block : d->freeBlocks[c]) {
+                blocks.push_back({block, sizeOfClass(c)});
+                if (block.locked) {
+                    d->stats.lockedBytes -= sizeOfClass(c);
+                }
+            }
+            d->freeBlocks[c].clear();
+        }
+        d->stats.pooledBytes = 0;
+    }
+    for (const auto &b : blocks) {
+        freePages(b.first.data, b.second, b.first.locked);
+    }
+}
+
+SecureBufferPool::Statistics SecureBufferPool::statistics() const
+{
+    std::lock_guard<std::mutex> lock{d->mutex};
+    return d->stats;
+}
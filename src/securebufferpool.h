@@ -0,0 +1,231 @@
+/*
+    securebufferpool.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SECUREBUFFERPOOL_H__
+#define __QGPGME_SECUREBUFFERPOOL_H__
+
+#include "qgpgme_export.h"
+
+#include <QtGlobal>
+
+#include <memory>
+
+class QByteArray;
+
+namespace QGpgME
+{
+
+class SecureBufferPool;
+
+/**
+ * A buffer in secure memory that was obtained from a SecureBufferPool.
+ *
+ * The memory of the buffer is locked into RAM (if the operating system
+ * allows this), so that it is never written to swap. When the buffer is
+ * destroyed, then its content is wiped and the memory is returned to the
+ * pool for reuse.
+ *
+ * A SecureBuffer can be moved, but not copied.
+ */
+class QGPGME_EXPORT SecureBuffer
+{
+public:
+    SecureBuffer() = default;
+    ~SecureBuffer();
+
+    SecureBuffer(SecureBuffer &&other) noexcept;
+    SecureBuffer &operator=(SecureBuffer &&other) noexcept;
+
+    SecureBuffer(const SecureBuffer &) = delete;
+    SecureBuffer &operator=(const SecureBuffer &) = delete;
+
+    bool isNull() const
+    {
+        return !mData;
+    }
+
+    /**
+     * Returns a pointer to the memory of the buffer. Only the first size()
+     * bytes are considered content, i.e. call resize() before writing
+     * beyond size().
+     */
+    char *data()
+    {
+        return mData;
+    }
+    const char *constData() const
+    {
+        return mData;
+    }
+
+    /**
+     * Returns the number of bytes of the buffer that are in use.
+     */
+    qint64 size() const
+    {
+        return mSize;
+    }
+
+    /**
+     * Sets the number of bytes that are in use. \a size is limited to the
+     * capacity of the buffer. Bytes that are added are zero-initialized.
+     */
+    void resize(qint64 size);
+
+    qint64 capacity() const
+    {
+        return mCapacity;
+    }
+
+    /**
+     * Returns true, if the memory of the buffer is locked into RAM.
+     */
+    bool isLocked() const
+    {
+        return mLocked;
+    }
+
+    /**
+     * Wipes the content of the buffer and sets its size to 0. The memory
+     * is kept.
+     */
+    void clear();
+
+    /**
+     * Wipes the content of the buffer and returns the memory to the pool.
+     * Afterwards the buffer is null.
+     */
+    void release();
+
+    /**
+     * Returns the pool the buffer was obtained from.
+     */
+    SecureBufferPool *pool() const
+    {
+        return mPool;
+    }
+
+    /**
+     * Returns a copy of the content of the buffer in ordinary memory.
+     *
+     * \note The copy is neither locked into RAM nor wiped when it is freed.
+     */
+    QByteArray toByteArray() const;
+
+private:
+    friend class SecureBufferPool;
+
+    SecureBufferPool *mPool = nullptr;
+    char *mData = nullptr;
+    qint64 mSize = 0;
+    qint64 mCapacity = 0;
+    // number of bytes that may contain data and need to be wiped
+    qint64 mDirty = 0;
+    bool mLocked = false;
+};
+
+/**
+ * A pool of buffers in secure memory.
+ *
+ * The pool hands out buffers whose capacity is a power of two of at least
+ * 4 KiB (the size class). Buffers that are released are wiped and kept in
+ * the pool, so that they can be reused for later operations without having
+ * to allocate and lock new memory. Buffers larger than the largest size
+ * class are not pooled.
+ *
+ * All functions are thread-safe.
+ */
+class QGPGME_EXPORT SecureBufferPool
+{
+public:
+    struct Statistics {
+        /** Number of acquired buffers. */
+        quint64 acquisitions = 0;
+        /** Number of acquired buffers that were reused from the pool. */
+        quint64 hits = 0;
+        /** Number of acquired buffers that had to be newly allocated. */
+        quint64 misses = 0;
+        /** Number of bytes currently handed out to buffers. */
+        qint64 bytesInUse = 0;
+        /** Maximum number of bytes that were handed out at the same time. */
+        qint64 highWaterMark = 0;
+        /** Number of bytes kept in the pool for reuse. */
+        qint64 pooledBytes = 0;
+        /** Number of bytes (in use or pooled) that are locked into RAM. */
+        qint64 lockedBytes = 0;
+        /** Number of allocations for which locking the memory failed. */
+        quint64 lockFailures = 0;
+    };
+
+    /**
+     * Returns the global pool.
+     */
+    static SecureBufferPool *instance();
+
+    SecureBufferPool();
+    ~SecureBufferPool();
+
+    SecureBufferPool(const SecureBufferPool &) = delete;
+    SecureBufferPool &operator=(const SecureBufferPool &) = delete;
+
+    /**
+     * Returns an empty buffer with a capacity of at least \a minimumCapacity
+     * bytes. Returns a null buffer if the memory could not be allocated.
+     */
+    SecureBuffer acquire(qint64 minimumCapacity);
+
+    /**
+     * Sets the maximum number of bytes that are kept in the pool. Released
+     * buffers that would exceed this limit are freed. Defaults to 16 MiB.
+     */
+    void setMaxPooledBytes(qint64 bytes);
+    qint64 maxPooledBytes() const;
+
+    /**
+     * Frees all buffers that are kept in the pool.
+     */
+    void trim();
+
+    Statistics statistics() const;
+
+private:
+    friend class SecureBuffer;
+    void release(SecureBuffer &buffer);
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_SECUREBUFFERPOOL_H__
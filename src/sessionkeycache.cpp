@@ -0,0 +1,332 @@
+/*
+    sessionkeycache.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "sessionkeycache.h"
+#include "sessionkeycache_p.h"
+
+#include "securebufferpool.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QHash>
+
+#include <gpgme++/context.h>
+#include <gpgme++/data.h>
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/interfaces/dataprovider.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <vector>
+
+using namespace QGpgME;
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+// each session key is stored in a slot of this size including a null byte
+constexpr qint64 slotSize = SessionKeyCache::MaxSessionKeyLength + 1;
+
+struct Entry {
+    QByteArray messageId;
+    int slot;
+    Clock::time_point insertTime;
+};
+}
+
+class SessionKeyCache::Private
+{
+public:
+    using EntryList = std::list<Entry>;
+
+    char *slotData(int slot)
+    {
+        return storage.data() + slot * slotSize;
+    }
+
+    void wipeSlot(int slot)
+    {
+        // overwriting the slot with zeros is enough; the storage is wiped
+        // by the pool when it is released
+        std::memset(slotData(slot), 0, slotSize);
+        freeSlots.push_back(slot);
+    }
+
+    void removeEntry(EntryList::iterator it)
+    {
+        wipeSlot(it->slot);
+        index.remove(it->messageId);
+        entries.erase(it);
+    }
+
+    bool isExpired(const Entry &entry, Clock::time_point now) const
+    {
+        return maxAge > 0 && now - entry.insertTime >= std::chrono::seconds{maxAge};
+    }
+
+    // makes sure that the storage has room for maxEntries session keys
+    bool ensureStorage()
+    {
+        const qint64 size = maxEntries * slotSize;
+        if (!storage.isNull() && storage.size() == size) {
+            return true;
+        }
+        SecureBuffer newStorage = SecureBufferPool::instance()->acquire(size);
+        if (newStorage.isNull()) {
+            return false;
+        }
+        newStorage.resize(size);
+        // move the cached session keys to the first slots of the new storage
+        int slot = 0;
+        for (auto &entry : entries) {
+            std::memcpy(newStorage.data() + slot * slotSize, slotData(entry.slot), slotSize);
+            entry.slot = slot++;
+        }
+        freeSlots.clear();
+        for (int s = maxEntries - 1; s >= slot; --s) {
+            freeSlots.push_back(s);
+        }
+        storage = std::move(newStorage);
+        return true;
+    }
+
+    void evictToSize(int size)
+    {
+        while (static_cast<int>(entries.size()) > size) {
+            removeEntry(std::prev(entries.end()));
+            stats.evictions++;
+        }
+    }
+
+    mutable std::mutex mutex;
+    int maxEntries = 256;
+    int maxAge = 0;
+    // the session keys in the order of their last use; the most recently
+    // used session key comes first
+    EntryList entries;
+    QHash<QByteArray, EntryList::iterator> index;
+    SecureBuffer storage;
+    std::vector<int> freeSlots;
+    Statistics stats;
+};
+
+SessionKeyCache::SessionKeyCache()
+    : d{new Private}
+{
+}
+
+SessionKeyCache::~SessionKeyCache() = default;
+
+QByteArray SessionKeyCache::messageId(const QByteArray &cipherText)
+{
+    return QCryptographicHash::hash(cipherText, QCryptographicHash::Sha256);
+}
+
+void SessionKeyCache::setMaxEntries(int entries)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->maxEntries = std::max(entries, 1);
+    d->evictToSize(d->maxEntries);
+    if (!d->storage.isNull() && !d->ensureStorage()) {
+        // no secure memory for the new size -> drop the cached session keys
+        d->entries.clear();
+        d->index.clear();
+        d->freeSlots.clear();
+        d->storage.release();
+    }
+}
+
+int SessionKeyCache::maxEntries() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->maxEntries;
+}
+
+void SessionKeyCache::setMaxAge(int seconds)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->maxAge = std::max(seconds, 0);
+}
+
+int SessionKeyCache::maxAge() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->maxAge;
+}
+
+bool SessionKeyCache::insert(const QByteArray &messageId, const char *sessionKey)
+{
+    const size_t length = sessionKey ? std::strlen(sessionKey) : 0;
+    if (length == 0 || length > static_cast<size_t>(MaxSessionKeyLength)) {
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    if (!d->ensureStorage()) {
+        return false;
+    }
+    const auto it = d->index.constFind(messageId);
+    if (it != d->index.constEnd()) {
+        d->removeEntry(it.value());
+    }
+    if (d->freeSlots.empty()) {
+        d->evictToSize(d->entries.empty() ? 0 : static_cast<int>(d->entries.size()) - 1);
+    }
+    if (d->freeSlots.empty()) {
+        return false;
+    }
+    const int slot = d->freeSlots.back();
+    d->freeSlots.pop_back();
+    std::memcpy(d->slotData(slot), sessionKey, length + 1);
+    d->entries.push_front(Entry{messageId, slot, Clock::now()});
+    d->index.insert(messageId, d->entries.begin());
+    d->stats.insertions++;
+    return true;
+}
+
+SecureBuffer SessionKeyCache::find(const QByteArray &messageId)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->stats.lookups++;
+    const auto it = d->index.constFind(messageId);
+    if (it == d->index.constEnd()) {
+        d->stats.misses++;
+        return {};
+    }
+    const auto entry = it.value();
+    if (d->isExpired(*entry, Clock::now())) {
+        d->removeEntry(entry);
+        d->stats.expirations++;
+        d->stats.misses++;
+        return {};
+    }
+    const char *sessionKey = d->slotData(entry->slot);
+    const qint64 length = static_cast<qint64>(std::strlen(sessionKey));
+    SecureBuffer result = SecureBufferPool::instance()->acquire(length + 1);
+    if (result.isNull()) {
+        d->stats.misses++;
+        return {};
+    }
+    result.resize(length + 1);
+    std::memcpy(result.data(), sessionKey, length + 1);
+    result.resize(length);
+    // mark the session key as most recently used
+    d->entries.splice(d->entries.begin(), d->entries, entry);
+    d->stats.hits++;
+    return result;
+}
+
+void SessionKeyCache::remove(const QByteArray &messageId)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto it = d->index.constFind(messageId);
+    if (it != d->index.constEnd()) {
+        d->removeEntry(it.value());
+    }
+}
+
+void SessionKeyCache::clear()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->entries.clear();
+    d->index.clear();
+    d->freeSlots.clear();
+    // releasing the storage wipes it
+    d->storage.release();
+}
+
+SessionKeyCache::Statistics SessionKeyCache::statistics() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    Statistics result = d->stats;
+    result.entries = static_cast<int>(d->entries.size());
+    result.hitRate = result.lookups > 0 ? static_cast<double>(result.hits) / result.lookups : 0;
+    return result;
+}
+
+bool _detail::prepareSessionKey(GpgME::Context *ctx, SessionKeyCache *cache, const QByteArray &messageId)
+{
+    if (!cache) {
+        return false;
+    }
+    // the context may be reused for other messages, i.e. the flags set for
+    // the previous message must be overwritten
+    const SecureBuffer sessionKey = cache->find(messageId);
+    if (!sessionKey.isNull()) {
+        ctx->setFlag("override-session-key", sessionKey.constData());
+        ctx->setFlag("export-session-key", "0");
+        return true;
+    }
+    ctx->setFlag("override-session-key", "");
+    ctx->setFlag("export-session-key", "1");
+    return false;
+}
+
+bool _detail::updateSessionKeyCache(SessionKeyCache *cache, const QByteArray &messageId,
+                                    const GpgME::DecryptionResult &result, bool usedCachedSessionKey)
+{
+    if (!cache) {
+        return false;
+    }
+    if (result.error().code()) {
+        if (usedCachedSessionKey && !result.error().isCanceled()) {
+            // don't try the session key again
+            cache->remove(messageId);
+            return true;
+        }
+        return false;
+    }
+    if (!usedCachedSessionKey && result.sessionKey()) {
+        cache->insert(messageId, result.sessionKey());
+    }
+    return false;
+}
+
+bool _detail::rewindForRetry(GpgME::Data &input, GpgME::DataProvider &output)
+{
+    // gpg rejects a wrong session key before it writes any plain text, but
+    // if something has been written anyway, then it cannot be taken back
+    if (!output.isSupported(GpgME::DataProvider::Seek) || output.seek(0, SEEK_CUR) != 0) {
+        return false;
+    }
+    return input.seek(0, SEEK_SET) == 0;
+}
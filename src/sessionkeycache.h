@@ -0,0 +1,157 @@
+/*
+    sessionkeycache.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SESSIONKEYCACHE_H__
+#define __QGPGME_SESSIONKEYCACHE_H__
+
+#include "qgpgme_export.h"
+
+#include <QtGlobal>
+
+#include <memory>
+
+class QByteArray;
+
+namespace QGpgME
+{
+
+class SecureBuffer;
+
+/**
+ * A cache for the session keys of decrypted messages.
+ *
+ * Decrypting a message requires a public-key operation, which may involve a
+ * smartcard or a pinentry, every time the message is decrypted. If a
+ * session key cache is set for a DecryptJob or a DecryptVerifyJob, then the
+ * job exports the session key when it decrypts a message for the first
+ * time, and decrypts the message with the cached session key the next
+ * time.
+ *
+ * The session keys are kept in secure memory (see SecureBufferPool) and
+ * are wiped when they are evicted. The cache holds at most maxEntries()
+ * session keys; if it is full, then the least recently used session key is
+ * evicted. Optionally, session keys expire after maxAge() seconds.
+ *
+ * The messages are identified by an id, usually the messageId() of the
+ * cipher text.
+ *
+ * All functions are thread-safe.
+ */
+class QGPGME_EXPORT SessionKeyCache
+{
+public:
+    struct Statistics {
+        /** Number of lookups. */
+        quint64 lookups = 0;
+        /** Number of lookups that found a session key. */
+        quint64 hits = 0;
+        /** Number of lookups that didn't find a session key. */
+        quint64 misses = 0;
+        /** Number of session keys that were added. */
+        quint64 insertions = 0;
+        /** Number of session keys that were evicted because the cache was full. */
+        quint64 evictions = 0;
+        /** Number of session keys that were dropped because they expired. */
+        quint64 expirations = 0;
+        /** Number of session keys in the cache. */
+        int entries = 0;
+        /** hits / lookups, or 0 if there were no lookups. */
+        double hitRate = 0;
+    };
+
+    /**
+     * The maximum length of a session key in the format used by gpgme,
+     * i.e. "<algo>:<hex key>". Longer session keys are not cached.
+     */
+    static constexpr int MaxSessionKeyLength = 127;
+
+    SessionKeyCache();
+    ~SessionKeyCache();
+
+    SessionKeyCache(const SessionKeyCache &) = delete;
+    SessionKeyCache &operator=(const SessionKeyCache &) = delete;
+
+    /**
+     * Returns the id of the message \a cipherText, i.e. a hash of the cipher
+     * text.
+     */
+    static QByteArray messageId(const QByteArray &cipherText);
+
+    /**
+     * Sets the maximum number of cached session keys. Defaults to 256.
+     */
+    void setMaxEntries(int entries);
+    int maxEntries() const;
+
+    /**
+     * Sets the number of seconds after which a cached session key expires.
+     * Defaults to 0, i.e. session keys don't expire.
+     */
+    void setMaxAge(int seconds);
+    int maxAge() const;
+
+    /**
+     * Adds the session key \a sessionKey of the message with the id
+     * \a messageId to the cache. Returns false if the session key is too
+     * long or if no secure memory is available.
+     */
+    bool insert(const QByteArray &messageId, const char *sessionKey);
+
+    /**
+     * Returns a copy of the session key of the message with the id
+     * \a messageId in secure memory, or a null buffer if the cache doesn't
+     * contain a session key for the message. The session key is followed by
+     * a null byte.
+     */
+    SecureBuffer find(const QByteArray &messageId);
+
+    /**
+     * Removes the session key of the message with the id \a messageId, e.g.
+     * because it didn't work.
+     */
+    void remove(const QByteArray &messageId);
+
+    /**
+     * Removes all session keys.
+     */
+    void clear();
+
+    Statistics statistics() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_SESSIONKEYCACHE_H__
@@ -0,0 +1,91 @@
+/*
+    sessionkeycache_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SESSIONKEYCACHE_P_H__
+#define __QGPGME_SESSIONKEYCACHE_P_H__
+
+#include "sessionkeycache.h"
+
+#include <QByteArray>
+
+#include <tuple>
+
+namespace GpgME
+{
+class Context;
+class Data;
+class DataProvider;
+class DecryptionResult;
+}
+
+namespace QGpgME
+{
+namespace _detail
+{
+// Sets up ctx to decrypt the message with the cached session key, or to
+// export the session key if the cache doesn't contain it. Returns true if
+// the cached session key is used. Does nothing if cache is null.
+bool prepareSessionKey(GpgME::Context *ctx, SessionKeyCache *cache, const QByteArray &messageId);
+
+// Adds the exported session key to the cache after a successful decryption;
+// removes a cached session key that didn't work. Returns true if the cached
+// session key didn't work.
+bool updateSessionKeyCache(SessionKeyCache *cache, const QByteArray &messageId,
+                           const GpgME::DecryptionResult &result, bool usedCachedSessionKey);
+
+// Rewinds the input for decrypting the message once more; returns false if
+// this isn't possible, e.g. because some output has already been written.
+bool rewindForRetry(GpgME::Data &input, GpgME::DataProvider &output);
+
+// Runs decrypt(), which decrypts input into output with ctx and returns a
+// tuple starting with the DecryptionResult, with the cached session key of
+// the message. If the cached session key doesn't work, e.g. because another
+// message has the same message ID, then the message is decrypted once more
+// with the secret key.
+template<typename T_decrypt>
+auto decryptWithSessionKeyCache(GpgME::Context *ctx, SessionKeyCache *cache, const QByteArray &messageId,
+                                GpgME::Data &input, GpgME::DataProvider &output, const T_decrypt &decrypt)
+{
+    bool usedCachedSessionKey = prepareSessionKey(ctx, cache, messageId);
+    auto result = decrypt();
+    if (updateSessionKeyCache(cache, messageId, std::get<0>(result), usedCachedSessionKey)
+        && rewindForRetry(input, output)) {
+        usedCachedSessionKey = prepareSessionKey(ctx, cache, messageId);
+        result = decrypt();
+        updateSessionKeyCache(cache, messageId, std::get<0>(result), usedCachedSessionKey);
+    }
+    return result;
+}
+}
+}
+
+#endif // __QGPGME_SESSIONKEYCACHE_P_H__
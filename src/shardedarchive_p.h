@@ -0,0 +1,170 @@
+/*
+    shardedarchive_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SHARDEDARCHIVE_P_H__
+#define __QGPGME_SHARDEDARCHIVE_P_H__
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include <utility>
+#include <vector>
+
+namespace QGpgME
+{
+namespace _detail
+{
+
+// The manifest of a sharded archive. It's a small text file with one line
+// per shard which is clear-signed, e.g.
+//   QGpgME-Sharded-Archive: 1
+//   Shard: 1048576 <sha256 in hex> 1234 2097152 archive.0.tar.gpg
+struct ShardedArchiveManifest {
+    struct Shard {
+        qint64 size = 0;
+        QByteArray sha256; // in hex
+        qint64 fileCount = 0;
+        qint64 bytes = 0; // total size of the files in the shard
+        QString fileName; // relative to the directory of the manifest
+    };
+    std::vector<Shard> shards;
+
+    QByteArray toByteArray() const
+    {
+        QByteArray result = "QGpgME-Sharded-Archive: 1\n";
+        for (const auto &shard : shards) {
+            result += "Shard: " + QByteArray::number(shard.size) + ' ' + shard.sha256 + ' '
+                + QByteArray::number(shard.fileCount) + ' ' + QByteArray::number(shard.bytes) + ' '
+                + shard.fileName.toUtf8() + '\n';
+        }
+        return result;
+    }
+
+    static bool fromByteArray(const QByteArray &data, ShardedArchiveManifest &manifest)
+    {
+        manifest.shards.clear();
+        const QList<QByteArray> lines = data.split('\n');
+        if (lines.isEmpty() || lines.front().trimmed() != "QGpgME-Sharded-Archive: 1") {
+            return false;
+        }
+        for (const auto &line : lines) {
+            if (!line.startsWith("Shard: ")) {
+                continue;
+            }
+            const QList<QByteArray> fields = line.mid(7).trimmed().split(' ');
+            if (fields.size() < 5) {
+                return false;
+            }
+            Shard shard;
+            bool sizeOk = false, countOk = false, bytesOk = false;
+            shard.size = fields[0].toLongLong(&sizeOk);
+            shard.sha256 = fields[1];
+            shard.fileCount = fields[2].toLongLong(&countOk);
+            shard.bytes = fields[3].toLongLong(&bytesOk);
+            // the file name is the rest of the line and may contain spaces
+            const int nameStart = 7 + fields[0].size() + fields[1].size() + fields[2].size() + fields[3].size() + 4;
+            shard.fileName = QString::fromUtf8(line.mid(nameStart).trimmed());
+            // the shards must be next to the manifest
+            if (!sizeOk || !countOk || !bytesOk || shard.sha256.size() != 64 || shard.fileName.isEmpty()
+                || shard.fileName.contains(QLatin1Char('/')) || shard.fileName.contains(QLatin1Char('\\'))
+                || shard.fileName.startsWith(QLatin1Char('.'))) {
+                return false;
+            }
+            manifest.shards.push_back(shard);
+        }
+        return !manifest.shards.empty();
+    }
+};
+
+// Combines the scaled data progress of multiple archive jobs
+class ShardedArchiveProgress
+{
+public:
+    void resize(size_t numShards)
+    {
+        mFiles.assign(numShards, {0, 0});
+        mData.assign(numShards, {0, 0});
+    }
+
+    void setFileProgress(size_t shard, int current, int total)
+    {
+        mFiles[shard] = {current, total};
+    }
+
+    // converts the scaled values to bytes using the total size of the files
+    // in the shard, i.e. the progress is always measured in plaintext bytes
+    void setDataProgress(size_t shard, int current, int total, qint64 shardBytes)
+    {
+        mData[shard] = {total > 0 ? shardBytes * current / total : 0, shardBytes};
+    }
+
+    std::pair<int, int> fileProgress() const
+    {
+        qint64 current = 0, total = 0;
+        for (const auto &p : mFiles) {
+            current += p.first;
+            total += p.second;
+        }
+        return scaled(current, total);
+    }
+
+    std::pair<int, int> dataProgress() const
+    {
+        qint64 current = 0, total = 0;
+        for (const auto &p : mData) {
+            current += p.first;
+            total += p.second;
+        }
+        return scaled(current, total);
+    }
+
+private:
+    // like gpg, scale the values so that they do not exceed 2^20
+    static std::pair<int, int> scaled(qint64 current, qint64 total)
+    {
+        static const qint64 limit = 1 << 20;
+        if (total > limit) {
+            current = current * limit / total;
+            total = limit;
+        }
+        return {static_cast<int>(current), static_cast<int>(total)};
+    }
+
+    std::vector<std::pair<qint64, qint64>> mFiles;
+    std::vector<std::pair<qint64, qint64>> mData;
+};
+
+}
+}
+
+#endif // __QGPGME_SHARDEDARCHIVE_P_H__
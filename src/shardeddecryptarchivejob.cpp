@@ -0,0 +1,370 @@
+/*
+    shardeddecryptarchivejob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "shardeddecryptarchivejob.h"
+
+#include "decryptverifyarchivejob.h"
+#include "job_p.h"
+#include "protocol.h"
+#include "shardedarchive_p.h"
+#include "signaturecheck_p.h"
+#include "verifyopaquejob.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
+#include <QThread>
+
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::ShardedDecryptArchiveJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(ShardedDecryptArchiveJob)
+
+    explicit ShardedDecryptArchiveJobPrivate(const Protocol *protocol)
+        : m_protocol{protocol}
+    {
+    }
+
+    ~ShardedDecryptArchiveJobPrivate() override
+    {
+        m_canceled = true;
+        for (auto &shard : m_shards) {
+            if (shard.hashThread.joinable()) {
+                shard.hashThread.join();
+            }
+        }
+    }
+
+    GpgME::Error startIt() override;
+
+    void startNow() override
+    {
+    }
+
+    void manifestVerified(const GpgME::VerificationResult &result, const QByteArray &plainText);
+    void startNextShards();
+    void shardChecked(size_t index, bool matches);
+    void shardFinished(size_t index, const GpgME::Error &error);
+    void fail(const GpgME::Error &error);
+    void finishIfDone();
+
+    struct Shard {
+        _detail::ShardedArchiveManifest::Shard info;
+        QString filePath;
+        std::thread hashThread;
+        QPointer<DecryptVerifyArchiveJob> job;
+    };
+
+    const Protocol *const m_protocol;
+    QString m_manifestFile;
+    QString m_outputDirectory;
+    int m_maxConcurrentShards = QThread::idealThreadCount();
+
+    QPointer<VerifyOpaqueJob> m_verifyJob;
+    GpgME::VerificationResult m_manifestVerificationResult;
+    std::vector<Shard> m_shards;
+    size_t m_nextShard = 0;
+    size_t m_activeShards = 0;
+    std::atomic<bool> m_canceled{false};
+    GpgME::Error m_error;
+    _detail::ShardedArchiveProgress m_progress;
+    bool m_started = false;
+    bool m_finished = false;
+};
+
+GpgME::Error ShardedDecryptArchiveJobPrivate::startIt()
+{
+    if (m_manifestFile.isEmpty() || m_outputDirectory.isEmpty()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (m_started) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+
+    QFile file{m_manifestFile};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return Error::fromCode(file.exists() ? GPG_ERR_EACCES : GPG_ERR_ENOENT);
+    }
+    // a manifest is small; don't let a bogus file exhaust the memory
+    static const qint64 maxManifestSize = 1024 * 1024;
+    if (file.size() > maxManifestSize) {
+        return Error::fromCode(GPG_ERR_TOO_LARGE);
+    }
+    const QByteArray signedManifest = file.readAll();
+
+    Q_Q(ShardedDecryptArchiveJob);
+    m_verifyJob = m_protocol->verifyOpaqueJob(true);
+    if (!m_verifyJob) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    QObject::connect(m_verifyJob.data(), &VerifyOpaqueJob::result, q, [this](const VerificationResult &result, const QByteArray &plainText) {
+        manifestVerified(result, plainText);
+    });
+    if (const auto err = m_verifyJob->start(signedManifest)) {
+        delete m_verifyJob.data();
+        return err;
+    }
+    m_started = true;
+    return {};
+}
+
+void ShardedDecryptArchiveJobPrivate::manifestVerified(const GpgME::VerificationResult &result, const QByteArray &plainText)
+{
+    m_verifyJob = nullptr;
+    m_manifestVerificationResult = result;
+    if (m_canceled) {
+        fail(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (result.error()) {
+        fail(result.error());
+        return;
+    }
+    if (!_detail::allSignaturesValid(result)) {
+        fail(Error::fromCode(GPG_ERR_BAD_SIGNATURE));
+        return;
+    }
+
+    _detail::ShardedArchiveManifest manifest;
+    if (!_detail::ShardedArchiveManifest::fromByteArray(plainText, manifest)) {
+        fail(Error::fromCode(GPG_ERR_BAD_DATA));
+        return;
+    }
+    if (!QDir{}.mkpath(m_outputDirectory)) {
+        fail(Error::fromCode(GPG_ERR_EIO));
+        return;
+    }
+
+    const QDir manifestDir = QFileInfo{m_manifestFile}.absoluteDir();
+    m_shards = std::vector<Shard>(manifest.shards.size());
+    m_progress.resize(m_shards.size());
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        m_shards[i].info = manifest.shards[i];
+        m_shards[i].filePath = manifestDir.filePath(manifest.shards[i].fileName);
+    }
+    startNextShards();
+}
+
+void ShardedDecryptArchiveJobPrivate::startNextShards()
+{
+    Q_Q(ShardedDecryptArchiveJob);
+    while (!m_error && m_nextShard < m_shards.size() && m_activeShards < static_cast<size_t>(m_maxConcurrentShards)) {
+        const size_t index = m_nextShard++;
+        m_activeShards++;
+        // check the shard against the manifest before anything is extracted
+        const QString filePath = m_shards[index].filePath;
+        const qint64 expectedSize = m_shards[index].info.size;
+        const QByteArray expectedHash = m_shards[index].info.sha256;
+        m_shards[index].hashThread = std::thread{[this, q, index, filePath, expectedSize, expectedHash]() {
+            bool matches = false;
+            QFile file{filePath};
+            if (file.open(QIODevice::ReadOnly) && file.size() == expectedSize) {
+                QCryptographicHash hash{QCryptographicHash::Sha256};
+                QByteArray buffer(256 * 1024, Qt::Uninitialized);
+                qint64 numRead;
+                while (!m_canceled && (numRead = file.read(buffer.data(), buffer.size())) > 0) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+                    hash.addData(QByteArrayView{buffer.constData(), static_cast<qsizetype>(numRead)});
+#else
+                    hash.addData(buffer.constData(), static_cast<int>(numRead));
+#endif
+                }
+                matches = !m_canceled && numRead == 0 && hash.result().toHex() == expectedHash;
+            }
+            // the destructor joins this thread, i.e. q is still alive
+            QMetaObject::invokeMethod(q, [this, index, matches]() {
+                shardChecked(index, matches);
+            }, Qt::QueuedConnection);
+        }};
+    }
+    finishIfDone();
+}
+
+void ShardedDecryptArchiveJobPrivate::shardChecked(size_t index, bool matches)
+{
+    Q_Q(ShardedDecryptArchiveJob);
+    auto &shard = m_shards[index];
+    shard.hashThread.join();
+
+    if (m_canceled || m_error) {
+        m_activeShards--;
+        fail(m_error ? m_error : Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (!matches) {
+        m_activeShards--;
+        fail(Error::fromCode(GPG_ERR_CHECKSUM));
+        return;
+    }
+
+    shard.job = m_protocol->decryptVerifyArchiveJob();
+    if (!shard.job) {
+        m_activeShards--;
+        fail(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+        return;
+    }
+    shard.job->setInputFile(shard.filePath);
+    shard.job->setOutputDirectory(m_outputDirectory);
+    QObject::connect(shard.job.data(), &DecryptVerifyArchiveJob::fileProgress, q, [this, q, index](int current, int) {
+        // gpgtar doesn't know the number of files when extracting; the manifest does
+        m_progress.setFileProgress(index, current, m_shards[index].info.fileCount);
+        const auto progress = m_progress.fileProgress();
+        Q_EMIT q->fileProgress(progress.first, progress.second);
+    });
+    QObject::connect(shard.job.data(), &DecryptVerifyArchiveJob::dataProgress, q, [this, q, index](int current, int total) {
+        // like the encrypt job, count the bytes of the extracted files
+        m_progress.setDataProgress(index, current, total, m_shards[index].info.bytes);
+        const auto progress = m_progress.dataProgress();
+        Q_EMIT q->dataProgress(progress.first, progress.second);
+        Q_EMIT q->jobProgress(progress.first, progress.second);
+    });
+    QObject::connect(shard.job.data(), &DecryptVerifyArchiveJob::result, q, [this, index](const DecryptionResult &result) {
+        shardFinished(index, result.error());
+    });
+    if (const auto err = shard.job->startIt()) {
+        delete shard.job.data();
+        m_activeShards--;
+        fail(err);
+    }
+}
+
+void ShardedDecryptArchiveJobPrivate::shardFinished(size_t index, const GpgME::Error &error)
+{
+    m_shards[index].job = nullptr;
+    m_activeShards--;
+    if (error) {
+        fail(error);
+        return;
+    }
+    startNextShards();
+}
+
+void ShardedDecryptArchiveJobPrivate::fail(const GpgME::Error &error)
+{
+    if (!m_error) {
+        m_error = error;
+        for (const auto &shard : m_shards) {
+            if (shard.job) {
+                shard.job->slotCancel();
+            }
+        }
+    }
+    finishIfDone();
+}
+
+void ShardedDecryptArchiveJobPrivate::finishIfDone()
+{
+    Q_Q(ShardedDecryptArchiveJob);
+    if (m_finished || m_activeShards > 0 || (!m_error && m_nextShard < m_shards.size())) {
+        return;
+    }
+    m_finished = true;
+    Q_EMIT q->done();
+    Q_EMIT q->result(m_error, m_manifestVerificationResult);
+    q->deleteLater();
+}
+
+ShardedDecryptArchiveJob::ShardedDecryptArchiveJob(const Protocol *protocol)
+    : Job{std::unique_ptr<ShardedDecryptArchiveJobPrivate>(new ShardedDecryptArchiveJobPrivate{protocol}), nullptr}
+{
+}
+
+ShardedDecryptArchiveJob::~ShardedDecryptArchiveJob() = default;
+
+void ShardedDecryptArchiveJob::setManifestFile(const QString &path)
+{
+    Q_D(ShardedDecryptArchiveJob);
+    d->m_manifestFile = path;
+}
+
+QString ShardedDecryptArchiveJob::manifestFile() const
+{
+    Q_D(const ShardedDecryptArchiveJob);
+    return d->m_manifestFile;
+}
+
+void ShardedDecryptArchiveJob::setOutputDirectory(const QString &outputDirectory)
+{
+    Q_D(ShardedDecryptArchiveJob);
+    d->m_outputDirectory = outputDirectory;
+}
+
+QString ShardedDecryptArchiveJob::outputDirectory() const
+{
+    Q_D(const ShardedDecryptArchiveJob);
+    return d->m_outputDirectory;
+}
+
+void ShardedDecryptArchiveJob::setMaxConcurrentShards(int count)
+{
+    Q_D(ShardedDecryptArchiveJob);
+    d->m_maxConcurrentShards = std::max(count, 1);
+}
+
+int ShardedDecryptArchiveJob::maxConcurrentShards() const
+{
+    Q_D(const ShardedDecryptArchiveJob);
+    return d->m_maxConcurrentShards;
+}
+
+void ShardedDecryptArchiveJob::slotCancel()
+{
+    Q_D(ShardedDecryptArchiveJob);
+    if (d->m_finished) {
+        return;
+    }
+    d->m_canceled = true;
+    if (d->m_verifyJob) {
+        d->m_verifyJob->slotCancel();
+    }
+    if (!d->m_error) {
+        d->fail(Error::fromCode(GPG_ERR_CANCELED));
+    }
+}
+
+#include "moc_shardeddecryptarchivejob.cpp"
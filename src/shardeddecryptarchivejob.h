@@ -0,0 +1,117 @@
+/*
+    shardeddecryptarchivejob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SHARDEDDECRYPTARCHIVEJOB_H__
+#define __QGPGME_SHARDEDDECRYPTARCHIVEJOB_H__
+
+#include "job.h"
+
+namespace GpgME
+{
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+class Protocol;
+class ShardedDecryptArchiveJobPrivate;
+
+/**
+ * This job extracts an archive created by a ShardedEncryptArchiveJob.
+ *
+ * The job verifies the signature of the manifest and then extracts the
+ * shards listed in the manifest in parallel into the output directory. Before
+ * a shard is decrypted, its size and SHA-256 checksum are compared with the
+ * values in the manifest. If the signature of the manifest is bad or was not
+ * made with a valid, i.e. trusted, key, then no shard is extracted. If a shard does not match the manifest, then the job
+ * fails, but other shards may already have been extracted.
+ *
+ * The manifest verification result is passed to result(), so that the
+ * caller can check who signed the manifest.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself.
+ */
+class QGPGME_EXPORT ShardedDecryptArchiveJob : public Job
+{
+    Q_OBJECT
+public:
+    explicit ShardedDecryptArchiveJob(const Protocol *protocol);
+    ~ShardedDecryptArchiveJob() override;
+
+    /**
+     * Sets the path of the manifest of the sharded archive. The shards are
+     * expected in the same directory.
+     */
+    void setManifestFile(const QString &path);
+    QString manifestFile() const;
+
+    /**
+     * Sets the directory the content of the archive shall be written to. The
+     * directory is created if it doesn't exist.
+     */
+    void setOutputDirectory(const QString &outputDirectory);
+    QString outputDirectory() const;
+
+    /**
+     * Sets the maximum number of shards that are extracted concurrently.
+     * Defaults to the number of CPU cores.
+     */
+    void setMaxConcurrentShards(int count);
+    int maxConcurrentShards() const;
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the combined number of extracted files of all shards.
+     */
+    void fileProgress(int current, int total);
+
+    /**
+     * Emitted with the combined amount of processed data of all shards. The
+     * data is measured by the size of the files in the archive. Both values
+     * never exceed 2^20.
+     */
+    void dataProgress(int current, int total);
+
+    void result(const GpgME::Error &error, const GpgME::VerificationResult &manifestVerificationResult);
+
+private:
+    Q_DECLARE_PRIVATE(ShardedDecryptArchiveJob)
+};
+
+}
+
+#endif // __QGPGME_SHARDEDDECRYPTARCHIVEJOB_H__
@@ -0,0 +1,584 @@
+/*
+    shardedencryptarchivejob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "shardedencryptarchivejob.h"
+
+#include "encryptarchivejob.h"
+#include "filetreescanner.h"
+#include "job_p.h"
+#include "protocol.h"
+#include "shardedarchive_p.h"
+#include "signjob.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QPointer>
+#include <QThread>
+
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+namespace
+{
+// Writes the data to a file and computes the SHA-256 checksum of the data on
+// the fly, so that the shards don't have to be read again for the manifest.
+class HashingFileDevice : public QIODevice
+{
+public:
+    explicit HashingFileDevice(const QString &fileName)
+        : mFile{fileName}
+        , mHash{QCryptographicHash::Sha256}
+    {
+    }
+
+    bool open(OpenMode mode) override
+    {
+        // never overwrite existing files
+        if (!mFile.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+            setErrorString(mFile.errorString());
+            return false;
+        }
+        return QIODevice::open(mode | QIODevice::Unbuffered);
+    }
+
+    void close() override
+    {
+        mFile.close();
+        QIODevice::close();
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+    QByteArray sha256() const
+    {
+        return mHash.result().toHex();
+    }
+
+    qint64 size() const override
+    {
+        return mSize;
+    }
+
+protected:
+    qint64 readData(char *, qint64) override
+    {
+        return -1;
+    }
+
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        const qint64 written = mFile.write(data, len);
+        if (written < 0) {
+            setErrorString(mFile.errorString());
+            return -1;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+        mHash.addData(QByteArrayView{data, static_cast<qsizetype>(written)});
+#else
+        mHash.addData(data, static_cast<int>(written));
+#endif
+        mSize += written;
+        return written;
+    }
+
+private:
+    QFile mFile;
+    QCryptographicHash mHash;
+    qint64 mSize = 0;
+};
+
+struct Partition {
+    std::vector<std::vector<QString>> paths;
+    std::vector<qint64> bytes;
+};
+
+// Distributes the files over the shards so that the shards have about the
+// same size. The largest files are assigned first, each to the currently
+// smallest shard.
+Partition partition(FileTreeScanner::Result &scan, int shardCount)
+{
+    const size_t numShards = std::min<size_t>(std::max(shardCount, 1), scan.paths.size());
+    Partition result;
+    result.paths.resize(numShards);
+    result.bytes.resize(numShards, 0);
+
+    std::vector<size_t> order(scan.paths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&scan](size_t a, size_t b) {
+        return scan.fileSizes[a] > scan.fileSizes[b];
+    });
+
+    std::vector<std::vector<size_t>> assigned(numShards);
+    using Bin = std::pair<qint64, size_t>;
+    std::priority_queue<Bin, std::vector<Bin>, std::greater<Bin>> bins;
+    for (size_t i = 0; i < numShards; ++i) {
+        bins.push({0, i});
+    }
+    for (const auto i : order) {
+        auto bin = bins.top();
+        bins.pop();
+        assigned[bin.second].push_back(i);
+        // count empty files and directories, too, so that they are spread
+        bin.first += std::max<qint64>(scan.fileSizes[i], 1);
+        bins.push(bin);
+    }
+
+    for (size_t shard = 0; shard < numShards; ++shard) {
+        // keep the order of the scanner within a shard
+        std::sort(assigned[shard].begin(), assigned[shard].end());
+        result.paths[shard].reserve(assigned[shard].size());
+        for (const auto i : assigned[shard]) {
+            result.paths[shard].push_back(std::move(scan.paths[i]));
+            result.bytes[shard] += scan.fileSizes[i];
+        }
+    }
+    return result;
+}
+}
+
+class QGpgME::ShardedEncryptArchiveJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(ShardedEncryptArchiveJob)
+
+    explicit ShardedEncryptArchiveJobPrivate(const Protocol *protocol)
+        : m_protocol{protocol}
+    {
+    }
+
+    ~ShardedEncryptArchiveJobPrivate() override
+    {
+        stopScan();
+    }
+
+    GpgME::Error startIt() override;
+
+    void startNow() override
+    {
+    }
+
+    void stopScan()
+    {
+        m_canceled = true;
+        if (m_scanner) {
+            m_scanner->cancel();
+        }
+        if (m_scanThread.joinable()) {
+            m_scanThread.join();
+        }
+    }
+
+    void startShards(const std::shared_ptr<Partition> &partition);
+    void shardFinished(size_t index, const GpgME::Error &error);
+    void signManifest();
+    void manifestSigned(const GpgME::SigningResult &result, const QByteArray &signedManifest);
+    void cancelShards();
+    void removeShardFiles();
+    void finish(const GpgME::Error &error, const QString &manifestFile = {});
+
+    struct Shard {
+        QString fileName;
+        qint64 fileCount = 0;
+        qint64 bytes = 0;
+        std::shared_ptr<HashingFileDevice> device;
+        QPointer<EncryptArchiveJob> job;
+    };
+
+    const Protocol *const m_protocol;
+    std::vector<GpgME::Key> m_recipients;
+    std::vector<GpgME::Key> m_signers;
+    std::vector<QString> m_inputPaths;
+    QString m_baseDirectory;
+    QString m_outputDirectory;
+    QString m_archiveName = QStringLiteral("archive");
+    int m_shardCount = QThread::idealThreadCount();
+    GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::EncryptArchive;
+
+    std::unique_ptr<FileTreeScanner> m_scanner;
+    std::thread m_scanThread;
+    std::atomic<bool> m_canceled{false};
+    std::vector<Shard> m_shards;
+    size_t m_runningShards = 0;
+    GpgME::Error m_error;
+    _detail::ShardedArchiveProgress m_progress;
+    QPointer<SignJob> m_signJob;
+    bool m_finished = false;
+};
+
+GpgME::Error ShardedEncryptArchiveJobPrivate::startIt()
+{
+    if (m_inputPaths.empty() || m_outputDirectory.isEmpty() || m_archiveName.isEmpty()
+        || m_archiveName.contains(QLatin1Char('/')) || m_archiveName.startsWith(QLatin1Char('.'))) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (m_scanThread.joinable() || m_finished) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+
+    Q_Q(ShardedEncryptArchiveJob);
+    m_scanner.reset(new FileTreeScanner{m_inputPaths});
+    m_scanner->setBaseDirectory(m_baseDirectory);
+    // scan and partition the files in a separate thread to keep the
+    // event loop responsive
+    m_scanThread = std::thread{[this, q]() {
+        auto scan = m_scanner->scan();
+        auto result = std::make_shared<Partition>(partition(scan, m_shardCount));
+        // the event is discarded if the job is destroyed in the meantime
+        // because the destructor joins this thread
+        QMetaObject::invokeMethod(q, [this, result]() {
+            startShards(result);
+        }, Qt::QueuedConnection);
+    }};
+
+    return {};
+}
+
+void ShardedEncryptArchiveJobPrivate::startShards(const std::shared_ptr<Partition> &partition)
+{
+    Q_Q(ShardedEncryptArchiveJob);
+    m_scanThread.join();
+    m_scanner.reset();
+
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (partition->paths.empty()) {
+        finish(Error::fromCode(GPG_ERR_NO_DATA));
+        return;
+    }
+
+    const QDir outputDir{m_outputDirectory};
+    m_shards.resize(partition->paths.size());
+    m_progress.resize(m_shards.size());
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        auto &shard = m_shards[i];
+        shard.fileName = outputDir.filePath(QStringLiteral("%1.%2.tar.gpg").arg(m_archiveName).arg(i));
+        shard.fileCount = partition->paths[i].size();
+        shard.bytes = partition->bytes[i];
+        shard.device = std::make_shared<HashingFileDevice>(shard.fileName);
+        if (!shard.device->open(QIODevice::WriteOnly)) {
+            shard.device.reset();
+            m_error = Error::fromCode(QFileInfo::exists(shard.fileName) ? GPG_ERR_EEXIST : GPG_ERR_EIO);
+            break;
+        }
+
+        shard.job = m_protocol->encryptArchiveJob(false);
+        if (!shard.job) {
+            m_error = Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+            break;
+        }
+        shard.job->setBaseDirectory(m_baseDirectory);
+        shard.job->setInputSizeHint(shard.fileCount, shard.bytes);
+        QObject::connect(shard.job.data(), &EncryptArchiveJob::fileProgress, q, [this, q, i](int current, int total) {
+            m_progress.setFileProgress(i, current, total);
+            const auto progress = m_progress.fileProgress();
+            Q_EMIT q->fileProgress(progress.first, progress.second);
+        });
+        QObject::connect(shard.job.data(), &EncryptArchiveJob::dataProgress, q, [this, q, i](int current, int total) {
+            m_progress.setDataProgress(i, current, total, m_shards[i].bytes);
+            const auto progress = m_progress.dataProgress();
+            Q_EMIT q->dataProgress(progress.first, progress.second);
+            Q_EMIT q->jobProgress(progress.first, progress.second);
+        });
+        QObject::connect(shard.job.data(), &EncryptArchiveJob::result, q, [this, i](const EncryptionResult &result) {
+            shardFinished(i, result.error());
+        });
+        if (const auto err = shard.job->start(m_recipients, partition->paths[i], shard.device, m_encryptionFlags)) {
+            delete shard.job.data();
+            m_error = err;
+            break;
+        }
+        m_runningShards++;
+    }
+
+    if (m_error) {
+        cancelShards();
+        if (m_runningShards == 0) {
+            removeShardFiles();
+            finish(m_error);
+        }
+    }
+}
+
+void ShardedEncryptArchiveJobPrivate::shardFinished(size_t index, const GpgME::Error &error)
+{
+    m_shards[index].job = nullptr;
+    m_runningShards--;
+    if (error && !m_error) {
+        // one failed shard makes the whole archive useless
+        m_error = error;
+        cancelShards();
+    }
+    if (m_runningShards > 0) {
+        return;
+    }
+    if (m_error) {
+        removeShardFiles();
+        finish(m_error);
+        return;
+    }
+    signManifest();
+}
+
+void ShardedEncryptArchiveJobPrivate::signManifest()
+{
+    Q_Q(ShardedEncryptArchiveJob);
+
+    _detail::ShardedArchiveManifest manifest;
+    for (const auto &shard : m_shards) {
+        manifest.shards.push_back({shard.device->size(), shard.device->sha256(), shard.fileCount, shard.bytes, QFileInfo{shard.fileName}.fileName()});
+    }
+
+    m_signJob = m_protocol->signJob(true, true);
+    if (!m_signJob) {
+        removeShardFiles();
+        finish(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+        return;
+    }
+    QObject::connect(m_signJob.data(), &SignJob::result, q, [this](const SigningResult &result, const QByteArray &signedManifest) {
+        manifestSigned(result, signedManifest);
+    });
+    if (const auto err = m_signJob->start(m_signers, manifest.toByteArray(), GpgME::Clearsigned)) {
+        delete m_signJob.data();
+        removeShardFiles();
+        finish(err);
+    }
+}
+
+void ShardedEncryptArchiveJobPrivate::manifestSigned(const GpgME::SigningResult &result, const QByteArray &signedManifest)
+{
+    m_signJob = nullptr;
+    Error err = m_canceled ? Error::fromCode(GPG_ERR_CANCELED) : result.error();
+    const QString manifestFile = QDir{m_outputDirectory}.filePath(m_archiveName + QLatin1String{".manifest.asc"});
+    if (!err) {
+        QFile file{manifestFile};
+        if (!file.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+            err = Error::fromCode(file.exists() ? GPG_ERR_EEXIST : GPG_ERR_EIO);
+        } else if (file.write(signedManifest) != signedManifest.size() || !file.flush()) {
+            err = Error::fromCode(GPG_ERR_EIO);
+            file.remove();
+        }
+    }
+    if (err) {
+        removeShardFiles();
+        finish(err);
+        return;
+    }
+    finish(err, manifestFile);
+}
+
+void ShardedEncryptArchiveJobPrivate::cancelShards()
+{
+    for (const auto &shard : m_shards) {
+        if (shard.job) {
+            shard.job->slotCancel();
+        }
+    }
+}
+
+void ShardedEncryptArchiveJobPrivate::removeShardFiles()
+{
+    for (auto &shard : m_shards) {
+        if (shard.device) {
+            shard.device->close();
+            QFile::remove(shard.fileName);
+            shard.device.reset();
+        }
+    }
+}
+
+void ShardedEncryptArchiveJobPrivate::finish(const GpgME::Error &error, const QString &manifestFile)
+{
+    Q_Q(ShardedEncryptArchiveJob);
+    m_finished = true;
+    Q_EMIT q->done();
+    Q_EMIT q->result(error, manifestFile);
+    q->deleteLater();
+}
+
+ShardedEncryptArchiveJob::ShardedEncryptArchiveJob(const Protocol *protocol)
+    : Job{std::unique_ptr<ShardedEncryptArchiveJobPrivate>(new ShardedEncryptArchiveJobPrivate{protocol}), nullptr}
+{
+}
+
+ShardedEncryptArchiveJob::~ShardedEncryptArchiveJob() = default;
+
+void ShardedEncryptArchiveJob::setRecipients(const std::vector<GpgME::Key> &recipients)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_recipients = recipients;
+}
+
+std::vector<GpgME::Key> ShardedEncryptArchiveJob::recipients() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_recipients;
+}
+
+void ShardedEncryptArchiveJob::setSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_signers = signers;
+}
+
+std::vector<GpgME::Key> ShardedEncryptArchiveJob::signers() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_signers;
+}
+
+void ShardedEncryptArchiveJob::setInputPaths(const std::vector<QString> &paths)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_inputPaths = paths;
+}
+
+std::vector<QString> ShardedEncryptArchiveJob::inputPaths() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_inputPaths;
+}
+
+void ShardedEncryptArchiveJob::setBaseDirectory(const QString &baseDirectory)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_baseDirectory = baseDirectory;
+}
+
+QString ShardedEncryptArchiveJob::baseDirectory() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_baseDirectory;
+}
+
+void ShardedEncryptArchiveJob::setOutputDirectory(const QString &outputDirectory)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_outputDirectory = outputDirectory;
+}
+
+QString ShardedEncryptArchiveJob::outputDirectory() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_outputDirectory;
+}
+
+void ShardedEncryptArchiveJob::setArchiveName(const QString &name)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_archiveName = name;
+}
+
+QString ShardedEncryptArchiveJob::archiveName() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_archiveName;
+}
+
+void ShardedEncryptArchiveJob::setShardCount(int count)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_shardCount = std::max(count, 1);
+}
+
+int ShardedEncryptArchiveJob::shardCount() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_shardCount;
+}
+
+void ShardedEncryptArchiveJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
+{
+    Q_D(ShardedEncryptArchiveJob);
+    d->m_encryptionFlags = static_cast<GpgME::Context::EncryptionFlags>(flags | GpgME::Context::EncryptArchive);
+}
+
+GpgME::Context::EncryptionFlags ShardedEncryptArchiveJob::encryptionFlags() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    return d->m_encryptionFlags;
+}
+
+std::vector<QString> ShardedEncryptArchiveJob::shardFiles() const
+{
+    Q_D(const ShardedEncryptArchiveJob);
+    std::vector<QString> result;
+    for (const auto &shard : d->m_shards) {
+        if (shard.device) {
+            result.push_back(shard.fileName);
+        }
+    }
+    return result;
+}
+
+void ShardedEncryptArchiveJob::slotCancel()
+{
+    Q_D(ShardedEncryptArchiveJob);
+    if (d->m_finished) {
+        return;
+    }
+    d->m_canceled = true;
+    if (d->m_scanner) {
+        d->m_scanner->cancel();
+    }
+    if (!d->m_error) {
+        d->m_error = Error::fromCode(GPG_ERR_CANCELED);
+    }
+    d->cancelShards();
+    if (d->m_signJob) {
+        d->m_signJob->slotCancel();
+    }
+}
+
+#include "moc_shardedencryptarchivejob.cpp"
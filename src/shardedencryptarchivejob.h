@@ -0,0 +1,160 @@
+/*
+    shardedencryptarchivejob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SHARDEDENCRYPTARCHIVEJOB_H__
+#define __QGPGME_SHARDEDENCRYPTARCHIVEJOB_H__
+
+#include "job.h"
+
+#include <gpgme++/context.h>
+
+#include <vector>
+
+namespace GpgME
+{
+class Key;
+}
+
+namespace QGpgME
+{
+
+class Protocol;
+class ShardedEncryptArchiveJobPrivate;
+
+/**
+ * This job creates multiple encrypted archives (shards) of a directory tree
+ * in parallel.
+ *
+ * A single encrypted archive is created by one gpgtar and one gpg process,
+ * i.e. it cannot use more than one or two CPU cores. This job scans the input
+ * files with a FileTreeScanner, distributes the files over a configurable
+ * number of shards so that all shards have about the same size, and then
+ * runs one EncryptArchiveJob per shard concurrently. Finally, it writes a
+ * clear-signed manifest listing the shards with their sizes and SHA-256
+ * checksums. The shards can be decrypted with a ShardedDecryptArchiveJob.
+ *
+ * The shards are written to the output directory as
+ * <em>name</em>.<em>n</em>.tar.gpg and the manifest is written as
+ * <em>name</em>.manifest.asc. If the job fails or is canceled, then all
+ * written shards are removed.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself.
+ */
+class QGPGME_EXPORT ShardedEncryptArchiveJob : public Job
+{
+    Q_OBJECT
+public:
+    explicit ShardedEncryptArchiveJob(const Protocol *protocol);
+    ~ShardedEncryptArchiveJob() override;
+
+    /**
+     * Sets the keys to use for encrypting the shards.
+     */
+    void setRecipients(const std::vector<GpgME::Key> &recipients);
+    std::vector<GpgME::Key> recipients() const;
+
+    /**
+     * Sets the keys to use for signing the manifest. If no key is set, then
+     * the default key is used.
+     */
+    void setSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> signers() const;
+
+    /**
+     * Sets the paths of the files and folders to put into the archive.
+     * If base directory is set, then the paths must be relative to the
+     * base directory.
+     */
+    void setInputPaths(const std::vector<QString> &paths);
+    std::vector<QString> inputPaths() const;
+
+    void setBaseDirectory(const QString &baseDirectory);
+    QString baseDirectory() const;
+
+    /**
+     * Sets the directory to write the shards and the manifest to.
+     */
+    void setOutputDirectory(const QString &outputDirectory);
+    QString outputDirectory() const;
+
+    /**
+     * Sets the base name of the shards and the manifest. Defaults to "archive".
+     */
+    void setArchiveName(const QString &name);
+    QString archiveName() const;
+
+    /**
+     * Sets the number of shards. Defaults to the number of CPU cores. Fewer
+     * shards are created if there are fewer files.
+     */
+    void setShardCount(int count);
+    int shardCount() const;
+
+    /**
+     * Sets the flags to use for encryption. The \c EncryptArchive flag is
+     * always assumed set for this job.
+     */
+    void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
+    GpgME::Context::EncryptionFlags encryptionFlags() const;
+
+    /**
+     * Returns the paths of the shards. Valid after the job has finished
+     * successfully.
+     */
+    std::vector<QString> shardFiles() const;
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the combined number of processed files of all shards.
+     */
+    void fileProgress(int current, int total);
+
+    /**
+     * Emitted with the combined amount of processed data of all shards. The
+     * data is measured by the size of the files in the archive. Both values
+     * never exceed 2^20.
+     */
+    void dataProgress(int current, int total);
+
+    void result(const GpgME::Error &error, const QString &manifestFile);
+
+private:
+    Q_DECLARE_PRIVATE(ShardedEncryptArchiveJob)
+};
+
+}
+
+#endif // __QGPGME_SHARDEDENCRYPTARCHIVEJOB_H__
@@ -80,6 +80,37 @@ std::vector<QString> SignArchiveJob::inputPaths() const
     return d->m_inputPaths;
 }
 
+void SignArchiveJob::setInputPathGenerator(const std::function<QString()> &generator)
+{
+    Q_D(SignArchiveJob);
+    d->m_inputPathGenerator = generator;
+}
+
+std::function<QString()> SignArchiveJob::inputPathGenerator() const
+{
+    Q_D(const SignArchiveJob);
+    return d->m_inputPathGenerator;
+}
+
+void SignArchiveJob::setInputSizeHint(qint64 fileCount, qint64 totalBytes)
+{
+    Q_D(SignArchiveJob);
+    d->m_inputFileCountHint = fileCount;
+    d->m_inputSizeHint = totalBytes;
+}
+
+qint64 SignArchiveJob::inputFileCountHint() const
+{
+    Q_D(const SignArchiveJob);
+    return d->m_inputFileCountHint;
+}
+
+qint64 SignArchiveJob::inputSizeHint() const
+{
+    Q_D(const SignArchiveJob);
+    return d->m_inputSizeHint;
+}
+
 void SignArchiveJob::setOutputFile(const QString &path)
 {
     Q_D(SignArchiveJob);
@@ -44,6 +44,9 @@ class SignArchiveJobPrivate : public JobPrivate
 public:
     std::vector<GpgME::Key> m_signers;
     std::vector<QString> m_inputPaths;
+    std::function<QString()> m_inputPathGenerator;
+    qint64 m_inputFileCountHint = 0;
+    qint64 m_inputSizeHint = 0;
     QString m_outputFilePath;
     QString m_baseDirectory;
 };
@@ -0,0 +1,64 @@
+/*
+    signaturecheck.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "signaturecheck_p.h"
+
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+
+using namespace GpgME;
+
+bool QGpgME::_detail::allSignaturesValid(const VerificationResult &result)
+{
+    const auto signatures = result.signatures();
+    return !signatures.empty() && std::all_of(signatures.cbegin(), signatures.cend(), [](const Signature &sig) {
+        // a good signature of an unknown or untrusted key is not enough
+        return !sig.status().code() && (sig.summary() & Signature::Valid);
+    });
+}
+
+bool QGpgME::_detail::allSignaturesValid(const VerificationResult &result, const std::vector<QByteArray> &allowedSigners)
+{
+    if (!allSignaturesValid(result)) {
+        return false;
+    }
+    const auto signatures = result.signatures();
+    return std::all_of(signatures.cbegin(), signatures.cend(), [&allowedSigners](const Signature &sig) {
+        const QByteArray fingerprint{sig.fingerprint()};
+        return std::find(allowedSigners.cbegin(), allowedSigners.cend(), fingerprint) != allowedSigners.cend();
+    });
+}
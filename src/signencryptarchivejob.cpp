@@ -92,6 +92,37 @@ std::vector<QString> SignEncryptArchiveJob::inputPaths() const
     return d->m_inputPaths;
 }
 
+void SignEncryptArchiveJob::setInputPathGenerator(const std::function<QString()> &generator)
+{
+    Q_D(SignEncryptArchiveJob);
+    d->m_inputPathGenerator = generator;
+}
+
+std::function<QString()> SignEncryptArchiveJob::inputPathGenerator() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_inputPathGenerator;
+}
+
+void SignEncryptArchiveJob::setInputSizeHint(qint64 fileCount, qint64 totalBytes)
+{
+    Q_D(SignEncryptArchiveJob);
+    d->m_inputFileCountHint = fileCount;
+    d->m_inputSizeHint = totalBytes;
+}
+
+qint64 SignEncryptArchiveJob::inputFileCountHint() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_inputFileCountHint;
+}
+
+qint64 SignEncryptArchiveJob::inputSizeHint() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_inputSizeHint;
+}
+
 void SignEncryptArchiveJob::setOutputFile(const QString &path)
 {
     Q_D(SignEncryptArchiveJob);
@@ -104,6 +135,18 @@ QString SignEncryptArchiveJob::outputFile() const
     return d->m_outputFilePath;
 }
 
+void SignEncryptArchiveJob::setIncrementalManifestFile(const QString &path)
+{
+    Q_D(SignEncryptArchiveJob);
+    d->m_incrementalManifestFile = path;
+}
+
+QString SignEncryptArchiveJob::incrementalManifestFile() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_incrementalManifestFile;
+}
+
 void SignEncryptArchiveJob::setEncryptionFlags(GpgME::Context::EncryptionFlags flags)
 {
     Q_D(SignEncryptArchiveJob);
@@ -116,6 +159,24 @@ GpgME::Context::EncryptionFlags SignEncryptArchiveJob::encryptionFlags() const
     return d->m_encryptionFlags;
 }
 
+void SignEncryptArchiveJob::setDetectIncompressibleInput(bool detect)
+{
+    Q_D(SignEncryptArchiveJob);
+    d->m_detectIncompressibleInput = detect;
+}
+
+bool SignEncryptArchiveJob::detectIncompressibleInput() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_detectIncompressibleInput;
+}
+
+bool SignEncryptArchiveJob::incompressibleInputDetected() const
+{
+    Q_D(const SignEncryptArchiveJob);
+    return d->m_incompressibleInputDetected;
+}
+
 void SignEncryptArchiveJob::setBaseDirectory(const QString &baseDirectory)
 {
     Q_D(SignEncryptArchiveJob);
@@ -38,6 +38,8 @@
 
 #include <gpgme++/context.h>
 
+#include <functional>
+
 namespace GpgME
 {
 class Key;
@@ -88,6 +90,37 @@ public:
     void setInputPaths(const std::vector<QString> &paths);
     std::vector<QString> inputPaths() const;
 
+    /**
+     * Sets a function that returns the paths of the files and folders to put
+     * into the archive one by one. The function must return an empty string
+     * after the last path. If a generator is set, then the input paths are
+     * ignored.
+     *
+     * The paths are fetched while gpgtar reads them, i.e. the complete list of
+     * paths never needs to be held in memory. The function is called in the
+     * thread of the job.
+     *
+     * Used if the job is started with startIt().
+     *
+     * \sa DirectoryWalker
+     */
+    void setInputPathGenerator(const std::function<QString()> &generator);
+    std::function<QString()> inputPathGenerator() const;
+
+    /**
+     * Sets the number of files and the total size in bytes of the files that
+     * will be put into the archive, e.g. as determined by a FileTreeScanner.
+     *
+     * gpgtar knows the total number of files only after it has scanned all
+     * files. If a hint is set, then fileProgress() reports the hinted number
+     * of files as total during the scanning phase. The values reported by
+     * dataProgress() are scaled; they can be converted to bytes with the
+     * hinted total size.
+     */
+    void setInputSizeHint(qint64 fileCount, qint64 totalBytes);
+    qint64 inputFileCountHint() const;
+    qint64 inputSizeHint() const;
+
     /**
      * Sets the path of the file to write the created archive to.
      *
@@ -103,6 +136,31 @@ public:
     void setOutputFile(const QString &path);
     QString outputFile() const;
 
+    /**
+     * Enables incremental archives. \a path is the file with the
+     * ArchiveManifest of the last archive. If \a path is a relative path and
+     * base directory is set, then the path is interpreted relative to the base
+     * directory.
+     *
+     * The job compares the input paths with the manifest and only puts the
+     * files that were added or whose content changed since the last archive
+     * into the archive. If files were removed, then the signed and encrypted
+     * list of the removed paths is written to the output file with the suffix
+     * ".deletions.gpg". After the archive was created, the manifest is
+     * replaced with the manifest of the current files. If the manifest does
+     * not exist, then all files are put into the archive.
+     *
+     * If nothing changed, then the job fails with \c GPG_ERR_NO_DATA and no
+     * archive is created. Incremental archives cannot be combined with an
+     * input path generator.
+     *
+     * Used if the job is started with startIt().
+     *
+     * \sa RestoreIncrementalArchiveJob
+     */
+    void setIncrementalManifestFile(const QString &path);
+    QString incrementalManifestFile() const;
+
     /**
      * Sets the flags to use for encryption. Defaults to \c EncryptArchive.
      * The \c EncryptArchive flag is always assumed set for this job.
@@ -112,6 +170,30 @@ public:
     void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
     GpgME::Context::EncryptionFlags encryptionFlags() const;
 
+    /**
+     * Enables the detection of incompressible input.
+     *
+     * If enabled, then the job probes the beginning of the first few input
+     * files before it starts. If most of the probed data is in a compressed
+     * format (e.g. JPEG, ZIP or MP4) or looks random, then the \c NoCompress
+     * flag is added to the encryption flags, so that the backend doesn't
+     * waste time trying to compress it. The files are not probed if the
+     * paths are fetched with an input path generator.
+     *
+     * Defaults to false.
+     */
+    void setDetectIncompressibleInput(bool detect);
+    bool detectIncompressibleInput() const;
+
+    /**
+     * Returns true if the job detected incompressible input and disabled the
+     * compression. The files are probed in the job's thread; the value is
+     * valid when the job emits result().
+     *
+     * \sa setDetectIncompressibleInput
+     */
+    bool incompressibleInputDetected() const;
+
     /**
      * Sets the base directory for the relative paths of the input files and
      * the output file.
@@ -143,7 +225,8 @@ Q_SIGNALS:
      * This signal is emitted whenever gpgtar sends a progress status update for
      * the number of files. In the scanning phase (i.e. while gpgtar checks
      * which files to put into the archive), \a current is the current number of
-     * files and \a total is 0. In the writing phase, \a current is the number
+     * files and \a total is 0 (or the number of files set with
+     * setInputSizeHint()). In the writing phase, \a current is the number
      * of processed files and \a total is the total number of files.
      */
     void fileProgress(int current, int total);
@@ -36,6 +36,8 @@
 
 #include "job_p.h"
 
+#include <atomic>
+
 namespace QGpgME
 {
 
@@ -45,9 +47,16 @@ public:
     std::vector<GpgME::Key> m_signers;
     std::vector<GpgME::Key> m_recipients;
     std::vector<QString> m_inputPaths;
+    std::function<QString()> m_inputPathGenerator;
+    qint64 m_inputFileCountHint = 0;
+    qint64 m_inputSizeHint = 0;
     QString m_outputFilePath;
+    QString m_incrementalManifestFile;
     QString m_baseDirectory;
     GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::EncryptArchive;
+    bool m_detectIncompressibleInput = false;
+    // set in the job's thread
+    std::atomic<bool> m_incompressibleInputDetected{false};
 };
 
 }
@@ -38,6 +38,9 @@
 #include "signencryptjob.h"
 #include "signencryptjob_p.h"
 
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/signingresult.h>
+
 using namespace QGpgME;
 
 SignEncryptJob::SignEncryptJob(std::unique_ptr<SignEncryptJobPrivate> dd, QObject *parent)
@@ -59,6 +62,18 @@ QString SignEncryptJob::fileName() const
     return d->m_fileName;
 }
 
+void SignEncryptJob::setInputSizeHint(qint64 size)
+{
+    Q_D(SignEncryptJob);
+    d->m_inputSizeHint = size;
+}
+
+qint64 SignEncryptJob::inputSizeHint() const
+{
+    Q_D(const SignEncryptJob);
+    return d->m_inputSizeHint;
+}
+
 void SignEncryptJob::setSigners(const std::vector<GpgME::Key> &signers)
 {
     Q_D(SignEncryptJob);
@@ -119,4 +134,50 @@ GpgME::Context::EncryptionFlags SignEncryptJob::encryptionFlags() const
     return d->m_encryptionFlags;
 }
 
+void SignEncryptJob::setDetectIncompressibleInput(bool detect)
+{
+    Q_D(SignEncryptJob);
+    d->m_detectIncompressibleInput = detect;
+}
+
+bool SignEncryptJob::detectIncompressibleInput() const
+{
+    Q_D(const SignEncryptJob);
+    return d->m_detectIncompressibleInput;
+}
+
+bool SignEncryptJob::incompressibleInputDetected() const
+{
+    Q_D(const SignEncryptJob);
+    return d->m_incompressibleInputDetected;
+}
+
+void SignEncryptJob::setEncryptionRecipients(const std::shared_ptr<EncryptionRecipients> &recipients)
+{
+    Q_D(SignEncryptJob);
+    d->m_encryptionRecipients = recipients;
+}
+
+std::shared_ptr<EncryptionRecipients> SignEncryptJob::encryptionRecipients() const
+{
+    Q_D(const SignEncryptJob);
+    return d->m_encryptionRecipients;
+}
+
+std::pair<GpgME::SigningResult, GpgME::EncryptionResult>
+SignEncryptJob::exec(const std::vector<GpgME::Key> &signers, const std::vector<GpgME::Key> &recipients, const QByteArray &plainText,
+                     const GpgME::Context::EncryptionFlags flags, GpgME::DataProvider &cipherText)
+{
+    Q_D(SignEncryptJob);
+    return d->exec(signers, recipients, plainText, flags, cipherText);
+}
+
+std::pair<GpgME::SigningResult, GpgME::EncryptionResult>
+SignEncryptJobPrivate::exec(const std::vector<GpgME::Key> &, const std::vector<GpgME::Key> &, const QByteArray &,
+                            GpgME::Context::EncryptionFlags, GpgME::DataProvider &)
+{
+    const auto err = GpgME::Error::fromCode(GPG_ERR_NOT_IMPLEMENTED);
+    return {GpgME::SigningResult{err}, GpgME::EncryptionResult{err}};
+}
+
 #include "moc_signencryptjob.cpp"
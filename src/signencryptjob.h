@@ -52,6 +52,7 @@ class QIODevice;
 
 namespace GpgME
 {
+class DataProvider;
 class Error;
 class Key;
 class SigningResult;
@@ -61,6 +62,7 @@ class EncryptionResult;
 namespace QGpgME
 {
 
+class EncryptionRecipients;
 class SignEncryptJobPrivate;
 
 /**
@@ -101,6 +103,19 @@ public:
     void setFileName(const QString &fileName);
     QString fileName() const;
 
+    /**
+     * Sets the expected size of the input data in bytes.
+     *
+     * The size hint is passed to the backend, so that progress information
+     * has a known total even if the input is a sequential device (e.g. a pipe
+     * or a socket) whose size cannot be determined. It is also used to
+     * preallocate the output buffer if the result is returned as byte array.
+     *
+     * This is only used if one of the start() or exec() functions is used.
+     */
+    void setInputSizeHint(qint64 size);
+    qint64 inputSizeHint() const;
+
     /**
      * Sets the keys to use for signing.
      *
@@ -148,6 +163,42 @@ public:
     void setEncryptionFlags(GpgME::Context::EncryptionFlags flags);
     GpgME::Context::EncryptionFlags encryptionFlags() const;
 
+    /**
+     * Enables the detection of incompressible input.
+     *
+     * If enabled, then the job probes the beginning of the input before it
+     * starts. If the input starts with the signature of a compressed format
+     * (e.g. JPEG, ZIP or MP4) or if it looks random (e.g. because it is
+     * encrypted), then the \c NoCompress flag is added to the encryption
+     * flags, so that the backend doesn't waste time trying to compress it.
+     * Input from sequential devices is not probed.
+     *
+     * Defaults to false.
+     */
+    void setDetectIncompressibleInput(bool detect);
+    bool detectIncompressibleInput() const;
+
+    /**
+     * Returns true if the job detected incompressible input and disabled the
+     * compression. The input is probed in the job's thread; the value is
+     * valid when the job emits result() or when exec() returns.
+     *
+     * \sa setDetectIncompressibleInput
+     */
+    bool incompressibleInputDetected() const;
+
+    /**
+     * Sets a set of recipients that is validated once and shared by many
+     * jobs. If it is set, then the validated keys of \a recipients are used
+     * instead of the recipients passed to start() or exec() or set with
+     * setRecipients(), and the \c AlwaysTrust flag is added if all of them
+     * are valid.
+     *
+     * \sa EncryptionRecipients
+     */
+    void setEncryptionRecipients(const std::shared_ptr<EncryptionRecipients> &recipients);
+    std::shared_ptr<EncryptionRecipients> encryptionRecipients() const;
+
     /**
        Starts the combined signing and encrypting operation. \a signers
        is the list of keys to sign \a plainText with. \a recipients is
@@ -203,6 +254,22 @@ public:
          const std::vector<GpgME::Key> &recipients,
          const QByteArray &plainText,
          const GpgME::Context::EncryptionFlags flags, QByteArray &cipherText) = 0;
+
+    /**
+     * Like exec, but writes the ciphertext to \a cipherText instead of
+     * returning it in a byte array.
+     *
+     * This allows writing the ciphertext to a custom sink or reusing an
+     * output buffer for many operations, e.g. with a QByteArraySinkDataProvider.
+     *
+     * Returns errors with code GPG_ERR_NOT_IMPLEMENTED if the job doesn't
+     * support this.
+     */
+    std::pair<GpgME::SigningResult, GpgME::EncryptionResult>
+    exec(const std::vector<GpgME::Key> &signers,
+         const std::vector<GpgME::Key> &recipients,
+         const QByteArray &plainText,
+         const GpgME::Context::EncryptionFlags flags, GpgME::DataProvider &cipherText);
 Q_SIGNALS:
     void result(const GpgME::SigningResult &signingresult,
                 const GpgME::EncryptionResult &encryptionresult,
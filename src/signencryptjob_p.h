@@ -38,14 +38,28 @@
 
 #include <gpgme++/key.h>
 
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace GpgME
+{
+class DataProvider;
+class EncryptionResult;
+class SigningResult;
+}
+
 namespace QGpgME
 {
 
+class EncryptionRecipients;
+
 class SignEncryptJobPrivate : public JobPrivate
 {
 public:
     // used by start() functions
     QString m_fileName;
+    qint64 m_inputSizeHint = 0;
 
     // used by startIt()
     std::vector<GpgME::Key> m_signers;
@@ -53,6 +67,17 @@ public:
     QString m_inputFilePath;
     QString m_outputFilePath;
     GpgME::Context::EncryptionFlags m_encryptionFlags = GpgME::Context::EncryptFile;
+    bool m_detectIncompressibleInput = false;
+    // set in the job's thread
+    std::atomic<bool> m_incompressibleInputDetected{false};
+    std::shared_ptr<EncryptionRecipients> m_encryptionRecipients;
+
+    // used by exec() with a data provider
+    virtual std::pair<GpgME::SigningResult, GpgME::EncryptionResult> exec(const std::vector<GpgME::Key> &signers,
+                                                                          const std::vector<GpgME::Key> &recipients,
+                                                                          const QByteArray &plainText,
+                                                                          GpgME::Context::EncryptionFlags flags,
+                                                                          GpgME::DataProvider &cipherText);
 };
 
 }
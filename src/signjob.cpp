@@ -38,6 +38,8 @@
 #include "signjob.h"
 #include "signjob_p.h"
 
+#include <gpgme++/signingresult.h>
+
 using namespace QGpgME;
 
 SignJob::SignJob(std::unique_ptr<SignJobPrivate> dd, QObject *parent)
@@ -47,6 +49,18 @@ SignJob::SignJob(std::unique_ptr<SignJobPrivate> dd, QObject *parent)
 
 SignJob::~SignJob() = default;
 
+void SignJob::setInputSizeHint(qint64 size)
+{
+    Q_D(SignJob);
+    d->m_inputSizeHint = size;
+}
+
+qint64 SignJob::inputSizeHint() const
+{
+    Q_D(const SignJob);
+    return d->m_inputSizeHint;
+}
+
 void SignJob::setSigners(const std::vector<GpgME::Key> &signers)
 {
     Q_D(SignJob);
@@ -107,4 +121,15 @@ bool SignJob::appendSignatureEnabled() const
     return d->m_appendSignature;
 }
 
+GpgME::SigningResult SignJob::exec(const std::vector<GpgME::Key> &signers, const QByteArray &plainText, GpgME::SignatureMode mode, GpgME::DataProvider &signature)
+{
+    Q_D(SignJob);
+    return d->exec(signers, plainText, mode, signature);
+}
+
+GpgME::SigningResult SignJobPrivate::exec(const std::vector<GpgME::Key> &, const QByteArray &, GpgME::SignatureMode, GpgME::DataProvider &)
+{
+    return GpgME::SigningResult{GpgME::Error::fromCode(GPG_ERR_NOT_IMPLEMENTED)};
+}
+
 #include "moc_signjob.cpp"
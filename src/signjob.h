@@ -47,6 +47,7 @@ class QIODevice;
 
 namespace GpgME
 {
+class DataProvider;
 class Error;
 class Key;
 class SigningResult;
@@ -87,6 +88,19 @@ protected:
 public:
     ~SignJob() override;
 
+    /**
+     * Sets the expected size of the input data in bytes.
+     *
+     * The size hint is passed to the backend, so that progress information
+     * has a known total even if the input is a sequential device (e.g. a pipe
+     * or a socket) whose size cannot be determined. It is also used to
+     * preallocate the output buffer if the result is returned as byte array.
+     *
+     * This is only used if one of the start() or exec() functions is used.
+     */
+    void setInputSizeHint(qint64 size);
+    qint64 inputSizeHint() const;
+
     /**
      * Sets the keys to use for signing.
      *
@@ -169,6 +183,21 @@ public:
     */
     virtual void setOutputIsBase64Encoded(bool) = 0;
 
+    /**
+     * Like exec, but writes the signature or the signed data to \a signature
+     * instead of returning it in a byte array.
+     *
+     * This allows writing the result to a custom sink or reusing an
+     * output buffer for many operations, e.g. with a QByteArraySinkDataProvider.
+     *
+     * Returns an error with code GPG_ERR_NOT_IMPLEMENTED if the job doesn't
+     * support this.
+     */
+    GpgME::SigningResult exec(const std::vector<GpgME::Key> &signers,
+                              const QByteArray &plainText,
+                              GpgME::SignatureMode mode,
+                              GpgME::DataProvider &signature);
+
 Q_SIGNALS:
     void result(const GpgME::SigningResult &result, const QByteArray &signature, const QString &auditLogAsHtml = QString(), const GpgME::Error &auditLogError = GpgME::Error());
 
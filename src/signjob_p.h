@@ -38,18 +38,31 @@
 
 #include <gpgme++/key.h>
 
+namespace GpgME
+{
+class DataProvider;
+class SigningResult;
+}
+
 namespace QGpgME
 {
 
 class SignJobPrivate : public JobPrivate
 {
 public:
+    // used by start() functions
+    qint64 m_inputSizeHint = 0;
+
     // used by startIt()
     std::vector<GpgME::Key> m_signers;
     QString m_inputFilePath;
     QString m_outputFilePath;
     GpgME::SignatureMode m_signingFlags = GpgME::SignFile;
     bool m_appendSignature = false;
+
+    // used by exec() with a data provider
+    virtual GpgME::SigningResult exec(const std::vector<GpgME::Key> &signers, const QByteArray &plainText,
+                                      GpgME::SignatureMode mode, GpgME::DataProvider &signature);
 };
 
 }
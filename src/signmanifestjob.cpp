@@ -0,0 +1,306 @@
+/*
+    signmanifestjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "signmanifestjob.h"
+
+#include "filehash_p.h"
+#include "filemanifest_p.h"
+#include "job_p.h"
+#include "protocol.h"
+#include "signjob.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
+#include <QThread>
+
+#include <gpgme++/key.h>
+#include <gpgme++/signingresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::SignManifestJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(SignManifestJob)
+
+    explicit SignManifestJobPrivate(const Protocol *protocol)
+        : m_protocol{protocol}
+    {
+    }
+
+    ~SignManifestJobPrivate() override
+    {
+        m_canceled = true;
+        if (m_hashThread.joinable()) {
+            m_hashThread.join();
+        }
+    }
+
+    GpgME::Error startIt() override;
+
+    void startNow() override
+    {
+    }
+
+    void filesHashed(const std::shared_ptr<_detail::FileManifest> &manifest, const GpgME::Error &error);
+    void manifestSigned(const GpgME::SigningResult &result, const QByteArray &signedManifest);
+    void finish(const GpgME::Error &error, const GpgME::SigningResult &result = GpgME::SigningResult{});
+
+    const Protocol *const m_protocol;
+    std::vector<GpgME::Key> m_signers;
+    std::vector<QString> m_files;
+    QString m_baseDirectory;
+    QString m_outputFile;
+    SignManifestJob::HashAlgorithm m_hashAlgorithm = SignManifestJob::Sha256;
+    int m_maxThreads = QThread::idealThreadCount();
+
+    std::thread m_hashThread;
+    std::atomic<bool> m_canceled{false};
+    QPointer<SignJob> m_signJob;
+    bool m_finished = false;
+};
+
+GpgME::Error SignManifestJobPrivate::startIt()
+{
+    if (m_files.empty() || m_outputFile.isEmpty()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (!std::all_of(m_files.cbegin(), m_files.cend(), &_detail::FileManifest::isSafePath)) {
+        return Error::fromCode(GPG_ERR_INV_NAME);
+    }
+    if (m_hashThread.joinable() || m_finished) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+    if (QFile::exists(m_outputFile)) {
+        return Error::fromCode(GPG_ERR_EEXIST);
+    }
+
+    Q_Q(SignManifestJob);
+    std::vector<QString> files = m_files;
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    const auto algorithm = m_hashAlgorithm == SignManifestJob::Sha512 ? QCryptographicHash::Sha512 : QCryptographicHash::Sha256;
+    // hash the files in a separate thread to keep the event loop responsive
+    m_hashThread = std::thread{[this, q, files, algorithm]() {
+        const QDir baseDir{m_baseDirectory};
+        std::vector<QString> filePaths;
+        filePaths.reserve(files.size());
+        for (const auto &file : files) {
+            filePaths.push_back(baseDir.filePath(file));
+        }
+        const int total = static_cast<int>(files.size());
+        const auto hashes = _detail::hashFiles(filePaths, algorithm, m_maxThreads, &m_canceled, [q, total](size_t n) {
+            QMetaObject::invokeMethod(q, [q, n, total]() {
+                Q_EMIT q->fileProgress(static_cast<int>(n), total);
+                Q_EMIT q->jobProgress(static_cast<int>(n), total);
+            }, Qt::QueuedConnection);
+        });
+
+        auto manifest = std::make_shared<_detail::FileManifest>();
+        manifest->algorithm = algorithm;
+        Error error;
+        for (size_t i = 0; i < files.size() && !m_canceled; ++i) {
+            if (hashes[i].checksum.isEmpty()) {
+                error = Error::fromCode(QFileInfo::exists(filePaths[i]) ? GPG_ERR_EIO : GPG_ERR_ENOENT);
+                break;
+            }
+            // record the size of the hashed data; the file may have been
+            // changed since it was hashed
+            manifest->entries.push_back({files[i], hashes[i].size, hashes[i].checksum});
+        }
+        // the event is discarded if the job is destroyed in the meantime
+        // because the destructor joins this thread
+        QMetaObject::invokeMethod(q, [this, manifest, error]() {
+            filesHashed(manifest, error);
+        }, Qt::QueuedConnection);
+    }};
+
+    return {};
+}
+
+void SignManifestJobPrivate::filesHashed(const std::shared_ptr<_detail::FileManifest> &manifest, const GpgME::Error &error)
+{
+    Q_Q(SignManifestJob);
+    m_hashThread.join();
+
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (error) {
+        finish(error);
+        return;
+    }
+
+    m_signJob = m_protocol->signJob(true, true);
+    if (!m_signJob) {
+        finish(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+        return;
+    }
+    QObject::connect(m_signJob.data(), &SignJob::result, q, [this](const SigningResult &result, const QByteArray &signedManifest) {
+        manifestSigned(result, signedManifest);
+    });
+    if (const auto err = m_signJob->start(m_signers, manifest->toByteArray(), GpgME::Clearsigned)) {
+        delete m_signJob.data();
+        finish(err);
+    }
+}
+
+void SignManifestJobPrivate::manifestSigned(const GpgME::SigningResult &result, const QByteArray &signedManifest)
+{
+    m_signJob = nullptr;
+    Error err = m_canceled ? Error::fromCode(GPG_ERR_CANCELED) : result.error();
+    if (!err) {
+        QFile file{m_outputFile};
+        if (!file.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+            err = Error::fromCode(file.exists() ? GPG_ERR_EEXIST : GPG_ERR_EIO);
+        } else if (file.write(signedManifest) != signedManifest.size() || !file.flush()) {
+            err = Error::fromCode(GPG_ERR_EIO);
+            file.remove();
+        }
+    }
+    finish(err, result);
+}
+
+void SignManifestJobPrivate::finish(const GpgME::Error &error, const GpgME::SigningResult &result)
+{
+    Q_Q(SignManifestJob);
+    m_finished = true;
+    Q_EMIT q->done();
+    Q_EMIT q->result(error, result);
+    q->deleteLater();
+}
+
+SignManifestJob::SignManifestJob(const Protocol *protocol)
+    : Job{std::unique_ptr<SignManifestJobPrivate>(new SignManifestJobPrivate{protocol}), nullptr}
+{
+}
+
+SignManifestJob::~SignManifestJob() = default;
+
+void SignManifestJob::setSigners(const std::vector<GpgME::Key> &signers)
+{
+    Q_D(SignManifestJob);
+    d->m_signers = signers;
+}
+
+std::vector<GpgME::Key> SignManifestJob::signers() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_signers;
+}
+
+void SignManifestJob::setFiles(const std::vector<QString> &files)
+{
+    Q_D(SignManifestJob);
+    d->m_files = files;
+}
+
+std::vector<QString> SignManifestJob::files() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_files;
+}
+
+void SignManifestJob::setBaseDirectory(const QString &baseDirectory)
+{
+    Q_D(SignManifestJob);
+    d->m_baseDirectory = baseDirectory;
+}
+
+QString SignManifestJob::baseDirectory() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_baseDirectory;
+}
+
+void SignManifestJob::setOutputFile(const QString &outputFile)
+{
+    Q_D(SignManifestJob);
+    d->m_outputFile = outputFile;
+}
+
+QString SignManifestJob::outputFile() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_outputFile;
+}
+
+void SignManifestJob::setHashAlgorithm(HashAlgorithm algorithm)
+{
+    Q_D(SignManifestJob);
+    d->m_hashAlgorithm = algorithm;
+}
+
+SignManifestJob::HashAlgorithm SignManifestJob::hashAlgorithm() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_hashAlgorithm;
+}
+
+void SignManifestJob::setMaxThreads(int count)
+{
+    Q_D(SignManifestJob);
+    d->m_maxThreads = std::max(count, 1);
+}
+
+int SignManifestJob::maxThreads() const
+{
+    Q_D(const SignManifestJob);
+    return d->m_maxThreads;
+}
+
+void SignManifestJob::slotCancel()
+{
+    Q_D(SignManifestJob);
+    if (d->m_finished) {
+        return;
+    }
+    d->m_canceled = true;
+    if (d->m_signJob) {
+        d->m_signJob->slotCancel();
+    }
+}
+
+#include "moc_signmanifestjob.cpp"
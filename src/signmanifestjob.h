@@ -0,0 +1,135 @@
+/*
+    signmanifestjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SIGNMANIFESTJOB_H__
+#define __QGPGME_SIGNMANIFESTJOB_H__
+
+#include "job.h"
+
+#include <vector>
+
+namespace GpgME
+{
+class Key;
+class SigningResult;
+}
+
+namespace QGpgME
+{
+
+class Protocol;
+class SignManifestJobPrivate;
+
+/**
+ * This job signs many files with a single signature, e.g. the artifacts of
+ * a release.
+ *
+ * The job computes the checksums of the files with multiple threads and
+ * writes a clear-signed manifest listing the files with their sizes and
+ * checksums. Compared to signing each file separately this needs only one
+ * operation with the secret key. The manifest can be checked with a
+ * VerifyManifestJob.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself.
+ */
+class QGPGME_EXPORT SignManifestJob : public Job
+{
+    Q_OBJECT
+public:
+    enum HashAlgorithm {
+        Sha256,
+        Sha512,
+    };
+
+    explicit SignManifestJob(const Protocol *protocol);
+    ~SignManifestJob() override;
+
+    /**
+     * Sets the keys to use for signing the manifest. If no key is set, then
+     * the default key is used.
+     */
+    void setSigners(const std::vector<GpgME::Key> &signers);
+    std::vector<GpgME::Key> signers() const;
+
+    /**
+     * Sets the paths of the files to list in the manifest. The paths must be
+     * relative to the base directory and must not point outside of it. Use a
+     * FileTreeScanner for collecting the files of directory trees.
+     */
+    void setFiles(const std::vector<QString> &files);
+    std::vector<QString> files() const;
+
+    /**
+     * Sets the directory the files are relative to. Defaults to the current
+     * directory.
+     */
+    void setBaseDirectory(const QString &baseDirectory);
+    QString baseDirectory() const;
+
+    /**
+     * Sets the file to write the signed manifest to. The file must not exist.
+     */
+    void setOutputFile(const QString &outputFile);
+    QString outputFile() const;
+
+    /**
+     * Sets the hash algorithm used for the checksums. Defaults to Sha256.
+     */
+    void setHashAlgorithm(HashAlgorithm algorithm);
+    HashAlgorithm hashAlgorithm() const;
+
+    /**
+     * Sets the maximum number of files that are hashed concurrently.
+     * Defaults to the number of CPU cores.
+     */
+    void setMaxThreads(int count);
+    int maxThreads() const;
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the number of hashed files.
+     */
+    void fileProgress(int current, int total);
+
+    void result(const GpgME::Error &error, const GpgME::SigningResult &signingResult);
+
+private:
+    Q_DECLARE_PRIVATE(SignManifestJob)
+};
+
+}
+
+#endif // __QGPGME_SIGNMANIFESTJOB_H__
@@ -0,0 +1,141 @@
+/*
+    singleflight_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_SINGLEFLIGHT_P_H__
+#define __QGPGME_SINGLEFLIGHT_P_H__
+
+#include <QByteArray>
+#include <QStringList>
+
+#include <gpgme++/global.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace GpgME
+{
+class Context;
+}
+
+namespace QGpgME
+{
+namespace _detail
+{
+// the counters reported by KeyListCoalescing::statistics()
+bool keyListCoalescingEnabled();
+void countKeyListRequest(bool coalesced);
+void countInFlightKeyListRequests(int delta);
+
+// Returns a hash of the parameters of a key listing with the context ctx
+// that identifies identical requests. Besides the protocol, the key list
+// mode and the patterns, the hash covers the offline mode, the context
+// flags that affect key listings and the engine and its home directory.
+QByteArray keyListRequestId(GpgME::Context *ctx, unsigned int keyListMode, const QStringList &patterns,
+                            const QByteArray &options);
+
+// Runs identical concurrent requests only once. The first element of
+// T_result must have an error() function and a constructor taking an error.
+template<typename T_result>
+class SingleFlightGroup
+{
+public:
+    using Work = std::function<T_result(GpgME::Context *)>;
+
+    // Returns the function the job shall run instead of work. If a request
+    // with the same id is running, then the returned function waits for
+    // its result instead of doing the work again. The waiting stops with
+    // GPG_ERR_CANCELED as soon as the job sets canceled.
+    Work join(const QByteArray &id, const Work &work, const std::shared_ptr<std::atomic<bool>> &canceled)
+    {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        const auto it = m_inFlight.find(id);
+        if (it != m_inFlight.end()) {
+            countKeyListRequest(true);
+            const auto result = it->second;
+            return [result, work, canceled](GpgME::Context *ctx) {
+                while (result.wait_for(std::chrono::milliseconds{100}) != std::future_status::ready) {
+                    if (*canceled) {
+                        T_result r;
+                        std::get<0>(r) = typename std::tuple_element<0, T_result>::type{GpgME::Error::fromCode(GPG_ERR_CANCELED)};
+                        return r;
+                    }
+                }
+                T_result r = result.get();
+                // the running request was canceled, but this one wasn't
+                if (std::get<0>(r).error().isCanceled()) {
+                    r = work(ctx);
+                }
+                return r;
+            };
+        }
+
+        countKeyListRequest(false);
+        countInFlightKeyListRequests(1);
+        auto promise = std::make_shared<std::promise<T_result>>();
+        m_inFlight.emplace(id, promise->get_future().share());
+        return [this, id, promise, work](GpgME::Context *ctx) {
+            T_result r;
+            try {
+                r = work(ctx);
+            } catch (...) {
+                // don't let the waiting requests wait forever
+                finish(id);
+                promise->set_exception(std::current_exception());
+                throw;
+            }
+            finish(id);
+            promise->set_value(r);
+            return r;
+        };
+    }
+
+private:
+    void finish(const QByteArray &id)
+    {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        m_inFlight.erase(id);
+        countInFlightKeyListRequests(-1);
+    }
+
+    std::mutex m_mutex;
+    std::map<QByteArray, std::shared_future<T_result>> m_inFlight;
+};
+}
+}
+
+#endif // __QGPGME_SINGLEFLIGHT_P_H__
@@ -0,0 +1,284 @@
+/*
+    verificationcache.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "verificationcache.h"
+
+#include <QCryptographicHash>
+#include <QHash>
+
+#include <gpgme++/context.h>
+#include <gpgme++/key.h>
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iterator>
+#include <list>
+#include <mutex>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+struct Entry {
+    QByteArray id;
+    VerificationResult result;
+    QByteArray plainText;
+    QByteArray keyState;
+    Clock::time_point insertTime;
+    // the time when the first of the signatures expires, or 0
+    std::time_t signatureExpiration = 0;
+};
+
+// Returns the time when the first of the signatures of result expires, or 0
+// if none of the signatures expires.
+std::time_t signatureExpiration(const VerificationResult &result)
+{
+    std::time_t expiration = 0;
+    for (const auto &sig : result.signatures()) {
+        const std::time_t sigExpiration = sig.expirationTime();
+        if (sigExpiration > 0 && (expiration == 0 || sigExpiration < expiration)) {
+            expiration = sigExpiration;
+        }
+    }
+    return expiration;
+}
+
+bool isExpired(std::time_t expiration)
+{
+    return expiration > 0 && std::time(nullptr) >= expiration;
+}
+
+// Returns a description of the state of the keys that made the signatures
+// of result. Everything that affects the validity of a signature is part of
+// the state.
+QByteArray keyState(Context *ctx, const VerificationResult &result)
+{
+    QByteArray state;
+    for (const auto &sig : result.signatures()) {
+        if (!sig.fingerprint()) {
+            state += "-;";
+            continue;
+        }
+        state += sig.fingerprint();
+        state += ':';
+        Error err;
+        const Key key = ctx->key(sig.fingerprint(), err, false);
+        if (err || key.isNull()) {
+            state += "none;";
+            continue;
+        }
+        state += QByteArray::number(static_cast<qint64>(key.lastUpdate())) + ',';
+        state += key.isRevoked() ? 'r' : '-';
+        state += key.isExpired() ? 'e' : '-';
+        state += key.isDisabled() ? 'd' : '-';
+        state += key.isInvalid() ? 'i' : '-';
+        state += QByteArray::number(static_cast<int>(key.ownerTrust()));
+        for (const auto &subkey : key.subkeys()) {
+            state += subkey.isRevoked() ? 'r' : '-';
+            state += subkey.isExpired() ? 'e' : '-';
+        }
+        for (const auto &uid : key.userIDs()) {
+            state += QByteArray::number(static_cast<int>(uid.validity()));
+        }
+        state += ';';
+    }
+    return state;
+}
+}
+
+class VerificationCache::Private
+{
+public:
+    using EntryList = std::list<Entry>;
+
+    void removeEntry(EntryList::iterator it)
+    {
+        index.remove(it->id);
+        entries.erase(it);
+    }
+
+    void evictToSize(int size)
+    {
+        while (static_cast<int>(entries.size()) > size) {
+            removeEntry(std::prev(entries.end()));
+            stats.evictions++;
+        }
+    }
+
+    mutable std::mutex mutex;
+    int maxEntries = 1024;
+    int maxAge = 0;
+    // the results in the order of their last use; the most recently used
+    // result comes first
+    EntryList entries;
+    QHash<QByteArray, EntryList::iterator> index;
+    Statistics stats;
+};
+
+VerificationCache::VerificationCache()
+    : d{new Private}
+{
+}
+
+VerificationCache::~VerificationCache() = default;
+
+QByteArray VerificationCache::signatureId(const QByteArray &signature, const QByteArray &signedData,
+                                          bool processAllSignatures)
+{
+    QCryptographicHash hash{QCryptographicHash::Sha256};
+    hash.addData(processAllSignatures ? QByteArrayLiteral("all") : QByteArrayLiteral("first"));
+    hash.addData(QCryptographicHash::hash(signature, QCryptographicHash::Sha256));
+    if (!signedData.isNull()) {
+        hash.addData(QCryptographicHash::hash(signedData, QCryptographicHash::Sha256));
+    }
+    return hash.result();
+}
+
+void VerificationCache::setMaxEntries(int entries)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->maxEntries = std::max(entries, 1);
+    d->evictToSize(d->maxEntries);
+}
+
+int VerificationCache::maxEntries() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->maxEntries;
+}
+
+void VerificationCache::setMaxAge(int seconds)
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->maxAge = std::max(seconds, 0);
+}
+
+int VerificationCache::maxAge() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    return d->maxAge;
+}
+
+void VerificationCache::insert(GpgME::Context *ctx, const QByteArray &id, const GpgME::VerificationResult &result,
+                               const QByteArray &plainText)
+{
+    if (!ctx || result.isNull() || result.error().code()) {
+        return;
+    }
+    const std::time_t expiration = signatureExpiration(result);
+    if (isExpired(expiration)) {
+        // the result would be outdated on the next lookup
+        return;
+    }
+    // look up the keys without holding the lock
+    Entry entry{id, result, plainText, keyState(ctx, result), Clock::now(), expiration};
+
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto it = d->index.constFind(id);
+    if (it != d->index.constEnd()) {
+        d->removeEntry(it.value());
+    }
+    d->evictToSize(d->maxEntries - 1);
+    d->entries.push_front(std::move(entry));
+    d->index.insert(id, d->entries.begin());
+    d->stats.insertions++;
+}
+
+bool VerificationCache::find(GpgME::Context *ctx, const QByteArray &id, GpgME::VerificationResult &result,
+                             QByteArray &plainText)
+{
+    Entry entry;
+    {
+        const std::lock_guard<std::mutex> lock{d->mutex};
+        d->stats.lookups++;
+        const auto it = d->index.constFind(id);
+        if (it == d->index.constEnd()) {
+            d->stats.misses++;
+            return false;
+        }
+        if ((d->maxAge > 0 && Clock::now() - it.value()->insertTime >= std::chrono::seconds{d->maxAge})
+            || isExpired(it.value()->signatureExpiration)) {
+            d->removeEntry(it.value());
+            d->stats.invalidations++;
+            d->stats.misses++;
+            return false;
+        }
+        entry = *it.value();
+    }
+
+    // look up the keys without holding the lock
+    const bool keysUnchanged = ctx && keyState(ctx, entry.result) == entry.keyState;
+
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    const auto it = d->index.constFind(id);
+    if (!keysUnchanged) {
+        if (it != d->index.constEnd()) {
+            d->removeEntry(it.value());
+            d->stats.invalidations++;
+        }
+        d->stats.misses++;
+        return false;
+    }
+    if (it != d->index.constEnd()) {
+        // mark the result as most recently used
+        d->entries.splice(d->entries.begin(), d->entries, it.value());
+    }
+    d->stats.hits++;
+    result = entry.result;
+    plainText = entry.plainText;
+    return true;
+}
+
+void VerificationCache::clear()
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    d->entries.clear();
+    d->index.clear();
+}
+
+VerificationCache::Statistics VerificationCache::statistics() const
+{
+    const std::lock_guard<std::mutex> lock{d->mutex};
+    Statistics result = d->stats;
+    result.entries = static_cast<int>(d->entries.size());
+    result.hitRate = result.lookups > 0 ? static_cast<double>(result.hits) / result.lookups : 0;
+    return result;
+}
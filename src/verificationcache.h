@@ -0,0 +1,159 @@
+/*
+    verificationcache.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_VERIFICATIONCACHE_H__
+#define __QGPGME_VERIFICATIONCACHE_H__
+
+#include "qgpgme_export.h"
+
+#include <QByteArray>
+
+#include <memory>
+
+namespace GpgME
+{
+class Context;
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+/**
+ * A cache for the results of signature verifications.
+ *
+ * If a verification cache is set for a VerifyOpaqueJob or a
+ * VerifyDetachedJob, then the job returns the cached result if the same
+ * signature of the same data is verified again, instead of asking the
+ * engine to verify the signature.
+ *
+ * Together with the result, the cache remembers the state of the keys that
+ * made the signatures, e.g. when they were last updated and whether they
+ * are revoked or expired. A cached result is only used if the state of the
+ * keys hasn't changed since, so that e.g. a revocation or an import of a
+ * missing key invalidates the cached result. Checking the state of the
+ * keys requires a key listing, which is much cheaper than a verification.
+ *
+ * The cache holds at most maxEntries() results; if it is full, then the
+ * least recently used result is evicted. A result that contains a signature
+ * with an expiration time is only used until the signature expires, because
+ * the verification of an expired signature has a different result.
+ * Optionally, results expire after maxAge() seconds.
+ *
+ * All functions are thread-safe.
+ */
+class QGPGME_EXPORT VerificationCache
+{
+public:
+    struct Statistics {
+        /** Number of lookups. */
+        quint64 lookups = 0;
+        /** Number of lookups that found a valid result. */
+        quint64 hits = 0;
+        /** Number of lookups that didn't find a valid result. */
+        quint64 misses = 0;
+        /** Number of results that were added. */
+        quint64 insertions = 0;
+        /** Number of results that were evicted because the cache was full. */
+        quint64 evictions = 0;
+        /** Number of results that were dropped because they expired or
+         *  because the state of a signing key changed. */
+        quint64 invalidations = 0;
+        /** Number of results in the cache. */
+        int entries = 0;
+        /** hits / lookups, or 0 if there were no lookups. */
+        double hitRate = 0;
+    };
+
+    VerificationCache();
+    ~VerificationCache();
+
+    VerificationCache(const VerificationCache &) = delete;
+    VerificationCache &operator=(const VerificationCache &) = delete;
+
+    /**
+     * Returns the id of the verification of \a signature, i.e. a hash of the
+     * signature and the signed data. For opaque signatures \a signedData is
+     * null. The result of a verification may depend on whether all
+     * signatures are processed; \a processAllSignatures is part of the id.
+     */
+    static QByteArray signatureId(const QByteArray &signature, const QByteArray &signedData,
+                                  bool processAllSignatures = false);
+
+    /**
+     * Sets the maximum number of cached results. Defaults to 1024.
+     */
+    void setMaxEntries(int entries);
+    int maxEntries() const;
+
+    /**
+     * Sets the number of seconds after which a cached result expires.
+     * Defaults to 0, i.e. results don't expire.
+     */
+    void setMaxAge(int seconds);
+    int maxAge() const;
+
+    /**
+     * Adds the result \a result of the verification with the id \a id and,
+     * for opaque signatures, the signed data \a plainText to the cache.
+     * \a ctx is used to look up the state of the signing keys.
+     *
+     * Results with an error and results with signatures that have already
+     * expired are not cached.
+     */
+    void insert(GpgME::Context *ctx, const QByteArray &id, const GpgME::VerificationResult &result,
+                const QByteArray &plainText = {});
+
+    /**
+     * Looks up the result of the verification with the id \a id. Returns
+     * true and sets \a result and \a plainText if the cache contains a
+     * result and the state of the signing keys hasn't changed. \a ctx is
+     * used to look up the state of the signing keys.
+     */
+    bool find(GpgME::Context *ctx, const QByteArray &id, GpgME::VerificationResult &result,
+              QByteArray &plainText);
+
+    /**
+     * Removes all results.
+     */
+    void clear();
+
+    Statistics statistics() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif // __QGPGME_VERIFICATIONCACHE_H__
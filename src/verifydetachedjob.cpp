@@ -59,6 +59,18 @@ bool VerifyDetachedJob::processAllSignatures() const
     return d->m_processAllSignatures;
 }
 
+void VerifyDetachedJob::setVerificationCache(const std::shared_ptr<VerificationCache> &cache)
+{
+    Q_D(VerifyDetachedJob);
+    d->m_verificationCache = cache;
+}
+
+std::shared_ptr<VerificationCache> VerifyDetachedJob::verificationCache() const
+{
+    Q_D(const VerifyDetachedJob);
+    return d->m_verificationCache;
+}
+
 void VerifyDetachedJob::setSignatureFile(const QString &path)
 {
     Q_D(VerifyDetachedJob);
@@ -52,6 +52,7 @@ namespace QGpgME
 {
 
 class VerifyDetachedJobPrivate;
+class VerificationCache;
 
 /**
    @short An abstract base class for asynchronous verification of detached signatures
@@ -94,6 +95,17 @@ public:
     void setProcessAllSignatures(bool processAll);
     bool processAllSignatures() const;
 
+    /**
+     * Sets a cache for the results of the verifications. If a cache is set,
+     * then the job returns the cached result if the same signature has been
+     * verified before and the signing keys haven't changed since.
+     *
+     * This is only used if the signature and the signed data are passed as byte arrays to
+     * start() or exec().
+     */
+    void setVerificationCache(const std::shared_ptr<VerificationCache> &cache);
+    std::shared_ptr<VerificationCache> verificationCache() const;
+
     /**
      * Sets the path of the file containing the signature to verify.
      *
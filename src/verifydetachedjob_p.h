@@ -36,15 +36,20 @@
 
 #include "job_p.h"
 
+#include <memory>
+
 namespace QGpgME
 {
 
+class VerificationCache;
+
 class VerifyDetachedJobPrivate : public JobPrivate
 {
 public:
     QString m_signatureFilePath;
     QString m_signedFilePath;
     bool m_processAllSignatures = false;
+    std::shared_ptr<VerificationCache> m_verificationCache;
 };
 
 }
@@ -0,0 +1,279 @@
+/*
+    verifymanifestjob.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "verifymanifestjob.h"
+
+#include "filehash_p.h"
+#include "filemanifest_p.h"
+#include "job_p.h"
+#include "protocol.h"
+#include "signaturecheck_p.h"
+#include "verifyopaquejob.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
+#include <QThread>
+
+#include <gpgme++/verificationresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class QGpgME::VerifyManifestJobPrivate : public JobPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(VerifyManifestJob)
+
+    explicit VerifyManifestJobPrivate(const Protocol *protocol)
+        : m_protocol{protocol}
+    {
+    }
+
+    ~VerifyManifestJobPrivate() override
+    {
+        m_canceled = true;
+        if (m_hashThread.joinable()) {
+            m_hashThread.join();
+        }
+    }
+
+    GpgME::Error startIt() override;
+
+    void startNow() override
+    {
+    }
+
+    void manifestVerified(const GpgME::VerificationResult &result, const QByteArray &plainText);
+    void filesChecked(const std::shared_ptr<std::vector<QString>> &mismatchedFiles);
+    void finish(const GpgME::Error &error, const std::vector<QString> &mismatchedFiles = {});
+
+    const Protocol *const m_protocol;
+    QString m_manifestFile;
+    QString m_baseDirectory;
+    int m_maxThreads = QThread::idealThreadCount();
+
+    QPointer<VerifyOpaqueJob> m_verifyJob;
+    GpgME::VerificationResult m_manifestVerificationResult;
+    std::thread m_hashThread;
+    std::atomic<bool> m_canceled{false};
+    bool m_started = false;
+    bool m_finished = false;
+};
+
+GpgME::Error VerifyManifestJobPrivate::startIt()
+{
+    if (m_manifestFile.isEmpty()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    if (m_started) {
+        return Error::fromCode(GPG_ERR_CONFLICT);
+    }
+
+    QFile file{m_manifestFile};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return Error::fromCode(file.exists() ? GPG_ERR_EACCES : GPG_ERR_ENOENT);
+    }
+    // a manifest of a large release can have many thousands of lines, but
+    // don't let a bogus file exhaust the memory
+    static const qint64 maxManifestSize = 64 * 1024 * 1024;
+    if (file.size() > maxManifestSize) {
+        return Error::fromCode(GPG_ERR_TOO_LARGE);
+    }
+    const QByteArray signedManifest = file.readAll();
+
+    Q_Q(VerifyManifestJob);
+    m_verifyJob = m_protocol->verifyOpaqueJob(true);
+    if (!m_verifyJob) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    QObject::connect(m_verifyJob.data(), &VerifyOpaqueJob::result, q, [this](const VerificationResult &result, const QByteArray &plainText) {
+        manifestVerified(result, plainText);
+    });
+    if (const auto err = m_verifyJob->start(signedManifest)) {
+        delete m_verifyJob.data();
+        return err;
+    }
+    m_started = true;
+    return {};
+}
+
+void VerifyManifestJobPrivate::manifestVerified(const GpgME::VerificationResult &result, const QByteArray &plainText)
+{
+    Q_Q(VerifyManifestJob);
+    m_verifyJob = nullptr;
+    m_manifestVerificationResult = result;
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    if (result.error()) {
+        finish(result.error());
+        return;
+    }
+    if (!_detail::allSignaturesValid(result)) {
+        finish(Error::fromCode(GPG_ERR_BAD_SIGNATURE));
+        return;
+    }
+
+    auto manifest = std::make_shared<_detail::FileManifest>();
+    if (!_detail::FileManifest::fromByteArray(plainText, *manifest)) {
+        finish(Error::fromCode(GPG_ERR_BAD_DATA));
+        return;
+    }
+
+    const QDir baseDir = m_baseDirectory.isEmpty() ? QFileInfo{m_manifestFile}.absoluteDir() : QDir{m_baseDirectory};
+    // hash the files in a separate thread to keep the event loop responsive
+    m_hashThread = std::thread{[this, q, manifest, baseDir]() {
+        const auto &entries = manifest->entries;
+        const int total = static_cast<int>(entries.size());
+        // only files with the expected size need to be hashed
+        auto mismatchedFiles = std::make_shared<std::vector<QString>>();
+        std::vector<size_t> indexes;
+        std::vector<QString> filePaths;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const QFileInfo fi{baseDir.filePath(entries[i].path)};
+            if (fi.isFile() && fi.size() == entries[i].size) {
+                indexes.push_back(i);
+                filePaths.push_back(fi.filePath());
+            } else {
+                mismatchedFiles->push_back(entries[i].path);
+            }
+        }
+        const int mismatchedSizes = static_cast<int>(mismatchedFiles->size());
+        const auto hashes = _detail::hashFiles(filePaths, manifest->algorithm, m_maxThreads, &m_canceled,
+                                               [q, mismatchedSizes, total](size_t n) {
+            QMetaObject::invokeMethod(q, [q, n, mismatchedSizes, total]() {
+                Q_EMIT q->fileProgress(mismatchedSizes + static_cast<int>(n), total);
+                Q_EMIT q->jobProgress(mismatchedSizes + static_cast<int>(n), total);
+            }, Qt::QueuedConnection);
+        });
+        for (size_t i = 0; i < indexes.size(); ++i) {
+            const auto &entry = entries[indexes[i]];
+            if (hashes[i].size != entry.size || hashes[i].checksum != entry.checksum) {
+                mismatchedFiles->push_back(entry.path);
+            }
+        }
+        std::sort(mismatchedFiles->begin(), mismatchedFiles->end());
+        // the event is discarded if the job is destroyed in the meantime
+        // because the destructor joins this thread
+        QMetaObject::invokeMethod(q, [this, mismatchedFiles]() {
+            filesChecked(mismatchedFiles);
+        }, Qt::QueuedConnection);
+    }};
+}
+
+void VerifyManifestJobPrivate::filesChecked(const std::shared_ptr<std::vector<QString>> &mismatchedFiles)
+{
+    m_hashThread.join();
+    if (m_canceled) {
+        finish(Error::fromCode(GPG_ERR_CANCELED));
+        return;
+    }
+    finish(mismatchedFiles->empty() ? Error{} : Error::fromCode(GPG_ERR_CHECKSUM), *mismatchedFiles);
+}
+
+void VerifyManifestJobPrivate::finish(const GpgME::Error &error, const std::vector<QString> &mismatchedFiles)
+{
+    Q_Q(VerifyManifestJob);
+    m_finished = true;
+    Q_EMIT q->done();
+    Q_EMIT q->result(error, m_manifestVerificationResult, mismatchedFiles);
+    q->deleteLater();
+}
+
+VerifyManifestJob::VerifyManifestJob(const Protocol *protocol)
+    : Job{std::unique_ptr<VerifyManifestJobPrivate>(new VerifyManifestJobPrivate{protocol}), nullptr}
+{
+}
+
+VerifyManifestJob::~VerifyManifestJob() = default;
+
+void VerifyManifestJob::setManifestFile(const QString &path)
+{
+    Q_D(VerifyManifestJob);
+    d->m_manifestFile = path;
+}
+
+QString VerifyManifestJob::manifestFile() const
+{
+    Q_D(const VerifyManifestJob);
+    return d->m_manifestFile;
+}
+
+void VerifyManifestJob::setBaseDirectory(const QString &baseDirectory)
+{
+    Q_D(VerifyManifestJob);
+    d->m_baseDirectory = baseDirectory;
+}
+
+QString VerifyManifestJob::baseDirectory() const
+{
+    Q_D(const VerifyManifestJob);
+    return d->m_baseDirectory;
+}
+
+void VerifyManifestJob::setMaxThreads(int count)
+{
+    Q_D(VerifyManifestJob);
+    d->m_maxThreads = std::max(count, 1);
+}
+
+int VerifyManifestJob::maxThreads() const
+{
+    Q_D(const VerifyManifestJob);
+    return d->m_maxThreads;
+}
+
+void VerifyManifestJob::slotCancel()
+{
+    Q_D(VerifyManifestJob);
+    if (d->m_finished) {
+        return;
+    }
+    d->m_canceled = true;
+    if (d->m_verifyJob) {
+        d->m_verifyJob->slotCancel();
+    }
+}
+
+#include "moc_verifymanifestjob.cpp"
@@ -0,0 +1,114 @@
+/*
+    verifymanifestjob.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_VERIFYMANIFESTJOB_H__
+#define __QGPGME_VERIFYMANIFESTJOB_H__
+
+#include "job.h"
+
+#include <vector>
+
+namespace GpgME
+{
+class VerificationResult;
+}
+
+namespace QGpgME
+{
+
+class Protocol;
+class VerifyManifestJobPrivate;
+
+/**
+ * This job checks files against a manifest created by a SignManifestJob.
+ *
+ * The job verifies the signature of the manifest and then compares the
+ * sizes and checksums of the listed files with the values in the manifest
+ * using multiple threads. If the signature of the manifest is bad or was not
+ * made with a valid, i.e. trusted, key, then the files are not checked and
+ * the job fails with \c GPG_ERR_BAD_SIGNATURE. If
+ * a file is missing or doesn't match the manifest, then the job fails with
+ * \c GPG_ERR_CHECKSUM and the file is passed to result().
+ *
+ * The manifest verification result is passed to result(), so that the
+ * caller can check who signed the manifest.
+ *
+ * Start the job with startIt(). After result() has been emitted, the job
+ * deletes itself.
+ */
+class QGPGME_EXPORT VerifyManifestJob : public Job
+{
+    Q_OBJECT
+public:
+    explicit VerifyManifestJob(const Protocol *protocol);
+    ~VerifyManifestJob() override;
+
+    /**
+     * Sets the path of the signed manifest.
+     */
+    void setManifestFile(const QString &path);
+    QString manifestFile() const;
+
+    /**
+     * Sets the directory the paths in the manifest are relative to. Defaults
+     * to the directory of the manifest.
+     */
+    void setBaseDirectory(const QString &baseDirectory);
+    QString baseDirectory() const;
+
+    /**
+     * Sets the maximum number of files that are hashed concurrently.
+     * Defaults to the number of CPU cores.
+     */
+    void setMaxThreads(int count);
+    int maxThreads() const;
+
+public Q_SLOTS:
+    void slotCancel() override;
+
+Q_SIGNALS:
+    /**
+     * Emitted with the number of checked files.
+     */
+    void fileProgress(int current, int total);
+
+    void result(const GpgME::Error &error,
+                const GpgME::VerificationResult &manifestVerificationResult,
+                const std::vector<QString> &mismatchedFiles);
+
+private:
+    Q_DECLARE_PRIVATE(VerifyManifestJob)
+};
+
+}
+
+#endif // __QGPGME_VERIFYMANIFESTJOB_H__
@@ -59,6 +59,18 @@ bool VerifyOpaqueJob::processAllSignatures() const
     return d->m_processAllSignatures;
 }
 
+void VerifyOpaqueJob::setVerificationCache(const std::shared_ptr<VerificationCache> &cache)
+{
+    Q_D(VerifyOpaqueJob);
+    d->m_verificationCache = cache;
+}
+
+std::shared_ptr<VerificationCache> VerifyOpaqueJob::verificationCache() const
+{
+    Q_D(const VerifyOpaqueJob);
+    return d->m_verificationCache;
+}
+
 void VerifyOpaqueJob::setInputFile(const QString &path)
 {
     Q_D(VerifyOpaqueJob);
@@ -36,15 +36,20 @@
 
 #include "job_p.h"
 
+#include <memory>
+
 namespace QGpgME
 {
 
+class VerificationCache;
+
 class VerifyOpaqueJobPrivate : public JobPrivate
 {
 public:
     QString m_inputFilePath;
     QString m_outputFilePath;
     bool m_processAllSignatures = false;
+    std::shared_ptr<VerificationCache> m_verificationCache;
 };
 
 }
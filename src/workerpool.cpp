@@ -0,0 +1,116 @@
+/*
+    workerpool.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "workerpool_p.h"
+
+#include <QThread>
+
+#include <gpgme++/context.h>
+
+#include <algorithm>
+
+using namespace QGpgME::_detail;
+using namespace GpgME;
+
+WorkerPool::WorkerPool(GpgME::Protocol protocol)
+    : mProtocol{protocol}
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+    cancel();
+    for (auto &thread : mThreads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::setContextSetup(const ContextSetup &setup)
+{
+    mContextSetup = setup;
+}
+
+void WorkerPool::start(size_t count, int threadCount, const Task &task, const std::function<void()> &finished)
+{
+    mCount = count;
+    mTask = task;
+    mFinished = finished;
+    const int numThreads = static_cast<int>(std::min<size_t>(std::max(threadCount, 1), std::max<size_t>(count, 1)));
+    mRunningThreads = numThreads;
+    mThreads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        mThreads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+void WorkerPool::cancel()
+{
+    mCanceled = true;
+    const std::lock_guard<std::mutex> lock{mContextsMutex};
+    for (auto ctx : mContexts) {
+        ctx->cancelPendingOperation();
+    }
+}
+
+// static
+int WorkerPool::defaultThreadCount()
+{
+    return std::max(QThread::idealThreadCount(), 1);
+}
+
+void WorkerPool::work()
+{
+    std::unique_ptr<Context> ctx{Context::createForProtocol(mProtocol)};
+    if (ctx) {
+        if (mContextSetup) {
+            mContextSetup(ctx.get());
+        }
+        const std::lock_guard<std::mutex> lock{mContextsMutex};
+        mContexts.push_back(ctx.get());
+    }
+
+    for (size_t index = mNextIndex++; index < mCount && !mCanceled; index = mNextIndex++) {
+        mTask(ctx.get(), index);
+    }
+
+    if (ctx) {
+        const std::lock_guard<std::mutex> lock{mContextsMutex};
+        mContexts.erase(std::find(mContexts.begin(), mContexts.end(), ctx.get()));
+    }
+    if (--mRunningThreads == 0) {
+        mFinished();
+    }
+}
@@ -0,0 +1,112 @@
+/*
+    workerpool_p.h
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifndef __QGPGME_WORKERPOOL_P_H__
+#define __QGPGME_WORKERPOOL_P_H__
+
+#include <gpgme++/global.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GpgME
+{
+class Context;
+}
+
+namespace QGpgME
+{
+namespace _detail
+{
+
+// A bounded pool of threads for running many small crypto operations. Each
+// thread creates one context and reuses it for all operations it runs, i.e.
+// the operations run by one thread must not depend on context state left
+// over by a previous operation.
+class WorkerPool
+{
+public:
+    using ContextSetup = std::function<void(GpgME::Context *)>;
+    using Task = std::function<void(GpgME::Context *ctx, size_t index)>;
+
+    explicit WorkerPool(GpgME::Protocol protocol);
+    // cancels the pool and waits for the threads
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // Sets a function that configures the contexts after they were created,
+    // e.g. for setting armor mode.
+    void setContextSetup(const ContextSetup &setup);
+
+    // Runs task(ctx, i) for all i in [0, count) on up to threadCount threads.
+    // The tasks are started in the order of their index. finished() is called
+    // by the last thread after all tasks have been run or the pool has been
+    // canceled. If the context cannot be created, then ctx is nullptr. Must
+    // only be called once.
+    void start(size_t count, int threadCount, const Task &task, const std::function<void()> &finished);
+
+    // Doesn't start further tasks and cancels the running operations. Can be
+    // called from any thread.
+    void cancel();
+    bool isCanceled() const
+    {
+        return mCanceled;
+    }
+
+    static int defaultThreadCount();
+
+private:
+    void work();
+
+    const GpgME::Protocol mProtocol;
+    ContextSetup mContextSetup;
+    Task mTask;
+    std::function<void()> mFinished;
+    size_t mCount = 0;
+    std::atomic<size_t> mNextIndex{0};
+    std::atomic<int> mRunningThreads{0};
+    std::atomic<bool> mCanceled{false};
+    std::mutex mContextsMutex;
+    std::vector<GpgME::Context *> mContexts;
+    std::vector<std::thread> mThreads;
+};
+
+}
+}
+
+#endif // __QGPGME_WORKERPOOL_P_H__
@@ -0,0 +1,210 @@
+/*
+    run-bulkdecryptbenchmark.cpp
+
+    This file is part of QGpgME's test suite.
+    Copyright (c) 2026 by g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License,
+    version 2, as published by the Free Software Foundation.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <bulkfiledecryptverifyjob.h>
+#include <bulkfileencryptjob.h>
+#include <keylistjob.h>
+#include <protocol.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <gpgme++/context.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/keylistresult.h>
+
+#include <iostream>
+#include <memory>
+
+using namespace GpgME;
+
+struct CommandLineOptions {
+    int files = 200;
+    int size = 4096;
+    int maxThreads = 0;
+    QString key;
+};
+
+CommandLineOptions parseCommandLine(const QStringList &arguments)
+{
+    CommandLineOptions options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark for decrypting many small files with different numbers of threads");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"n", "files"}, "Decrypt N files (default: 200).", "N"},
+        {{"s", "size"}, "Size of the files in bytes (default: 4096).", "SIZE"},
+        {{"t", "max-threads"}, "Use at most N threads (default: number of CPU cores).", "N"},
+    });
+    parser.addPositionalArgument("key", "Key to encrypt for (its secret key is needed for decryption)", "KEY");
+
+    parser.process(arguments);
+
+    const auto args = parser.positionalArguments();
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    const auto positiveValue = [&parser](const QString &name, int defaultValue) {
+        if (!parser.isSet(name)) {
+            return defaultValue;
+        }
+        bool ok;
+        const int value = parser.value(name).toInt(&ok);
+        if (!ok || value <= 0) {
+            parser.showHelp(1);
+        }
+        return value;
+    };
+    options.files = positiveValue("files", options.files);
+    options.size = positiveValue("size", options.size);
+    options.maxThreads = positiveValue("max-threads", QThread::idealThreadCount());
+    options.key = args.front();
+
+    return options;
+}
+
+int main(int argc, char **argv)
+{
+    GpgME::initializeLibrary();
+
+    QCoreApplication app{argc, argv};
+    app.setApplicationName("run-bulkdecryptbenchmark");
+
+    const auto options = parseCommandLine(app.arguments());
+
+    std::vector<Key> keys;
+    {
+        std::unique_ptr<QGpgME::KeyListJob> job{QGpgME::openpgp()->keyListJob()};
+        const auto result = job->exec({options.key}, true, keys);
+        if (result.error() || keys.empty()) {
+            std::cerr << "Error: Could not find secret key " << options.key.toLocal8Bit().constData() << std::endl;
+            return 1;
+        }
+        keys.resize(1);
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::cerr << "Error: Could not create temporary directory" << std::endl;
+        return 1;
+    }
+
+    // create the encrypted files
+    std::vector<std::pair<QString, QString>> encryptFiles;
+    const QByteArray plainText(options.size, 'x');
+    for (int i = 0; i < options.files; ++i) {
+        const QString fileName = dir.filePath(QStringLiteral("file%1.txt").arg(i));
+        QFile file{fileName};
+        if (!file.open(QIODevice::WriteOnly) || file.write(plainText) != plainText.size()) {
+            std::cerr << "Error: Could not write " << fileName.toLocal8Bit().constData() << std::endl;
+            return 1;
+        }
+        encryptFiles.push_back({fileName, fileName + QLatin1String{".gpg"}});
+    }
+    {
+        auto job = new QGpgME::BulkFileEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setFiles(encryptFiles);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        Error error;
+        QEventLoop loop;
+        QObject::connect(job, &QGpgME::BulkFileEncryptJob::result, &loop, [&](const Error &err, const std::vector<EncryptionResult> &) {
+            error = err;
+            loop.quit();
+        });
+        if (const auto err = job->startIt()) {
+            std::cerr << "Error: Could not start encryption: " << err << std::endl;
+            return 1;
+        }
+        loop.exec();
+        if (error) {
+            std::cerr << "Error: Encryption failed: " << error << std::endl;
+            return 1;
+        }
+    }
+
+    // 1, 2, 4, ... threads up to the maximum number of threads
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < options.maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.maxThreads);
+
+    for (const int threads : threadCounts) {
+        const QString outputDir = dir.filePath(QStringLiteral("out%1").arg(threads));
+        QDir{}.mkpath(outputDir);
+        std::vector<std::pair<QString, QString>> files;
+        for (int i = 0; i < options.files; ++i) {
+            files.push_back({encryptFiles[i].second, outputDir + QStringLiteral("/file%1.txt").arg(i)});
+        }
+
+        auto job = new QGpgME::BulkFileDecryptVerifyJob{GpgME::OpenPGP};
+        job->setFiles(files);
+        job->setMaxThreads(threads);
+        Error error;
+        QEventLoop loop;
+        QObject::connect(job, &QGpgME::BulkFileDecryptVerifyJob::result,
+                         &loop, [&](const Error &err, const std::vector<QGpgME::BulkFileDecryptVerifyJob::FileResult> &) {
+            error = err;
+            loop.quit();
+        });
+        QElapsedTimer timer;
+        timer.start();
+        if (const auto err = job->startIt()) {
+            std::cerr << "Error: Could not start decryption: " << err << std::endl;
+            return 1;
+        }
+        loop.exec();
+        const double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+        if (error) {
+            std::cerr << "Error: Decryption failed: " << error << std::endl;
+            return 1;
+        }
+        std::cout << threads << " threads\t" << options.files / seconds << " files/s\t"
+                  << (double(options.size) * options.files / (1024 * 1024)) / seconds << " MiB/s" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+    run-compressionbenchmark.cpp
+
+    This file is part of QGpgME's test suite.
+    Copyright (c) 2026 by g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License,
+    version 2, as published by the Free Software Foundation.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+
+#include <encryptjob.h>
+#include <keylistjob.h>
+#include <protocol.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <gpgme++/context.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/keylistresult.h>
+
+#include <iostream>
+#include <memory>
+
+using namespace GpgME;
+
+struct CommandLineOptions {
+    int iterations = 10;
+    int size = 1024 * 1024;
+    QString key;
+};
+
+CommandLineOptions parseCommandLine(const QStringList &arguments)
+{
+    CommandLineOptions options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark for encrypting compressible and incompressible data with and without detection of incompressible input");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"n", "iterations"}, "Encrypt each sample N times (default: 10).", "N"},
+        {{"s", "size"}, "Size of each sample in KiB (default: 1024).", "SIZE"},
+    });
+    parser.addPositionalArgument("key", "Key to encrypt for", "KEY");
+
+    parser.process(arguments);
+
+    const auto args = parser.positionalArguments();
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    bool ok = true;
+    if (parser.isSet("iterations")) {
+        options.iterations = parser.value("iterations").toInt(&ok);
+        if (!ok || options.iterations <= 0) {
+            parser.showHelp(1);
+        }
+    }
+    if (parser.isSet("size")) {
+        options.size = parser.value("size").toInt(&ok) * 1024;
+        if (!ok || options.size <= 0) {
+            parser.showHelp(1);
+        }
+    }
+    options.key = args.front();
+
+    return options;
+}
+
+static QByteArray randomData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(data.data()), size / sizeof(quint32));
+    return data;
+}
+
+// a mixed corpus of already compressed media and archives, encrypted data
+// and compressible text and logs
+static std::vector<std::pair<const char *, QByteArray>> createCorpus(int size)
+{
+    const QByteArray text = QByteArray{"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.\n"}.repeated(size / 81 + 1).left(size);
+    QByteArray log;
+    for (int i = 0; log.size() < size; ++i) {
+        log += "2026-10-18 12:00:" + QByteArray::number(i % 60).rightJustified(2, '0') + " worker[" + QByteArray::number(i % 17) + "]: processed request " + QByteArray::number(i) + "\n";
+    }
+    log.truncate(size);
+    QByteArray jpeg = randomData(size);
+    jpeg.replace(0, 3, "\xFF\xD8\xFF");
+    QByteArray zip = randomData(size);
+    zip.replace(0, 4, "PK\x03\x04");
+
+    return {
+        {"text", text},
+        {"log", log},
+        {"jpeg", jpeg},
+        {"zip", zip},
+        {"random", randomData(size)},
+    };
+}
+
+static bool encrypt(const std::vector<Key> &keys, const QByteArray &plainText, bool detect, int iterations,
+                    qint64 &elapsedMs, qint64 &cipherTextSize, bool &detected)
+{
+    QByteArray cipherText;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        std::unique_ptr<QGpgME::EncryptJob> job{QGpgME::openpgp()->encryptJob()};
+        job->setDetectIncompressibleInput(detect);
+        const auto result = job->exec(keys, plainText, Context::AlwaysTrust, cipherText);
+        if (result.error()) {
+            std::cerr << "Error: Encryption failed: " << result.error() << std::endl;
+            return false;
+        }
+        detected = job->incompressibleInputDetected();
+    }
+    elapsedMs = timer.elapsed();
+    cipherTextSize = cipherText.size();
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    GpgME::initializeLibrary();
+
+    QCoreApplication app{argc, argv};
+    app.setApplicationName("run-compressionbenchmark");
+
+    const auto options = parseCommandLine(app.arguments());
+
+    std::vector<Key> keys;
+    {
+        std::unique_ptr<QGpgME::KeyListJob> job{QGpgME::openpgp()->keyListJob()};
+        const auto result = job->exec({options.key}, false, keys);
+        if (result.error() || keys.empty()) {
+            std::cerr << "Error: Could not find key " << options.key.toLocal8Bit().constData() << std::endl;
+            return 1;
+        }
+        keys.resize(1);
+    }
+
+    qint64 totalMs[2] = {0, 0};
+    for (const auto &sample : createCorpus(options.size)) {
+        for (const bool detect : {false, true}) {
+            qint64 elapsedMs = 0;
+            qint64 cipherTextSize = 0;
+            bool detected = false;
+            if (!encrypt(keys, sample.second, detect, options.iterations, elapsedMs, cipherTextSize, detected)) {
+                return 1;
+            }
+            totalMs[detect] += elapsedMs;
+            const double seconds = qMax<qint64>(elapsedMs, 1) / 1000.0;
+            std::cout << sample.first << "\t" << (detect ? "detect" : "default") << "\t"
+                      << (detected ? "no-compress" : "compress") << "\t"
+                      << (double(sample.second.size()) * options.iterations / (1024 * 1024)) / seconds << " MiB/s\t"
+                      << cipherTextSize * 100 / sample.second.size() << " % of input" << std::endl;
+        }
+    }
+    std::cout << "total\tdefault\t" << totalMs[0] << " ms" << std::endl;
+    std::cout << "total\tdetect\t" << totalMs[1] << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+    run-filetreescanner.cpp
+
+    This file is part of QGpgME's test suite.
+    Copyright (c) 2026 by g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License,
+    version 2, as published by the Free Software Foundation.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <directorywalker.h>
+#include <filetreescanner.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <iostream>
+#include <memory>
+
+using namespace QGpgME;
+
+struct CommandLineOptions {
+    QString directory;
+    int numberOfFiles = 1000000;
+    int threads = 0;
+};
+
+CommandLineOptions parseCommandLine(const QStringList &arguments)
+{
+    CommandLineOptions options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark for scanning directory trees for archive jobs. "
+                                     "If no directory is given, then a temporary tree of small files is created.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"n", "files"}, "Number of files to create in the temporary tree (default: 1000000).", "N"},
+        {{"t", "threads"}, "Number of threads to use for the parallel scan (default: scanner's default).", "N"},
+    });
+    parser.addPositionalArgument("directory", "Directory to scan", "[DIRECTORY]");
+
+    parser.process(arguments);
+
+    const auto args = parser.positionalArguments();
+    if (args.size() > 1) {
+        parser.showHelp(1);
+    }
+    if (parser.isSet("files")) {
+        bool ok;
+        options.numberOfFiles = parser.value("files").toInt(&ok);
+        if (!ok || options.numberOfFiles <= 0) {
+            parser.showHelp(1);
+        }
+    }
+    if (parser.isSet("threads")) {
+        bool ok;
+        options.threads = parser.value("threads").toInt(&ok);
+        if (!ok || options.threads <= 0) {
+            parser.showHelp(1);
+        }
+    }
+    if (!args.isEmpty()) {
+        options.directory = args.front();
+    }
+
+    return options;
+}
+
+static bool createTree(const QString &path, int numberOfFiles)
+{
+    // 1000 files per directory, 100 directories per parent directory
+    const int filesPerDirectory = 1000;
+    for (int i = 0; i < numberOfFiles; ++i) {
+        const int dirIndex = i / filesPerDirectory;
+        const QString dir = path + QStringLiteral("/d%1/d%2").arg(dirIndex / 100).arg(dirIndex % 100);
+        if (i % filesPerDirectory == 0 && !QDir{}.mkpath(dir)) {
+            return false;
+        }
+        QFile file{dir + QStringLiteral("/f%1").arg(i)};
+        if (!file.open(QIODevice::WriteOnly) || file.write("small file\n") < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void printResult(const char *method, qint64 numberOfPaths, qint64 elapsedMs)
+{
+    const double seconds = qMax<qint64>(elapsedMs, 1) / 1000.0;
+    std::cout << method << "\t" << numberOfPaths << " paths\t"
+              << elapsedMs << " ms\t" << numberOfPaths / seconds << " paths/s" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName("run-filetreescanner");
+
+    const auto options = parseCommandLine(app.arguments());
+
+    std::unique_ptr<QTemporaryDir> tempDir;
+    QString directory = options.directory;
+    if (directory.isEmpty()) {
+        tempDir.reset(new QTemporaryDir);
+        directory = tempDir->path();
+        std::cout << "Creating " << options.numberOfFiles << " files in " << qPrintable(directory) << " ..." << std::endl;
+        if (!tempDir->isValid() || !createTree(directory, options.numberOfFiles)) {
+            std::cerr << "Error: Failed to create the files" << std::endl;
+            return 1;
+        }
+    }
+
+    {
+        DirectoryWalker walker{{directory}};
+        QElapsedTimer timer;
+        timer.start();
+        while (!walker.next().isEmpty()) {
+        }
+        printResult("walker", walker.count(), timer.elapsed());
+    }
+
+    {
+        FileTreeScanner scanner{{directory}};
+        if (options.threads > 0) {
+            scanner.setThreadCount(options.threads);
+        }
+        QElapsedTimer timer;
+        timer.start();
+        const auto result = scanner.scan();
+        printResult("scanner", result.paths.size(), timer.elapsed());
+        std::cout << "\t" << scanner.threadCount() << " threads, " << result.fileCount << " files, "
+                  << result.directoryCount << " directories, " << result.totalBytes << " bytes" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+    run-smallmessagebenchmark.cpp
+
+    This file is part of QGpgME's test suite.
+    Copyright (c) 2026 by g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License,
+    version 2, as published by the Free Software Foundation.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <batchencryptjob.h>
+#include <encryptjob.h>
+#include <keylistjob.h>
+#include <protocol.h>
+#include <signjob.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+
+#include <gpgme++/context.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+#include <gpgme++/keylistresult.h>
+#include <gpgme++/signingresult.h>
+
+#include <iostream>
+#include <memory>
+
+using namespace GpgME;
+
+struct CommandLineOptions {
+    bool armor = false;
+    bool sign = true;
+    bool encrypt = true;
+    bool batch = true;
+    int iterations = 100;
+    QString key;
+};
+
+CommandLineOptions parseCommandLine(const QStringList &arguments)
+{
+    CommandLineOptions options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark for signing and encrypting small in-memory messages");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"a", "armor"}, "Create ASCII armored output."},
+        {{"n", "iterations"}, "Process each message size N times (default: 100).", "N"},
+        {"sign-only", "Only benchmark signing."},
+        {"encrypt-only", "Only benchmark encryption."},
+        {"no-batch", "Don't benchmark the batch encryption job."},
+    });
+    parser.addPositionalArgument("key", "Key to sign with and to encrypt for", "KEY");
+
+    parser.process(arguments);
+
+    const auto args = parser.positionalArguments();
+    if (args.size() != 1 || (parser.isSet("sign-only") && parser.isSet("encrypt-only"))) {
+        parser.showHelp(1);
+    }
+
+    options.armor = parser.isSet("armor");
+    options.sign = !parser.isSet("encrypt-only");
+    options.encrypt = !parser.isSet("sign-only");
+    options.batch = options.encrypt && !parser.isSet("no-batch");
+    if (parser.isSet("iterations")) {
+        bool ok;
+        options.iterations = parser.value("iterations").toInt(&ok);
+        if (!ok || options.iterations <= 0) {
+            parser.showHelp(1);
+        }
+    }
+    options.key = args.front();
+
+    return options;
+}
+
+static void printResult(const char *operation, int size, int iterations, qint64 elapsedMs)
+{
+    const double seconds = qMax<qint64>(elapsedMs, 1) / 1000.0;
+    std::cout << operation << "\t" << size / 1024 << " KiB\t"
+              << iterations / seconds << " ops/s\t"
+              << (double(size) * iterations / (1024 * 1024)) / seconds << " MiB/s" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    GpgME::initializeLibrary();
+
+    QCoreApplication app{argc, argv};
+    app.setApplicationName("run-smallmessagebenchmark");
+
+    const auto options = parseCommandLine(app.arguments());
+
+    std::vector<Key> keys;
+    {
+        std::unique_ptr<QGpgME::KeyListJob> job{QGpgME::openpgp()->keyListJob()};
+        const auto result = job->exec({options.key}, true, keys);
+        if (result.error() || keys.empty()) {
+            std::cerr << "Error: Could not find secret key " << options.key.toLocal8Bit().constData() << std::endl;
+            return 1;
+        }
+        keys.resize(1);
+    }
+
+    for (int size = 1024; size <= 64 * 1024; size *= 2) {
+        const QByteArray plainText(size, 'x');
+
+        if (options.sign) {
+            // the output buffer is reused for all operations
+            QByteArray signedData;
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < options.iterations; ++i) {
+                std::unique_ptr<QGpgME::SignJob> job{QGpgME::openpgp()->signJob(options.armor)};
+                const auto result = job->exec(keys, plainText, NormalSignatureMode, signedData);
+                if (result.error()) {
+                    std::cerr << "Error: Signing failed: " << result.error() << std::endl;
+                    return 1;
+                }
+            }
+            printResult("sign", size, options.iterations, timer.elapsed());
+        }
+
+        if (options.encrypt) {
+            QByteArray cipherText;
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < options.iterations; ++i) {
+                std::unique_ptr<QGpgME::EncryptJob> job{QGpgME::openpgp()->encryptJob(options.armor)};
+                const auto result = job->exec(keys, plainText, Context::AlwaysTrust, cipherText);
+                if (result.error()) {
+                    std::cerr << "Error: Encryption failed: " << result.error() << std::endl;
+                    return 1;
+                }
+            }
+            printResult("encrypt", size, options.iterations, timer.elapsed());
+        }
+
+        if (options.batch) {
+            // all messages are encrypted by one job with reused contexts
+            auto job = new QGpgME::BatchEncryptJob{GpgME::OpenPGP};
+            job->setRecipients(keys);
+            job->setPlainTexts(std::vector<QByteArray>(options.iterations, plainText));
+            job->setEncryptionFlags(Context::AlwaysTrust);
+            job->setArmor(options.armor);
+            Error error;
+            QEventLoop loop;
+            QObject::connect(job, &QGpgME::BatchEncryptJob::result, &loop, [&](const Error &err, const std::vector<EncryptionResult> &, const std::vector<QByteArray> &) {
+                error = err;
+                loop.quit();
+            });
+            QElapsedTimer timer;
+            timer.start();
+            if (const auto err = job->startIt()) {
+                std::cerr << "Error: Could not start batch encryption: " << err << std::endl;
+                return 1;
+            }
+            loop.exec();
+            if (error) {
+                std::cerr << "Error: Batch encryption failed: " << error << std::endl;
+                return 1;
+            }
+            printResult("batch-encrypt", size, options.iterations, timer.elapsed());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+    t-archivemanifest.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <archivemanifest.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace QGpgME;
+
+class ArchiveManifestTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    void writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile file{mDir->filePath(path)};
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(file.write(content), qint64(content.size()));
+    }
+
+    ArchiveManifest createManifest(const ArchiveManifest &previous = {})
+    {
+        return ArchiveManifest::create({QStringLiteral("tree")}, mDir->path(), previous);
+    }
+
+private Q_SLOTS:
+    void init()
+    {
+        mDir.reset(new QTemporaryDir);
+        QVERIFY(mDir->isValid());
+        QDir dir{mDir->path()};
+        QVERIFY(dir.mkpath(QStringLiteral("tree/sub")));
+        QVERIFY(dir.mkpath(QStringLiteral("tree/empty")));
+        writeFile(QStringLiteral("tree/a.txt"), "a");
+        writeFile(QStringLiteral("tree/b.txt"), "b");
+        writeFile(QStringLiteral("tree/sub/c.txt"), "c");
+    }
+
+    void cleanup()
+    {
+        mDir.reset();
+    }
+
+    void testCreate()
+    {
+        const auto manifest = createManifest();
+        QCOMPARE(manifest.entries().size(), size_t(4));
+        const auto entry = manifest.find(QStringLiteral("tree/a.txt"));
+        QVERIFY(entry);
+        QCOMPARE(entry->type, ArchiveManifest::File);
+        QCOMPARE(entry->size, qint64(1));
+        QCOMPARE(entry->sha256, QCryptographicHash::hash("a", QCryptographicHash::Sha256).toHex());
+        const auto emptyDir = manifest.find(QStringLiteral("tree/empty"));
+        QVERIFY(emptyDir);
+        QCOMPARE(emptyDir->type, ArchiveManifest::Directory);
+        QVERIFY(!manifest.find(QStringLiteral("tree/sub")));
+        QVERIFY(manifest.diff(manifest).isEmpty());
+    }
+
+    void testChecksumOfLargeFile()
+    {
+        // large files are hashed in memory-mapped chunks
+        QByteArray content(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+        for (int i = 0; i < content.size(); ++i) {
+            content[i] = static_cast<char>(i % 251);
+        }
+        writeFile(QStringLiteral("tree/large.bin"), content);
+        const auto manifest = createManifest();
+        const auto entry = manifest.find(QStringLiteral("tree/large.bin"));
+        QVERIFY(entry);
+        QCOMPARE(entry->size, qint64(content.size()));
+        QCOMPARE(entry->sha256, QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
+    }
+
+    void testDiff()
+    {
+        const auto previous = createManifest();
+
+        // added, modified, removed, and touched without a change of the content
+        writeFile(QStringLiteral("tree/new.txt"), "new");
+        writeFile(QStringLiteral("tree/a.txt"), "A");
+        QVERIFY(QFile::remove(mDir->filePath(QStringLiteral("tree/sub/c.txt"))));
+        {
+            QFile file{mDir->filePath(QStringLiteral("tree/b.txt"))};
+            QVERIFY(file.open(QIODevice::ReadWrite));
+            QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+        }
+        // the formerly empty directory is not removed
+        writeFile(QStringLiteral("tree/empty/d.txt"), "d");
+
+        const auto current = createManifest(previous);
+        const auto diff = current.diff(previous);
+        QCOMPARE(diff.added, (std::vector<QString>{QStringLiteral("tree/empty/d.txt"),
+                                                   QStringLiteral("tree/new.txt"),
+                                                   QStringLiteral("tree/sub")}));
+        QCOMPARE(diff.modified, (std::vector<QString>{QStringLiteral("tree/a.txt")}));
+        QCOMPARE(diff.removed, (std::vector<QString>{QStringLiteral("tree/sub/c.txt")}));
+        // tree/sub is empty now and therefore an entry of its own
+        QCOMPARE(current.find(QStringLiteral("tree/sub"))->type, ArchiveManifest::Directory);
+        QCOMPARE(diff.changed(), (std::vector<QString>{QStringLiteral("tree/a.txt"),
+                                                       QStringLiteral("tree/empty/d.txt"),
+                                                       QStringLiteral("tree/new.txt"),
+                                                       QStringLiteral("tree/sub")}));
+    }
+
+    void testSaveAndLoad()
+    {
+        writeFile(QStringLiteral("tree/name with spaces %.txt"), "x");
+        const auto manifest = createManifest();
+        const QString fileName = mDir->filePath(QStringLiteral("manifest"));
+        QVERIFY(manifest.save(fileName));
+
+        ArchiveManifest loaded;
+        QVERIFY(ArchiveManifest::load(fileName, loaded));
+        QCOMPARE(loaded.toByteArray(), manifest.toByteArray());
+        QVERIFY(loaded.find(QStringLiteral("tree/name with spaces %.txt")));
+        QVERIFY(loaded.diff(manifest).isEmpty());
+
+        QVERIFY(!ArchiveManifest::fromByteArray("garbage", loaded));
+        QVERIFY(!ArchiveManifest::fromByteArray("QGpgME-Archive-Manifest: 1\nx - 1 2 a\n", loaded));
+    }
+
+private:
+    std::unique_ptr<QTemporaryDir> mDir;
+};
+
+QTEST_GUILESS_MAIN(ArchiveManifestTest)
+
+#include "t-archivemanifest.moc"
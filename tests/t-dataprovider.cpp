@@ -0,0 +1,168 @@
+/*
+    t-dataprovider.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <dataprovider.h>
+
+#include <QProcess>
+#include <QTest>
+
+#include <cstdio>
+#include <memory>
+
+using namespace QGpgME;
+
+class DataProviderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testQProcessWritesAreBounded()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("This test requires the cat tool");
+#endif
+        auto proc = std::make_shared<QProcess>();
+        proc->setStandardOutputFile(QProcess::nullDevice());
+        proc->start(QStringLiteral("cat"), QStringList{});
+        QVERIFY(proc->waitForStarted());
+
+        QIODeviceDataProvider dp{proc};
+        dp.setWriteFlushThreshold(16 * 1024);
+        dp.setMaxPendingWriteBytes(64 * 1024);
+        QCOMPARE(dp.writeFlushThreshold(), qint64(16 * 1024));
+        QCOMPARE(dp.maxPendingWriteBytes(), qint64(64 * 1024));
+
+        GpgME::DataProvider &provider = dp;
+        const QByteArray chunk(4096, 'x');
+        for (int i = 0; i < 1024; ++i) {
+            QCOMPARE(qint64(provider.write(chunk.constData(), chunk.size())), qint64(chunk.size()));
+            QVERIFY(proc->bytesToWrite() <= dp.maxPendingWriteBytes());
+        }
+
+        proc->closeWriteChannel();
+        QVERIFY(proc->waitForFinished());
+        QCOMPARE(proc->exitCode(), 0);
+    }
+
+    void testReadOnlyByteArrayProviderDoesNotCopy()
+    {
+        const QByteArray input{"Lorem ipsum dolor sit amet"};
+        QByteArrayReadOnlyDataProvider dp{input};
+        GpgME::DataProvider &provider = dp;
+
+        QVERIFY(provider.isSupported(GpgME::DataProvider::Read));
+        QVERIFY(provider.isSupported(GpgME::DataProvider::Seek));
+        QVERIFY(!provider.isSupported(GpgME::DataProvider::Write));
+
+        char buffer[10];
+        QByteArray output;
+        qint64 n;
+        while ((n = provider.read(buffer, sizeof(buffer))) > 0) {
+            output.append(buffer, n);
+        }
+        QCOMPARE(n, qint64(0));
+        QCOMPARE(output, input);
+        QVERIFY(dp.data().isSharedWith(input));
+
+        QCOMPARE(qint64(provider.seek(6, SEEK_SET)), qint64(6));
+        QCOMPARE(qint64(provider.read(buffer, 5)), qint64(5));
+        QCOMPARE(QByteArray(buffer, 5), QByteArray("ipsum"));
+        QCOMPARE(qint64(provider.seek(-4, SEEK_END)), qint64(input.size() - 4));
+        QCOMPARE(qint64(provider.read(buffer, sizeof(buffer))), qint64(4));
+        QCOMPARE(QByteArray(buffer, 4), QByteArray("amet"));
+        QCOMPARE(qint64(provider.seek(-1, SEEK_SET)), qint64(-1));
+
+        QCOMPARE(qint64(provider.write("x", 1)), qint64(-1));
+        QVERIFY(dp.data().isSharedWith(input));
+    }
+
+    void testByteArrayProviderReadDoesNotDetach()
+    {
+        const QByteArray input{"Lorem ipsum dolor sit amet"};
+        QByteArrayDataProvider dp{input};
+        GpgME::DataProvider &provider = dp;
+
+        char buffer[64];
+        QCOMPARE(qint64(provider.read(buffer, sizeof(buffer))), qint64(input.size()));
+        QVERIFY(dp.data().isSharedWith(input));
+    }
+
+    void testSinkProviderReusesMemoryOfByteArray()
+    {
+        QByteArray output;
+        const QByteArray first{"Lorem ipsum dolor sit amet"};
+        {
+            QByteArraySinkDataProvider dp{output};
+            dp.reserve(1024);
+            GpgME::DataProvider &provider = dp;
+            QCOMPARE(qint64(provider.write(first.constData(), first.size())), qint64(first.size()));
+            provider.release();
+        }
+        QCOMPARE(output, first);
+        QVERIFY(output.capacity() >= 1024);
+
+        const auto capacity = output.capacity();
+        const char *memory = output.constData();
+        const QByteArray second{"consectetur"};
+        {
+            QByteArraySinkDataProvider dp{output};
+            QVERIFY(output.isEmpty());
+            GpgME::DataProvider &provider = dp;
+            QCOMPARE(qint64(provider.write(second.constData(), second.size())), qint64(second.size()));
+        }
+        QCOMPARE(output, second);
+        QCOMPARE(output.capacity(), capacity);
+        QCOMPARE(output.constData(), memory);
+    }
+
+    void testSinkProviderZeroFillsGapAfterSeek()
+    {
+        QByteArray output;
+        QByteArraySinkDataProvider dp{output};
+        GpgME::DataProvider &provider = dp;
+        QCOMPARE(qint64(provider.write("ab", 2)), qint64(2));
+        QCOMPARE(qint64(provider.seek(4, SEEK_SET)), qint64(4));
+        QCOMPARE(qint64(provider.write("cd", 2)), qint64(2));
+        QCOMPARE(output, QByteArray("ab\0\0cd", 6));
+        QCOMPARE(qint64(provider.seek(1, SEEK_SET)), qint64(1));
+        QCOMPARE(qint64(provider.write("x", 1)), qint64(1));
+        QCOMPARE(output, QByteArray("ax\0\0cd", 6));
+    }
+};
+
+QTEST_GUILESS_MAIN(DataProviderTest)
+
+#include "t-dataprovider.moc"
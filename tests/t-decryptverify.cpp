@@ -37,10 +37,17 @@
 
 #include "t-support.h"
 
+#include <batchdecryptverifyjob.h>
+#include <bulkfiledecryptverifyjob.h>
 #include <protocol.h>
 #include <decryptverifyjob.h>
+#include <securebufferpool.h>
 
 #include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 
 #include <gpgme++/decryptionresult.h>
@@ -50,6 +57,8 @@
 using namespace QGpgME;
 using namespace GpgME;
 
+Q_DECLARE_METATYPE(QGpgME::BulkFileJob::FailurePolicy)
+
 static const char encryptedText[] =
 "-----BEGIN PGP MESSAGE-----\n"
 "\n"
@@ -125,6 +134,132 @@ private Q_SLOTS:
         QCOMPARE(verificationResult.error().code(), int{GPG_ERR_NO_DATA});
         QCOMPARE(verificationResult.numSignatures(), 0u);
     }
+
+    void testBulkFileDecryptVerify_data()
+    {
+        QTest::addColumn<BulkFileJob::FailurePolicy>("policy");
+        QTest::newRow("continue on error") << BulkFileJob::ContinueOnError;
+        QTest::newRow("stop on error") << BulkFileJob::StopOnError;
+    }
+
+    void testBulkFileDecryptVerify()
+    {
+        QFETCH(BulkFileJob::FailurePolicy, policy);
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        std::vector<std::pair<QString, QString>> files;
+        for (int i = 0; i < 5; ++i) {
+            const QString fileName = dir.filePath(QStringLiteral("file%1.txt.gpg").arg(i));
+            QFile file{fileName};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            // the second file is not encrypted
+            file.write(i == 1 ? QByteArray{"not encrypted"} : QByteArray{encryptedText});
+            files.push_back({fileName, dir.filePath(QStringLiteral("file%1.txt").arg(i))});
+        }
+
+        auto job = new BulkFileDecryptVerifyJob{GpgME::OpenPGP};
+        job->setFiles(files);
+        job->setFailurePolicy(policy);
+        // with one thread the files are processed in order
+        job->setMaxThreads(1);
+        job->setContextSetupFunction([this](Context *ctx) {
+            hookUpPassphraseProvider(ctx);
+        });
+        Error error;
+        std::vector<BulkFileDecryptVerifyJob::FileResult> results;
+        connect(job, &BulkFileDecryptVerifyJob::result, this, [this, &error, &results](const Error &err, const std::vector<BulkFileDecryptVerifyJob::FileResult> &res) {
+            error = err;
+            results = res;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(!job->startIt());
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+        QCOMPARE(results.size(), files.size());
+        QVERIFY(error.code());
+        QCOMPARE(error.code(), results[1].error.code());
+        QVERIFY(!QFile::exists(files[1].second));
+        QCOMPARE(results[0].error.code(), int{GPG_ERR_NO_ERROR});
+        QCOMPARE(results[0].numSignatures, 0);
+        QVERIFY(QFile::exists(files[0].second));
+        for (size_t i = 2; i < files.size(); ++i) {
+            if (policy == BulkFileJob::ContinueOnError) {
+                QCOMPARE(results[i].error.code(), int{GPG_ERR_NO_ERROR});
+                QVERIFY(QFile::exists(files[i].second));
+            } else {
+                QCOMPARE(results[i].error.code(), int{GPG_ERR_CANCELED});
+                QVERIFY(!QFile::exists(files[i].second));
+            }
+        }
+    }
+
+    void testBatchDecryptVerify()
+    {
+        const std::vector<QByteArray> cipherTexts{
+            QByteArray{encryptedText},
+            QByteArray{"not encrypted"},
+            QByteArray{encryptedText},
+            QByteArray{encryptedText},
+            QByteArray{encryptedText},
+        };
+        SecureBufferPool pool;
+
+        auto job = new BatchDecryptVerifyJob{GpgME::OpenPGP};
+        job->setCipherTexts(static_cast<int>(cipherTexts.size()), [&cipherTexts](int index) {
+            return cipherTexts[index];
+        });
+        job->setOutputBufferPool(&pool);
+        job->setChunkSize(2);
+        job->setMaxThreads(2);
+        job->setContextSetupFunction([this](Context *ctx) {
+            hookUpPassphraseProvider(ctx);
+        });
+        QMutex mutex;
+        std::vector<QByteArray> handledPlainTexts(cipherTexts.size());
+        job->setPlainTextHandler([&mutex, &handledPlainTexts](int index, const SecureBuffer &plainText) {
+            QMutexLocker locker{&mutex};
+            handledPlainTexts[index] = plainText.toByteArray();
+        });
+        std::vector<int> chunkStarts;
+        connect(job, &BatchDecryptVerifyJob::chunkDecrypted, this, [&chunkStarts](int firstIndex,
+                                                                                  const std::vector<DecryptionResult> &,
+                                                                                  const std::vector<VerificationResult> &,
+                                                                                  const std::vector<QByteArray> &) {
+            chunkStarts.push_back(firstIndex);
+        });
+        Error error;
+        std::vector<DecryptionResult> decryptionResults;
+        std::vector<QByteArray> plainTexts;
+        connect(job, &BatchDecryptVerifyJob::result, this, [this, &error, &decryptionResults, &plainTexts](const Error &err,
+                                                                                                         const std::vector<DecryptionResult> &res,
+                                                                                                         const std::vector<VerificationResult> &,
+                                                                                                         const std::vector<QByteArray> &pt) {
+            error = err;
+            decryptionResults = res;
+            plainTexts = pt;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(!job->startIt());
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+        /* The message that is not encrypted doesn't affect the other messages */
+        QCOMPARE(decryptionResults.size(), cipherTexts.size());
+        QVERIFY(error.code());
+        QCOMPARE(error.code(), decryptionResults[1].error().code());
+        for (size_t i : {0, 2, 3, 4}) {
+            QCOMPARE(decryptionResults[i].error().code(), int{GPG_ERR_NO_ERROR});
+            QVERIFY(!handledPlainTexts[i].isEmpty());
+            QCOMPARE(handledPlainTexts[i], handledPlainTexts[0]);
+            /* The plain texts were passed to the handler */
+            QVERIFY(plainTexts[i].isEmpty());
+        }
+        QVERIFY(chunkStarts == (std::vector<int>{0, 2, 4}));
+        QVERIFY(pool.statistics().acquisitions >= cipherTexts.size());
+        QCOMPARE(pool.statistics().bytesInUse, qint64{0});
+    }
 };
 
 QTEST_MAIN(DecryptVerifyTest)
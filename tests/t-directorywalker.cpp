@@ -0,0 +1,220 @@
+/*
+    t-directorywalker.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <directorywalker.h>
+#include <filelistdataprovider.h>
+#include <filetreescanner.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+using namespace QGpgME;
+
+static QStringList walk(DirectoryWalker &walker)
+{
+    QStringList result;
+    for (QString path = walker.next(); !path.isEmpty(); path = walker.next()) {
+        result.push_back(path);
+    }
+    result.sort();
+    return result;
+}
+
+class DirectoryWalkerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    void createFile(const QString &path)
+    {
+        QFile file{mDir->filePath(path)};
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("x");
+    }
+
+private Q_SLOTS:
+    void init()
+    {
+        mDir.reset(new QTemporaryDir);
+        QVERIFY(mDir->isValid());
+        QDir dir{mDir->path()};
+        QVERIFY(dir.mkpath(QStringLiteral("tree/sub/subsub")));
+        QVERIFY(dir.mkpath(QStringLiteral("tree/empty")));
+        QVERIFY(dir.mkpath(QStringLiteral("tree/.hidden")));
+        createFile(QStringLiteral("tree/a.txt"));
+        createFile(QStringLiteral("tree/b.tmp"));
+        createFile(QStringLiteral("tree/sub/c.txt"));
+        createFile(QStringLiteral("tree/sub/subsub/d.txt"));
+        createFile(QStringLiteral("tree/.hidden/e.txt"));
+    }
+
+    void cleanup()
+    {
+        mDir.reset();
+    }
+
+    void testWalkReturnsFilesAndEmptyDirectories()
+    {
+        DirectoryWalker walker{{QStringLiteral("tree")}};
+        walker.setBaseDirectory(mDir->path());
+        const QStringList expected = {
+            QStringLiteral("tree/.hidden/e.txt"),
+            QStringLiteral("tree/a.txt"),
+            QStringLiteral("tree/b.tmp"),
+            QStringLiteral("tree/empty"),
+            QStringLiteral("tree/sub/c.txt"),
+            QStringLiteral("tree/sub/subsub/d.txt"),
+        };
+        QCOMPARE(walk(walker), expected);
+        QCOMPARE(walker.count(), qint64(expected.size()));
+    }
+
+    void testFilters()
+    {
+        DirectoryWalker walker{{QStringLiteral("tree")}};
+        walker.setBaseDirectory(mDir->path());
+        walker.setIncludeHidden(false);
+        walker.setNameFilters({QStringLiteral("*.txt")});
+        walker.setExcludeFilters({QStringLiteral("subsub")});
+        walker.setFilter([](const QFileInfo &fi) {
+            return fi.fileName() != QLatin1String("c.txt");
+        });
+        const QStringList expected = {
+            QStringLiteral("tree/a.txt"),
+            QStringLiteral("tree/empty"),
+        };
+        QCOMPARE(walk(walker), expected);
+    }
+
+    void testSymlinkPolicies()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("This test requires symbolic links");
+#endif
+        QVERIFY(QFile::link(QStringLiteral("sub"), mDir->filePath(QStringLiteral("tree/link"))));
+        // a cycle
+        QVERIFY(QFile::link(QStringLiteral(".."), mDir->filePath(QStringLiteral("tree/sub/subsub/up"))));
+
+        DirectoryWalker walker{{QStringLiteral("tree/sub")}};
+        walker.setBaseDirectory(mDir->path());
+
+        walker.setSymlinkPolicy(DirectoryWalker::SkipSymlinks);
+        QCOMPARE(walk(walker), (QStringList{QStringLiteral("tree/sub/c.txt"), QStringLiteral("tree/sub/subsub/d.txt")}));
+
+        DirectoryWalker keepWalker{{QStringLiteral("tree/sub")}};
+        keepWalker.setBaseDirectory(mDir->path());
+        QCOMPARE(walk(keepWalker), (QStringList{QStringLiteral("tree/sub/c.txt"),
+                                                QStringLiteral("tree/sub/subsub/d.txt"),
+                                                QStringLiteral("tree/sub/subsub/up")}));
+
+        DirectoryWalker followWalker{{QStringLiteral("tree/link")}};
+        followWalker.setBaseDirectory(mDir->path());
+        followWalker.setSymlinkPolicy(DirectoryWalker::FollowSymlinks);
+        // the cycle back to tree/sub is not followed
+        QCOMPARE(walk(followWalker), (QStringList{QStringLiteral("tree/link/c.txt"), QStringLiteral("tree/link/subsub/d.txt")}));
+    }
+
+    void testFileListDataProviderWithGenerator()
+    {
+        DirectoryWalker walker{{QStringLiteral("tree/sub")}};
+        walker.setBaseDirectory(mDir->path());
+        FileListDataProvider provider{[&walker]() { return walker.next(); }};
+        GpgME::DataProvider &dp = provider;
+
+        QCOMPARE(qint64(dp.seek(0, SEEK_SET)), qint64(0));
+        QByteArray data;
+        char buffer[5];
+        qint64 numRead;
+        while ((numRead = dp.read(buffer, sizeof(buffer))) > 0) {
+            data.append(buffer, numRead);
+        }
+        QCOMPARE(numRead, qint64(0));
+        QList<QByteArray> filenames = data.split('\0');
+        std::sort(filenames.begin(), filenames.end());
+        QCOMPARE(filenames, (QList<QByteArray>{"tree/sub/c.txt", "tree/sub/subsub/d.txt"}));
+        QCOMPARE(qint64(dp.seek(0, SEEK_SET)), qint64(-1));
+    }
+
+    void testScannerFindsSameFilesAsWalker()
+    {
+        for (int i = 0; i < 50; ++i) {
+            const QString dir = QStringLiteral("tree/many/dir%1").arg(i);
+            QVERIFY(QDir{mDir->path()}.mkpath(dir));
+            for (int j = 0; j < 10; ++j) {
+                createFile(dir + QStringLiteral("/file%1").arg(j));
+            }
+        }
+
+        DirectoryWalker walker{{QStringLiteral("tree")}};
+        walker.setBaseDirectory(mDir->path());
+        walker.setExcludeFilters({QStringLiteral("*.tmp")});
+        const QStringList expected = walk(walker);
+
+        FileTreeScanner scanner{{QStringLiteral("tree")}};
+        scanner.setBaseDirectory(mDir->path());
+        scanner.setExcludeFilters({QStringLiteral("*.tmp")});
+        scanner.setThreadCount(8);
+        const auto result = scanner.scan();
+
+        QCOMPARE(QStringList(result.paths.cbegin(), result.paths.cend()), expected);
+        // all paths except for the empty directory are files with 1 byte each
+        QCOMPARE(result.fileCount, qint64(expected.size() - 1));
+        QCOMPARE(result.totalBytes, result.fileCount);
+        QCOMPARE(result.directoryCount, qint64(1 + 4 + 1 + 50));
+        QVERIFY(!result.canceled);
+
+        // a cancel() before the scan stops the next scan
+        scanner.cancel();
+        const auto canceledResult = scanner.scan();
+        QVERIFY(canceledResult.canceled);
+        QVERIFY(canceledResult.paths.size() < result.paths.size());
+
+        // and only the next scan
+        QVERIFY(!scanner.scan().canceled);
+    }
+
+private:
+    std::unique_ptr<QTemporaryDir> mDir;
+};
+
+QTEST_GUILESS_MAIN(DirectoryWalkerTest)
+
+#include "t-directorywalker.moc"
@@ -34,14 +34,26 @@
 #endif
 
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointer>
 #include <QTest>
 #include <QTemporaryDir>
 #include <QSignalSpy>
 #include <QBuffer>
+#include <QRandomGenerator>
+#include "batchencryptjob.h"
+#include "batchsignencryptjob.h"
+#include "batchsignjob.h"
+#include "bulkfileencryptjob.h"
 #include "keylistjob.h"
+#include "encryptionrecipients.h"
 #include "encryptjob.h"
+#include "fanoutencryptjob.h"
 #include "signencryptjob.h"
 #include <gpgme++/signingresult.h>
+#include <gpgme++/verificationresult.h>
 #include "encryptjob.h"
 #include <gpgme++/encryptionresult.h>
 #include <gpgme++/decryptionresult.h>
@@ -50,6 +62,9 @@
 #include <gpgme++/keylistresult.h>
 #include <gpgme++/engineinfo.h>
 #include "verifyopaquejob.h"
+#include "dataprovider.h"
+#include "securebufferdataprovider.h"
+#include "securebufferpool.h"
 #include "t-support.h"
 
 #define PROGRESS_TEST_SIZE 1 * 1024 * 1024
@@ -57,12 +72,49 @@
 using namespace QGpgME;
 using namespace GpgME;
 
+// a buffer that pretends to be a sequential device like a pipe or a socket
+class SequentialBuffer : public QBuffer
+{
+public:
+    using QBuffer::QBuffer;
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+};
 
 
 class EncryptionTest : public QGpgMETest
 {
     Q_OBJECT
 
+    /* Returns the keys matching the patterns; each pattern must match one key */
+    std::vector<Key> listKeys(const QStringList &patterns, bool secretOnly = false)
+    {
+        std::unique_ptr<KeyListJob> job{openpgp()->keyListJob(false, false, false)};
+        std::vector<Key> keys;
+        const auto result = job->exec(patterns, secretOnly, keys);
+        VERIFY_OR_OBJECT(!result.error());
+        COMPARE_OR_OBJECT(keys.size(), static_cast<size_t>(patterns.size()));
+        return keys;
+    }
+
+    std::vector<Key> alfaKeys(bool secretOnly = false)
+    {
+        return listKeys({QStringLiteral("alfa@example.net")}, secretOnly);
+    }
+
+    /* Starts the job with startIt() and waits until it has emitted its
+     * result; done() is emitted right before result() */
+    bool startAndWait(QGpgME::Job *job)
+    {
+        QSignalSpy spy{job, &QGpgME::Job::done};
+        VERIFY_OR_FALSE(!job->startIt());
+        VERIFY_OR_FALSE(spy.wait(QSIGNALSPY_TIMEOUT));
+        return true;
+    }
+
 private Q_SLOTS:
 
     void testSimpleEncryptDecrypt()
@@ -97,6 +149,144 @@ private Q_SLOTS:
         delete decJob;
     }
 
+    void testEncryptDecryptWithReusedOutputBuffer()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        QByteArray cipherText;
+        cipherText.reserve(4096);
+        const char *buffer = cipherText.constData();
+        for (const auto &message : {QByteArrayLiteral("Hello World"), QByteArrayLiteral("Hello again")}) {
+            auto job = openpgp()->encryptJob(/*ASCII Armor */true, /* Textmode */ true);
+            QVERIFY(job);
+            QByteArraySinkDataProvider sink{cipherText};
+            auto result = job->exec(keys, message, Context::AlwaysTrust, sink);
+            delete job;
+            QVERIFY(!result.error());
+            QVERIFY(cipherText.startsWith("-----BEGIN PGP MESSAGE-----"));
+            // the ciphertext was written into the memory reserved by the caller
+            QCOMPARE(cipherText.constData(), buffer);
+
+            if (!loopbackSupported()) {
+                continue;
+            }
+            auto decJob = openpgp()->decryptJob();
+            hookUpPassphraseProvider(decJob);
+            QByteArray plainText;
+            auto decResult = decJob->exec(cipherText, plainText);
+            QVERIFY(!decResult.error());
+            QCOMPARE(plainText, message);
+            delete decJob;
+        }
+    }
+
+    void testDetectIncompressibleInput()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        QByteArray randomData(64 * 1024, Qt::Uninitialized);
+        QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(randomData.data()), randomData.size() / sizeof(quint32));
+        const QByteArray pngData = QByteArrayLiteral("\x89PNG\r\n\x1A\n") + QByteArray(1024, 'x');
+        const QByteArray textData = QByteArray{"The quick brown fox jumps over the lazy dog.\n"}.repeated(1024);
+
+        const auto encrypt = [&keys](const QByteArray &plainText, bool detect) {
+            std::unique_ptr<EncryptJob> job{openpgp()->encryptJob()};
+            job->setDetectIncompressibleInput(detect);
+            QByteArray cipherText;
+            const auto result = job->exec(keys, plainText, Context::AlwaysTrust, cipherText);
+            return std::make_pair(!result.error() && !cipherText.isEmpty(), job->incompressibleInputDetected());
+        };
+        QCOMPARE(encrypt(randomData, true), std::make_pair(true, true));
+        QCOMPARE(encrypt(pngData, true), std::make_pair(true, true));
+        QCOMPARE(encrypt(textData, true), std::make_pair(true, false));
+        /* Nothing is probed if the detection is disabled */
+        QCOMPARE(encrypt(randomData, false), std::make_pair(true, false));
+
+        /* The input file is probed if the job is started with startIt() */
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString inputFile = dir.filePath(QStringLiteral("random.bin"));
+        {
+            QFile file{inputFile};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(randomData);
+        }
+        auto job = openpgp()->encryptJob();
+        job->setRecipients(keys);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setInputFile(inputFile);
+        job->setOutputFile(inputFile + QLatin1String{".gpg"});
+        job->setDetectIncompressibleInput(true);
+        Error error;
+        bool detected = false;
+        connect(job, &EncryptJob::result, this, [job, &error, &detected](const EncryptionResult &result) {
+            error = result.error();
+            detected = job->incompressibleInputDetected();
+        });
+        QVERIFY(startAndWait(job));
+        QVERIFY(!error);
+        QVERIFY(detected);
+        QVERIFY(QFile::exists(inputFile + QLatin1String{".gpg"}));
+    }
+
+    void testEncryptionRecipients()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        auto recipients = std::make_shared<EncryptionRecipients>(GpgME::OpenPGP, keys);
+        QVERIFY(!recipients->validate());
+        QCOMPARE(recipients->statistics().validations, quint64(1));
+        QCOMPARE(recipients->validatedKeys().size(), size_t(1));
+        QCOMPARE(QByteArray{recipients->validatedKeys().front().primaryFingerprint()}, QByteArray{keys.front().primaryFingerprint()});
+        QCOMPARE(recipients->allKeysValid(), recipients->invalidKeys().empty());
+        QCOMPARE(recipients->encryptionSubkeyFingerprints().size(), size_t(1));
+        QVERIFY(!recipients->encryptionSubkeyFingerprints().front().isEmpty());
+
+        /* The jobs use the result of the validation */
+        for (int i = 0; i < 2; ++i) {
+            std::unique_ptr<EncryptJob> job{openpgp()->encryptJob()};
+            job->setEncryptionRecipients(recipients);
+            QByteArray cipherText;
+            const auto result = job->exec(std::vector<Key>{}, QByteArrayLiteral("Hello World"), Context::AlwaysTrust, cipherText);
+            QVERIFY(!result.error());
+            QVERIFY(!cipherText.isEmpty());
+        }
+        QCOMPARE(recipients->statistics().validations, quint64(1));
+        QCOMPARE(recipients->statistics().reuses, quint64(2));
+
+        recipients->invalidate();
+        QVERIFY(!recipients->validate());
+        QCOMPARE(recipients->statistics().validations, quint64(2));
+    }
+
+    void testDecryptIntoSecureBuffer()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        auto job = openpgp()->encryptJob(/*ASCII Armor */false, /* Textmode */ false);
+        QByteArray cipherText;
+        auto result = job->exec(keys, QByteArrayLiteral("Hello Secure World"), Context::AlwaysTrust, cipherText);
+        delete job;
+        QVERIFY(!result.error());
+
+        SecureBuffer plainText;
+        auto decJob = openpgp()->decryptJob();
+        hookUpPassphraseProvider(decJob);
+        SecureBufferDataProvider sink{plainText};
+        auto decResult = decJob->exec(cipherText, sink);
+        delete decJob;
+        QVERIFY(!decResult.error());
+        QCOMPARE(plainText.toByteArray(), QByteArrayLiteral("Hello Secure World"));
+        QCOMPARE(plainText.pool(), SecureBufferPool::instance());
+    }
+
     void testProgress()
     {
         if (GpgME::engineInfo(GpgME::GpgEngine).engineVersion() < "2.1.15") {
@@ -166,6 +356,48 @@ private Q_SLOTS:
         QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
     }
 
+    void testProgressWithSizeHintForSequentialInput()
+    {
+        if (GpgME::engineInfo(GpgME::GpgEngine).engineVersion() < "2.1.15") {
+            return;
+        }
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        auto job = openpgp()->encryptJob(/*ASCII Armor */false, /* Textmode */ false);
+        QVERIFY(job);
+        job->setInputSizeHint(PROGRESS_TEST_SIZE);
+        QCOMPARE(job->inputSizeHint(), qint64(PROGRESS_TEST_SIZE));
+        QByteArray plainBa;
+        plainBa.fill('X', PROGRESS_TEST_SIZE);
+        QByteArray cipherText;
+
+        bool finishSeen = false;
+        connect(job, &Job::jobProgress, this, [&finishSeen] (int current, int total) {
+                QVERIFY(total == PROGRESS_TEST_SIZE);
+                if (current == total) {
+                    finishSeen = true;
+                }
+            });
+        connect(job, &EncryptJob::result, this, [this, &finishSeen] (const GpgME::EncryptionResult &result,
+                                                                    const QByteArray &,
+                                                                    const QString,
+                                                                    const GpgME::Error) {
+                QVERIFY(!result.error());
+                QVERIFY(finishSeen);
+                Q_EMIT asyncDone();
+            });
+
+        auto inptr  = std::shared_ptr<QIODevice>(new SequentialBuffer(&plainBa));
+        inptr->open(QIODevice::ReadOnly);
+        auto outptr = std::shared_ptr<QIODevice>(new QBuffer(&cipherText));
+        outptr->open(QIODevice::WriteOnly);
+
+        job->start(keys, inptr, outptr, Context::AlwaysTrust);
+        QSignalSpy spy (this, SIGNAL(asyncDone()));
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+    }
+
     void testSymmetricEncryptDecrypt()
     {
         if (!loopbackSupported()) {
@@ -251,6 +483,378 @@ private Q_SLOTS:
         QVERIFY(verified == QStringLiteral("Hello World"));
     }
 
+    void testBatchEncrypt()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        std::vector<QByteArray> plainTexts;
+        for (int i = 0; i < 10; ++i) {
+            plainTexts.push_back("Message " + QByteArray::number(i));
+        }
+
+        auto job = new BatchEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setPlainTexts(plainTexts);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setArmor(true);
+        job->setMaxThreads(3);
+        Error error;
+        std::vector<EncryptionResult> results;
+        std::vector<QByteArray> cipherTexts;
+        connect(job, &BatchEncryptJob::result, this, [&error, &results, &cipherTexts](const Error &err,
+                                                                                     const std::vector<EncryptionResult> &res,
+                                                                                     const std::vector<QByteArray> &ct) {
+            error = err;
+            results = res;
+            cipherTexts = ct;
+        });
+        QVERIFY(startAndWait(job));
+
+        QVERIFY(!error);
+        QCOMPARE(results.size(), plainTexts.size());
+        QCOMPARE(cipherTexts.size(), plainTexts.size());
+        for (size_t i = 0; i < plainTexts.size(); ++i) {
+            QVERIFY(!results[i].error());
+            QVERIFY(cipherTexts[i].startsWith("-----BEGIN PGP MESSAGE-----"));
+        }
+
+        /* Check that the cipher texts are in the order of the messages */
+        if (!loopbackSupported()) {
+            return;
+        }
+        for (size_t i : {size_t(0), plainTexts.size() - 1}) {
+            std::unique_ptr<DecryptJob> decJob{openpgp()->decryptJob()};
+            hookUpPassphraseProvider(decJob.get());
+            QByteArray plainText;
+            auto decResult = decJob->exec(cipherTexts[i], plainText);
+            QVERIFY(!decResult.error());
+            QCOMPARE(plainText, plainTexts[i]);
+        }
+    }
+
+    void testContextSetupFunctionOverridesJobSettings()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        auto job = new BatchEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setPlainTexts({"Message 1", "Message 2"});
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setArmor(false);
+        job->setContextSetupFunction([](Context *ctx) {
+            ctx->setArmor(true);
+        });
+        std::vector<QByteArray> cipherTexts;
+        connect(job, &BatchEncryptJob::result, this, [&cipherTexts](const Error &,
+                                                                   const std::vector<EncryptionResult> &,
+                                                                   const std::vector<QByteArray> &ct) {
+            cipherTexts = ct;
+        });
+        QVERIFY(startAndWait(job));
+
+        QCOMPARE(cipherTexts.size(), size_t(2));
+        for (const auto &cipherText : cipherTexts) {
+            QVERIFY(cipherText.startsWith("-----BEGIN PGP MESSAGE-----"));
+        }
+    }
+
+    void testDeleteRunningBatchJob()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        std::vector<QByteArray> plainTexts(200, QByteArray(16 * 1024, 'x'));
+        auto job = new BatchEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setPlainTexts(plainTexts);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setMaxThreads(2);
+        bool resultEmitted = false;
+        connect(job, &BatchEncryptJob::result, this, [&resultEmitted]() {
+            resultEmitted = true;
+        });
+        QPointer<BatchJob> guard{job};
+        QSignalSpy progressSpy{job, &Job::jobProgress};
+        QVERIFY(!job->startIt());
+        QVERIFY(progressSpy.wait(QSIGNALSPY_TIMEOUT));
+
+        /* Deleting the job while messages are processed waits for the threads */
+        QVERIFY(guard);
+        delete job;
+        QVERIFY(!resultEmitted);
+    }
+
+    void testFanOutEncrypt()
+    {
+        const auto keys = listKeys({QStringLiteral("alfa@example.net"), QStringLiteral("bravo@example.net")});
+        QVERIFY(!keys.empty());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString inputFile = dir.filePath(QStringLiteral("document.txt"));
+        const QByteArray document = QByteArray{"A document for everybody.\n"}.repeated(100);
+        {
+            QFile file{inputFile};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(document);
+        }
+
+        const std::vector<Key> recipients{keys[0], keys[1], keys[0], keys[1]};
+        // the cipher texts for the odd recipients are written to sinks
+        std::vector<QByteArray> sinkOutputs(recipients.size());
+        auto job = new FanOutEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(recipients);
+        job->setInputFile(inputFile);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setMaxThreads(2);
+        job->setCipherTextSink([&sinkOutputs](int index) -> std::unique_ptr<DataProvider> {
+            if (index % 2 == 0) {
+                return {};
+            }
+            return std::make_unique<QByteArraySinkDataProvider>(sinkOutputs[index]);
+        });
+        Error error;
+        std::vector<EncryptionResult> results;
+        std::vector<QByteArray> cipherTexts;
+        connect(job, &FanOutEncryptJob::result, this, [&error, &results, &cipherTexts](const Error &err,
+                                                                                      const std::vector<EncryptionResult> &res,
+                                                                                      const std::vector<QByteArray> &ct) {
+            error = err;
+            results = res;
+            cipherTexts = ct;
+        });
+        QVERIFY(startAndWait(job));
+
+        QVERIFY(!error);
+        QCOMPARE(results.size(), recipients.size());
+        QCOMPARE(cipherTexts.size(), recipients.size());
+        for (size_t i = 0; i < recipients.size(); ++i) {
+            QVERIFY(!results[i].error());
+            QCOMPARE(cipherTexts[i].isEmpty(), i % 2 == 1);
+            QCOMPARE(sinkOutputs[i].isEmpty(), i % 2 == 0);
+        }
+
+        /* Check that the copy for alfa contains the document */
+        if (!loopbackSupported()) {
+            return;
+        }
+        std::unique_ptr<DecryptJob> decJob{openpgp()->decryptJob()};
+        hookUpPassphraseProvider(decJob.get());
+        QByteArray plainText;
+        auto decResult = decJob->exec(cipherTexts[0], plainText);
+        QVERIFY(!decResult.error());
+        QCOMPARE(plainText, document);
+    }
+
+    void testFanOutEncryptMissingInputFile()
+    {
+        const auto keys = listKeys({QStringLiteral("alfa@example.net"), QStringLiteral("bravo@example.net")});
+        QVERIFY(!keys.empty());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto job = new FanOutEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setInputFile(dir.filePath(QStringLiteral("missing.txt")));
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        Error error;
+        std::vector<EncryptionResult> results;
+        connect(job, &FanOutEncryptJob::result, this, [&error, &results](const Error &err,
+                                                                        const std::vector<EncryptionResult> &res) {
+            error = err;
+            results = res;
+        });
+        // the file is opened by the worker threads, so the job starts
+        QVERIFY(startAndWait(job));
+
+        QCOMPARE(error.code(), static_cast<int>(GPG_ERR_ENOENT));
+        QCOMPARE(results.size(), keys.size());
+        for (const auto &result : results) {
+            QCOMPARE(result.error().code(), static_cast<int>(GPG_ERR_ENOENT));
+        }
+    }
+
+    void testBatchSignAndSignEncrypt()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        const auto keys = alfaKeys(/* secretOnly= */ true);
+        QVERIFY(!keys.empty());
+
+        std::vector<QByteArray> plainTexts;
+        for (int i = 0; i < 6; ++i) {
+            plainTexts.push_back("Notification " + QByteArray::number(i));
+        }
+
+        {
+            auto job = new BatchSignJob{GpgME::OpenPGP};
+            job->setSigners(keys);
+            job->setPlainTexts(plainTexts);
+            job->setArmor(true);
+            job->setMaxThreads(2);
+            job->setContextSetupFunction([this](Context *ctx) {
+                hookUpPassphraseProvider(ctx);
+            });
+            Error error;
+            std::vector<QByteArray> signedData;
+            BatchJob::SigningSummary summary;
+            connect(job, &BatchSignJob::result, this, [&error, &signedData, &summary](const Error &err,
+                                                                                    const std::vector<SigningResult> &,
+                                                                                    const std::vector<QByteArray> &data,
+                                                                                    const BatchJob::SigningSummary &sum) {
+                error = err;
+                signedData = data;
+                summary = sum;
+            });
+            QVERIFY(startAndWait(job));
+
+            QVERIFY(!error);
+            QCOMPARE(summary.signedMessages, static_cast<int>(plainTexts.size()));
+            QCOMPARE(summary.failedMessages, 0);
+            QCOMPARE(static_cast<int>(summary.signerFingerprints.size()), 1);
+            QCOMPARE(summary.signerFingerprints.front(), QByteArray{keys.front().primaryFingerprint()});
+            QCOMPARE(signedData.size(), plainTexts.size());
+
+            /* Check that the signed messages are in the order of the messages */
+            std::unique_ptr<VerifyOpaqueJob> verifyJob{openpgp()->verifyOpaqueJob()};
+            QByteArray plainText;
+            auto verifyResult = verifyJob->exec(signedData.back(), plainText);
+            QVERIFY(!verifyResult.error());
+            QCOMPARE(static_cast<int>(verifyResult.numSignatures()), 1);
+            QCOMPARE(plainText, plainTexts.back());
+        }
+
+        {
+            auto job = new BatchSignEncryptJob{GpgME::OpenPGP};
+            job->setSigners(keys);
+            job->setRecipients(keys);
+            job->setPlainTexts(plainTexts);
+            job->setEncryptionFlags(Context::AlwaysTrust);
+            job->setArmor(true);
+            job->setMaxThreads(2);
+            job->setContextSetupFunction([this](Context *ctx) {
+                hookUpPassphraseProvider(ctx);
+            });
+            Error error;
+            std::vector<QByteArray> cipherTexts;
+            BatchJob::SigningSummary summary;
+            connect(job, &BatchSignEncryptJob::result, this, [&error, &cipherTexts, &summary](const Error &err,
+                                                                                            const std::vector<SigningResult> &,
+                                                                                            const std::vector<EncryptionResult> &,
+                                                                                            const std::vector<QByteArray> &ct,
+                                                                                            const BatchJob::SigningSummary &sum) {
+                error = err;
+                cipherTexts = ct;
+                summary = sum;
+            });
+            QVERIFY(startAndWait(job));
+
+            QVERIFY(!error);
+            QCOMPARE(summary.signedMessages, static_cast<int>(plainTexts.size()));
+            QCOMPARE(summary.failedMessages, 0);
+            QCOMPARE(cipherTexts.size(), plainTexts.size());
+            for (const auto &cipherText : cipherTexts) {
+                QVERIFY(cipherText.startsWith("-----BEGIN PGP MESSAGE-----"));
+            }
+        }
+    }
+
+    void testBulkFileEncrypt()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        std::vector<std::pair<QString, QString>> files;
+        for (int i = 0; i < 8; ++i) {
+            const QString fileName = dir.filePath(QStringLiteral("file%1.txt").arg(i));
+            QFile file{fileName};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QByteArray::number(i));
+            files.push_back({fileName, fileName + QLatin1String{".gpg"}});
+        }
+        // an existing output file is not overwritten
+        {
+            QFile file{files[3].second};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+
+        auto job = new BulkFileEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setFiles(files);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setMaxThreads(3);
+        std::vector<int> progress;
+        connect(job, &BulkFileJob::fileProgress, this, [&progress](int current, int) {
+            progress.push_back(current);
+        });
+        Error error;
+        std::vector<EncryptionResult> results;
+        connect(job, &BulkFileEncryptJob::result, this, [&error, &results](const Error &err, const std::vector<EncryptionResult> &res) {
+            error = err;
+            results = res;
+        });
+        QVERIFY(startAndWait(job));
+
+        QCOMPARE(error.code(), static_cast<int>(GPG_ERR_EEXIST));
+        QCOMPARE(results.size(), files.size());
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (i == 3) {
+                QCOMPARE(results[i].error().code(), static_cast<int>(GPG_ERR_EEXIST));
+                QCOMPARE(QFileInfo{files[i].second}.size(), qint64(0));
+            } else {
+                QVERIFY(!results[i].error());
+                QVERIFY(QFileInfo{files[i].second}.size() > 0);
+            }
+        }
+        QCOMPARE(progress.size(), files.size());
+        QCOMPARE(progress.back(), int(files.size()));
+        // no temporary files are left behind
+        QCOMPARE(QDir{dir.path()}.entryList({QStringLiteral("*.part")}, QDir::Files).size(), 0);
+    }
+
+    void testDeleteRunningBulkFileJob()
+    {
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        std::vector<std::pair<QString, QString>> files;
+        for (int i = 0; i < 50; ++i) {
+            const QString fileName = dir.filePath(QStringLiteral("file%1.txt").arg(i));
+            QFile file{fileName};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QByteArray(64 * 1024, 'a' + i % 26));
+            files.push_back({fileName, fileName + QLatin1String{".gpg"}});
+        }
+
+        auto job = new BulkFileEncryptJob{GpgME::OpenPGP};
+        job->setRecipients(keys);
+        job->setFiles(files);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        job->setMaxThreads(2);
+        bool resultEmitted = false;
+        connect(job, &BulkFileEncryptJob::result, this, [&resultEmitted]() {
+            resultEmitted = true;
+        });
+        QPointer<BulkFileJob> guard{job};
+        QSignalSpy progressSpy{job, &BulkFileJob::fileProgress};
+        QVERIFY(!job->startIt());
+        QVERIFY(progressSpy.wait(QSIGNALSPY_TIMEOUT));
+
+        /* Deleting the job while files are processed waits for the threads */
+        QVERIFY(guard);
+        delete job;
+        QVERIFY(!resultEmitted);
+        // the files that were processed when the job was deleted are cleaned up
+        QCOMPARE(QDir{dir.path()}.entryList({QStringLiteral("*.part")}, QDir::Files).size(), 0);
+    }
+
 private:
     /* Loopback and passphrase provider don't work for mixed encryption.
      * So this test is disabled until gnupg(?) is fixed for this. */
@@ -0,0 +1,87 @@
+/*
+    t-filemanifest.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <filemanifest_p.h>
+
+#include <QTest>
+
+using namespace QGpgME::_detail;
+
+class FileManifestTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testManifestRoundTrip()
+    {
+        FileManifest manifest;
+        manifest.algorithm = QCryptographicHash::Sha512;
+        manifest.entries.push_back({QStringLiteral("release/foo-1.0.tar.gz"), 1000, QByteArray(128, 'a')});
+        manifest.entries.push_back({QStringLiteral("release/name with spaces %.txt"), 0, QByteArray(128, 'b')});
+
+        FileManifest parsed;
+        QVERIFY(FileManifest::fromByteArray(manifest.toByteArray(), parsed));
+        QCOMPARE(parsed.algorithm, QCryptographicHash::Sha512);
+        QCOMPARE(parsed.entries.size(), size_t(2));
+        QCOMPARE(parsed.entries[0].path, QStringLiteral("release/foo-1.0.tar.gz"));
+        QCOMPARE(parsed.entries[0].size, qint64(1000));
+        QCOMPARE(parsed.entries[0].checksum, QByteArray(128, 'a'));
+        QCOMPARE(parsed.entries[1].path, QStringLiteral("release/name with spaces %.txt"));
+        QCOMPARE(parsed.toByteArray(), manifest.toByteArray());
+    }
+
+    void testManifestRejectsInvalidEntries()
+    {
+        const QByteArray header = "QGpgME-File-Manifest: 1\nHash: SHA256\n";
+        const QByteArray hash(64, 'a');
+        FileManifest parsed;
+        QVERIFY(FileManifest::fromByteArray(header + hash + " 1 foo\n", parsed));
+        // files outside of the base directory
+        QVERIFY(!FileManifest::fromByteArray(header + hash + " 1 ../secret\n", parsed));
+        QVERIFY(!FileManifest::fromByteArray(header + hash + " 1 /etc/passwd\n", parsed));
+        QVERIFY(!FileManifest::fromByteArray(header + hash + " 1 a/../../secret\n", parsed));
+        // checksum of the wrong algorithm
+        QVERIFY(!FileManifest::fromByteArray(header + QByteArray(128, 'a') + " 1 foo\n", parsed));
+        QVERIFY(!FileManifest::fromByteArray(header + hash + " -1 foo\n", parsed));
+        QVERIFY(!FileManifest::fromByteArray("QGpgME-File-Manifest: 1\nHash: MD5\n" + hash + " 1 foo\n", parsed));
+        QVERIFY(!FileManifest::fromByteArray(header, parsed));
+        QVERIFY(!FileManifest::fromByteArray("Something else\n", parsed));
+    }
+};
+
+QTEST_GUILESS_MAIN(FileManifestTest)
+
+#include "t-filemanifest.moc"
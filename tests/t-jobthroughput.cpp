@@ -0,0 +1,134 @@
+/*
+    t-jobthroughput.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <dataprovider.h>
+#include <jobthroughput.h>
+
+#include <QBuffer>
+#include <QTest>
+#include <QThread>
+
+#include <gpgme++/data.h>
+
+#include <memory>
+
+using namespace QGpgME;
+
+class JobThroughputTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testEmptySnapshot()
+    {
+        const JobThroughput throughput;
+        const auto snapshot = throughput.snapshot();
+        QCOMPARE(snapshot.processedBytes, qint64(0));
+        QCOMPARE(snapshot.etaMSecs, qint64(-1));
+        QVERIFY(!snapshot.stalled);
+        QVERIFY(!snapshot.finished);
+    }
+
+    void testRateAndEta()
+    {
+        JobThroughput throughput;
+        throughput.setTotalBytes(10000);
+        for (int i = 1; i <= 6; ++i) {
+            QThread::msleep(100);
+            throughput.setProcessedBytes(i * 100);
+        }
+        const auto snapshot = throughput.snapshot();
+        QCOMPARE(snapshot.processedBytes, qint64(600));
+        QCOMPARE(snapshot.totalBytes, qint64(10000));
+        QVERIFY(snapshot.bytesPerSecond > 0);
+        QVERIFY(snapshot.etaMSecs > 0);
+        QVERIFY(snapshot.elapsedMSecs >= 500);
+
+        // values from an earlier phase don't decrease the progress
+        throughput.setProcessedBytes(10);
+        QCOMPARE(throughput.snapshot().processedBytes, qint64(600));
+
+        throughput.setProcessedBytes(10000);
+        QCOMPARE(throughput.snapshot().etaMSecs, qint64(0));
+    }
+
+    void testBlockedTimeAndStall()
+    {
+        JobThroughput throughput;
+        throughput.setStallTimeout(100);
+        throughput.beginWait(JobThroughput::WaitingForInput);
+        QThread::msleep(200);
+        auto snapshot = throughput.snapshot();
+        QVERIFY(snapshot.inputBlockedMSecs >= 150);
+        QCOMPARE(snapshot.outputBlockedMSecs, qint64(0));
+        // waiting for input is not a stall of the engine
+        QVERIFY(!snapshot.stalled);
+        throughput.endWait(JobThroughput::WaitingForInput);
+
+        QThread::msleep(200);
+        QVERIFY(throughput.snapshot().stalled);
+        throughput.addProcessedBytes(1);
+        QVERIFY(!throughput.snapshot().stalled);
+
+        throughput.finish();
+        snapshot = throughput.snapshot();
+        QVERIFY(snapshot.finished);
+        QVERIFY(!snapshot.stalled);
+        QCOMPARE(snapshot.etaMSecs, qint64(0));
+    }
+
+    void testFedByDataProvider()
+    {
+        const auto throughput = std::make_shared<JobThroughput>();
+        const auto buffer = std::make_shared<QBuffer>();
+        buffer->setData(QByteArray(5000, 'x'));
+        QVERIFY(buffer->open(QIODevice::ReadWrite));
+        QIODeviceDataProvider provider{buffer};
+        provider.setThroughput(throughput);
+        GpgME::Data data{&provider};
+        char chunk[1000];
+        while (data.read(chunk, sizeof(chunk)) > 0) {
+        }
+        QCOMPARE(throughput->snapshot().processedBytes, qint64(5000));
+
+        data.write("abc", 3);
+        QCOMPARE(throughput->snapshot().processedBytes, qint64(5000));
+    }
+};
+
+QTEST_GUILESS_MAIN(JobThroughputTest)
+
+#include "t-jobthroughput.moc"
@@ -38,6 +38,7 @@
 #include <QTest>
 #include <QSignalSpy>
 #include <QMap>
+#include "keylistcoalescing.h"
 #include "keylistjob.h"
 #include "listallkeysjob.h"
 #include "qgpgmebackend.h"
@@ -138,6 +139,56 @@ private Q_SLOTS:
         QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
     }
 
+    void testKeyListCoalescing()
+    {
+        KeyListCoalescing::setEnabled(true);
+        KeyListCoalescing::resetStatistics();
+
+        /* Identical jobs started while the first one is running wait for its result */
+        const int numJobs = 4;
+        int numResults = 0;
+        std::vector<std::vector<Key>> results;
+        for (int i = 0; i < numJobs; ++i) {
+            KeyListJob *job = openpgp()->keyListJob();
+            connect(job, &KeyListJob::result, this, [this, &numResults, &results](const KeyListResult &result, const std::vector<Key> &keys) {
+                QVERIFY(!result.error());
+                results.push_back(keys);
+                if (++numResults == numJobs + 1) {
+                    Q_EMIT asyncDone();
+                }
+            });
+            QVERIFY(!job->start(QStringList() << QStringLiteral("alfa@example.net")));
+        }
+        /* A job with different patterns is not coalesced */
+        KeyListJob *job = openpgp()->keyListJob();
+        std::vector<Key> otherKeys;
+        connect(job, &KeyListJob::result, this, [this, &numResults, &otherKeys](const KeyListResult &, const std::vector<Key> &keys) {
+            otherKeys = keys;
+            if (++numResults == numJobs + 1) {
+                Q_EMIT asyncDone();
+            }
+        });
+        QVERIFY(!job->start(QStringList() << QStringLiteral("bravo@example.net")));
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+        KeyListCoalescing::setEnabled(false);
+
+        QCOMPARE(results.size(), static_cast<size_t>(numJobs));
+        for (const auto &keys : results) {
+            QCOMPARE(keys.size(), static_cast<size_t>(1));
+            QCOMPARE(QByteArray{keys.front().primaryFingerprint()}, QByteArray{results.front().front().primaryFingerprint()});
+        }
+        QCOMPARE(otherKeys.size(), static_cast<size_t>(1));
+        QVERIFY(QByteArray{otherKeys.front().primaryFingerprint()} != QByteArray{results.front().front().primaryFingerprint()});
+
+        const auto statistics = KeyListCoalescing::statistics();
+        QCOMPARE(statistics.requests, quint64(numJobs + 1));
+        QVERIFY(statistics.coalescedRequests >= 1);
+        QVERIFY(statistics.coalescedRequests < quint64(numJobs));
+        QCOMPARE(statistics.inFlightRequests, 0);
+    }
+
     void testListAllKeysSync()
     {
         const auto accumulateFingerprints = [](std::vector<std::string> &v, const Key &key) { v.push_back(std::string(key.primaryFingerprint())); return v; };
@@ -0,0 +1,175 @@
+/*
+    t-pipedataprovider.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <pipedataprovider.h>
+
+#include <QTest>
+
+#include <gpgme++/error.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class PipeDataProviderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testTransferThroughSmallPipe()
+    {
+        auto pipe = PipeDataProvider::createPipe(4096);
+        DataProvider *reader = pipe.first.get();
+        DataProvider *writer = pipe.second.get();
+
+        QByteArray input(1024 * 1024, Qt::Uninitialized);
+        for (int i = 0; i < input.size(); ++i) {
+            input[i] = static_cast<char>(i % 251);
+        }
+
+        bool writeOk = true;
+        std::thread writerThread{[&]() {
+            // write in chunks of odd sizes to exercise the wrap-around
+            for (int pos = 0; pos < input.size(); pos += 3001) {
+                const int chunk = std::min(3001, input.size() - pos);
+                writeOk = writeOk && qint64(writer->write(input.constData() + pos, chunk)) == chunk;
+            }
+            writer->release();
+        }};
+
+        QByteArray output;
+        char buffer[1000];
+        qint64 numRead;
+        while ((numRead = reader->read(buffer, sizeof(buffer))) > 0) {
+            output.append(buffer, numRead);
+        }
+        writerThread.join();
+
+        QCOMPARE(numRead, qint64(0));
+        QVERIFY(writeOk);
+        QCOMPARE(output, input);
+    }
+
+    void testReaderGetsEOFAfterBufferedData()
+    {
+        auto pipe = PipeDataProvider::createPipe();
+        DataProvider *reader = pipe.first.get();
+        DataProvider *writer = pipe.second.get();
+
+        QCOMPARE(qint64(writer->write("foo", 3)), qint64(3));
+        pipe.second->close();
+
+        char buffer[10];
+        QCOMPARE(qint64(reader->read(buffer, sizeof(buffer))), qint64(3));
+        QCOMPARE(QByteArray(buffer, 3), QByteArray("foo"));
+        QCOMPARE(qint64(reader->read(buffer, sizeof(buffer))), qint64(0));
+    }
+
+    void testWriterFailsIfReaderIsClosed()
+    {
+        auto pipe = PipeDataProvider::createPipe(4096);
+        DataProvider *writer = pipe.second.get();
+
+        std::thread readerThread{[&]() {
+            char buffer[100];
+            static_cast<DataProvider *>(pipe.first.get())->read(buffer, sizeof(buffer));
+            pipe.first->close();
+        }};
+
+        // more than fits into the buffer; the write blocks until the reader is closed
+        const QByteArray data(100000, 'x');
+        const qint64 written = writer->write(data.constData(), data.size());
+        const auto code = Error::fromSystemError().code();
+        readerThread.join();
+
+        QCOMPARE(written, qint64(-1));
+        QCOMPARE(code, int(GPG_ERR_EPIPE));
+    }
+
+    void testCloseWithErrorIsPropagated()
+    {
+        auto pipe = PipeDataProvider::createPipe();
+        DataProvider *reader = pipe.first.get();
+        DataProvider *writer = pipe.second.get();
+
+        QCOMPARE(qint64(writer->write("foo", 3)), qint64(3));
+        pipe.second->closeWithError(Error::fromCode(GPG_ERR_CANCELED));
+
+        char buffer[10];
+        QCOMPARE(qint64(reader->read(buffer, sizeof(buffer))), qint64(-1));
+        QCOMPARE(Error::fromSystemError().code(), int(GPG_ERR_CANCELED));
+    }
+
+    void testSeekIsNotSupported()
+    {
+        auto pipe = PipeDataProvider::createPipe();
+        DataProvider *reader = pipe.first.get();
+
+        QVERIFY(reader->isSupported(DataProvider::Read));
+        QVERIFY(!reader->isSupported(DataProvider::Write));
+        QVERIFY(!reader->isSupported(DataProvider::Seek));
+        QCOMPARE(qint64(reader->seek(0, SEEK_SET)), qint64(-1));
+    }
+
+    void testDevicePipe()
+    {
+        auto pipe = PipeDataProvider::createDevicePipe(4096);
+        const auto reader = pipe.first;
+        const auto writer = pipe.second;
+        QVERIFY(reader->isOpen() && reader->isReadable() && reader->isSequential());
+        QVERIFY(writer->isOpen() && writer->isWritable());
+
+        const QByteArray input(50000, 'y');
+        qint64 written = 0;
+        std::thread writerThread{[&]() {
+            written = writer->write(input);
+            writer->close();
+        }};
+
+        const QByteArray output = reader->readAll();
+        writerThread.join();
+
+        QCOMPARE(written, qint64(input.size()));
+        QCOMPARE(output, input);
+        QVERIFY(reader->atEnd());
+    }
+};
+
+QTEST_GUILESS_MAIN(PipeDataProviderTest)
+
+#include "t-pipedataprovider.moc"
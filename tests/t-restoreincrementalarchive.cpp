@@ -0,0 +1,288 @@
+/*
+    t-restoreincrementalarchive.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "t-support.h"
+
+#include <changeownertrustjob.h>
+#include <decryptjob.h>
+#include <encryptjob.h>
+#include <keylistjob.h>
+#include <protocol.h>
+#include <restoreincrementalarchivejob.h>
+#include <signencryptarchivejob.h>
+#include <signencryptjob.h>
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/keylistresult.h>
+#include <gpgme++/signingresult.h>
+#include <gpgme++/verificationresult.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+class RestoreIncrementalArchiveTest : public QGpgMETest
+{
+    Q_OBJECT
+
+private:
+    std::vector<Key> listKeys(const QString &pattern, bool secretOnly = false)
+    {
+        std::unique_ptr<KeyListJob> job{openpgp()->keyListJob(false, false, false)};
+        std::vector<Key> keys;
+        const auto result = job->exec({pattern}, secretOnly, keys);
+        VERIFY_OR_OBJECT(!result.error());
+        COMPARE_OR_OBJECT(keys.size(), size_t(1));
+        return keys;
+    }
+
+    std::vector<Key> alfaKeys(bool secretOnly = false)
+    {
+        return listKeys(QStringLiteral("alfa@example.net"), secretOnly);
+    }
+
+    std::vector<Key> zuluKeys(bool secretOnly = false)
+    {
+        return listKeys(QStringLiteral("zulu@example.net"), secretOnly);
+    }
+
+    bool setOwnerTrust(const Key &key, Key::OwnerTrust trust)
+    {
+        auto job = openpgp()->changeOwnerTrustJob();
+        Error error;
+        connect(job, &ChangeOwnerTrustJob::result, this, [this, &error](const Error &err) {
+            error = err;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_FALSE(!job->start(key, trust));
+        VERIFY_OR_FALSE(spy.wait(QSIGNALSPY_TIMEOUT));
+        VERIFY_OR_FALSE(!error);
+        return true;
+    }
+
+    /* The restore job decrypts without passphrase provider; decrypt once with
+     * the passphrase provider, so that gpg-agent has cached the passphrase */
+    bool cachePassphrase()
+    {
+        std::unique_ptr<EncryptJob> encryptJob{openpgp()->encryptJob(false, false)};
+        QByteArray cipherText;
+        VERIFY_OR_FALSE(!encryptJob->exec(alfaKeys(), "Hello", Context::AlwaysTrust, cipherText).error());
+        std::unique_ptr<DecryptJob> decryptJob{openpgp()->decryptJob()};
+        hookUpPassphraseProvider(decryptJob.get());
+        QByteArray plainText;
+        VERIFY_OR_FALSE(!decryptJob->exec(cipherText, plainText).error());
+        return true;
+    }
+
+    bool writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile file{path};
+        VERIFY_OR_FALSE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        COMPARE_OR_FALSE(file.write(content), qint64(content.size()));
+        return true;
+    }
+
+    bool createArchive(const QString &archiveFile)
+    {
+        auto job = openpgp()->signEncryptArchiveJob();
+        hookUpPassphraseProvider(job);
+        job->setSigners(alfaKeys(/* secretOnly= */ true));
+        job->setRecipients(alfaKeys());
+        job->setInputPaths({QStringLiteral("tree")});
+        job->setBaseDirectory(mDir->path());
+        job->setOutputFile(archiveFile);
+        job->setIncrementalManifestFile(mDir->filePath(QStringLiteral("manifest")));
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        Error error;
+        connect(job, &SignEncryptArchiveJob::result, this, [this, &error](const SigningResult &signingResult, const EncryptionResult &encryptionResult) {
+            error = signingResult.error() ? signingResult.error() : encryptionResult.error();
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_FALSE(!job->startIt());
+        VERIFY_OR_FALSE(spy.wait(QSIGNALSPY_TIMEOUT));
+        VERIFY_OR_FALSE(!error);
+        return true;
+    }
+
+    /* Creates a full archive of tree and an incremental archive after
+     * tree/b.txt has been removed and tree/d.txt has been added */
+    bool createArchives()
+    {
+        VERIFY_OR_FALSE(createArchive(mArchives[0]));
+        VERIFY_OR_FALSE(QFile::remove(mDir->filePath(QStringLiteral("tree/b.txt"))));
+        VERIFY_OR_FALSE(writeFile(mDir->filePath(QStringLiteral("tree/d.txt")), "delta"));
+        VERIFY_OR_FALSE(createArchive(mArchives[1]));
+        VERIFY_OR_FALSE(QFile::exists(mArchives[1] + QStringLiteral(".deletions.gpg")));
+        return true;
+    }
+
+    /* Replaces the list of removed paths of the incremental archive */
+    bool replaceDeletions(const std::vector<Key> &signers, const QByteArray &deletions)
+    {
+        std::unique_ptr<SignEncryptJob> job{openpgp()->signEncryptJob(false, false)};
+        hookUpPassphraseProvider(job.get());
+        QByteArray cipherText;
+        const auto result = job->exec(signers, alfaKeys(), deletions, true, cipherText);
+        VERIFY_OR_FALSE(!result.first.error());
+        VERIFY_OR_FALSE(!result.second.error());
+        const QString deletionsFile = mArchives[1] + QStringLiteral(".deletions.gpg");
+        VERIFY_OR_FALSE(QFile::remove(deletionsFile));
+        VERIFY_OR_FALSE(writeFile(deletionsFile, cipherText));
+        return true;
+    }
+
+    Error restore(const QString &outputDirectory, const std::vector<Key> &trustedSigners = {})
+    {
+        auto job = new RestoreIncrementalArchiveJob{openpgp()};
+        job->setArchiveFiles(mArchives);
+        job->setOutputDirectory(outputDirectory);
+        job->setTrustedSigners(trustedSigners);
+        Error error;
+        connect(job, &RestoreIncrementalArchiveJob::result, this, [this, &error](const Error &err) {
+            error = err;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_RETURN_VALUE(!job->startIt(), Error::fromCode(GPG_ERR_GENERAL));
+        VERIFY_OR_RETURN_VALUE(spy.wait(QSIGNALSPY_TIMEOUT), Error::fromCode(GPG_ERR_TIMEOUT));
+        return error;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QGpgMETest::initTestCase();
+        // trust alfa's key, so that the signatures of the archives are valid
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+        QVERIFY(setOwnerTrust(keys.front(), Key::Ultimate));
+    }
+
+    void init()
+    {
+        if (!SignEncryptArchiveJob::isSupported() || !loopbackSupported()) {
+            QSKIP("gpgtar or loopback pinentry is not supported");
+        }
+        QVERIFY(cachePassphrase());
+        mDir.reset(new QTemporaryDir);
+        QVERIFY(mDir->isValid());
+        QVERIFY(QDir{mDir->path()}.mkpath(QStringLiteral("tree/sub")));
+        QVERIFY(writeFile(mDir->filePath(QStringLiteral("tree/a.txt")), "alfa"));
+        QVERIFY(writeFile(mDir->filePath(QStringLiteral("tree/b.txt")), "bravo"));
+        QVERIFY(writeFile(mDir->filePath(QStringLiteral("tree/sub/c.txt")), "charlie"));
+        mArchives = {mDir->filePath(QStringLiteral("archive0.tar.gpg")), mDir->filePath(QStringLiteral("archive1.tar.gpg"))};
+    }
+
+    void cleanup()
+    {
+        mDir.reset();
+    }
+
+    void testSignedDeletionsAreApplied()
+    {
+        QVERIFY(createArchives());
+
+        const QString out = mDir->filePath(QStringLiteral("out"));
+        QVERIFY(!restore(out));
+        QVERIFY(QFile::exists(out + QStringLiteral("/tree/a.txt")));
+        QVERIFY(!QFile::exists(out + QStringLiteral("/tree/b.txt")));
+        QVERIFY(QFile::exists(out + QStringLiteral("/tree/sub/c.txt")));
+        QVERIFY(QFile::exists(out + QStringLiteral("/tree/d.txt")));
+    }
+
+    void testDeletionsOfOtherSignersAreRejected()
+    {
+        QVERIFY(createArchives());
+        const auto zulu = zuluKeys();
+        QVERIFY(!zulu.empty());
+        QVERIFY(replaceDeletions(zuluKeys(/* secretOnly= */ true), "tree/b.txt"));
+
+        // zulu's key is not trusted
+        const QString out1 = mDir->filePath(QStringLiteral("out1"));
+        QCOMPARE(restore(out1).code(), static_cast<int>(GPG_ERR_BAD_SIGNATURE));
+        QVERIFY(QFile::exists(out1 + QStringLiteral("/tree/b.txt")));
+        QVERIFY(!QFile::exists(out1 + QStringLiteral("/tree/d.txt")));
+
+        // zulu's key is trusted, but zulu didn't sign the archives
+        QVERIFY(setOwnerTrust(zulu.front(), Key::Ultimate));
+        const QString out2 = mDir->filePath(QStringLiteral("out2"));
+        QCOMPARE(restore(out2).code(), static_cast<int>(GPG_ERR_BAD_SIGNATURE));
+        QVERIFY(QFile::exists(out2 + QStringLiteral("/tree/b.txt")));
+
+        // unless zulu is explicitly allowed to sign the lists of removed paths
+        const QString out3 = mDir->filePath(QStringLiteral("out3"));
+        QVERIFY(!restore(out3, zulu));
+        QVERIFY(!QFile::exists(out3 + QStringLiteral("/tree/b.txt")));
+        QVERIFY(QFile::exists(out3 + QStringLiteral("/tree/d.txt")));
+
+        QVERIFY(setOwnerTrust(zulu.front(), Key::Unknown));
+    }
+
+    void testSymlinkedParentIsRejected()
+    {
+        QVERIFY(createArchives());
+        // the list is signed by the signer of the archives, but it refers to
+        // a file outside of the output directory via a symbolic link
+        QVERIFY(replaceDeletions(alfaKeys(/* secretOnly= */ true), QByteArray{"tree/b.txt\0link/secret.txt", 26}));
+
+        const QString outside = mDir->filePath(QStringLiteral("outside"));
+        QVERIFY(QDir{}.mkpath(outside));
+        QVERIFY(writeFile(outside + QStringLiteral("/secret.txt"), "secret"));
+        const QString out = mDir->filePath(QStringLiteral("out"));
+        QVERIFY(QDir{}.mkpath(out));
+        QVERIFY(QFile::link(outside, out + QStringLiteral("/link")));
+
+        QCOMPARE(restore(out).code(), static_cast<int>(GPG_ERR_INV_NAME));
+        QVERIFY(QFile::exists(outside + QStringLiteral("/secret.txt")));
+        // nothing was removed
+        QVERIFY(QFile::exists(out + QStringLiteral("/tree/b.txt")));
+    }
+
+private:
+    std::unique_ptr<QTemporaryDir> mDir;
+    std::vector<QString> mArchives;
+};
+
+QTEST_MAIN(RestoreIncrementalArchiveTest)
+
+#include "t-restoreincrementalarchive.moc"
@@ -0,0 +1,152 @@
+/*
+    t-securebufferpool.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <securebufferdataprovider.h>
+#include <securebufferpool.h>
+
+#include <QTest>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace QGpgME;
+
+class SecureBufferPoolTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testBuffersAreRoundedUpToSizeClasses()
+    {
+        SecureBufferPool pool;
+        QCOMPARE(pool.acquire(1).capacity(), qint64(4096));
+        QCOMPARE(pool.acquire(4096).capacity(), qint64(4096));
+        QCOMPARE(pool.acquire(4097).capacity(), qint64(8192));
+        QCOMPARE(pool.acquire(100000).capacity(), qint64(128 * 1024));
+    }
+
+    void testReleasedBuffersAreWipedAndReused()
+    {
+        SecureBufferPool pool;
+        const char *memory = nullptr;
+        {
+            SecureBuffer buffer = pool.acquire(1000);
+            QVERIFY(!buffer.isNull());
+            QCOMPARE(buffer.size(), qint64(0));
+            buffer.resize(1000);
+            memset(buffer.data(), 'x', 1000);
+            memory = buffer.constData();
+        }
+        auto stats = pool.statistics();
+        QCOMPARE(stats.bytesInUse, qint64(0));
+        QCOMPARE(stats.pooledBytes, qint64(4096));
+
+        SecureBuffer buffer = pool.acquire(2000);
+        QCOMPARE(buffer.constData(), memory);
+        buffer.resize(buffer.capacity());
+        QVERIFY(std::all_of(buffer.constData(), buffer.constData() + buffer.size(), [](char c) { return c == 0; }));
+
+        stats = pool.statistics();
+        QCOMPARE(stats.acquisitions, quint64(2));
+        QCOMPARE(stats.hits, quint64(1));
+        QCOMPARE(stats.misses, quint64(1));
+        QCOMPARE(stats.pooledBytes, qint64(0));
+        QCOMPARE(stats.bytesInUse, qint64(4096));
+        QCOMPARE(stats.highWaterMark, qint64(4096));
+        QCOMPARE(stats.lockedBytes + qint64(stats.lockFailures) * 4096, qint64(4096));
+    }
+
+    void testHighWaterMarkAndTrim()
+    {
+        SecureBufferPool pool;
+        {
+            SecureBuffer a = pool.acquire(4096);
+            SecureBuffer b = pool.acquire(8192);
+            QCOMPARE(pool.statistics().highWaterMark, qint64(4096 + 8192));
+        }
+        QCOMPARE(pool.statistics().highWaterMark, qint64(4096 + 8192));
+        QCOMPARE(pool.statistics().pooledBytes, qint64(4096 + 8192));
+
+        pool.trim();
+        const auto stats = pool.statistics();
+        QCOMPARE(stats.pooledBytes, qint64(0));
+        QCOMPARE(stats.lockedBytes, qint64(0));
+    }
+
+    void testPoolSizeIsLimited()
+    {
+        SecureBufferPool pool;
+        pool.setMaxPooledBytes(4096);
+        {
+            SecureBuffer a = pool.acquire(4096);
+            SecureBuffer b = pool.acquire(4096);
+        }
+        QCOMPARE(pool.statistics().pooledBytes, qint64(4096));
+    }
+
+    void testDataProviderGrowsBuffer()
+    {
+        SecureBufferPool pool;
+        SecureBuffer buffer = pool.acquire(0);
+        const QByteArray chunk(3000, 'x');
+        {
+            SecureBufferDataProvider dp{buffer};
+            GpgME::DataProvider &provider = dp;
+            for (int i = 0; i < 10; ++i) {
+                QCOMPARE(qint64(provider.write(chunk.constData(), chunk.size())), qint64(chunk.size()));
+            }
+            provider.release();
+        }
+        QCOMPARE(buffer.size(), qint64(10 * chunk.size()));
+        QCOMPARE(buffer.capacity(), qint64(32 * 1024));
+        QCOMPARE(buffer.pool(), &pool);
+        QCOMPARE(buffer.toByteArray(), chunk.repeated(10));
+
+        // the content of a reused buffer is wiped
+        {
+            SecureBufferDataProvider dp{buffer};
+            QCOMPARE(buffer.size(), qint64(0));
+            GpgME::DataProvider &provider = dp;
+            QCOMPARE(qint64(provider.write("abc", 3)), qint64(3));
+        }
+        QCOMPARE(buffer.toByteArray(), QByteArray{"abc"});
+        QCOMPARE(buffer.capacity(), qint64(32 * 1024));
+    }
+};
+
+QTEST_GUILESS_MAIN(SecureBufferPoolTest)
+
+#include "t-securebufferpool.moc"
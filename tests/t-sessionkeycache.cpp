@@ -0,0 +1,219 @@
+/*
+    t-sessionkeycache.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "t-support.h"
+
+#include <decryptjob.h>
+#include <encryptjob.h>
+#include <protocol.h>
+#include <securebufferpool.h>
+#include <sessionkeycache.h>
+
+#include <QTest>
+
+#include <memory>
+
+#include <gpgme++/context.h>
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/key.h>
+
+using namespace QGpgME;
+using namespace GpgME;
+
+static const char encryptedText[] =
+"-----BEGIN PGP MESSAGE-----\n"
+"\n"
+"jA0ECQMCnJt+DX+RJJH90kIBCYlu/LYn57TCNO+O8kYwe4jcyEIaHqSZuvO50nFE\n"
+"hQy9p33Y5VwP6uDOYOKxr1W6iE4GvbX+5UNKYdjjPL0m1ak=\n"
+"=hgKY\n"
+"-----END PGP MESSAGE-----\n";
+
+class SessionKeyCacheTest : public QGpgMETest
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testLeastRecentlyUsedSessionKeyIsEvicted()
+    {
+        SessionKeyCache cache;
+        cache.setMaxEntries(2);
+        QVERIFY(cache.insert("a", "9:AAAA"));
+        QVERIFY(cache.insert("b", "9:BBBB"));
+        // use "a", so that "b" is the least recently used session key
+        QCOMPARE(QByteArray{cache.find("a").constData()}, QByteArray{"9:AAAA"});
+        QVERIFY(cache.insert("c", "9:CCCC"));
+
+        QVERIFY(cache.find("b").isNull());
+        QCOMPARE(QByteArray{cache.find("a").constData()}, QByteArray{"9:AAAA"});
+        QCOMPARE(QByteArray{cache.find("c").constData()}, QByteArray{"9:CCCC"});
+
+        const auto stats = cache.statistics();
+        QCOMPARE(stats.entries, 2);
+        QCOMPARE(stats.insertions, quint64(3));
+        QCOMPARE(stats.evictions, quint64(1));
+        QCOMPARE(stats.lookups, quint64(4));
+        QCOMPARE(stats.hits, quint64(3));
+        QCOMPARE(stats.misses, quint64(1));
+        QCOMPARE(stats.hitRate, 0.75);
+    }
+
+    void testReducingTheMaximumKeepsTheMostRecentSessionKeys()
+    {
+        SessionKeyCache cache;
+        QVERIFY(cache.insert("a", "9:AAAA"));
+        QVERIFY(cache.insert("b", "9:BBBB"));
+        QVERIFY(cache.insert("c", "9:CCCC"));
+        cache.setMaxEntries(1);
+        QCOMPARE(cache.statistics().entries, 1);
+        QCOMPARE(QByteArray{cache.find("c").constData()}, QByteArray{"9:CCCC"});
+        QVERIFY(cache.insert("a", "9:AAAA"));
+        QVERIFY(cache.find("c").isNull());
+    }
+
+    void testInvalidSessionKeysAreNotCached()
+    {
+        SessionKeyCache cache;
+        QVERIFY(!cache.insert("a", ""));
+        QVERIFY(!cache.insert("a", nullptr));
+        const QByteArray tooLong(SessionKeyCache::MaxSessionKeyLength + 1, 'A');
+        QVERIFY(!cache.insert("a", tooLong.constData()));
+        QCOMPARE(cache.statistics().entries, 0);
+    }
+
+    void testRemoveAndClear()
+    {
+        SessionKeyCache cache;
+        QVERIFY(cache.insert("a", "9:AAAA"));
+        QVERIFY(cache.insert("b", "9:BBBB"));
+        cache.remove("a");
+        QVERIFY(cache.find("a").isNull());
+        QVERIFY(!cache.find("b").isNull());
+        cache.clear();
+        QVERIFY(cache.find("b").isNull());
+        QCOMPARE(cache.statistics().entries, 0);
+        QVERIFY(cache.insert("b", "9:BBBB"));
+        QVERIFY(!cache.find("b").isNull());
+    }
+
+    void testDecryptWithCachedSessionKey()
+    {
+        const QByteArray cipherText{encryptedText};
+        auto cache = std::make_shared<SessionKeyCache>();
+
+        QByteArray firstPlainText;
+        {
+            std::unique_ptr<DecryptJob> job{openpgp()->decryptJob()};
+            hookUpPassphraseProvider(job.get());
+            job->setSessionKeyCache(cache);
+            const auto result = job->exec(cipherText, firstPlainText);
+            QCOMPARE(result.error().code(), int{GPG_ERR_NO_ERROR});
+        }
+        QCOMPARE(cache->statistics().insertions, quint64(1));
+        QVERIFY(!cache->find(SessionKeyCache::messageId(cipherText)).isNull());
+
+        /* The second decryption doesn't need the passphrase */
+        QByteArray secondPlainText;
+        {
+            std::unique_ptr<DecryptJob> job{openpgp()->decryptJob()};
+            job->setSessionKeyCache(cache);
+            const auto result = job->exec(cipherText, secondPlainText);
+            QCOMPARE(result.error().code(), int{GPG_ERR_NO_ERROR});
+        }
+        QCOMPARE(secondPlainText, firstPlainText);
+        QCOMPARE(cache->statistics().hits, quint64(2));
+    }
+
+    void testReusedJobDoesNotUseTheSessionKeyOfThePreviousMessage()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        QByteArray otherCipherText;
+        {
+            std::unique_ptr<EncryptJob> job{openpgp()->encryptJob()};
+            hookUpPassphraseProvider(job.get());
+            Job::context(job.get())->setArmor(true);
+            const auto result = job->exec(std::vector<Key>(), QByteArray{"Another message"}, Context::AlwaysTrust, otherCipherText);
+            QVERIFY(!result.error());
+        }
+
+        const QByteArray cipherText{encryptedText};
+        auto cache = std::make_shared<SessionKeyCache>();
+        std::unique_ptr<DecryptJob> job{openpgp()->decryptJob()};
+        hookUpPassphraseProvider(job.get());
+        job->setSessionKeyCache(cache);
+        QByteArray plainText;
+        QVERIFY(!job->exec(cipherText, plainText).error());
+        QVERIFY(!job->exec(cipherText, plainText).error());
+        QCOMPARE(cache->statistics().hits, quint64(1));
+
+        /* The session key of the previous message must not be used for a
+         * message that isn't in the cache */
+        const auto result = job->exec(otherCipherText, plainText);
+        QCOMPARE(result.error().code(), int{GPG_ERR_NO_ERROR});
+        QCOMPARE(plainText, QByteArray{"Another message"});
+        QCOMPARE(cache->statistics().entries, 2);
+    }
+
+    void testDecryptWithSecretKeyIfCachedSessionKeyFails()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        const QByteArray cipherText{encryptedText};
+        const QByteArray messageId = SessionKeyCache::messageId(cipherText);
+        const QByteArray wrongSessionKey = "9:" + QByteArray(64, '0');
+        auto cache = std::make_shared<SessionKeyCache>();
+        QVERIFY(cache->insert(messageId, wrongSessionKey.constData()));
+
+        std::unique_ptr<DecryptJob> job{openpgp()->decryptJob()};
+        hookUpPassphraseProvider(job.get());
+        job->setSessionKeyCache(cache);
+        QByteArray plainText;
+        const auto result = job->exec(cipherText, plainText);
+        QCOMPARE(result.error().code(), int{GPG_ERR_NO_ERROR});
+        QVERIFY(!plainText.isEmpty());
+
+        /* The wrong session key has been replaced by the right one */
+        const auto sessionKey = cache->find(messageId);
+        QVERIFY(!sessionKey.isNull());
+        QVERIFY(QByteArray{sessionKey.constData()} != wrongSessionKey);
+    }
+};
+
+QTEST_MAIN(SessionKeyCacheTest)
+#include "t-sessionkeycache.moc"
@@ -0,0 +1,300 @@
+/*
+    t-shardedarchive.cpp
+
+    This file is part of qgpgme, the Qt API binding for gpgme
+    Copyright (c) 2026 g10 Code GmbH
+
+    QGpgME is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    QGpgME is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+    In addition, as a special exception, the copyright holders give
+    permission to link the code of this program with any edition of
+    the Qt library by Trolltech AS, Norway (or with modified versions
+    of Qt that use the same license as Qt), and distribute linked
+    combinations including the two.  You must obey the GNU General
+    Public License in all respects for all of the code used other than
+    Qt.  If you modify this file, you may extend this exception to
+    your version of the file, but you are not obligated to do so.  If
+    you do not wish to do so, delete this exception statement from
+    your version.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "t-support.h"
+
+#include <changeownertrustjob.h>
+#include <decryptjob.h>
+#include <decryptverifyarchivejob.h>
+#include <encryptarchivejob.h>
+#include <encryptjob.h>
+#include <keylistjob.h>
+#include <protocol.h>
+#include <shardedarchive_p.h>
+#include <shardeddecryptarchivejob.h>
+#include <shardedencryptarchivejob.h>
+#include <signjob.h>
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gpgme++/decryptionresult.h>
+#include <gpgme++/encryptionresult.h>
+#include <gpgme++/keylistresult.h>
+#include <gpgme++/signingresult.h>
+#include <gpgme++/verificationresult.h>
+
+using namespace QGpgME;
+using namespace QGpgME::_detail;
+using namespace GpgME;
+
+class ShardedArchiveTest : public QGpgMETest
+{
+    Q_OBJECT
+
+private:
+    std::vector<Key> alfaKeys(bool secretOnly = false)
+    {
+        std::unique_ptr<KeyListJob> job{openpgp()->keyListJob(false, false, false)};
+        std::vector<Key> keys;
+        const auto result = job->exec({QStringLiteral("alfa@example.net")}, secretOnly, keys);
+        VERIFY_OR_OBJECT(!result.error());
+        COMPARE_OR_OBJECT(keys.size(), size_t(1));
+        return keys;
+    }
+
+    /* The sharded jobs sign and decrypt without passphrase provider; sign and
+     * decrypt once with the passphrase provider, so that gpg-agent has cached
+     * the passphrases of the keys */
+    bool cachePassphrases()
+    {
+        const auto keys = alfaKeys(/* secretOnly= */ true);
+        VERIFY_OR_FALSE(!keys.empty());
+
+        std::unique_ptr<SignJob> signJob{openpgp()->signJob(true, true)};
+        hookUpPassphraseProvider(signJob.get());
+        QByteArray signature;
+        VERIFY_OR_FALSE(!signJob->exec(keys, "Hello", GpgME::Clearsigned, signature).error());
+
+        std::unique_ptr<EncryptJob> encryptJob{openpgp()->encryptJob(false, false)};
+        QByteArray cipherText;
+        VERIFY_OR_FALSE(!encryptJob->exec(keys, "Hello", Context::AlwaysTrust, cipherText).error());
+        std::unique_ptr<DecryptJob> decryptJob{openpgp()->decryptJob()};
+        hookUpPassphraseProvider(decryptJob.get());
+        QByteArray plainText;
+        VERIFY_OR_FALSE(!decryptJob->exec(cipherText, plainText).error());
+        COMPARE_OR_FALSE(plainText, QByteArray{"Hello"});
+        return true;
+    }
+
+    bool writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile file{path};
+        VERIFY_OR_FALSE(file.open(QIODevice::WriteOnly));
+        COMPARE_OR_FALSE(file.write(content), qint64(content.size()));
+        return true;
+    }
+
+    QByteArray readFile(const QString &path)
+    {
+        QFile file{path};
+        VERIFY_OR_OBJECT(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    /* Encrypts the files in mDir/tree into shards in mDir/shards and
+     * returns the path of the manifest */
+    QString encryptTree(int shardCount)
+    {
+        auto job = new ShardedEncryptArchiveJob{openpgp()};
+        job->setRecipients(alfaKeys());
+        job->setSigners(alfaKeys(/* secretOnly= */ true));
+        job->setInputPaths({QStringLiteral("tree")});
+        job->setBaseDirectory(mDir->path());
+        job->setOutputDirectory(mDir->filePath(QStringLiteral("shards")));
+        job->setShardCount(shardCount);
+        job->setEncryptionFlags(Context::AlwaysTrust);
+        Error error;
+        QString manifestFile;
+        connect(job, &ShardedEncryptArchiveJob::result, this, [this, &error, &manifestFile](const Error &err, const QString &file) {
+            error = err;
+            manifestFile = file;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_OBJECT(!job->startIt());
+        VERIFY_OR_OBJECT(spy.wait(QSIGNALSPY_TIMEOUT));
+        VERIFY_OR_OBJECT(!error);
+        VERIFY_OR_OBJECT(QFile::exists(manifestFile));
+        return manifestFile;
+    }
+
+    Error decryptArchive(const QString &manifestFile, VerificationResult &verificationResult)
+    {
+        auto job = new ShardedDecryptArchiveJob{openpgp()};
+        job->setManifestFile(manifestFile);
+        job->setOutputDirectory(mDir->filePath(QStringLiteral("out")));
+        Error error;
+        connect(job, &ShardedDecryptArchiveJob::result, this, [this, &error, &verificationResult](const Error &err, const VerificationResult &result) {
+            error = err;
+            verificationResult = result;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_RETURN_VALUE(!job->startIt(), Error::fromCode(GPG_ERR_GENERAL));
+        VERIFY_OR_RETURN_VALUE(spy.wait(QSIGNALSPY_TIMEOUT), Error::fromCode(GPG_ERR_TIMEOUT));
+        return error;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QGpgMETest::initTestCase();
+
+        // trust alfa's key, so that the signature of the manifest is valid
+        const auto keys = alfaKeys();
+        QVERIFY(!keys.empty());
+        auto job = openpgp()->changeOwnerTrustJob();
+        connect(job, &ChangeOwnerTrustJob::result, this, [this](const Error &err) {
+            QVERIFY(!err);
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(!job->start(keys.front(), Key::Ultimate));
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+    }
+
+    void init()
+    {
+        mDir.reset(new QTemporaryDir);
+        QVERIFY(mDir->isValid());
+        QVERIFY(QDir{mDir->path()}.mkpath(QStringLiteral("tree/sub")));
+        for (int i = 0; i < 6; ++i) {
+            QVERIFY(writeFile(mDir->filePath(QStringLiteral("tree/file%1.txt").arg(i)), QByteArray(100 * (i + 1), 'a' + i)));
+        }
+        QVERIFY(writeFile(mDir->filePath(QStringLiteral("tree/sub/file.txt")), "sub"));
+    }
+
+    void cleanup()
+    {
+        mDir.reset();
+    }
+
+    void testManifestRoundTrip()
+    {
+        const QByteArray hash(64, 'a');
+        ShardedArchiveManifest manifest;
+        manifest.shards.push_back({1000, hash, 10, 4000, QStringLiteral("archive.0.tar.gpg")});
+        manifest.shards.push_back({2000, hash, 20, 8000, QStringLiteral("my archive.1.tar.gpg")});
+
+        ShardedArchiveManifest parsed;
+        QVERIFY(ShardedArchiveManifest::fromByteArray(manifest.toByteArray(), parsed));
+        QCOMPARE(parsed.shards.size(), size_t(2));
+        QCOMPARE(parsed.shards[0].size, qint64(1000));
+        QCOMPARE(parsed.shards[0].sha256, hash);
+        QCOMPARE(parsed.shards[0].fileCount, qint64(10));
+        QCOMPARE(parsed.shards[0].bytes, qint64(4000));
+        QCOMPARE(parsed.shards[0].fileName, QStringLiteral("archive.0.tar.gpg"));
+        QCOMPARE(parsed.shards[1].bytes, qint64(8000));
+        QCOMPARE(parsed.shards[1].fileName, QStringLiteral("my archive.1.tar.gpg"));
+    }
+
+    void testManifestRejectsShardsOutsideOfManifestDirectory()
+    {
+        const QByteArray hash(64, 'a');
+        ShardedArchiveManifest parsed;
+        QVERIFY(!ShardedArchiveManifest::fromByteArray("QGpgME-Sharded-Archive: 1\nShard: 1 " + hash + " 1 1 ../secret\n", parsed));
+        QVERIFY(!ShardedArchiveManifest::fromByteArray("QGpgME-Sharded-Archive: 1\nShard: 1 " + hash + " 1 1 /etc/passwd\n", parsed));
+        QVERIFY(!ShardedArchiveManifest::fromByteArray("QGpgME-Sharded-Archive: 1\nShard: 1 abc 1 1 archive.0.tar.gpg\n", parsed));
+        QVERIFY(!ShardedArchiveManifest::fromByteArray("QGpgME-Sharded-Archive: 1\nShard: 1 " + hash + " 1 archive.0.tar.gpg\n", parsed));
+        QVERIFY(!ShardedArchiveManifest::fromByteArray("Something else\n", parsed));
+    }
+
+    void testProgressIsCombined()
+    {
+        ShardedArchiveProgress progress;
+        progress.resize(2);
+        progress.setFileProgress(0, 5, 10);
+        progress.setFileProgress(1, 1, 20);
+        QCOMPARE(progress.fileProgress(), std::make_pair(6, 30));
+
+        // scaled values are converted to bytes using the size of the files in the shards
+        progress.setDataProgress(0, 512, 1024, 1000);
+        progress.setDataProgress(1, 0, 1024, 3000);
+        QCOMPARE(progress.dataProgress(), std::make_pair(500, 4000));
+
+        // large totals are scaled down to 2^20
+        progress.setDataProgress(0, 1, 2, qint64(1) << 32);
+        progress.setDataProgress(1, 1, 2, qint64(1) << 32);
+        QCOMPARE(progress.dataProgress(), std::make_pair(1 << 19, 1 << 20));
+    }
+
+    void testEncryptDecryptRoundTrip()
+    {
+        if (!EncryptArchiveJob::isSupported() || !DecryptVerifyArchiveJob::isSupported() || !loopbackSupported()) {
+            QSKIP("gpgtar or loopback pinentry is not supported");
+        }
+        QVERIFY(cachePassphrases());
+
+        const QString manifestFile = encryptTree(3);
+        QVERIFY(!manifestFile.isEmpty());
+
+        VerificationResult verificationResult;
+        const auto error = decryptArchive(manifestFile, verificationResult);
+        QVERIFY(!error);
+        QCOMPARE(verificationResult.numSignatures(), 1u);
+        QVERIFY(verificationResult.signature(0).summary() & Signature::Valid);
+
+        const QDir out{mDir->filePath(QStringLiteral("out"))};
+        for (int i = 0; i < 6; ++i) {
+            QCOMPARE(readFile(out.filePath(QStringLiteral("tree/file%1.txt").arg(i))), QByteArray(100 * (i + 1), 'a' + i));
+        }
+        QCOMPARE(readFile(out.filePath(QStringLiteral("tree/sub/file.txt"))), QByteArray{"sub"});
+    }
+
+    void testTamperedShardIsRejected()
+    {
+        if (!EncryptArchiveJob::isSupported() || !DecryptVerifyArchiveJob::isSupported() || !loopbackSupported()) {
+            QSKIP("gpgtar or loopback pinentry is not supported");
+        }
+        QVERIFY(cachePassphrases());
+
+        const QString manifestFile = encryptTree(2);
+        QVERIFY(!manifestFile.isEmpty());
+
+        // modify one byte of the last shard without changing its size
+        const QString shardFile = mDir->filePath(QStringLiteral("shards/archive.1.tar.gpg"));
+        QByteArray shard = readFile(shardFile);
+        QVERIFY(shard.size() > 100);
+        shard[shard.size() / 2] = shard[shard.size() / 2] ^ 0x01;
+        QVERIFY(QFile::remove(shardFile));
+        QVERIFY(writeFile(shardFile, shard));
+
+        VerificationResult verificationResult;
+        const auto error = decryptArchive(manifestFile, verificationResult);
+        QCOMPARE(error.code(), static_cast<int>(GPG_ERR_CHECKSUM));
+    }
+
+private:
+    std::unique_ptr<QTemporaryDir> mDir;
+};
+
+QTEST_MAIN(ShardedArchiveTest)
+
+#include "t-shardedarchive.moc"
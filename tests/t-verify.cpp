@@ -33,13 +33,31 @@
  #include "config.h"
 #endif
 
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 
+#include <memory>
 
 #include "protocol.h"
 
+#include "batchverifyjob.h"
+#include "bulkfilesignjob.h"
+#include "bulkfileverifydetachedjob.h"
+#include "changeownertrustjob.h"
+#include "keylistjob.h"
+#include "signjob.h"
+#include "signmanifestjob.h"
+#include "verificationcache.h"
+#include "verifymanifestjob.h"
 #include "verifyopaquejob.h"
+#include <gpgme++/global.h>
+#include <gpgme++/signingresult.h>
 #include <gpgme++/verificationresult.h>
 #include <gpgme++/key.h>
 
@@ -62,6 +80,112 @@ class VerifyTest: public QGpgMETest
 {
     Q_OBJECT
 
+    std::vector<Key> alfaKeys(bool secretOnly = false)
+    {
+        std::unique_ptr<KeyListJob> job{openpgp()->keyListJob(false, false, false)};
+        std::vector<Key> keys;
+        const auto result = job->exec({QStringLiteral("alfa@example.net")}, secretOnly, keys);
+        VERIFY_OR_OBJECT(!result.error());
+        COMPARE_OR_OBJECT(keys.size(), size_t(1));
+        return keys;
+    }
+
+    /* Gives alfa's key ultimate trust, so that its signatures are valid */
+    bool trustAlfa()
+    {
+        const auto keys = alfaKeys();
+        VERIFY_OR_FALSE(!keys.empty());
+        auto job = openpgp()->changeOwnerTrustJob();
+        Error error;
+        connect(job, &ChangeOwnerTrustJob::result, this, [this, &error](const Error &err) {
+            error = err;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_FALSE(!job->start(keys.front(), Key::Ultimate));
+        VERIFY_OR_FALSE(spy.wait(QSIGNALSPY_TIMEOUT));
+        VERIFY_OR_FALSE(!error);
+        return true;
+    }
+
+    /* The manifest is signed without passphrase provider; sign once with the
+     * passphrase provider, so that gpg-agent has cached the passphrase */
+    bool cachePassphrase()
+    {
+        std::unique_ptr<SignJob> job{openpgp()->signJob(true, true)};
+        hookUpPassphraseProvider(job.get());
+        QByteArray signature;
+        VERIFY_OR_FALSE(!job->exec(alfaKeys(true), "Hello", GpgME::Clearsigned, signature).error());
+        return true;
+    }
+
+    bool writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile file{fileName};
+        VERIFY_OR_FALSE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        COMPARE_OR_FALSE(file.write(content), qint64(content.size()));
+        return true;
+    }
+
+    /* Signs \a data with alfa's key with a signature that expires after
+     * \a seconds; gpgme cannot create such signatures */
+    QByteArray signWithExpiration(const QByteArray &data, int seconds)
+    {
+        QProcess p;
+        p.setProgram(QString::fromUtf8(dirInfo("gpg-name")));
+        p.setArguments({QStringLiteral("--batch"),
+                        QStringLiteral("--armor"),
+                        QStringLiteral("--pinentry-mode"), QStringLiteral("loopback"),
+                        QStringLiteral("--passphrase"), QStringLiteral("abc"),
+                        QStringLiteral("--default-sig-expire"), QStringLiteral("seconds=%1").arg(seconds),
+                        QStringLiteral("--local-user"), QStringLiteral("alfa@example.net"),
+                        QStringLiteral("--sign")
+        });
+        p.start();
+        VERIFY_OR_OBJECT(p.waitForStarted());
+        p.write(data);
+        p.closeWriteChannel();
+        VERIFY_OR_OBJECT(p.waitForFinished());
+        VERIFY_OR_OBJECT(p.exitStatus() == QProcess::NormalExit);
+        COMPARE_OR_OBJECT(p.exitCode(), 0);
+        return p.readAllStandardOutput();
+    }
+
+    VerificationResult verifyOpaque(const QByteArray &signedData, const std::shared_ptr<VerificationCache> &cache)
+    {
+        std::unique_ptr<VerifyOpaqueJob> job{openpgp()->verifyOpaqueJob(true)};
+        job->setVerificationCache(cache);
+        QByteArray plainText;
+        return job->exec(signedData, plainText);
+    }
+
+    struct ManifestCheck {
+        Error error;
+        VerificationResult verificationResult;
+        std::vector<QString> mismatchedFiles;
+        int progressSignals = 0;
+    };
+
+    ManifestCheck verifyManifest(const QString &manifestFile)
+    {
+        ManifestCheck check;
+        auto job = new VerifyManifestJob{openpgp()};
+        job->setManifestFile(manifestFile);
+        connect(job, &VerifyManifestJob::fileProgress, this, [&check]() {
+            check.progressSignals++;
+        });
+        connect(job, &VerifyManifestJob::result, this, [this, &check](const Error &err, const VerificationResult &result, const std::vector<QString> &files) {
+            check.error = err;
+            check.verificationResult = result;
+            check.mismatchedFiles = files;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        VERIFY_OR_OBJECT(!job->startIt());
+        VERIFY_OR_OBJECT(spy.wait(QSIGNALSPY_TIMEOUT));
+        return check;
+    }
+
 private Q_SLOTS:
 
     /* Check that a signature always has a key. */
@@ -89,6 +213,287 @@ private Q_SLOTS:
         }
         QVERIFY(found);
     }
+
+    void testVerificationCache()
+    {
+        const QByteArray signedData(testMsg1);
+        auto cache = std::make_shared<VerificationCache>();
+
+        QByteArray firstPlainText;
+        VerificationResult firstResult;
+        {
+            std::unique_ptr<VerifyOpaqueJob> job{openpgp()->verifyOpaqueJob(true)};
+            job->setVerificationCache(cache);
+            firstResult = job->exec(signedData, firstPlainText);
+            QVERIFY(!firstResult.error());
+        }
+        QCOMPARE(cache->statistics().insertions, quint64(1));
+        QCOMPARE(cache->statistics().misses, quint64(1));
+
+        /* The second verification returns the cached result */
+        QByteArray secondPlainText;
+        VerificationResult secondResult;
+        {
+            std::unique_ptr<VerifyOpaqueJob> job{openpgp()->verifyOpaqueJob(true)};
+            job->setVerificationCache(cache);
+            secondResult = job->exec(signedData, secondPlainText);
+            QVERIFY(!secondResult.error());
+        }
+        QCOMPARE(cache->statistics().hits, quint64(1));
+        QCOMPARE(secondPlainText, firstPlainText);
+        QCOMPARE(secondResult.numSignatures(), firstResult.numSignatures());
+        QCOMPARE(QByteArray{secondResult.signature(0).fingerprint()}, QByteArray{firstResult.signature(0).fingerprint()});
+
+        /* Processing all signatures is a different verification */
+        {
+            std::unique_ptr<VerifyOpaqueJob> job{openpgp()->verifyOpaqueJob(true)};
+            job->setVerificationCache(cache);
+            job->setProcessAllSignatures(true);
+            QByteArray plainText;
+            job->exec(signedData, plainText);
+        }
+        QCOMPARE(cache->statistics().hits, quint64(1));
+        QCOMPARE(cache->statistics().misses, quint64(2));
+    }
+
+    void testVerificationCacheHonorsSignatureExpiration()
+    {
+        const QByteArray signedData = signWithExpiration("Hello", 3);
+        QVERIFY(!signedData.isEmpty());
+        auto cache = std::make_shared<VerificationCache>();
+
+        const auto firstResult = verifyOpaque(signedData, cache);
+        QVERIFY(!firstResult.error());
+        QCOMPARE(firstResult.numSignatures(), 1U);
+        const auto expiration = static_cast<qint64>(firstResult.signature(0).expirationTime());
+        QVERIFY(expiration > 0);
+        QVERIFY(!(firstResult.signature(0).summary() & Signature::SigExpired));
+        QCOMPARE(cache->statistics().insertions, quint64(1));
+
+        /* The cached result is used until the signature expires */
+        verifyOpaque(signedData, cache);
+        QCOMPARE(cache->statistics().hits, quint64(1));
+
+        QTRY_VERIFY_WITH_TIMEOUT(QDateTime::currentSecsSinceEpoch() >= expiration, 10000);
+        const auto expiredResult = verifyOpaque(signedData, cache);
+        QVERIFY(!expiredResult.error());
+        QVERIFY(expiredResult.signature(0).summary() & Signature::SigExpired);
+        QCOMPARE(cache->statistics().hits, quint64(1));
+        QCOMPARE(cache->statistics().invalidations, quint64(1));
+        /* The result with the expired signature isn't cached */
+        QCOMPARE(cache->statistics().insertions, quint64(1));
+        QCOMPARE(cache->statistics().entries, 0);
+    }
+
+    void testBatchVerify()
+    {
+        std::vector<BatchVerifyJob::Item> items;
+        for (int i = 0; i < 20; ++i) {
+            items.push_back({QByteArray{testMsg1}, QByteArray{}});
+        }
+
+        auto job = new BatchVerifyJob{GpgME::OpenPGP};
+        job->setItems(items);
+        job->setChunkSize(8);
+        job->setMaxThreads(3);
+        std::vector<std::pair<int, int>> chunks;
+        connect(job, &BatchVerifyJob::chunkVerified, this, [&chunks](int firstIndex,
+                                                                     const std::vector<VerificationResult> &results,
+                                                                     const std::vector<QByteArray> &) {
+            chunks.push_back({firstIndex, static_cast<int>(results.size())});
+        });
+        Error error;
+        std::vector<VerificationResult> results;
+        std::vector<QByteArray> plainTexts;
+        BatchJob::LatencyStatistics latencies;
+        connect(job, &BatchVerifyJob::result, this, [this, job, &error, &results, &plainTexts, &latencies](const Error &err,
+                                                                                                         const std::vector<VerificationResult> &res,
+                                                                                                         const std::vector<QByteArray> &pt) {
+            error = err;
+            results = res;
+            plainTexts = pt;
+            latencies = job->latencyStatistics();
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(!job->startIt());
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+        QVERIFY(!error);
+        QCOMPARE(results.size(), items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            QVERIFY(!results[i].error());
+            QCOMPARE(static_cast<int>(results[i].numSignatures()), 1);
+            QCOMPARE(plainTexts[i], plainTexts.front());
+        }
+        QVERIFY(!plainTexts.front().isEmpty());
+        /* The chunks are reported in the order of the items */
+        const std::vector<std::pair<int, int>> expectedChunks{{0, 8}, {8, 8}, {16, 4}};
+        QVERIFY(chunks == expectedChunks);
+        QCOMPARE(latencies.processedMessages, 20);
+        QVERIFY(latencies.p50USecs <= latencies.p90USecs);
+        QVERIFY(latencies.p90USecs <= latencies.p99USecs);
+        QVERIFY(latencies.p99USecs <= latencies.maxUSecs);
+        QVERIFY(latencies.maxUSecs > 0);
+    }
+
+    void testBulkFileSignAndVerifyDetached()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        auto listjob = openpgp()->keyListJob(false, false, false);
+        std::vector<Key> keys;
+        auto keylistresult = listjob->exec(QStringList() << QStringLiteral("alfa@example.net"),
+                                          true, keys);
+        QVERIFY(!keylistresult.error());
+        QVERIFY(keys.size() == 1);
+        delete listjob;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        std::vector<std::pair<QString, QString>> files;
+        for (int i = 0; i < 6; ++i) {
+            const QString fileName = dir.filePath(QStringLiteral("file%1.txt").arg(i));
+            QFile file{fileName};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QByteArray::number(i));
+            files.push_back({fileName, fileName + QLatin1String{".sig"}});
+        }
+
+        {
+            auto job = new BulkFileSignJob{GpgME::OpenPGP};
+            job->setSigners(keys);
+            job->setFiles(files);
+            job->setMaxThreads(3);
+            job->setContextSetupFunction([this](Context *ctx) {
+                hookUpPassphraseProvider(ctx);
+            });
+            Error error;
+            std::vector<BulkFileJob::FileResult> results;
+            connect(job, &BulkFileSignJob::result, this, [this, &error, &results](const Error &err, const std::vector<BulkFileJob::FileResult> &res) {
+                error = err;
+                results = res;
+                Q_EMIT asyncDone();
+            });
+            QSignalSpy spy{this, SIGNAL(asyncDone())};
+            QVERIFY(!job->startIt());
+            QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+            QVERIFY(!error);
+            QCOMPARE(results.size(), files.size());
+            for (const auto &result : results) {
+                QVERIFY(!result.error);
+                QCOMPARE(result.numSignatures, 1);
+                QCOMPARE(result.signerFingerprint, QByteArray{keys.front().primaryFingerprint()});
+            }
+        }
+
+        // tamper with one of the signed files
+        {
+            QFile file{files[2].first};
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+            file.write("modified");
+        }
+
+        auto job = new BulkFileVerifyDetachedJob{GpgME::OpenPGP};
+        job->setFiles(files);
+        job->setMaxThreads(3);
+        job->setReportCompletedFiles(true);
+        job->setCompletionOrder(BulkFileJob::OrderedCompletion);
+        std::vector<int> completedFiles;
+        connect(job, &BulkFileJob::fileCompleted, this, [&completedFiles](int index, const BulkFileJob::FileResult &result) {
+            completedFiles.push_back(index);
+            QCOMPARE(result.numSignatures, 1);
+        });
+        Error error;
+        std::vector<BulkFileJob::FileResult> results;
+        connect(job, &BulkFileVerifyDetachedJob::result, this, [this, &error, &results](const Error &err, const std::vector<BulkFileJob::FileResult> &res) {
+            error = err;
+            results = res;
+            Q_EMIT asyncDone();
+        });
+        QSignalSpy spy{this, SIGNAL(asyncDone())};
+        QVERIFY(!job->startIt());
+        QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+
+        QVERIFY(!error);
+        QCOMPARE(completedFiles, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+        QCOMPARE(results.size(), files.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            QVERIFY(!results[i].error);
+            QCOMPARE(results[i].numSignatures, 1);
+            QCOMPARE(bool(results[i].signatureSummary & Signature::Red), i == 2);
+        }
+    }
+
+    void testSignAndVerifyManifest()
+    {
+        if (!loopbackSupported()) {
+            return;
+        }
+        QVERIFY(trustAlfa());
+        QVERIFY(cachePassphrase());
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QVERIFY(QDir{dir.path()}.mkpath(QStringLiteral("sub")));
+        QVERIFY(writeFile(dir.filePath(QStringLiteral("a.txt")), "alpha"));
+        QVERIFY(writeFile(dir.filePath(QStringLiteral("b.txt")), "bravo"));
+        QVERIFY(writeFile(dir.filePath(QStringLiteral("sub/c.txt")), "charlie"));
+        const QString manifestFile = dir.filePath(QStringLiteral("manifest.asc"));
+
+        {
+            auto job = new SignManifestJob{openpgp()};
+            job->setSigners(alfaKeys(true));
+            job->setFiles({QStringLiteral("a.txt"), QStringLiteral("b.txt"), QStringLiteral("sub/c.txt")});
+            job->setBaseDirectory(dir.path());
+            job->setOutputFile(manifestFile);
+            job->setMaxThreads(2);
+            Error error;
+            connect(job, &SignManifestJob::result, this, [this, &error](const Error &err, const SigningResult &) {
+                error = err;
+                Q_EMIT asyncDone();
+            });
+            QSignalSpy spy{this, SIGNAL(asyncDone())};
+            QVERIFY(!job->startIt());
+            QVERIFY(spy.wait(QSIGNALSPY_TIMEOUT));
+            QVERIFY(!error);
+            QVERIFY(QFile::exists(manifestFile));
+        }
+
+        {
+            const auto check = verifyManifest(manifestFile);
+            QVERIFY(!check.error);
+            QVERIFY(check.mismatchedFiles.empty());
+            QCOMPARE(check.verificationResult.numSignatures(), 1u);
+            QVERIFY(check.verificationResult.signature(0).summary() & Signature::Valid);
+        }
+
+        // modify one file without changing its size and truncate another one
+        QVERIFY(writeFile(dir.filePath(QStringLiteral("a.txt")), "alfa!"));
+        QVERIFY(writeFile(dir.filePath(QStringLiteral("sub/c.txt")), "char"));
+        {
+            const auto check = verifyManifest(manifestFile);
+            QCOMPARE(check.error.code(), static_cast<int>(GPG_ERR_CHECKSUM));
+            QCOMPARE(check.mismatchedFiles, (std::vector<QString>{QStringLiteral("a.txt"), QStringLiteral("sub/c.txt")}));
+        }
+
+        // tamper with the manifest; the files are not checked at all
+        QFile file{manifestFile};
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QByteArray manifest = file.readAll();
+        file.close();
+        QVERIFY(manifest.contains("b.txt"));
+        manifest.replace("b.txt", "x.txt");
+        QVERIFY(writeFile(manifestFile, manifest));
+        {
+            const auto check = verifyManifest(manifestFile);
+            QCOMPARE(check.error.code(), static_cast<int>(GPG_ERR_BAD_SIGNATURE));
+            QVERIFY(check.mismatchedFiles.empty());
+            QCOMPARE(check.progressSignals, 0);
+        }
+    }
 };
 
 QTEST_MAIN(VerifyTest)